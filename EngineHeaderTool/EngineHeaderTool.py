@@ -6,6 +6,7 @@ import argparse
 menu = []
 active_choice = 0
 scene_serializer_lines = ""
+registered_components = []
 
 def find_serializable_variables(header_file_path, all_public):
     
@@ -131,45 +132,6 @@ def check_includes(Component, file = '/src/SceneSerializer.cpp'):
 
     return False
 
-def remove_lines_between(start_line, end_line, first_skip = False, file = '/src/SceneSerializer.cpp'):
-    global scene_serializer_lines
-    print('Removing lines from ' + start_line + ' to ' + end_line)
-
-    file_path = args.engine_dir + file
-    lines = None
-    from_cache = False
-
-    if file == '/src/SceneSerializer.cpp':
-        lines = scene_serializer_lines
-        from_cache = True
-    else:
-        with open(file_path, 'r') as file:
-            lines = file.readlines()
-
-    save_lines = True
-
-    new_lines = []
-    
-    for line in lines:
-        if start_line in line:
-            save_lines = False
-
-        if save_lines:
-            new_lines.append(line)
-        else:
-            if end_line in line:
-                if first_skip == True:
-                    first_skip = False
-                else:
-                    save_lines = True
-
-    if from_cache:
-        scene_serializer_lines.clear()
-        scene_serializer_lines += new_lines
-    else:
-        with open(file_path, 'w') as file:
-            file.writelines(new_lines)
-
 def add_lines_at_target(target_line, lines_to_add, shift = 0, file = '/src/SceneSerializer.cpp'):
     global scene_serializer_lines
 
@@ -210,109 +172,275 @@ def create_header_code(Component):
 
     return header_code
 
-def create_serialization_code(file, Component, serializable_vars, indentation = 0):
+def get_variable_name(Component):
+    return Component.lower()
 
-    name, parent, is_parent, is_abstract = file
+def create_serialization_code():
+    serialization_code = []
 
-    component = Component.lower()
+    for type_id, (Component, include, serializable_vars) in enumerate(registered_components):
+        component = get_variable_name(Component)
+        fields = get_checked_fields(serializable_vars)
 
-    serialization_code = [
-        '    if (auto const ' + component + ' = std::dynamic_pointer_cast<class ' + Component + '>(component); ' + component + ' != nullptr)',
-        '    {'
-    ]
-
-    if parent == 'Component':
         serialization_code += [
-        '        out << YAML::BeginMap;'
+        '    case ' + str(type_id) + ': // ' + Component + 'Component'
         ]
 
-    if is_parent == True:
-        serialization_code += [
-        '        // # Put new ' + Component  + ' kid here',
-        '        {',
-        '            out << YAML::Key << "ComponentName" << YAML::Value << "' + Component + 'Component";',
-        '            out << YAML::Key << "guid" << YAML::Value << ' + component + '->guid;',
-        '            out << YAML::Key << "custom_name" << YAML::Value << ' + component + '->custom_name;'
-        ]
-    else:
+        if fields == []:
+            serialization_code += [
+            '        break;',
+            '',
+            ]
+            continue
+
         serialization_code += [
-        '        out << YAML::Key << "ComponentName" << YAML::Value << "' + Component + 'Component";',
-        '        out << YAML::Key << "guid" << YAML::Value << ' + component + '->guid;',
-        '        out << YAML::Key << "custom_name" << YAML::Value << ' + component + '->custom_name;'
+        '    {',
+        '        auto const ' + component + ' = std::static_pointer_cast<class ' + Component + '>(component);'
         ]
 
-    if is_parent == True:
+        for var_type, var_name in fields:
+            serialization_code += [
+            '        out << YAML::Key << "' + var_name + '" << YAML::Value << ' + component + '->' + var_name + ';'
+            ]
+
         serialization_code += [
-        '        }'
+        '        break;',
+        '    }',
+        '',
         ]
 
-    for var_type, var_name, is_checked in serializable_vars:
+    return serialization_code
 
-        if is_checked == False:
-            continue
+def create_deserialization_code():
+    deserialization_code = []
 
-        serialization_code += [
-        '        out << YAML::Key << "' + var_name + '" << YAML::Value << ' + component + '->' + var_name + ';',
-    ]    
+    for type_id, (Component, include, serializable_vars) in enumerate(registered_components):
+        component = get_variable_name(Component)
+        fields = get_checked_fields(serializable_vars)
 
-    if parent == 'Component':
-        serialization_code += [
-        '        out << YAML::EndMap;',
+        deserialization_code += [
+        '    case ' + str(type_id) + ': // ' + Component + 'Component'
         ]
 
-    serialization_code += [
+        if fields == []:
+            deserialization_code += [
+            '        break;',
+            '',
+            ]
+            continue
+
+        deserialization_code += [
+        '    {',
+        '        auto const ' + component + ' = std::static_pointer_cast<class ' + Component + '>(deserialized_component);'
+        ]
+
+        for var_type, var_name in fields:
+            deserialization_code += [
+            '        if (component["' + var_name + '"].IsDefined())',
+            '            ' + component + '->' + var_name + ' = component["' + var_name + '"].as<' + var_type + '>();'
+            ]
+
+        deserialization_code += [
+        '        break;',
         '    }',
+        '',
+        ]
+
+    return deserialization_code
+
+def create_registry_include_code():
+    return sorted(set(['#include "' + include + '"' for Component, include, serializable_vars in registered_components]))
+
+# 64-bit FNV-1a, same as AK::fnv_hash().
+def fnv_hash(data, seed):
+    hash = seed
+    for byte in data:
+        hash = ((hash ^ byte) * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return hash
+
+def create_registry_code():
+    names = [Component + 'Component' for Component, include, serializable_vars in registered_components]
+
+    if len(names) >= 255:
+        print('Too many components for the name slots, make them wider than u8')
+        exit()
+
+    # Tries seeds until every name gets a slot of its own, so looking up a name is a single probe.
+    slot_count = 256
+    seed = 0xCBF29CE484222325
+    while True:
+        slots = [0] * slot_count
+        for type_id, name in enumerate(names):
+            slot = fnv_hash(name.encode('utf-8'), seed) % slot_count
+            if slots[slot] != 0:
+                break
+            slots[slot] = type_id + 1
+        else:
+            break
+        seed += 1
+
+    registry_code = [
+        'std::array<ComponentRegistry::ComponentType, ' + str(len(names)) + '> const component_types = {{',
     ]
 
-    #if parent != 'Component':
-    serialization_code += [
-    '    else'
+    for Component, include, serializable_vars in registered_components:
+        readable = re.sub(r'(?<=[a-z])(?=[A-Z])', ' ', Component)
+        entry = '    {"' + Component + 'Component", "' + readable + '", &create_component<' + Component + '>,'
+        # Wrapped the way clang-format does.
+        if len(entry + ' typeid(' + Component + ')},') > 140:
+            registry_code += [
+            entry,
+            '     typeid(' + Component + ')},'
+            ]
+        else:
+            registry_code += [
+            entry + ' typeid(' + Component + ')},'
+            ]
+
+    registry_code += [
+        '}};',
+        '',
+        'u64 constexpr name_hash_seed = 0x' + format(seed, '016X') + ';',
+        '',
+        'std::array<u8, ' + str(slot_count) + '> constexpr name_slots = {',
     ]
 
-    for i in range(len(serialization_code)):
-        for j in range(indentation):
-            serialization_code[i] = '    ' + serialization_code[i]
+    for row in range(0, slot_count, 16):
+        registry_code += [
+        '    ' + ', '.join(str(slot) for slot in slots[row:row + 16]) + ','
+        ]
 
-    return serialization_code
+    registry_code += [
+        '};'
+    ]
 
-def create_deserialization_code(Component, serializable_vars):
+    return registry_code
 
-    deserialization_code = [
-        '    if (component_name == "' + Component + 'Component")',
-        '    {',
-        '        if (first_pass)',
-        '        {',
-        '            auto const deserialized_component = ' + Component + '::create();',
-        '            deserialized_component->guid = component["guid"].as<std::string>();',
-        '            deserialized_component->custom_name = component["custom_name"].as<std::string>();',
-        '            deserialized_pool.emplace_back(deserialized_component);',
-        '        }',
-        '        else',
-        '        {',
-        '            auto const deserialized_component = std::dynamic_pointer_cast<class ' + Component + '>(get_from_pool(component["guid"].as<std::string>()));'
+def add_registry():
+    replace_generated_lines('// # Auto registry includes start', '// # Auto registry includes end', create_registry_include_code(),
+                            '/src/ComponentRegistry.cpp')
+    replace_generated_lines('// # Auto registry start', '// # Auto registry end', create_registry_code(), '/src/ComponentRegistry.cpp')
+    print('Succesful added ' + str(len(registered_components)) + ' components to the registry!')
+
+def add_yaml_serialization():
+    replace_generated_lines('// # Auto serialization start', '// # Auto serialization end', create_serialization_code())
+    replace_generated_lines('// # Auto deserialization start', '// # Auto deserialization end', create_deserialization_code())
+
+def replace_generated_lines(start_line, end_line, lines_to_add, file = '/src/SceneSerializer.cpp'):
+    global scene_serializer_lines
+
+    file_path = args.engine_dir + file
+    lines = None
+    from_cache = False
+
+    if file == '/src/SceneSerializer.cpp':
+        lines = scene_serializer_lines
+        from_cache = True
+    else:
+        with open(file_path, 'r') as file:
+            lines = file.readlines()
+
+    start_index = None
+    end_index = None
+    for index, line in enumerate(lines):
+        if start_line in line and start_index is None:
+            start_index = index
+        elif end_line in line and start_index is not None:
+            end_index = index
+            break
+
+    if start_index is None or end_index is None:
+        print("Can't find " + start_line + ' or ' + end_line)
+        return
+
+    lines[start_index + 1:end_index] = [line + '\n' for line in lines_to_add]
+
+    if not from_cache:
+        with open(file_path, 'w') as file:
+            file.writelines(lines)
+
+def get_checked_fields(serializable_vars):
+    return [(var_type, var_name) for var_type, var_name, is_checked in serializable_vars if is_checked]
+
+def create_binary_layout_code():
+    # Cooked binary scenes store this hash and are ignored once any serialized field changes.
+    layout = ''
+    for Component, include, serializable_vars in registered_components:
+        layout += Component + 'Component:'
+        for var_type, var_name in get_checked_fields(serializable_vars):
+            layout += var_type + ' ' + var_name + ','
+        layout += ';'
+
+    # FNV-1a
+    layout_hash = 0x811C9DC5
+    for byte in layout.encode('utf-8'):
+        layout_hash = ((layout_hash ^ byte) * 0x01000193) & 0xFFFFFFFF
+
+    binary_layout_code = [
+        'u32 constexpr binary_scene_layout_hash = 0x' + format(layout_hash, '08X') + ';'
     ]
 
-    for var_type, var_name, is_checked in serializable_vars:
-        
-        if is_checked == False:
+    return binary_layout_code
+
+def create_binary_transcoding_code():
+    binary_transcoding_code = []
+
+    for type_index, (Component, include, serializable_vars) in enumerate(registered_components):
+        binary_transcoding_code += [
+        '    case ' + str(type_index) + ': // ' + Component + 'Component'
+        ]
+
+        for var_type, var_name in get_checked_fields(serializable_vars):
+            binary_transcoding_code += [
+            '        out.transcode_field<' + var_type + '>(component["' + var_name + '"]);'
+            ]
+
+        binary_transcoding_code += [
+        '        break;',
+        '',
+        ]
+
+    return binary_transcoding_code
+
+def create_binary_deserialization_code():
+    binary_deserialization_code = []
+
+    for type_index, (Component, include, serializable_vars) in enumerate(registered_components):
+        fields = get_checked_fields(serializable_vars)
+
+        if fields == []:
+            binary_deserialization_code += [
+            '    case ' + str(type_index) + ': // ' + Component + 'Component',
+            '        break;',
+            '',
+            ]
             continue
 
-        deserialization_code += [
-            '            if (component["'+ var_name + '"].IsDefined())',
-            '            {',
-            '                deserialized_component->' + var_name + ' = component["' + var_name + '"].as<' + var_type + '>();',
-            '            }',
+        binary_deserialization_code += [
+        '    case ' + str(type_index) + ': // ' + Component + 'Component',
+        '    {',
+        '        auto const deserialized_component = std::static_pointer_cast<class ' + Component + '>(component);'
         ]
 
-    deserialization_code += [
-        '            deserialized_entity->add_component(deserialized_component);',
-        '            deserialized_component->reprepare();',
-        '        }',
+        for var_type, var_name in fields:
+            binary_deserialization_code += [
+            '        if (in.has_field())',
+            '            deserialized_component->' + var_name + ' = in.read<' + var_type + '>();'
+            ]
+
+        binary_deserialization_code += [
+        '        break;',
         '    }',
-        '        else'
-    ]
+        '',
+        ]
 
-    return deserialization_code
+    return binary_deserialization_code
+
+def add_binary_serialization():
+    replace_generated_lines('// # Auto binary layout start', '// # Auto binary layout end', create_binary_layout_code())
+    replace_generated_lines('// # Auto binary transcoding start', '// # Auto binary transcoding end', create_binary_transcoding_code())
+    replace_generated_lines('// # Auto binary deserialization start', '// # Auto binary deserialization end', create_binary_deserialization_code())
+    print('Succesful added binary serialization for ' + str(len(registered_components)) + ' components!')
 
 def pick_variables(serializable_vars):
     
@@ -392,23 +520,7 @@ def scan_all_files(inherits_from = 'Component'):
 
     return files_to_serialize
 
-def clean_up(files_to_serilize, Component, is_parent):
-
-    if args.pick_files:
-        component = Component.lower()
-        for file in files_to_serilize:
-            new_name, new_parent, new_is_parent, new_is_abstract = file
-            new_Component = os.path.basename(new_name)[:-2]
-            if new_parent == Component:
-                clean_up(files_to_serilize, new_Component, new_is_parent)
-        
-        if is_parent:
-            remove_lines_between('if (auto const ' + component + ' = std::dynamic_pointer_cast<class ' + Component + '>(component); ' + component + ' != nullptr)', 'else', True)
-        else:
-            remove_lines_between('if (auto const ' + component + ' = std::dynamic_pointer_cast<class ' + Component + '>(component); ' + component + ' != nullptr)', 'else')
-        remove_lines_between('if (component_name == "' + Component + 'Component")', 'else')
-
-def add_serialization(file, pick_vars, pick_files, indentation = 0):
+def add_serialization(file, pick_vars, pick_files):
 
     name, parent, is_parent, is_abstract = file
     name = name.replace("\\", "/")
@@ -430,32 +542,18 @@ def add_serialization(file, pick_vars, pick_files, indentation = 0):
     if pick_vars == True:
         serializable_vars = pick_variables(serializable_vars)
     
-    is_already_serialized = check_includes(name)
-
-    create_serialization_code(file, Component, serializable_vars)
-
-    if is_already_serialized == False:
+    if check_includes(name) == False:
         add_lines_at_target('// # Put new header here', create_header_code(name))
-    else:
-        clean_up(files_to_serialize, Component, is_parent)
-        
-    place_to_add_serialization = '// # Put new serialization here'
-    shift = -5
-    if parent != 'Component':
-        place_to_add_serialization = '// # Put new ' + parent + ' kid here'
-        shift = 1
-        
-    add_lines_at_target(place_to_add_serialization, create_serialization_code(file, Component, serializable_vars, indentation), shift)
-    print('Succesful added serialization for ' + Component + '!')
 
     additional_variables = recursively_search_serializable_variables(header_file_path)
 
-    print("Additional variables from parents added to deserialization code: ")
+    print("Additional variables from parents added to serialization code: ")
     print(additional_variables)
 
+    # Abstract components are never saved on their own, their variables are part of every kid.
     if is_abstract == False:
-        add_lines_at_target('// # Put new deserialization here', create_deserialization_code(Component, serializable_vars + additional_variables), -3)
-        print('Succesful added deserialization for ' + Component + '!')
+        include = name.replace(args.engine_dir + "/src/", "", 1)
+        registered_components.append((Component, include, serializable_vars + additional_variables))
 
     components_to_remove = []
 
@@ -463,7 +561,7 @@ def add_serialization(file, pick_vars, pick_files, indentation = 0):
         new_name, new_parent, new_is_parent, new_is_abstract = file
         if new_parent == Component:
             components_to_remove.append(new_name)
-            add_serialization(file, pick_vars, pick_files, indentation + 1)
+            add_serialization(file, pick_vars, pick_files)
 
     for trash in components_to_remove:
         index = 0
@@ -473,24 +571,6 @@ def add_serialization(file, pick_vars, pick_files, indentation = 0):
             else:
                 index += 1
 
-def add_to_component_list(file):
-    name, parent, is_parent, is_abstract = file
-    name = name.replace("\\", "/")
-    Component = os.path.basename(name)[:-2]
-    readable = re.sub(r'(?<=[a-z])(?=[A-Z])', ' ', Component)
-
-    if is_abstract:
-        return
-    
-    print('Adding ' + Component + ' to component list')
-    add_lines_at_target('// # Put new component here', ['    ENUMERATE_COMPONENT(' + Component + ', "' + readable + '") \\'], 0, '/src/ComponentList.h')
-    
-    is_already_serialized = check_includes(name, '/src/Editor.cpp')
-
-    if is_already_serialized == False:
-        add_lines_at_target('// # Put new header here', create_header_code(name), 0, '/src/Editor.cpp')
-
-
 parser = argparse.ArgumentParser(description='Engine Header Tool')
 parser.add_argument('-d', '--engine_dir', action='store', help="root directory of the engine")
 parser.add_argument('-pv', '--pick_vars', action='store_true', help='let you pick variables to serilize')
@@ -506,38 +586,12 @@ sorted_files = sorted(files_to_serialize, key=lambda x: x[1] != "Component")
 for i in range(len(files_to_serialize)):
     print(files_to_serialize[i])
 
-remove_lines_between('// # Auto serialization start', '// # Put new serialization here')
-code = [
-    '    // # Auto serialization start',
-    '    {',
-    '        // NOTE: This only returns unmangled name while using the MSVC compiler',
-    '        std::string const name = typeid(*component).name();',
-    '        std::cout << "Error. Serialization of component " << name.substr(6) << " failed." << "\\n";',
-    '    }',
-    '    // # Put new serialization here'
-]
-add_lines_at_target('auto_serialize_component', code, 2)
-
-remove_lines_between('// # Auto deserialization start', '// # Put new deserialization here')
-code = [
-    '    // # Auto deserialization start',
-    '    {',
-    '        std::cout << "Error. Deserialization of component " << component_name << " failed." << "\\n";',
-    '    }',
-    '    // # Put new deserialization here'
-]
-add_lines_at_target('auto_deserialize_component', code, 4)
-
-remove_lines_between('// # Auto component list start', '// # Auto component list end', False, '/src/ComponentList.h')
-add_lines_at_target('// # Put new component here', ['    // # Auto component list start'], 0, '/src/ComponentList.h')
-add_lines_at_target('// # Put new component here', ['#define ENUMERATE_COMPONENTS \\'], 0, '/src/ComponentList.h')
-
-for file in files_to_serialize:
-    add_to_component_list(file)
 for file in files_to_serialize:
     add_serialization(file, args.pick_vars, args.pick_files)
 
-add_lines_at_target('// # Put new component here', ['    // # Auto component list end'], 0, '/src/ComponentList.h')
+add_registry()
+add_yaml_serialization()
+add_binary_serialization()
 
 with open(args.engine_dir + '/src/SceneSerializer.cpp', 'w') as file:
     file.truncate(0)
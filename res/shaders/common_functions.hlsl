@@ -57,3 +57,12 @@ float3 normal_blend(float3 n1, float3 n2)
 
     return normalize(n2.x*nBasis[0] + n2.y*nBasis[1] + n2.z*nBasis[2]);
 }
+
+// Inverse of VertexPacking::encode_normal(), vertex normals are stored octahedral encoded.
+float3 decode_octahedral_normal(float2 encoded)
+{
+    float3 normal = float3(encoded.x, encoded.y, 1.0f - abs(encoded.x) - abs(encoded.y));
+    float t = saturate(-normal.z);
+    normal.xy += normal.xy >= 0.0f ? -t : t;
+    return normalize(normal);
+}
@@ -4,7 +4,7 @@
 struct VS_Input
 {
     float3 pos: POSITION;
-    float3 normal : NORMAL;
+    float2 normal : NORMAL;
     float2 UV : TEXCOORD;
 };
 
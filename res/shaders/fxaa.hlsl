@@ -214,7 +214,7 @@ float3 FXAA(Texture2D tex, float2 UV)
 struct VS_Input
 {
     float3 pos: POSITION;
-    float3 normal : NORMAL;
+    float2 normal : NORMAL;
     float2 UV : TEXCOORD;
 };
 
@@ -1,3 +1,5 @@
+#include "common_functions.hlsl"
+
 cbuffer skinning_buffer : register(b4)
 {
     float4x4 bones[512];
@@ -6,9 +8,9 @@ cbuffer skinning_buffer : register(b4)
 struct VS_Input
 {
     float3 pos: POSITION;
-    float3 normal : NORMAL;
+    float2 normal : NORMAL;
     float2 UV : TEXCOORD0;
-    int4 skin_indices : TEXCOORD1;
+    uint4 skin_indices : TEXCOORD1;
     float4 skin_weights : TEXCOORD2;
 };
 
@@ -50,12 +52,13 @@ VS_Output vs_main(VS_Input input)
     VS_Output output;
 
     float4 pos_skinned = float4(input.pos, 1.0f);
+    float3 normal = decode_octahedral_normal(input.normal);
     /////////////
     // Check if there are bones influencing the vertex
     bool has_influences = false;
     for(int i = 0; i < 4; i++)
     {
-        if(input.skin_indices[i] >= 0)
+        if(input.skin_weights[i] > 0.0f)
         {
             has_influences = true;
             break;
@@ -69,12 +72,12 @@ VS_Output vs_main(VS_Input input)
         float4 norm_skinned = float4(0.f,0.f,0.f,0.f);
 
         float4 input_pos_4 = float4(input.pos, 1.0f);
-        float4 input_norm_4 = float4(input.normal, 1.0f);
+        float4 input_norm_4 = float4(normal, 1.0f);
         
         
         for(int i = 0; i < 4; i++)
         {
-            if(input.skin_indices[i] >= 0)
+            if(input.skin_weights[i] > 0.0f)
             {
                 float4x4 bone = bones[input.skin_indices[i]];
                 float weight = input.skin_weights[i];
@@ -88,7 +91,7 @@ VS_Output vs_main(VS_Input input)
     
     output.world_pos = mul(model, pos_skinned);
     output.UV = input.UV;
-    output.normal = normalize(mul(input.normal, (float3x3)model));
+    output.normal = normalize(mul(normal, (float3x3)model));
     output.pixel_pos = mul(projection_view_model, pos_skinned);
     return output;
 
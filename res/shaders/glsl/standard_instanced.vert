@@ -1,7 +1,7 @@
 #version 430 core
 
 layout (location = 0) in vec3 PositionInput;
-layout (location = 1) in vec3 NormalInput;
+layout (location = 1) in vec2 NormalInput;
 layout (location = 2) in vec2 TextureCoordinatesInput;
 
 layout(std430, binding = 0) buffer modelMatrices
@@ -15,12 +15,21 @@ out vec3 NormalVertex;
 
 uniform mat4 PV;
 
+// Vertex normals are stored octahedral encoded, see VertexPacking::encode_normal().
+vec3 decode_octahedral_normal(vec2 encoded)
+{
+    vec3 normal = vec3(encoded.x, encoded.y, 1.0 - abs(encoded.x) - abs(encoded.y));
+    float t = clamp(-normal.z, 0.0, 1.0);
+    normal.xy += mix(vec2(t), vec2(-t), greaterThanEqual(normal.xy, vec2(0.0)));
+    return normalize(normal);
+}
+
 void main()
 {
     gl_Position = PV * model[gl_InstanceID] * vec4(PositionInput, 1.0);
     FragmentPosition = vec3(model[gl_InstanceID] * vec4(PositionInput, 1.0));
 
     // TODO: Do this on the CPU?
-    NormalVertex = mat3(transpose(inverse(model[gl_InstanceID]))) * NormalInput;
+    NormalVertex = mat3(transpose(inverse(model[gl_InstanceID]))) * decode_octahedral_normal(NormalInput);
     TextureCoordinatesVertex = TextureCoordinatesInput;
 }
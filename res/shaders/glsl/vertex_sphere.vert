@@ -1,7 +1,7 @@
 #version 430 core
 
 layout (location = 0) in vec3 PositionInput;
-layout (location = 1) in vec3 NormalInput;
+layout (location = 1) in vec2 NormalInput;
 layout (location = 2) in vec2 TextureCoordinatesInput;
 
 out VS_OUT
@@ -9,7 +9,7 @@ cbuffer object_buffer : register(b0)
 struct vs_input
 {
     float3 pos : POSITION;
-    float3 normal : NORMAL;
+    float2 normal : NORMAL;
     float2 uv : TEXCOORD;
 };
 
@@ -29,7 +29,7 @@ vs_output vs_main(vs_input input)
     vs_output output;
     output.pos = mul(projection_view_model, float4(input.pos, 1.0f));
     output.uv = input.uv;
-    output.world_normal = mul((float3x3) world, input.normal); 
+    output.world_normal = mul((float3x3) world, decode_octahedral_normal(input.normal));
     output.world_pos = mul(world, float4(input.pos, 1.0f)).xyz;
     return output;
 }
@@ -15,9 +15,9 @@ cbuffer skinning_buffer : register(b4)
 struct VS_Input
 {
     float3 pos: POSITION;
-    float3 normal : NORMAL;
+    float2 normal : NORMAL;
     float2 UV : TEXCOORD0;
-    int4 skin_indices : TEXCOORD1;
+    uint4 skin_indices : TEXCOORD1;
     float4 skin_weights : TEXCOORD2;
 };
 
@@ -37,13 +37,13 @@ VS_Output vs_main(VS_Input input)
     VS_Output output;
 
     const float4 pos = float4(input.pos, 1.0f);
-    const float4 norm = float4(input.normal, 0.0f);
+    const float4 norm = float4(decode_octahedral_normal(input.normal), 0.0f);
     float4 pos_skinned = {0.0f, 0.0f, 0.0f, 0.0f};
     float4 norm_skinned = {0.0f, 0.0f, 0.0f, 0.0f};
 
     for(int i = 0; i < 4; i++)
     {
-        if(input.skin_indices[i] >= 0)
+        if(input.skin_weights[i] > 0.0f)
         {
             const float4x4 bone = bones[input.skin_indices[i]];
             const float weight = input.skin_weights[i];
@@ -53,6 +53,13 @@ VS_Output vs_main(VS_Input input)
         }
     }
 
+    // Static meshes have no influences at all.
+    if (dot(input.skin_weights, 1.0f) <= 0.0f)
+    {
+        pos_skinned = pos;
+        norm_skinned = norm;
+    }
+
     pos_skinned.w = 1.0f;
 
     output.world_pos = mul(model, pos_skinned).xyz;
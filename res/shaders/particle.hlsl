@@ -14,7 +14,7 @@ cbuffer ConstantBufferParticle : register(b4)
 struct VS_Input
 {
     float3 pos: POSITION;
-    float3 normal : NORMAL;
+    float2 normal : NORMAL;
     float2 UV : TEXCOORD;
 };
 
@@ -32,7 +32,7 @@ VS_Output vs_main(VS_Input input)
 {
     VS_Output output;
     output.pos = mul(projection_view_model,float4(input.pos.xyz, 1.0f));
-    output.normal = input.normal;
+    output.normal = decode_octahedral_normal(input.normal);
     output.UV = input.UV;
     return output;
 }
@@ -1,3 +1,5 @@
+#include "common_functions.hlsl"
+
 cbuffer object_buffer : register(b0)
 {
     float4x4 projection_view_model;
@@ -7,7 +9,7 @@ cbuffer object_buffer : register(b0)
 struct VS_Input
 {
     float3 pos: POSITION;
-    float3 normal : NORMAL;
+    float2 normal : NORMAL;
     float2 UV : TEXCOORD;
 };
 
@@ -25,7 +27,7 @@ VS_Output vs_main(VS_Input input)
 {
     VS_Output output;
     output.pos = mul(projection_view_model,float4(input.pos.xyz,1.0f));
-    output.normal = input.normal;
+    output.normal = decode_octahedral_normal(input.normal);
     output.UV = input.UV;
     return output;
 }
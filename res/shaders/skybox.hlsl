@@ -11,7 +11,7 @@ cbuffer object_buffer : register(b0)
 struct VS_Input
 {
     float3 pos : POSITION;
-    float3 normal : NORMAL;
+    float2 normal : NORMAL;
     float2 UV : TEXCOORD0;
 };
 
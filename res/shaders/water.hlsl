@@ -36,7 +36,7 @@ cbuffer time_buffer : register(b1)
 struct VS_Input
 {
     float3 pos: POSITION;
-    float3 normal : NORMAL;
+    float2 normal : NORMAL;
     float2 UV : TEXCOORD0;
 };
 
@@ -185,6 +185,23 @@ inline u32 murmur_hash(u8 const* key, size_t const len, u32 const seed)
     return h;
 }
 
+u64 constexpr fnv_offset_basis = 0xcbf29ce484222325ull;
+
+// 64-bit FNV-1a. Pass the previous result as seed to hash several pieces of data without concatenating them.
+inline u64 fnv_hash(void const* data, size_t const size, u64 const seed = fnv_offset_basis)
+{
+    u8 const* bytes = static_cast<u8 const*>(data);
+    u64 hash = seed;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+
+    return hash;
+}
+
 template<typename T>
 void swap_and_erase(std::vector<T>& vector, T element)
 {
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Types.h"
+
+namespace AK
+{
+
+// Appends trivially copyable values to a byte buffer. Used for the engine's baked binary formats.
+class BinaryWriter
+{
+public:
+    template<typename T>
+    void write(T const& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write_bytes(&value, sizeof(T));
+    }
+
+    template<typename T>
+    void write_vector(std::vector<T> const& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        write(static_cast<u32>(values.size()));
+        write_bytes(values.data(), values.size() * sizeof(T));
+    }
+
+    void write_string(std::string const& value)
+    {
+        write(static_cast<u32>(value.size()));
+        write_bytes(value.data(), value.size());
+    }
+
+    void write_bytes(void const* data, size_t const size)
+    {
+        if (size == 0)
+            return;
+
+        size_t const offset = m_buffer.size();
+        m_buffer.resize(offset + size);
+        std::memcpy(m_buffer.data() + offset, data, size);
+    }
+
+    [[nodiscard]] std::vector<u8> const& get_buffer() const
+    {
+        return m_buffer;
+    }
+
+private:
+    std::vector<u8> m_buffer = {};
+};
+
+// Reads values back from a byte range written by BinaryWriter. Never reads past the end,
+// once a read fails every following read fails too and is_valid() returns false.
+class BinaryReader
+{
+public:
+    BinaryReader(u8 const* data, size_t const size) : m_data(data), m_size(size)
+    {
+    }
+
+    template<typename T>
+    bool read(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        return read_bytes(&value, sizeof(T));
+    }
+
+    template<typename T>
+    bool read_vector(std::vector<T>& values)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+
+        u32 count = 0;
+        if (!read(count) || !can_read(static_cast<size_t>(count) * sizeof(T)))
+            return fail();
+
+        values.resize(count);
+        return read_bytes(values.data(), values.size() * sizeof(T));
+    }
+
+    bool read_string(std::string& value)
+    {
+        u32 length = 0;
+        if (!read(length) || !can_read(length))
+            return fail();
+
+        value.assign(reinterpret_cast<char const*>(m_data + m_offset), length);
+        m_offset += length;
+        return true;
+    }
+
+    bool read_bytes(void* destination, size_t const size)
+    {
+        if (!can_read(size))
+            return fail();
+
+        if (size != 0)
+            std::memcpy(destination, m_data + m_offset, size);
+
+        m_offset += size;
+        return true;
+    }
+
+    [[nodiscard]] bool is_valid() const
+    {
+        return m_valid;
+    }
+
+    [[nodiscard]] bool is_at_end() const
+    {
+        return m_offset == m_size;
+    }
+
+    [[nodiscard]] size_t get_offset() const
+    {
+        return m_offset;
+    }
+
+private:
+    bool can_read(size_t const size) const
+    {
+        return m_valid && size <= m_size - m_offset;
+    }
+
+    bool fail()
+    {
+        m_valid = false;
+        return false;
+    }
+
+    u8 const* m_data = nullptr;
+    size_t m_size = 0;
+    size_t m_offset = 0;
+    bool m_valid = true;
+};
+
+}
@@ -0,0 +1,246 @@
+#include "AnimationCache.h"
+
+#include "AK/AK.h"
+#include "AK/BinaryStream.h"
+#include "CookedModel.h"
+#include "VirtualFileSystem.h"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+std::string AnimationCache::get_cache_path(std::string const& model_path, std::string const& anim_path)
+{
+    // Bone IDs come from the model, so the same clip baked for two models needs two files.
+    std::filesystem::path cache_path = anim_path;
+    cache_path.replace_extension(std::filesystem::path(model_path).stem().string() + ".animcache");
+    return cache_path.string();
+}
+
+std::shared_ptr<Animation> AnimationCache::load(std::string const& cache_path, std::string const& anim_path, ModelSkin const& skin)
+{
+    FileView const file = VirtualFileSystem::read(cache_path);
+
+    if (!file.is_valid())
+        return nullptr;
+
+    u8 const* data = file.get_bytes();
+    size_t const file_size = file.get_size();
+
+    AK::BinaryReader reader(data, file_size);
+
+    Header header = {};
+    if (!reader.read(header) || header.magic != magic || header.version != version || header.skin_hash != hash_skin(skin))
+        return nullptr;
+
+    // Shipped builds may come with baked clips only, so a missing source is fine.
+    if (VirtualFileSystem::exists(anim_path))
+    {
+        u64 source_size = 0;
+        u32 source_hash = 0;
+        if (!CookedModel::get_source_stamp(anim_path, source_size, source_hash) || source_size != header.source_size
+            || source_hash != header.source_hash)
+        {
+            return nullptr;
+        }
+    }
+
+    u64 const key_data_size = static_cast<u64>(header.key_count) * sizeof(QuantizedKey);
+
+    if (header.key_data_offset % data_alignment != 0 || header.key_data_offset > file_size
+        || key_data_size > file_size - header.key_data_offset)
+    {
+        return nullptr;
+    }
+
+    // Loose files are mapped at page boundaries and packed ones at AssetPack::data_alignment, so the blob can be used in place.
+    std::span<QuantizedKey const> const keys = {reinterpret_cast<QuantizedKey const*>(data + header.key_data_offset), header.key_count};
+
+    auto animation = std::make_shared<Animation>();
+    reader.read(animation->duration);
+    reader.read(animation->ticks_per_second);
+
+    u32 bone_count = 0;
+    reader.read(bone_count);
+
+    if (!reader.is_valid() || bone_count > file_size)
+        return nullptr;
+
+    animation->bones.resize(bone_count);
+    for (auto& bone : animation->bones)
+    {
+        reader.read_string(bone.name);
+        reader.read(bone.id);
+        reader.read(bone.time_to_key);
+        reader.read(bone.positions.min);
+        reader.read(bone.positions.extent);
+        reader.read(bone.scales.min);
+        reader.read(bone.scales.extent);
+
+        if (!read_keys(reader, keys, bone.positions.keys) || !read_keys(reader, keys, bone.rotations.keys)
+            || !read_keys(reader, keys, bone.scales.keys))
+        {
+            return nullptr;
+        }
+    }
+
+    Rig& rig = animation->rig;
+    u32 joint_count = 0;
+    reader.read(joint_count);
+
+    if (!reader.is_valid() || joint_count > file_size)
+        return nullptr;
+
+    rig.bone_names.resize(joint_count);
+    for (auto& name : rig.bone_names)
+        reader.read_string(name);
+
+    reader.read_vector(rig.parents);
+    reader.read_vector(rig.depths);
+    reader.read_vector(rig.ref_pose_matrices);
+    reader.read_vector(rig.channels);
+    reader.read_vector(rig.palette_ids);
+    reader.read_vector(rig.offsets);
+    reader.read(rig.palette_size);
+
+    glm::vec3 bounds_min = {};
+    glm::vec3 bounds_max = {};
+    reader.read(animation->has_bounds);
+    reader.read(bounds_min);
+    reader.read(bounds_max);
+    animation->bounds = {bounds_min, bounds_max};
+
+    if (!reader.is_valid() || reader.get_offset() > header.key_data_offset)
+        return nullptr;
+
+    if (rig.parents.size() != joint_count || rig.depths.size() != joint_count || rig.ref_pose_matrices.size() != joint_count
+        || rig.channels.size() != joint_count || rig.palette_ids.size() != joint_count || rig.offsets.size() != joint_count)
+    {
+        return nullptr;
+    }
+
+    rig.num_bones = joint_count;
+    rig.build_ref_pose();
+
+    animation->key_file = file;
+
+    // root_node and bone_info_map are only needed while baking the rig, so they aren't stored.
+    return animation;
+}
+
+bool AnimationCache::save(std::string const& cache_path, std::string const& anim_path, ModelSkin const& skin, Animation const& animation)
+{
+    Header header = {};
+    header.magic = magic;
+    header.version = version;
+    header.skin_hash = hash_skin(skin);
+
+    if (!CookedModel::get_source_stamp(anim_path, header.source_size, header.source_hash))
+        return false;
+
+    AK::BinaryWriter tables;
+    AK::BinaryWriter keys;
+    tables.write(animation.duration);
+    tables.write(animation.ticks_per_second);
+
+    tables.write(static_cast<u32>(animation.bones.size()));
+    for (auto const& bone : animation.bones)
+    {
+        tables.write_string(bone.name);
+        tables.write(bone.id);
+        tables.write(bone.time_to_key);
+        tables.write(bone.positions.min);
+        tables.write(bone.positions.extent);
+        tables.write(bone.scales.min);
+        tables.write(bone.scales.extent);
+        write_keys(tables, keys, bone.positions.keys);
+        write_keys(tables, keys, bone.rotations.keys);
+        write_keys(tables, keys, bone.scales.keys);
+    }
+
+    Rig const& rig = animation.rig;
+    tables.write(rig.num_bones);
+    for (auto const& name : rig.bone_names)
+        tables.write_string(name);
+
+    tables.write_vector(rig.parents);
+    tables.write_vector(rig.depths);
+    tables.write_vector(rig.ref_pose_matrices);
+    tables.write_vector(rig.channels);
+    tables.write_vector(rig.palette_ids);
+    tables.write_vector(rig.offsets);
+    tables.write(rig.palette_size);
+
+    tables.write(animation.has_bounds);
+    tables.write(animation.bounds.min);
+    tables.write(animation.bounds.max);
+
+    u64 const tables_end = sizeof(Header) + tables.get_buffer().size();
+    header.key_count = static_cast<u32>(keys.get_buffer().size() / sizeof(QuantizedKey));
+    header.key_data_offset = (tables_end + data_alignment - 1) / data_alignment * data_alignment;
+
+    std::array<u8, data_alignment> constexpr zeros = {};
+
+    AK::BinaryWriter writer;
+    writer.write(header);
+    writer.write_bytes(tables.get_buffer().data(), tables.get_buffer().size());
+    writer.write_bytes(zeros.data(), header.key_data_offset - tables_end);
+    writer.write_bytes(keys.get_buffer().data(), keys.get_buffer().size());
+
+    std::ofstream file(cache_path, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        std::cout << "Error. Failed writing an animation cache: " << cache_path << "\n";
+        return false;
+    }
+
+    auto const& buffer = writer.get_buffer();
+    file.write(reinterpret_cast<char const*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+    return file.good();
+}
+
+u32 AnimationCache::hash_skin(ModelSkin const& skin)
+{
+    // Offsets and joint bounds are part of the hash too, re-exporting the model with a different bind pose
+    // or different vertices invalidates the cache.
+    u32 hash = static_cast<u32>(skin.bone_info_map.size());
+    for (auto const& [name, bone_info] : skin.bone_info_map)
+    {
+        hash = AK::murmur_hash(reinterpret_cast<u8 const*>(name.data()), name.size(), hash);
+        hash = AK::murmur_hash(reinterpret_cast<u8 const*>(&bone_info.id), sizeof(bone_info.id), hash);
+        hash = AK::murmur_hash(reinterpret_cast<u8 const*>(&bone_info.offset), sizeof(bone_info.offset), hash);
+    }
+
+    for (auto const& joint_bounds : skin.joint_bounds)
+    {
+        hash = AK::murmur_hash(reinterpret_cast<u8 const*>(&joint_bounds.min), sizeof(joint_bounds.min), hash);
+        hash = AK::murmur_hash(reinterpret_cast<u8 const*>(&joint_bounds.max), sizeof(joint_bounds.max), hash);
+    }
+
+    return hash;
+}
+
+void AnimationCache::write_keys(AK::BinaryWriter& writer, AK::BinaryWriter& keys, std::span<QuantizedKey const> const track_keys)
+{
+    writer.write(static_cast<u32>(keys.get_buffer().size() / sizeof(QuantizedKey)));
+    writer.write(static_cast<u32>(track_keys.size()));
+    keys.write_bytes(track_keys.data(), track_keys.size_bytes());
+}
+
+bool AnimationCache::read_keys(AK::BinaryReader& reader, std::span<QuantizedKey const> const keys,
+                               std::span<QuantizedKey const>& track_keys)
+{
+    u32 first_key = 0;
+    u32 key_count = 0;
+    reader.read(first_key);
+    reader.read(key_count);
+
+    if (!reader.is_valid() || first_key > keys.size() || key_count > keys.size() - first_key)
+        return false;
+
+    track_keys = keys.subspan(first_key, key_count);
+    return true;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+
+#include "Rig.h"
+
+namespace AK
+{
+class BinaryReader;
+class BinaryWriter;
+}
+
+// Baked rig and clip data next to the source animation, so skinned models don't go through Assimp on every launch.
+// A cache is only used while the source file and the model's bones match what it was baked from. Like cooked models,
+// the source is identified by its size and a hash of its contents. Keys are read in place from the mapped file.
+class AnimationCache
+{
+public:
+    AnimationCache() = delete;
+
+    static std::string get_cache_path(std::string const& model_path, std::string const& anim_path);
+
+    static std::shared_ptr<Animation> load(std::string const& cache_path, std::string const& anim_path, ModelSkin const& skin);
+    static bool save(std::string const& cache_path, std::string const& anim_path, ModelSkin const& skin, Animation const& animation);
+
+private:
+    struct Header
+    {
+        u32 magic = 0;
+        u32 version = 0;
+        u32 source_hash = 0;
+        u32 skin_hash = 0;
+        u32 key_count = 0;
+        u64 source_size = 0;
+        u64 key_data_offset = 0;
+    };
+
+    static u32 hash_skin(ModelSkin const& skin);
+
+    // Tracks are stored as a range of the key blob that follows the tables.
+    static void write_keys(AK::BinaryWriter& writer, AK::BinaryWriter& keys, std::span<QuantizedKey const> const track_keys);
+    static bool read_keys(AK::BinaryReader& reader, std::span<QuantizedKey const> const keys, std::span<QuantizedKey const>& track_keys);
+
+    // "ANIM"
+    static u32 constexpr magic = 0x4D494E41;
+
+    // Bump whenever the layout of the file or of the compressed tracks changes.
+    static u32 constexpr version = 3;
+
+    // The key blob starts at a multiple of this, so it can be read in place.
+    static u32 constexpr data_alignment = 16;
+};
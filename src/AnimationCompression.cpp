@@ -0,0 +1,190 @@
+#include "AnimationCompression.h"
+
+#include <cassert>
+
+template<typename ErrorFunction>
+std::vector<u32> AnimationCompression::reduce_keys(u32 const count, float const tolerance, ErrorFunction const& error_at)
+{
+    std::vector<u32> kept = {0};
+
+    // Constant track, a single key is enough
+    bool is_constant = true;
+    for (u32 i = 1; i < count && is_constant; ++i)
+        is_constant = error_at(0, 0, i) <= tolerance;
+
+    if (is_constant)
+        return kept;
+
+    // Drop key i if interpolating between the last kept key and key i + 1 reproduces every key in between within tolerance
+    for (u32 i = 1; i + 1 < count; ++i)
+    {
+        u32 const start = kept.back();
+        bool can_drop = true;
+
+        for (u32 j = start + 1; j <= i && can_drop; ++j)
+            can_drop = error_at(start, i + 1, j) <= tolerance;
+
+        if (!can_drop)
+            kept.emplace_back(i);
+    }
+
+    kept.emplace_back(count - 1);
+
+    return kept;
+}
+
+Vec3Track AnimationCompression::compress_vec3_track(std::vector<float> const& times, std::vector<glm::vec3> const& values,
+                                                    float const time_to_key, float const tolerance, float& max_error,
+                                                    std::vector<QuantizedKey>& key_storage, AnimationCompressionStats& stats)
+{
+    Vec3Track track = {};
+    u32 const count = static_cast<u32>(values.size());
+
+    stats.raw_keys += count;
+    stats.raw_bytes += count * (sizeof(glm::vec3) + sizeof(float));
+
+    if (count == 0)
+        return track;
+
+    // Error of key j when it's reconstructed by interpolating between keys a and b
+    auto const error_at = [&](u32 const a, u32 const b, u32 const j) {
+        float const factor = get_interpolation_factor(times[a], times[b], times[j]);
+        return glm::distance(glm::mix(values[a], values[b], factor), values[j]);
+    };
+
+    std::vector<u32> const kept = reduce_keys(count, tolerance, error_at);
+
+    glm::vec3 min = values[kept[0]];
+    glm::vec3 max = values[kept[0]];
+    for (u32 const index : kept)
+    {
+        min = glm::min(min, values[index]);
+        max = glm::max(max, values[index]);
+    }
+
+    track.min = min;
+    track.extent = max - min;
+
+    size_t const first_key = key_storage.size();
+    assert(key_storage.capacity() - first_key >= kept.size());
+
+    for (u32 const index : kept)
+    {
+        QuantizedKey key = {};
+        key.time_stamp = quantize_time(times[index], time_to_key);
+
+        for (u32 i = 0; i < 3; ++i)
+        {
+            if (track.extent[i] > 0.0f)
+                key.value[i] = static_cast<u16>(glm::round((values[index][i] - min[i]) / track.extent[i] * 65535.0f));
+        }
+
+        key_storage.emplace_back(key);
+    }
+
+    track.keys = {key_storage.data() + first_key, kept.size()};
+
+    stats.kept_keys += track.keys.size();
+    stats.compressed_bytes += track.keys.size() * sizeof(QuantizedKey) + sizeof(track.min) + sizeof(track.extent);
+
+    // Measure the final track against every source key, so the reported error includes both reduction and quantization
+    u32 cursor = 0;
+    for (u32 i = 0; i < count; ++i)
+    {
+        glm::vec3 const sampled = track.sample(times[i] * time_to_key, cursor, values[i]);
+        max_error = glm::max(max_error, glm::distance(sampled, values[i]));
+    }
+
+    return track;
+}
+
+QuatTrack AnimationCompression::compress_quat_track(std::vector<float> const& times, std::vector<glm::quat> const& values,
+                                                    float const time_to_key, std::vector<QuantizedKey>& key_storage,
+                                                    AnimationCompressionStats& stats)
+{
+    QuatTrack track = {};
+    u32 const count = static_cast<u32>(values.size());
+
+    stats.raw_keys += count;
+    stats.raw_bytes += count * (sizeof(glm::quat) + sizeof(float));
+
+    if (count == 0)
+        return track;
+
+    auto const error_at = [&](u32 const a, u32 const b, u32 const j) {
+        float const factor = get_interpolation_factor(times[a], times[b], times[j]);
+        return angle_between(glm::slerp(values[a], values[b], factor), values[j]);
+    };
+
+    std::vector<u32> const kept = reduce_keys(count, rotation_tolerance, error_at);
+
+    size_t const first_key = key_storage.size();
+    assert(key_storage.capacity() - first_key >= kept.size());
+
+    for (u32 const index : kept)
+    {
+        QuantizedKey key = {};
+        key.time_stamp = quantize_time(times[index], time_to_key);
+        key.value = encode_quat(values[index]);
+        key_storage.emplace_back(key);
+    }
+
+    track.keys = {key_storage.data() + first_key, kept.size()};
+
+    stats.kept_keys += track.keys.size();
+    stats.compressed_bytes += track.keys.size() * sizeof(QuantizedKey);
+
+    u32 cursor = 0;
+    for (u32 i = 0; i < count; ++i)
+    {
+        glm::quat const sampled = track.sample(times[i] * time_to_key, cursor);
+        stats.max_rotation_error = glm::max(stats.max_rotation_error, angle_between(sampled, values[i]));
+    }
+
+    return track;
+}
+
+std::array<u16, 3> AnimationCompression::encode_quat(glm::quat const& rotation)
+{
+    float constexpr range = 0.70710678f;
+
+    glm::quat const normalized = glm::normalize(rotation);
+    std::array<float, 4> const xyzw = {normalized.x, normalized.y, normalized.z, normalized.w};
+
+    u32 largest = 0;
+    for (u32 i = 1; i < 4; ++i)
+    {
+        if (glm::abs(xyzw[i]) > glm::abs(xyzw[largest]))
+            largest = i;
+    }
+
+    // q and -q are the same rotation, so flip the quaternion to make the dropped component positive
+    float const sign = xyzw[largest] < 0.0f ? -1.0f : 1.0f;
+
+    std::array<u16, 3> result = {};
+    u32 small_index = 0;
+    for (u32 i = 0; i < 4; ++i)
+    {
+        if (i == largest)
+            continue;
+
+        float const normalized_component = glm::clamp(xyzw[i] * sign / range * 0.5f + 0.5f, 0.0f, 1.0f);
+        result[small_index++] = static_cast<u16>(glm::round(normalized_component * 32767.0f));
+    }
+
+    result[0] |= static_cast<u16>((largest >> 1) << 15);
+    result[1] |= static_cast<u16>((largest & 1) << 15);
+
+    return result;
+}
+
+u16 AnimationCompression::quantize_time(float const time, float const time_to_key)
+{
+    return static_cast<u16>(glm::round(glm::clamp(time * time_to_key, 0.0f, 65535.0f)));
+}
+
+float AnimationCompression::angle_between(glm::quat const& a, glm::quat const& b)
+{
+    float const dot = glm::clamp(glm::abs(glm::dot(a, b)), 0.0f, 1.0f);
+    return 2.0f * glm::acos(dot);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <vector>
+
+#include "Rig.h"
+
+struct AnimationCompressionStats
+{
+    u32 raw_keys = 0;
+    u32 kept_keys = 0;
+    size_t raw_bytes = 0;
+    size_t compressed_bytes = 0;
+
+    float max_position_error = 0.0f;
+    float max_rotation_error = 0.0f; // Radians
+    float max_scale_error = 0.0f;
+};
+
+// Import-time clip compression. Keys that linear interpolation between their neighbours reproduces within tolerance are dropped,
+// then positions and scales are quantized to 16 bits per component relative to the track bounds,
+// and rotations are stored as 48-bit smallest-three quaternions. Everything is decompressed on sampling.
+class AnimationCompression
+{
+public:
+    AnimationCompression() = delete;
+
+    // Kept keys are appended to key_storage and the returned track points at them. key_storage has to be reserved
+    // for every key of the clip up front, reallocating it would leave the tracks compressed before pointing at freed memory.
+    static Vec3Track compress_vec3_track(std::vector<float> const& times, std::vector<glm::vec3> const& values, float const time_to_key,
+                                         float const tolerance, float& max_error, std::vector<QuantizedKey>& key_storage,
+                                         AnimationCompressionStats& stats);
+    static QuatTrack compress_quat_track(std::vector<float> const& times, std::vector<glm::quat> const& values, float const time_to_key,
+                                         std::vector<QuantizedKey>& key_storage, AnimationCompressionStats& stats);
+
+    static std::array<u16, 3> encode_quat(glm::quat const& rotation);
+    static u16 quantize_time(float const time, float const time_to_key);
+
+    inline static float position_tolerance = 0.0005f;
+    inline static float rotation_tolerance = 0.001f; // Radians
+    inline static float scale_tolerance = 0.0005f;
+
+private:
+    template<typename ErrorFunction>
+    static std::vector<u32> reduce_keys(u32 const count, float const tolerance, ErrorFunction const& error_at);
+    static float angle_between(glm::quat const& a, glm::quat const& b);
+};
@@ -1,9 +1,13 @@
 #include "AnimationEngine.h"
 
 #include "AK/AK.h"
+#include "Camera.h"
 #include "Globals.h"
 #include "Rig.h"
 
+#include <algorithm>
+#include <execution>
+
 void AnimationEngine::initialize()
 {
     auto const animation_engine = std::make_shared<AnimationEngine>();
@@ -12,26 +16,35 @@ void AnimationEngine::initialize()
 
 void AnimationEngine::update_animations()
 {
-    auto const renderer_dx11 = RendererDX11::get_instance_dx11()->get_instance_dx11();
+    double const update_start = glfwGetTime();
 
-    if (renderer_dx11 == nullptr)
-        return;
+    // LOD selection. Reads the camera and the world space bounds the renderer keeps up to date, so it runs before the workers start.
+    m_model_counts = {};
+    auto const main_camera = Camera::get_main_camera();
+    Frustum const frustum = main_camera != nullptr ? main_camera->get_frustum() : Frustum {};
+    glm::vec3 const camera_position = main_camera != nullptr ? main_camera->get_position() : glm::vec3(0.0f);
 
     for (auto const& skinned_model : m_skinned_models)
     {
-        m_current_time += skinned_model->animation.ticks_per_second * delta_time; // you can apply play_rate here
-        m_current_time = fmod(m_current_time, skinned_model->animation.duration);
-
-        skinned_model->calculate_bone_transform(&skinned_model->animation.root_node, glm::mat4(1.0f));
-        if (!skinned_model->skinning_matrices.empty())
-        {
-            // u16 const rotation_bone_id = 35;
-            // auto const value = static_cast<float>(delta_time);
-            // glm::mat4 rotation_matrix = glm::rotate(glm::mat4(1.0f), value, glm::vec3(0.0f, 1.0f, 0.0f));
-            // skinned_model->skinning_matrices[rotation_bone_id] = rotation_matrix * skinned_model->skinning_matrices[rotation_bone_id];
-            renderer_dx11->set_skinning_buffer(skinned_model, skinned_model->get_skinning_matrices());
-        }
+        if (main_camera != nullptr)
+            skinned_model->playback.lod = select_lod(skinned_model, camera_position, frustum);
+        else
+            skinned_model->playback.lod = AnimationLOD::Full;
+
+        m_model_counts[static_cast<size_t>(skinned_model->playback.lod)] += 1;
     }
+
+    // CPU phase. Every model only writes to its own playback state and palette and reads shared clip data,
+    // so models can be evaluated on worker threads without any synchronization.
+    double const delta = delta_time;
+    AnimationLODSettings const settings = lod_settings;
+    std::for_each(std::execution::par, m_skinned_models.begin(), m_skinned_models.end(),
+                  [delta, &settings](std::shared_ptr<SkinnedModel> const& skinned_model) {
+                      skinned_model->update_animation(delta, settings);
+                  });
+
+    // Palettes are uploaded by the renderer right before each skinned model is drawn.
+    m_last_update_time_ms = (glfwGetTime() - update_start) * 1000.0;
 }
 
 void AnimationEngine::register_skinned_model(std::shared_ptr<SkinnedModel> const& skinned_model)
@@ -44,7 +57,24 @@ void AnimationEngine::unregister_skinned_model(std::shared_ptr<SkinnedModel> con
     AK::swap_and_erase(m_skinned_models, skinned_model);
 }
 
-double AnimationEngine::get_current_time() const
+double AnimationEngine::get_last_update_time_ms() const
+{
+    return m_last_update_time_ms;
+}
+
+u32 AnimationEngine::get_model_count(AnimationLOD const lod) const
+{
+    return m_model_counts[static_cast<size_t>(lod)];
+}
+
+AnimationLOD AnimationEngine::select_lod(std::shared_ptr<SkinnedModel> const& skinned_model, glm::vec3 const& camera_position,
+                                         Frustum const& frustum) const
 {
-    return m_current_time;
+    if (!skinned_model->bounds.is_in_frustum(frustum))
+        return AnimationLOD::Frozen;
+
+    if (glm::distance(camera_position, skinned_model->bounds.center) <= lod_settings.full_distance)
+        return AnimationLOD::Full;
+
+    return AnimationLOD::Reduced;
 }
@@ -3,6 +3,7 @@
 #include "Rig.h"
 #include "SkinnedModel.h"
 
+#include <array>
 #include <memory>
 #include <vector>
 
@@ -17,7 +18,10 @@ public:
     void register_skinned_model(std::shared_ptr<SkinnedModel> const& skinned_model);
     void unregister_skinned_model(std::shared_ptr<SkinnedModel> const& skinned_model);
 
-    double get_current_time() const;
+    double get_last_update_time_ms() const;
+    u32 get_model_count(AnimationLOD const lod) const;
+
+    AnimationLODSettings lod_settings = {};
 
     static std::shared_ptr<AnimationEngine> get_instance()
     {
@@ -33,7 +37,11 @@ public:
     }
 
 private:
+    AnimationLOD select_lod(std::shared_ptr<SkinnedModel> const& skinned_model, glm::vec3 const& camera_position,
+                            Frustum const& frustum) const;
+
     inline static std::shared_ptr<AnimationEngine> m_instance;
     std::vector<std::shared_ptr<SkinnedModel>> m_skinned_models = {};
-    double m_current_time = 0.0;
+    double m_last_update_time_ms = 0.0;
+    std::array<u32, static_cast<size_t>(AnimationLOD::Count)> m_model_counts = {};
 };
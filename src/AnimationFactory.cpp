@@ -0,0 +1,271 @@
+#include "AnimationFactory.h"
+
+#include "AK/Math.h"
+#include "AnimationCache.h"
+#include "AnimationCompression.h"
+#include "AnimationPose.h"
+#include "AssimpFileSystem.h"
+#include "ConstantBufferTypes.h"
+#include "Debug.h"
+
+#include <cfloat>
+#include <format>
+#include <iostream>
+
+#include <GLFW/glfw3.h>
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+std::shared_ptr<Animation> AnimationFactory::create(std::string const& model_path, std::string const& anim_path, ModelSkin const& skin)
+{
+    double const load_start = glfwGetTime();
+    std::string const cache_path = AnimationCache::get_cache_path(model_path, anim_path);
+
+    if (auto cached_animation = AnimationCache::load(cache_path, anim_path, skin); cached_animation != nullptr)
+    {
+        Debug::log(std::format("Animation {} loaded from cache in {:.2f} ms", anim_path, (glfwGetTime() - load_start) * 1000.0));
+        return cached_animation;
+    }
+
+    auto animation = std::make_shared<Animation>();
+
+    Assimp::Importer importer;
+    importer.SetIOHandler(new AssimpFileSystem);
+    aiScene const* scene = importer.ReadFile(anim_path, aiProcess_Triangulate);
+
+    if (scene == nullptr || scene->mRootNode == nullptr || scene->mNumAnimations == 0)
+    {
+        std::cout << "Error. Failed loading an animation: " << importer.GetErrorString() << "\n";
+        return animation;
+    }
+
+    auto const assimp_animation = scene->mAnimations[0];
+    animation->duration = assimp_animation->mDuration;
+    animation->ticks_per_second = assimp_animation->mTicksPerSecond;
+    read_hierarchy_data(animation->root_node, scene->mRootNode);
+
+    AnimationCompressionStats stats = {};
+    read_missing_bones(*animation, assimp_animation, skin.bone_info_map, stats);
+    build_rig(*animation, static_cast<u32>(skin.bone_info_map.size()));
+    calculate_bounds(*animation, skin.joint_bounds);
+
+    Debug::log(std::format("Animation {}: {} -> {} keys, {:.1f} KB -> {:.1f} KB. Max error: position {:.5f}, rotation {:.5f} rad, scale {:.5f}",
+                           anim_path, stats.raw_keys, stats.kept_keys, stats.raw_bytes / 1024.0f, stats.compressed_bytes / 1024.0f,
+                           stats.max_position_error, stats.max_rotation_error, stats.max_scale_error));
+
+    // Cache is missing or stale, bake it so the next launch skips Assimp.
+    if (AnimationCache::save(cache_path, anim_path, skin, *animation))
+        Debug::log(std::format("Animation {} baked to {} in {:.2f} ms", anim_path, cache_path, (glfwGetTime() - load_start) * 1000.0));
+
+    return animation;
+}
+
+void AnimationFactory::read_hierarchy_data(AssimpNodeData& dest, aiNode const* src)
+{
+    assert(src);
+
+    dest.name = src->mName.data;
+    dest.transformation = AK::Math::ai_matrix_to_glm(src->mTransformation);
+    dest.children_count = src->mNumChildren;
+    dest.children.reserve(src->mNumChildren);
+
+    for (int i = 0; i < src->mNumChildren; i++)
+    {
+        AssimpNodeData newData;
+        read_hierarchy_data(newData, src->mChildren[i]);
+        dest.children.push_back(newData);
+    }
+}
+
+void AnimationFactory::read_missing_bones(Animation& animation, aiAnimation const* assimp_animation,
+                                          std::map<std::string, BoneInfo> const& bone_info_map, AnimationCompressionStats& stats)
+{
+    u32 const size = assimp_animation->mNumChannels;
+
+    std::map<std::string, BoneInfo> new_bone_info_map = bone_info_map;
+    u32 bone_count = bone_info_map.size();
+
+    animation.bones.reserve(size);
+
+    // Tracks point into the key storage, so it's sized for every source key before the first one is compressed.
+    size_t key_count = 0;
+    for (u32 i = 0; i < size; ++i)
+    {
+        auto const channel = assimp_animation->mChannels[i];
+        key_count += channel->mNumPositionKeys + channel->mNumRotationKeys + channel->mNumScalingKeys;
+    }
+
+    animation.key_storage.reserve(key_count);
+
+    for (int i = 0; i < size; i++)
+    {
+        auto const channel = assimp_animation->mChannels[i];
+        std::string boneName = channel->mNodeName.data;
+
+        if (!new_bone_info_map.contains(boneName))
+        {
+            new_bone_info_map[boneName].id = bone_count;
+            bone_count++;
+        }
+
+        float const time_to_key = animation.duration > 0.0f ? 65535.0f / animation.duration : 0.0f;
+        animation.bones.emplace_back(create_bone(channel, new_bone_info_map[boneName].id, time_to_key, animation.key_storage, stats));
+    }
+
+    animation.bone_info_map = new_bone_info_map;
+}
+
+Bone AnimationFactory::create_bone(aiNodeAnim const* channel, i32 const id, float const time_to_key, std::vector<QuantizedKey>& key_storage,
+                                   AnimationCompressionStats& stats)
+{
+    Bone bone;
+    bone.name = channel->mNodeName.data;
+    bone.id = id;
+    bone.time_to_key = time_to_key;
+
+    std::vector<float> times;
+    std::vector<glm::vec3> vec3_values;
+    std::vector<glm::quat> quat_values;
+
+    times.reserve(channel->mNumPositionKeys);
+    vec3_values.reserve(channel->mNumPositionKeys);
+    for (u32 i = 0; i < channel->mNumPositionKeys; ++i)
+    {
+        aiVector3D const ai_position = channel->mPositionKeys[i].mValue;
+        times.emplace_back(static_cast<float>(channel->mPositionKeys[i].mTime));
+        vec3_values.emplace_back(ai_position.x, ai_position.y, ai_position.z);
+    }
+
+    bone.positions = AnimationCompression::compress_vec3_track(times, vec3_values, time_to_key, AnimationCompression::position_tolerance,
+                                                               stats.max_position_error, key_storage, stats);
+
+    times.clear();
+    times.reserve(channel->mNumRotationKeys);
+    quat_values.reserve(channel->mNumRotationKeys);
+    for (u32 i = 0; i < channel->mNumRotationKeys; ++i)
+    {
+        aiQuaternion const ai_orientation = channel->mRotationKeys[i].mValue;
+        times.emplace_back(static_cast<float>(channel->mRotationKeys[i].mTime));
+        quat_values.emplace_back(ai_orientation.w, ai_orientation.x, ai_orientation.y, ai_orientation.z);
+    }
+
+    bone.rotations = AnimationCompression::compress_quat_track(times, quat_values, time_to_key, key_storage, stats);
+
+    times.clear();
+    vec3_values.clear();
+    times.reserve(channel->mNumScalingKeys);
+    vec3_values.reserve(channel->mNumScalingKeys);
+    for (u32 i = 0; i < channel->mNumScalingKeys; ++i)
+    {
+        aiVector3D const ai_scale = channel->mScalingKeys[i].mValue;
+        times.emplace_back(static_cast<float>(channel->mScalingKeys[i].mTime));
+        vec3_values.emplace_back(ai_scale.x, ai_scale.y, ai_scale.z);
+    }
+
+    bone.scales = AnimationCompression::compress_vec3_track(times, vec3_values, time_to_key, AnimationCompression::scale_tolerance,
+                                                            stats.max_scale_error, key_storage, stats);
+
+    return bone;
+}
+
+Bone const* AnimationFactory::find_bone(Animation const& animation, std::string const& name)
+{
+    auto const iter = std::ranges::find_if(animation.bones, [&](Bone const& bone) { return bone.name == name; });
+    if (iter == animation.bones.end())
+        return nullptr;
+
+    return &(*iter);
+}
+
+void AnimationFactory::build_rig(Animation& animation, u32 const palette_size)
+{
+    animation.rig = {};
+    animation.rig.palette_size = palette_size;
+    flatten_hierarchy(animation, animation.root_node, -1);
+    animation.rig.num_bones = animation.rig.bone_names.size();
+    animation.rig.build_ref_pose();
+}
+
+void AnimationFactory::flatten_hierarchy(Animation& animation, AssimpNodeData const& node, i32 const parent)
+{
+    Rig& rig = animation.rig;
+    i32 const index = static_cast<i32>(rig.bone_names.size());
+
+    rig.bone_names.emplace_back(node.name);
+    rig.parents.emplace_back(parent);
+    rig.depths.emplace_back(parent == -1 ? 0 : rig.depths[parent] + 1);
+    rig.ref_pose_matrices.emplace_back(node.transformation);
+
+    Bone const* bone = find_bone(animation, node.name);
+    rig.channels.emplace_back(bone != nullptr ? static_cast<i32>(bone - animation.bones.data()) : -1);
+
+    // Bones only the clip knows about get ids past the model's, no vertex references them so they stay out of the palette.
+    if (auto const it = animation.bone_info_map.find(node.name);
+        it != animation.bone_info_map.end() && it->second.id < static_cast<i32>(rig.palette_size))
+    {
+        assert(it->second.id < SKINNING_BUFFER_SIZE);
+        rig.palette_ids.emplace_back(it->second.id);
+        rig.offsets.emplace_back(it->second.offset);
+    }
+    else
+    {
+        rig.palette_ids.emplace_back(-1);
+        rig.offsets.emplace_back(glm::mat4(1.0f));
+    }
+
+    for (auto const& child : node.children)
+        flatten_hierarchy(animation, child, index);
+}
+
+void AnimationFactory::calculate_bounds(Animation& animation, std::vector<BoundingBox> const& joint_bounds)
+{
+    Rig const& rig = animation.rig;
+
+    if (rig.num_bones == 0 || joint_bounds.empty())
+        return;
+
+    // Skinned vertices are weighted averages of their vertex transformed by each influencing joint, so they never leave
+    // the union of every joint's vertex box transformed by that joint. Taking that union over the whole clip is conservative.
+    float constexpr samples_per_second = 60.0f;
+    float const clip_seconds = animation.ticks_per_second > 0.0f ? animation.duration / animation.ticks_per_second : 0.0f;
+    u32 const sample_count = glm::max(static_cast<u32>(glm::ceil(clip_seconds * samples_per_second)), 1u) + 1;
+
+    Pose pose = {};
+    std::vector<glm::mat4> model_space_transforms(rig.num_bones);
+    AnimationPlayback playback = {};
+    playback.cursors.assign(animation.bones.size(), {});
+
+    glm::vec3 bounds_min = glm::vec3(FLT_MAX);
+    glm::vec3 bounds_max = glm::vec3(-FLT_MAX);
+
+    for (u32 sample = 0; sample < sample_count; ++sample)
+    {
+        playback.time = animation.duration * static_cast<double>(sample) / static_cast<double>(sample_count - 1);
+        PoseBlending::sample(rig, animation, rig.channels, playback, UINT32_MAX, pose);
+        PoseBlending::local_to_model(rig, pose, model_space_transforms);
+
+        for (u32 i = 0; i < rig.num_bones; ++i)
+        {
+            i32 const palette_id = rig.palette_ids[i];
+            if (palette_id == -1 || static_cast<size_t>(palette_id) >= joint_bounds.size())
+                continue;
+
+            BoundingBox const& joint_box = joint_bounds[palette_id];
+            if (joint_box.min.x > joint_box.max.x)
+                continue;
+
+            BoundingBox const skinned_box = joint_box.get_transformed(model_space_transforms[i] * rig.offsets[i]);
+            bounds_min = glm::min(bounds_min, skinned_box.min);
+            bounds_max = glm::max(bounds_max, skinned_box.max);
+        }
+    }
+
+    if (bounds_min.x > bounds_max.x)
+        return;
+
+    // Motion between two samples is tiny at this rate, a small margin covers it.
+    glm::vec3 const margin = (bounds_max - bounds_min) * 0.02f;
+    animation.bounds = {bounds_min - margin, bounds_max + margin};
+    animation.has_bounds = true;
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "Rig.h"
+
+class ResourceManager;
+struct AnimationCompressionStats;
+struct aiAnimation;
+struct aiNode;
+struct aiNodeAnim;
+
+class AnimationFactory
+{
+public:
+    AnimationFactory() = delete;
+
+private:
+    static std::shared_ptr<Animation> create(std::string const& model_path, std::string const& anim_path, ModelSkin const& skin);
+
+    static void read_hierarchy_data(AssimpNodeData& dest, aiNode const* src);
+    static void read_missing_bones(Animation& animation, aiAnimation const* assimp_animation,
+                                   std::map<std::string, BoneInfo> const& bone_info_map, AnimationCompressionStats& stats);
+    static Bone create_bone(aiNodeAnim const* channel, i32 const id, float const time_to_key, std::vector<QuantizedKey>& key_storage,
+                            AnimationCompressionStats& stats);
+    static Bone const* find_bone(Animation const& animation, std::string const& name);
+
+    static void build_rig(Animation& animation, u32 const palette_size);
+    static void flatten_hierarchy(Animation& animation, AssimpNodeData const& node, i32 const parent);
+    static void calculate_bounds(Animation& animation, std::vector<BoundingBox> const& joint_bounds);
+
+    friend class ResourceManager;
+};
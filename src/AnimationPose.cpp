@@ -0,0 +1,124 @@
+#include "AnimationPose.h"
+
+std::vector<i32> PoseBlending::map_channels(Rig const& rig, Animation const& clip)
+{
+    std::map<std::string, i32> bone_indices;
+    for (u32 i = 0; i < clip.bones.size(); ++i)
+        bone_indices.emplace(clip.bones[i].name, static_cast<i32>(i));
+
+    std::vector<i32> channels(rig.num_bones, -1);
+    for (u32 i = 0; i < rig.num_bones; ++i)
+    {
+        if (auto const it = bone_indices.find(rig.bone_names[i]); it != bone_indices.end())
+            channels[i] = it->second;
+    }
+
+    return channels;
+}
+
+std::vector<float> PoseBlending::build_joint_mask(Rig const& rig, std::string const& mask_root)
+{
+    if (mask_root.empty())
+        return std::vector<float>(rig.num_bones, 1.0f);
+
+    // Parents come before children, so a single pass is enough to mark the whole subtree.
+    std::vector<float> joint_weights(rig.num_bones, 0.0f);
+    for (u32 i = 0; i < rig.num_bones; ++i)
+    {
+        i32 const parent = rig.parents[i];
+        if (rig.bone_names[i] == mask_root || (parent != -1 && joint_weights[parent] > 0.0f))
+            joint_weights[i] = 1.0f;
+    }
+
+    return joint_weights;
+}
+
+void PoseBlending::sample(Rig const& rig, Animation const& clip, std::vector<i32> const& channels, AnimationPlayback& playback,
+                          u32 const max_joint_depth, Pose& out)
+{
+    out.resize(rig.num_bones);
+    float const current_time = static_cast<float>(playback.time);
+
+    for (u32 i = 0; i < rig.num_bones; ++i)
+    {
+        out.positions[i] = rig.ref_pose[i].pos;
+        out.rotations[i] = rig.ref_pose[i].rot;
+        out.scales[i] = rig.ref_pose_scales[i];
+
+        if (i32 const channel = channels[i]; channel != -1 && rig.depths[i] <= max_joint_depth)
+            clip.bones[channel].sample(current_time, playback.cursors[channel], out.positions[i], out.rotations[i], out.scales[i]);
+    }
+}
+
+void PoseBlending::blend(Pose const& a, Pose const& b, float const weight, Pose& out)
+{
+    size_t const joint_count = a.positions.size();
+    out.resize(static_cast<u32>(joint_count));
+
+    for (size_t i = 0; i < joint_count; ++i)
+        out.positions[i] = glm::mix(a.positions[i], b.positions[i], weight);
+
+    for (size_t i = 0; i < joint_count; ++i)
+        out.rotations[i] = nlerp(a.rotations[i], b.rotations[i], weight);
+
+    for (size_t i = 0; i < joint_count; ++i)
+        out.scales[i] = glm::mix(a.scales[i], b.scales[i], weight);
+}
+
+void PoseBlending::blend_masked(Pose const& a, Pose const& b, float const weight, std::vector<float> const& joint_weights, Pose& out)
+{
+    size_t const joint_count = a.positions.size();
+    out.resize(static_cast<u32>(joint_count));
+
+    for (size_t i = 0; i < joint_count; ++i)
+    {
+        float const joint_weight = weight * joint_weights[i];
+        out.positions[i] = glm::mix(a.positions[i], b.positions[i], joint_weight);
+        out.rotations[i] = nlerp(a.rotations[i], b.rotations[i], joint_weight);
+        out.scales[i] = glm::mix(a.scales[i], b.scales[i], joint_weight);
+    }
+}
+
+void PoseBlending::add(Pose const& base, Pose const& additive, Pose const& reference, float const weight,
+                       std::vector<float> const& joint_weights, Pose& out)
+{
+    size_t const joint_count = base.positions.size();
+    out.resize(static_cast<u32>(joint_count));
+
+    for (size_t i = 0; i < joint_count; ++i)
+    {
+        float const joint_weight = weight * joint_weights[i];
+
+        out.positions[i] = base.positions[i] + (additive.positions[i] - reference.positions[i]) * joint_weight;
+
+        glm::quat const delta = glm::conjugate(reference.rotations[i]) * additive.rotations[i];
+        out.rotations[i] = glm::normalize(base.rotations[i] * nlerp(glm::quat(1.0f, 0.0f, 0.0f, 0.0f), delta, joint_weight));
+
+        out.scales[i] = base.scales[i] * glm::mix(glm::vec3(1.0f), additive.scales[i] / reference.scales[i], joint_weight);
+    }
+}
+
+void PoseBlending::local_to_model(Rig const& rig, Pose const& pose, std::vector<glm::mat4>& model_space_transforms)
+{
+    // Joints are sorted parent-first, so the parent's model space transform is always ready by the time we reach its children.
+    for (u32 i = 0; i < rig.num_bones; ++i)
+    {
+        glm::mat3 const rotation = glm::mat3_cast(pose.rotations[i]);
+        glm::vec3 const& scale = pose.scales[i];
+
+        glm::mat4 const local_transform = {glm::vec4(rotation[0] * scale.x, 0.0f), glm::vec4(rotation[1] * scale.y, 0.0f),
+                                           glm::vec4(rotation[2] * scale.z, 0.0f), glm::vec4(pose.positions[i], 1.0f)};
+
+        i32 const parent = rig.parents[i];
+        model_space_transforms[i] = parent == -1 ? local_transform : model_space_transforms[parent] * local_transform;
+    }
+}
+
+glm::quat PoseBlending::nlerp(glm::quat const& a, glm::quat b, float const t)
+{
+    // Take the shorter way around.
+    if (glm::dot(a, b) < 0.0f)
+        b = -b;
+
+    return glm::normalize(a * (1.0f - t) + b * t);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Rig.h"
+
+// Local space pose of a rig, stored as separate arrays per component so blending runs over contiguous memory
+// and the compiler can vectorize it across joints. Positions and rotations are the AK::xform parts, split apart.
+struct Pose
+{
+    std::vector<glm::vec3> positions = {};
+    std::vector<glm::quat> rotations = {};
+    std::vector<glm::vec3> scales = {};
+
+    void resize(u32 const joint_count)
+    {
+        positions.resize(joint_count);
+        rotations.resize(joint_count);
+        scales.resize(joint_count);
+    }
+};
+
+enum class AnimationLayerMode
+{
+    // Replaces the pose below it, weighted by the layer and joint weights.
+    Override,
+
+    // Adds the difference between the clip and its first frame on top of the pose below it.
+    Additive
+};
+
+// A clip played on top of, or instead of, a model's base clip.
+struct AnimationLayer
+{
+    std::shared_ptr<Animation const> animation = nullptr;
+    AnimationPlayback playback = {};
+    AnimationLayerMode mode = AnimationLayerMode::Override;
+    float weight = 1.0f;
+
+    // Per rig joint, see PoseBlending::map_channels.
+    std::vector<i32> channels = {};
+
+    // Per rig joint, 0 for joints outside the layer's mask.
+    std::vector<float> joint_weights = {};
+
+    // First frame of the clip, what Additive layers are relative to.
+    Pose reference_pose = {};
+};
+
+// Steps of the pose pipeline: sample clips into local poses, blend and layer them,
+// then convert to model space once at the end.
+class PoseBlending
+{
+public:
+    PoseBlending() = delete;
+
+    // Maps every joint of the rig to the clip's bone with the same name, -1 if the clip doesn't animate it.
+    // Clips exported with a different node order still line up with the rig this way.
+    static std::vector<i32> map_channels(Rig const& rig, Animation const& clip);
+
+    // Joint weights covering the subtree under mask_root, or every joint if mask_root is empty.
+    static std::vector<float> build_joint_mask(Rig const& rig, std::string const& mask_root);
+
+    // Joints deeper than max_joint_depth or without a channel keep the bind pose.
+    static void sample(Rig const& rig, Animation const& clip, std::vector<i32> const& channels, AnimationPlayback& playback,
+                       u32 const max_joint_depth, Pose& out);
+
+    // Work joint by joint, so out can alias any of the inputs.
+    static void blend(Pose const& a, Pose const& b, float const weight, Pose& out);
+    static void blend_masked(Pose const& a, Pose const& b, float const weight, std::vector<float> const& joint_weights, Pose& out);
+    static void add(Pose const& base, Pose const& additive, Pose const& reference, float const weight,
+                    std::vector<float> const& joint_weights, Pose& out);
+
+    static void local_to_model(Rig const& rig, Pose const& pose, std::vector<glm::mat4>& model_space_transforms);
+
+private:
+    static glm::quat nlerp(glm::quat const& a, glm::quat b, float const t);
+};
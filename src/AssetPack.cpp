@@ -0,0 +1,100 @@
+#include "AssetPack.h"
+
+#include "AK/AK.h"
+#include "MemoryMappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+std::shared_ptr<AssetPack> AssetPack::open(std::string const& pack_path)
+{
+    auto const mapped_file = MemoryMappedFile::open(pack_path);
+
+    if (mapped_file == nullptr)
+        return nullptr;
+
+    u8 const* data = mapped_file->get_data();
+    u64 const file_size = mapped_file->get_size();
+
+    Header header = {};
+
+    if (file_size < sizeof(Header))
+        return nullptr;
+
+    std::memcpy(&header, data, sizeof(Header));
+
+    if (header.magic != magic || header.version != version)
+    {
+        std::cout << "Error. Asset pack is not compatible with this build: " << pack_path << "\n";
+        return nullptr;
+    }
+
+    u64 const toc_size = static_cast<u64>(header.entry_count) * sizeof(Entry);
+
+    if (toc_size > file_size - sizeof(Header) || header.path_table_offset < sizeof(Header) + toc_size
+        || header.path_table_offset > file_size || header.path_table_size > file_size - header.path_table_offset
+        || header.data_offset > file_size)
+    {
+        std::cout << "Error. Asset pack is corrupted: " << pack_path << "\n";
+        return nullptr;
+    }
+
+    auto pack = std::make_shared<AssetPack>(AK::Badge<AssetPack> {});
+
+    // The mapping is page aligned and Header is a multiple of Entry's alignment, so the table is read in place.
+    pack->m_entries = {reinterpret_cast<Entry const*>(data + sizeof(Header)), header.entry_count};
+    pack->m_paths = {reinterpret_cast<char const*>(data + header.path_table_offset), header.path_table_size};
+
+    bool const is_valid = std::ranges::all_of(pack->m_entries, [&](Entry const& entry) {
+        return entry.offset % data_alignment == 0 && entry.offset >= header.data_offset && entry.offset <= file_size
+            && entry.size <= file_size - entry.offset && static_cast<u64>(entry.path_offset) + entry.path_length <= header.path_table_size;
+    });
+
+    if (!is_valid || !std::ranges::is_sorted(pack->m_entries, {}, &Entry::path_hash))
+    {
+        std::cout << "Error. Asset pack is corrupted: " << pack_path << "\n";
+        return nullptr;
+    }
+
+    pack->m_file = mapped_file;
+
+    return pack;
+}
+
+AssetPack::AssetPack(AK::Badge<AssetPack>)
+{
+}
+
+std::optional<std::span<std::byte const>> AssetPack::find(std::string_view const path) const
+{
+    u64 const hash = hash_path(path);
+
+    auto const [begin, end] = std::ranges::equal_range(m_entries, hash, {}, &Entry::path_hash);
+
+    for (auto it = begin; it != end; ++it)
+    {
+        if (m_paths.substr(it->path_offset, it->path_length) != path)
+            continue;
+
+        auto const* data = reinterpret_cast<std::byte const*>(m_file->get_data());
+        return std::span(data + it->offset, it->size);
+    }
+
+    return std::nullopt;
+}
+
+u32 AssetPack::get_entry_count() const
+{
+    return static_cast<u32>(m_entries.size());
+}
+
+u64 AssetPack::get_size() const
+{
+    return m_file->get_size();
+}
+
+u64 AssetPack::hash_path(std::string_view const path)
+{
+    return AK::fnv_hash(path.data(), path.size());
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "AK/Badge.h"
+#include "AK/Types.h"
+
+class MemoryMappedFile;
+
+// Every asset under res/ in a single file written by AssetPackBuilder. The table of contents is sorted by the hash
+// of each path, so a lookup is a binary search over the mapped file and every asset is read in place, without
+// opening anything. Paths are stored too, to tell apart the rare paths whose hashes collide.
+//
+// Layout: Header, Entry[entry_count], path table, then the blobs, each starting at a multiple of data_alignment.
+class AssetPack
+{
+public:
+    struct Header
+    {
+        u32 magic = 0;
+        u32 version = 0;
+        u32 entry_count = 0;
+        u32 path_table_size = 0;
+        u64 path_table_offset = 0;
+        u64 data_offset = 0;
+    };
+
+    struct Entry
+    {
+        u64 path_hash = 0;
+        u64 offset = 0;
+        u64 size = 0;
+        u32 path_offset = 0;
+        u32 path_length = 0;
+    };
+
+    static std::shared_ptr<AssetPack> open(std::string const& pack_path);
+
+    explicit AssetPack(AK::Badge<AssetPack>);
+
+    // Expects a path from VirtualFileSystem::normalize_path(). Views stay valid for as long as the pack is alive.
+    [[nodiscard]] std::optional<std::span<std::byte const>> find(std::string_view const path) const;
+
+    [[nodiscard]] u32 get_entry_count() const;
+    [[nodiscard]] u64 get_size() const;
+
+    static u64 hash_path(std::string_view const path);
+
+    // "PACK"
+    static u32 constexpr magic = 0x4B434150;
+
+    static u32 constexpr version = 1;
+
+    // Blobs start at multiples of this, which covers the alignment of every format that is read in place, like CookedModel.
+    static u32 constexpr data_alignment = 64;
+
+private:
+    std::shared_ptr<MemoryMappedFile> m_file = nullptr;
+
+    std::span<Entry const> m_entries = {};
+    std::string_view m_paths = {};
+};
@@ -0,0 +1,158 @@
+#include "AssetPackBuilder.h"
+
+#include "AssetPack.h"
+#include "MemoryMappedFile.h"
+#include "VirtualFileSystem.h"
+
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+
+u64 align_offset(u64 const offset)
+{
+    return (offset + AssetPack::data_alignment - 1) / AssetPack::data_alignment * AssetPack::data_alignment;
+}
+
+void pad_to(std::ofstream& file, u64 const offset)
+{
+    std::array<char, AssetPack::data_alignment> constexpr zeros = {};
+    u64 const position = static_cast<u64>(file.tellp());
+    file.write(zeros.data(), static_cast<std::streamsize>(offset - position));
+}
+
+struct PackedFile
+{
+    std::string source_path = {};
+    std::string path = {};
+    AssetPack::Entry entry = {};
+};
+
+}
+
+bool AssetPackBuilder::build(std::string const& directory, std::string const& pack_path)
+{
+    std::string const normalized_pack_path = VirtualFileSystem::normalize_path(pack_path);
+
+    std::vector<PackedFile> files = {};
+
+    std::error_code error;
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(directory, error))
+    {
+        if (!entry.is_regular_file())
+            continue;
+
+        PackedFile file = {};
+        file.source_path = entry.path().generic_string();
+        file.path = VirtualFileSystem::normalize_path(file.source_path);
+
+        // An older pack written into the directory itself.
+        if (file.path == normalized_pack_path)
+            continue;
+
+        file.entry.path_hash = AssetPack::hash_path(file.path);
+        file.entry.size = entry.file_size(error);
+        file.entry.path_length = static_cast<u32>(file.path.size());
+
+        files.emplace_back(std::move(file));
+    }
+
+    if (error)
+    {
+        std::cout << "Error. Failed reading the directory to pack: " << directory << "\n";
+        return false;
+    }
+
+    std::ranges::sort(files, [](PackedFile const& lhs, PackedFile const& rhs) {
+        return lhs.entry.path_hash != rhs.entry.path_hash ? lhs.entry.path_hash < rhs.entry.path_hash : lhs.path < rhs.path;
+    });
+
+    // Paths are case-insensitive, two files that only differ in case can't both be packed.
+    for (u32 i = 1; i < files.size(); ++i)
+    {
+        if (files[i].path == files[i - 1].path)
+        {
+            std::cout << "Error. Two files map to the same packed path: " << files[i - 1].source_path << ", " << files[i].source_path
+                      << "\n";
+            return false;
+        }
+    }
+
+    std::string path_table = {};
+    for (auto& file : files)
+    {
+        file.entry.path_offset = static_cast<u32>(path_table.size());
+        path_table += file.path;
+    }
+
+    AssetPack::Header header = {};
+    header.magic = AssetPack::magic;
+    header.version = AssetPack::version;
+    header.entry_count = static_cast<u32>(files.size());
+    header.path_table_size = static_cast<u32>(path_table.size());
+    header.path_table_offset = sizeof(AssetPack::Header) + files.size() * sizeof(AssetPack::Entry);
+    header.data_offset = align_offset(header.path_table_offset + path_table.size());
+
+    u64 offset = header.data_offset;
+    for (auto& file : files)
+    {
+        file.entry.offset = offset;
+        offset = align_offset(offset + file.entry.size);
+    }
+
+    std::ofstream pack(pack_path, std::ios::binary | std::ios::trunc);
+
+    if (!pack.is_open())
+    {
+        std::cout << "Error. Failed writing an asset pack: " << pack_path << "\n";
+        return false;
+    }
+
+    pack.write(reinterpret_cast<char const*>(&header), sizeof(header));
+
+    for (auto const& file : files)
+    {
+        pack.write(reinterpret_cast<char const*>(&file.entry), sizeof(file.entry));
+    }
+
+    pack.write(path_table.data(), static_cast<std::streamsize>(path_table.size()));
+
+    u64 total_size = 0;
+
+    for (auto const& file : files)
+    {
+        pad_to(pack, file.entry.offset);
+
+        // Empty files can't be mapped, they only need their entry.
+        if (file.entry.size == 0)
+            continue;
+
+        auto const source = MemoryMappedFile::open(file.source_path);
+
+        if (source == nullptr || source->get_size() != file.entry.size)
+        {
+            std::cout << "Error. Failed reading a file to pack: " << file.source_path << "\n";
+            return false;
+        }
+
+        pack.write(reinterpret_cast<char const*>(source->get_data()), static_cast<std::streamsize>(source->get_size()));
+        total_size += source->get_size();
+    }
+
+    if (!pack.good())
+    {
+        std::cout << "Error. Failed writing an asset pack: " << pack_path << "\n";
+        return false;
+    }
+
+    std::cout << std::format("Packed {} files ({} KB) into {} ({} KB).\n", files.size(), total_size / 1024, pack_path,
+                             static_cast<u64>(pack.tellp()) / 1024);
+
+    return true;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <string>
+
+// Offline packing of a directory into an AssetPack. Only needs the standard library, so it also runs from
+// tools/AssetPacker on build machines.
+class AssetPackBuilder
+{
+public:
+    AssetPackBuilder() = delete;
+
+    // Packs every file under directory, stored under its path as the engine spells it, e.g. "./res" gives "res/...".
+    // Has to run from the directory the game runs from. Returns false if anything couldn't be read or written.
+    static bool build(std::string const& directory, std::string const& pack_path);
+};
@@ -1,9 +1,17 @@
 #include "AssetPreloader.h"
 
+#include "BinaryScene.h"
 #include "Debug.h"
+#include "EngineDefines.h"
+#include "VirtualFileSystem.h"
 
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <format>
 #include <fstream>
-#include <sstream>
+#include <functional>
+#include <iostream>
 
 std::shared_ptr<AssetPreloader> AssetPreloader::create()
 {
@@ -16,32 +24,257 @@ AssetPreloader::AssetPreloader(AK::Badge<AssetPreloader>)
 
 std::optional<std::string> AssetPreloader::get_text_asset(std::string const& asset_path)
 {
-    if (!preloaded_text_assets.contains(asset_path))
-    {
+    std::string const key = VirtualFileSystem::normalize_path(asset_path);
+    std::lock_guard lock(m_mutex);
+
+    m_requested_assets.emplace(asset_path);
+
+    auto const it = m_assets.find(key);
+
+    if (it == m_assets.end())
+        return {};
+
+    return it->second.text;
+}
+
+std::optional<YAML::Node> AssetPreloader::get_yaml_asset(std::string const& asset_path)
+{
+    std::string const key = VirtualFileSystem::normalize_path(asset_path);
+    std::lock_guard lock(m_mutex);
+
+    m_requested_assets.emplace(asset_path);
+
+    auto const it = m_assets.find(key);
+
+    if (it == m_assets.end())
         return {};
-    }
 
-    return preloaded_text_assets.at(asset_path);
+    return it->second.node;
 }
 
 void AssetPreloader::preload_text_asset(std::string const& asset_path)
 {
-    if (preloaded_text_assets.contains(asset_path))
+    preload_text_assets({asset_path}, false);
+}
+
+void AssetPreloader::preload_text_assets(std::vector<std::string> const& asset_paths, bool const parse_yaml)
+{
+    auto const start = std::chrono::steady_clock::now();
+
+    std::vector<std::string> paths_to_load = {};
+
     {
+        std::lock_guard lock(m_mutex);
+
+        for (auto const& path : asset_paths)
+        {
+            auto const it = m_assets.find(VirtualFileSystem::normalize_path(path));
+
+            if (it == m_assets.end() || (parse_yaml && !it->second.node.has_value()))
+                paths_to_load.emplace_back(path);
+        }
+    }
+
+    if (paths_to_load.empty())
         return;
+
+    if (m_thread_pool == nullptr)
+        m_thread_pool = std::make_unique<ThreadPool>(ThreadPool::get_default_thread_count());
+
+    std::vector<std::optional<Asset>> loaded_assets(paths_to_load.size());
+
+    // Every job writes its own slot, the results are only inserted once all of them are done.
+    for (u32 i = 0; i < paths_to_load.size(); ++i)
+    {
+        m_thread_pool->submit([&, i] { loaded_assets[i] = load_asset(paths_to_load[i], parse_yaml); });
     }
 
-    std::ifstream asset_file(asset_path);
+    m_thread_pool->wait();
+
+    u32 failed_count = 0;
+    size_t loaded_size = 0;
 
-    if (!asset_file.is_open())
     {
-        Debug::log("Could not open a scene file: " + asset_path + "\n", DebugType::Error);
-        return;
+        std::lock_guard lock(m_mutex);
+
+        for (u32 i = 0; i < paths_to_load.size(); ++i)
+        {
+            if (!loaded_assets[i].has_value())
+            {
+                ++failed_count;
+                continue;
+            }
+
+            loaded_size += loaded_assets[i]->text.size();
+            m_assets.insert_or_assign(VirtualFileSystem::normalize_path(paths_to_load[i]), std::move(loaded_assets[i].value()));
+        }
     }
 
-    std::stringstream stream;
-    stream << asset_file.rdbuf();
-    asset_file.close();
+    double const elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    Debug::log(std::format("Preloaded {} assets ({} KB{}) in {:.2f} ms on {} threads, {} failed", paths_to_load.size() - failed_count,
+                           loaded_size / 1024, parse_yaml ? ", parsed" : "", elapsed_ms, m_thread_pool->get_thread_count(), failed_count));
+}
+
+bool AssetPreloader::preload_manifest(std::string const& manifest_path, bool const parse_yaml)
+{
+    std::vector<std::string> asset_paths = read_manifest(manifest_path);
+
+    if (asset_paths.empty())
+    {
+        Debug::log("Preload manifest is missing or empty, assets are loaded when first used: " + manifest_path, DebugType::Warning);
+        return false;
+    }
+
+#if !EDITOR
+    // SceneSerializer reads the cooked copies in place, the YAML is only needed for files that weren't cooked.
+    std::erase_if(asset_paths, [](std::string const& path) { return VirtualFileSystem::exists(BinaryScene::get_binary_path(path)); });
+#endif
+
+    preload_text_assets(asset_paths, parse_yaml);
+
+    return true;
+}
+
+void AssetPreloader::invalidate(std::string const& asset_path)
+{
+    std::lock_guard lock(m_mutex);
+    m_assets.erase(VirtualFileSystem::normalize_path(asset_path));
+}
+
+bool AssetPreloader::generate_manifest(std::string const& manifest_path, std::vector<std::string> const& root_paths,
+                                       std::string const& prefab_directory)
+{
+    std::deque<std::string> pending(root_paths.begin(), root_paths.end());
+
+    {
+        std::lock_guard lock(m_mutex);
+        pending.insert(pending.end(), m_requested_assets.begin(), m_requested_assets.end());
+    }
+
+    std::vector<std::string> manifest = {};
+    std::unordered_set<std::string> visited = {};
+    std::unordered_set<std::string> checked_names = {};
+
+    while (!pending.empty())
+    {
+        std::string const path = std::move(pending.front());
+        pending.pop_front();
+
+        std::string const key = VirtualFileSystem::normalize_path(path);
+
+        // Requests also include editor files like the copied entity, only assets get shipped.
+        if (!key.starts_with("res/") || !visited.emplace(key).second)
+            continue;
+
+        std::optional<Asset> const asset = load_asset(path, true);
+
+        if (!asset.has_value())
+            continue;
+
+        manifest.emplace_back(path);
+
+        // Prefabs are referenced by name, e.g. CustomerManager's customer_prefab. Any scalar naming a prefab file counts.
+        std::function<void(YAML::Node const&)> visit = [&](YAML::Node const& node) {
+            if (node.IsScalar())
+            {
+                std::string const& name = node.Scalar();
+
+                if (name.empty() || !checked_names.emplace(name).second)
+                    return;
+
+                std::string const prefab_path = prefab_directory + name + ".txt";
+
+                if (VirtualFileSystem::exists(prefab_path))
+                    pending.emplace_back(prefab_path);
+            }
+            else if (node.IsSequence())
+            {
+                for (auto const& child : node)
+                    visit(child);
+            }
+            else if (node.IsMap())
+            {
+                for (auto const& pair : node)
+                    visit(pair.second);
+            }
+        };
+
+        if (asset->node.has_value())
+            visit(asset->node.value());
+    }
+
+    std::ranges::sort(manifest);
+
+    std::ofstream file(manifest_path, std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        Debug::log("Could not write the preload manifest: " + manifest_path, DebugType::Error);
+        return false;
+    }
+
+    file << "# Generated by the editor (Debug window, Generate preload manifest). Text assets read at startup, one per line.\n";
+
+    for (auto const& path : manifest)
+    {
+        file << path << "\n";
+    }
+
+    Debug::log(std::format("Wrote {} assets to the preload manifest {}", manifest.size(), manifest_path));
+
+    return file.good();
+}
+
+std::vector<std::string> AssetPreloader::read_manifest(std::string const& manifest_path)
+{
+    FileView const file = VirtualFileSystem::read(manifest_path);
+
+    if (!file.is_valid())
+        return {};
+
+    std::vector<std::string> asset_paths = {};
+    std::string_view text = file.get_text();
+
+    while (!text.empty())
+    {
+        size_t const line_end = std::min(text.find('\n'), text.size());
+        std::string_view line = text.substr(0, line_end);
+        text.remove_prefix(std::min(line_end + 1, text.size()));
+
+        if (!line.empty() && line.back() == '\r')
+            line.remove_suffix(1);
+
+        if (!line.empty() && line.front() != '#')
+            asset_paths.emplace_back(line);
+    }
+
+    return asset_paths;
+}
+
+std::optional<AssetPreloader::Asset> AssetPreloader::load_asset(std::string const& asset_path, bool const parse_yaml)
+{
+    FileView const asset_file = VirtualFileSystem::read(asset_path);
+
+    if (!asset_file.is_valid())
+    {
+        std::cout << "Error. Could not open a text asset: " << asset_path << "\n";
+        return {};
+    }
+
+    Asset asset = {};
+    asset.text = asset_file.get_text();
+
+    if (!parse_yaml)
+        return asset;
+
+    try
+    {
+        asset.node = YAML::Load(asset.text);
+    }
+    catch (YAML::Exception const& exception)
+    {
+        std::cout << "Error. Could not parse a text asset: " << asset_path << "\n" << exception.what() << "\n";
+    }
 
-    preloaded_text_assets.emplace(asset_path, stream.str());
+    return asset;
 }
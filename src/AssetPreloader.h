@@ -1,12 +1,21 @@
 #pragma once
 
 #include "AK/Badge.h"
+#include "ThreadPool.h"
 
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
+#include <yaml-cpp/yaml.h>
+
+// Keeps scene and prefab files in memory, so loading a level or spawning a prefab doesn't read them again.
+// Which files to load comes from a manifest, one path per line, that the editor generates from the scenes and everything
+// they reference. Files are read and optionally parsed on a thread pool. Parsed trees let SceneSerializer skip YAML::Load().
 class AssetPreloader
 {
 public:
@@ -15,7 +24,44 @@ public:
     explicit AssetPreloader(AK::Badge<AssetPreloader>);
 
     std::optional<std::string> get_text_asset(std::string const& asset_path);
+
+    // Shared by every caller, YAML::Clone() it before changing anything.
+    std::optional<YAML::Node> get_yaml_asset(std::string const& asset_path);
+
     void preload_text_asset(std::string const& asset_path);
 
-    std::unordered_map<std::string, std::string> preloaded_text_assets = {};
+    // Blocks until every file is read, and parsed if parse_yaml is set. Files that are already loaded are skipped.
+    // Only call from the main thread.
+    void preload_text_assets(std::vector<std::string> const& asset_paths, bool const parse_yaml);
+
+    // Returns false if the manifest is missing, nothing is preloaded then and assets are read when first used.
+    bool preload_manifest(std::string const& manifest_path, bool const parse_yaml);
+
+    // Called when a file is written, so the next request reads it again.
+    void invalidate(std::string const& asset_path);
+
+    // Writes root_paths, every prefab they name, recursively, and every text asset requested since startup.
+    // The last part catches prefabs that are only spawned from code, play through the game before generating.
+    bool generate_manifest(std::string const& manifest_path, std::vector<std::string> const& root_paths,
+                           std::string const& prefab_directory);
+
+    static std::vector<std::string> read_manifest(std::string const& manifest_path);
+
+    inline static std::string const default_manifest_path = "./res/preload_manifest.txt";
+
+private:
+    struct Asset
+    {
+        std::string text = {};
+        std::optional<YAML::Node> node = {};
+    };
+
+    // Runs on the thread pool, so it reports errors with std::cout rather than Debug::log().
+    static std::optional<Asset> load_asset(std::string const& asset_path, bool const parse_yaml);
+
+    std::mutex m_mutex = {};
+    std::unordered_map<std::string, Asset> m_assets = {};
+    std::unordered_set<std::string> m_requested_assets = {};
+
+    std::unique_ptr<ThreadPool> m_thread_pool = nullptr;
 };
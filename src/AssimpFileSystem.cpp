@@ -0,0 +1,103 @@
+#include "AssimpFileSystem.h"
+
+#include "VirtualFileSystem.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include <assimp/IOStream.hpp>
+
+namespace
+{
+
+class FileViewStream final : public Assimp::IOStream
+{
+public:
+    explicit FileViewStream(FileView file) : m_file(std::move(file))
+    {
+    }
+
+    size_t Read(void* buffer, size_t const size, size_t const count) override
+    {
+        if (size == 0)
+            return 0;
+
+        size_t const read_count = std::min(count, (m_file.get_size() - m_cursor) / size);
+
+        std::memcpy(buffer, m_file.get_bytes() + m_cursor, read_count * size);
+        m_cursor += read_count * size;
+
+        return read_count;
+    }
+
+    size_t Write(void const*, size_t, size_t) override
+    {
+        return 0;
+    }
+
+    aiReturn Seek(size_t const offset, aiOrigin const origin) override
+    {
+        size_t base = 0;
+        if (origin == aiOrigin_CUR)
+            base = m_cursor;
+        else if (origin == aiOrigin_END)
+            base = m_file.get_size();
+
+        if (base + offset > m_file.get_size())
+            return aiReturn_FAILURE;
+
+        m_cursor = base + offset;
+
+        return aiReturn_SUCCESS;
+    }
+
+    size_t Tell() const override
+    {
+        return m_cursor;
+    }
+
+    size_t FileSize() const override
+    {
+        return m_file.get_size();
+    }
+
+    void Flush() override
+    {
+    }
+
+private:
+    FileView m_file = {};
+    size_t m_cursor = 0;
+};
+
+}
+
+bool AssimpFileSystem::Exists(char const* path) const
+{
+    return VirtualFileSystem::exists(path);
+}
+
+char AssimpFileSystem::getOsSeparator() const
+{
+    return '/';
+}
+
+Assimp::IOStream* AssimpFileSystem::Open(char const* path, char const* mode)
+{
+    // Models are only ever read.
+    if (std::strchr(mode, 'w') != nullptr || std::strchr(mode, 'a') != nullptr)
+        return nullptr;
+
+    FileView file = VirtualFileSystem::read(path);
+
+    if (!file.is_valid())
+        return nullptr;
+
+    return new FileViewStream(std::move(file));
+}
+
+void AssimpFileSystem::Close(Assimp::IOStream* stream)
+{
+    delete stream;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <assimp/IOSystem.hpp>
+
+// Assimp IO handler that reads models through VirtualFileSystem, including the files they reference like glTF buffers
+// and OBJ materials. Pass a new instance to Assimp::Importer::SetIOHandler(), which takes ownership of it.
+class AssimpFileSystem final : public Assimp::IOSystem
+{
+public:
+    bool Exists(char const* path) const override;
+    char getOsSeparator() const override;
+
+    Assimp::IOStream* Open(char const* path, char const* mode = "rb") override;
+    void Close(Assimp::IOStream* stream) override;
+};
@@ -0,0 +1,424 @@
+#include "BinaryScene.h"
+
+#include <filesystem>
+#include <span>
+
+#include "AK/AK.h"
+#include "Material.h"
+#include "ResourceManager.h"
+#include "SceneSerializer.h"
+
+std::string BinaryScene::get_binary_path(std::string const& file_path)
+{
+    std::filesystem::path path = file_path;
+    path.replace_extension(".scene");
+    return path.string();
+}
+
+u32 BinaryScene::get_source_hash(std::string_view const source)
+{
+    return AK::murmur_hash(reinterpret_cast<u8 const*>(source.data()), source.size(), 0);
+}
+
+BinarySceneWriter::BinarySceneWriter(u32 const layout_hash) : m_layout_hash(layout_hash)
+{
+}
+
+u32 BinarySceneWriter::add_entity(std::string const& guid, std::string const& name, glm::vec3 const& translation,
+                                  glm::vec3 const& rotation, glm::vec3 const& scale)
+{
+    BinaryScene::EntityRecord entity = {};
+    entity.guid = add_string(guid);
+    entity.name = add_string(name);
+    entity.first_component = static_cast<u32>(m_components.size());
+    entity.translation = translation;
+    entity.rotation = rotation;
+    entity.scale = scale;
+
+    u32 const index = static_cast<u32>(m_entities.size());
+    m_entities.emplace_back(entity);
+    m_entity_indices.emplace(guid, index);
+
+    return index;
+}
+
+u32 BinarySceneWriter::add_component(u32 const entity, u32 const type, std::string const& guid, std::string const& custom_name)
+{
+    BinaryScene::ComponentRecord component = {};
+    component.type = type;
+    component.guid = add_string(guid);
+    component.custom_name = add_string(custom_name);
+
+    u32 const index = static_cast<u32>(m_components.size());
+    m_components.emplace_back(component);
+    m_component_indices.emplace(guid, index);
+
+    m_entities[entity].component_count += 1;
+
+    return index;
+}
+
+void BinarySceneWriter::set_parent(u32 const entity, std::string const& parent_guid)
+{
+    m_entities[entity].parent = get_reference(parent_guid, m_entity_indices);
+}
+
+void BinarySceneWriter::begin_fields(u32 const component)
+{
+    m_components[component].field_offset = static_cast<u32>(m_fields.get_buffer().size());
+}
+
+std::vector<u8> BinarySceneWriter::finish(std::string const& scene_name, std::string_view const source)
+{
+    BinaryScene::Header header = {};
+    header.magic = BinaryScene::magic;
+    header.version = BinaryScene::version;
+    header.layout_hash = m_layout_hash;
+    header.source_hash = BinaryScene::get_source_hash(source);
+    header.source_size = source.size();
+    header.scene_name = add_string(scene_name);
+    header.string_count = static_cast<u32>(m_strings.size());
+    header.entity_count = static_cast<u32>(m_entities.size());
+    header.component_count = static_cast<u32>(m_components.size());
+    header.field_data_size = static_cast<u32>(m_fields.get_buffer().size());
+
+    // Blocks are written one after another, each ends where the next one starts.
+    for (u32 i = 0; i < m_components.size(); ++i)
+    {
+        u32 const field_end = i + 1 < m_components.size() ? m_components[i + 1].field_offset : header.field_data_size;
+        m_components[i].field_size = field_end - m_components[i].field_offset;
+    }
+
+    std::vector<u32> string_offsets = {};
+    string_offsets.reserve(m_strings.size());
+
+    for (auto const& string : m_strings)
+    {
+        string_offsets.emplace_back(header.string_data_size);
+        header.string_data_size += static_cast<u32>(string.size());
+    }
+
+    AK::BinaryWriter out = {};
+    out.write(header);
+    out.write_bytes(string_offsets.data(), string_offsets.size() * sizeof(u32));
+
+    for (auto const& string : m_strings)
+    {
+        out.write_bytes(string.data(), string.size());
+    }
+
+    out.write_bytes(m_entities.data(), m_entities.size() * sizeof(BinaryScene::EntityRecord));
+    out.write_bytes(m_components.data(), m_components.size() * sizeof(BinaryScene::ComponentRecord));
+    out.write_bytes(m_fields.get_buffer().data(), m_fields.get_buffer().size());
+
+    return out.get_buffer();
+}
+
+void BinarySceneWriter::write_value(std::string const& value)
+{
+    m_fields.write(add_string(value));
+}
+
+void BinarySceneWriter::write_value(DialogueObject const& value)
+{
+    m_fields.write(value.auto_end);
+    write_value(value.upper_line);
+    write_value(value.middle_line);
+    write_value(value.lower_line);
+    write_value(value.sound_path);
+}
+
+void BinarySceneWriter::write_value(SpawnEvent const& value)
+{
+    m_fields.write(static_cast<u32>(value.spawn_list.size()));
+
+    for (auto const ship_type : value.spawn_list)
+        m_fields.write(ship_type);
+
+    m_fields.write(value.spawn_type);
+}
+
+void BinarySceneWriter::transcode_material(YAML::Node const& node)
+{
+    auto const shader = node["Shader"];
+    write_value(shader["VertexPath"].as<std::string>());
+    write_value(shader["FragmentPath"].as<std::string>());
+    write_value(shader["GeometryPath"].as<std::string>());
+
+    m_fields.write(node["Color"].as<glm::vec4>());
+    m_fields.write(node["RenderOrder"].as<i32>());
+    m_fields.write(node["NeedsForward"].as<bool>());
+    m_fields.write(node["CastsShadows"].as<bool>());
+    m_fields.write(node["IsBillboard"].as<bool>(false));
+}
+
+u32 BinarySceneWriter::add_string(std::string const& value)
+{
+    auto const [it, inserted] = m_string_indices.try_emplace(value, static_cast<u32>(m_strings.size()));
+
+    if (inserted)
+        m_strings.emplace_back(value);
+
+    return it->second;
+}
+
+u32 BinarySceneWriter::get_reference(std::string const& guid, std::unordered_map<std::string, u32> const& indices)
+{
+    if (guid.empty() || guid == "nullptr")
+        return BinaryScene::null_reference;
+
+    if (auto const it = indices.find(guid); it != indices.end())
+        return it->second;
+
+    return BinaryScene::external_reference | add_string(guid);
+}
+
+std::shared_ptr<BinarySceneFile> BinarySceneFile::load(std::string const& binary_path, std::string const& source_path,
+                                                       u32 const layout_hash)
+{
+    FileView const file = VirtualFileSystem::read(binary_path);
+
+    if (!file.is_valid())
+        return nullptr;
+
+    auto scene_file = std::make_shared<BinarySceneFile>(AK::Badge<BinarySceneFile> {}, file);
+
+    if (!scene_file->parse(layout_hash))
+        return nullptr;
+
+    // Shipped builds may come with cooked scenes only, so a missing source is fine.
+    if (FileView const source = VirtualFileSystem::read(source_path); source.is_valid())
+    {
+        if (source.get_size() != scene_file->m_header.source_size
+            || BinaryScene::get_source_hash(source.get_text()) != scene_file->m_header.source_hash)
+        {
+            return nullptr;
+        }
+    }
+
+    return scene_file;
+}
+
+std::shared_ptr<BinarySceneFile> BinarySceneFile::create(std::vector<u8>&& bytes, u32 const layout_hash)
+{
+    auto const owner = std::make_shared<std::vector<u8> const>(std::move(bytes));
+    FileView const file(std::as_bytes(std::span(*owner)), owner);
+
+    auto scene_file = std::make_shared<BinarySceneFile>(AK::Badge<BinarySceneFile> {}, file);
+
+    if (!scene_file->parse(layout_hash))
+        return nullptr;
+
+    return scene_file;
+}
+
+BinarySceneFile::BinarySceneFile(AK::Badge<BinarySceneFile>, FileView const& file) : m_file(file)
+{
+}
+
+bool BinarySceneFile::parse(u32 const layout_hash)
+{
+    AK::BinaryReader reader(m_file.get_bytes(), m_file.get_size());
+
+    if (!reader.read(m_header) || m_header.magic != BinaryScene::magic || m_header.version != BinaryScene::version
+        || m_header.layout_hash != layout_hash)
+    {
+        return false;
+    }
+
+    size_t const file_size = m_file.get_size();
+
+    if (m_header.string_count > file_size || m_header.entity_count > file_size || m_header.component_count > file_size)
+        return false;
+
+    std::vector<u32> string_offsets(m_header.string_count);
+    reader.read_bytes(string_offsets.data(), string_offsets.size() * sizeof(u32));
+
+    size_t const string_data_offset = reader.get_offset();
+
+    if (!reader.is_valid() || m_header.string_data_size > file_size - string_data_offset)
+        return false;
+
+    auto const string_data = reinterpret_cast<char const*>(m_file.get_bytes() + string_data_offset);
+
+    m_strings.resize(m_header.string_count);
+    for (u32 i = 0; i < m_header.string_count; ++i)
+    {
+        u32 const string_end = i + 1 < m_header.string_count ? string_offsets[i + 1] : m_header.string_data_size;
+
+        if (string_offsets[i] > string_end || string_end > m_header.string_data_size)
+            return false;
+
+        m_strings[i] = std::string_view(string_data + string_offsets[i], string_end - string_offsets[i]);
+    }
+
+    AK::BinaryReader records(m_file.get_bytes() + string_data_offset + m_header.string_data_size,
+                             file_size - string_data_offset - m_header.string_data_size);
+
+    m_entities.resize(m_header.entity_count);
+    records.read_bytes(m_entities.data(), m_entities.size() * sizeof(BinaryScene::EntityRecord));
+
+    m_components.resize(m_header.component_count);
+    records.read_bytes(m_components.data(), m_components.size() * sizeof(BinaryScene::ComponentRecord));
+
+    size_t const field_data_offset = string_data_offset + m_header.string_data_size + records.get_offset();
+
+    if (!records.is_valid() || m_header.field_data_size != file_size - field_data_offset)
+        return false;
+
+    m_field_data = m_file.get_bytes() + field_data_offset;
+
+    for (auto const& entity : m_entities)
+    {
+        if (static_cast<u64>(entity.first_component) + entity.component_count > m_header.component_count)
+            return false;
+
+        if (entity.parent != BinaryScene::null_reference && (entity.parent & BinaryScene::external_reference) == 0
+            && entity.parent >= m_header.entity_count)
+        {
+            return false;
+        }
+    }
+
+    for (auto const& component : m_components)
+    {
+        if (static_cast<u64>(component.field_offset) + component.field_size > m_header.field_data_size)
+            return false;
+    }
+
+    return true;
+}
+
+std::string_view BinarySceneFile::get_string(u32 const index) const
+{
+    if (index >= m_strings.size())
+        return {};
+
+    return m_strings[index];
+}
+
+std::span<std::string_view const> BinarySceneFile::get_strings() const
+{
+    return m_strings;
+}
+
+std::string_view BinarySceneFile::get_scene_name() const
+{
+    return get_string(m_header.scene_name);
+}
+
+std::vector<BinaryScene::EntityRecord> const& BinarySceneFile::get_entity_records() const
+{
+    return m_entities;
+}
+
+std::vector<BinaryScene::ComponentRecord> const& BinarySceneFile::get_component_records() const
+{
+    return m_components;
+}
+
+u8 const* BinarySceneFile::get_field_data(u32 const component) const
+{
+    return m_field_data + m_components[component].field_offset;
+}
+
+BinarySceneReader::BinarySceneReader(std::shared_ptr<BinarySceneFile const> const& file) : m_file(file)
+{
+}
+
+BinarySceneFile const& BinarySceneReader::get_file() const
+{
+    return *m_file;
+}
+
+void BinarySceneReader::begin_fields(u32 const component)
+{
+    m_is_valid = m_is_valid && m_fields.is_valid();
+
+    m_field_size = m_file->get_component_records()[component].field_size;
+    m_fields = AK::BinaryReader(m_file->get_field_data(component), m_field_size);
+}
+
+bool BinarySceneReader::has_field()
+{
+    return read<u8>() != 0;
+}
+
+bool BinarySceneReader::is_valid() const
+{
+    return m_is_valid && m_fields.is_valid();
+}
+
+void BinarySceneReader::read_value(std::string& value)
+{
+    value = m_file->get_string(read<u32>());
+}
+
+void BinarySceneReader::read_value(DialogueObject& value)
+{
+    read_value(value.auto_end);
+    read_value(value.upper_line);
+    read_value(value.middle_line);
+    read_value(value.lower_line);
+    read_value(value.sound_path);
+}
+
+void BinarySceneReader::read_value(SpawnEvent& value)
+{
+    read_value(value.spawn_list);
+    read_value(value.spawn_type);
+}
+
+void BinarySceneReader::read_value(std::shared_ptr<Material>& value)
+{
+    auto const vertex_path = read<std::string>();
+    auto const fragment_path = read<std::string>();
+    auto const geometry_path = read<std::string>();
+
+    auto const color = read<glm::vec4>();
+    auto const render_order = read<i32>();
+
+    std::shared_ptr<Shader> const shader = geometry_path.empty()
+                                             ? ResourceManager::get_instance().load_shader(vertex_path, fragment_path)
+                                             : ResourceManager::get_instance().load_shader(vertex_path, fragment_path, geometry_path);
+
+    value = Material::create(shader, render_order);
+    value->color = color;
+    value->needs_forward_rendering = read<bool>();
+    value->casts_shadows = read<bool>();
+    value->is_billboard = read<bool>();
+}
+
+std::shared_ptr<Component> BinarySceneReader::resolve_component(u32 const reference) const
+{
+    if (reference == BinaryScene::null_reference)
+        return nullptr;
+
+    if ((reference & BinaryScene::external_reference) != 0)
+    {
+        std::string const guid(m_file->get_string(reference & ~BinaryScene::external_reference));
+        return SceneSerializer::get_instance()->get_from_pool(guid);
+    }
+
+    if (reference >= components.size())
+        return nullptr;
+
+    return components[reference];
+}
+
+std::shared_ptr<Entity> BinarySceneReader::resolve_entity(u32 const reference) const
+{
+    if (reference == BinaryScene::null_reference)
+        return nullptr;
+
+    if ((reference & BinaryScene::external_reference) != 0)
+    {
+        std::string const guid(m_file->get_string(reference & ~BinaryScene::external_reference));
+        return SceneSerializer::get_instance()->get_entity_from_pool(guid);
+    }
+
+    if (reference >= entities.size())
+        return nullptr;
+
+    return entities[reference];
+}
@@ -0,0 +1,298 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec3.hpp>
+#include <yaml-cpp/yaml.h>
+
+#include "AK/Badge.h"
+#include "AK/BinaryStream.h"
+#include "AK/Types.h"
+#include "VirtualFileSystem.h"
+#include "yaml-cpp-extensions.h"
+
+// Cooked copy of a YAML scene or prefab file. YAML stays the source of truth, the editor writes the binary copy next to
+// every file under res/ it saves and runtime builds load that instead, without parsing text or looking up guids.
+// Strings are stored once in a string table. References to entities and components are indices into their tables.
+// Every component has a block of fields, written and read by code EngineHeaderTool generates in SceneSerializer.cpp.
+// Like CookedModel, a copy is only used while its source matches what it was cooked from.
+//
+// Layout: Header, u32 string offsets[string_count], string data, EntityRecord[entity_count],
+// ComponentRecord[component_count], then the field blocks.
+class BinaryScene
+{
+public:
+    BinaryScene() = delete;
+
+    struct Header
+    {
+        u32 magic = 0;
+        u32 version = 0;
+        u32 layout_hash = 0; // Generated from every serialized field, a changed component invalidates every cooked file.
+        u32 source_hash = 0;
+        u64 source_size = 0;
+        u32 scene_name = 0;
+        u32 string_count = 0;
+        u32 string_data_size = 0;
+        u32 entity_count = 0;
+        u32 component_count = 0;
+        u32 field_data_size = 0;
+    };
+
+    // Components of an entity are stored next to each other, in the order the entity has them.
+    struct EntityRecord
+    {
+        u32 guid = 0;
+        u32 name = 0;
+        u32 parent = null_reference;
+        u32 first_component = 0;
+        u32 component_count = 0;
+        glm::vec3 translation = {};
+        glm::vec3 rotation = {};
+        glm::vec3 scale = {};
+    };
+
+    struct ComponentRecord
+    {
+        u32 type = 0; // ComponentRegistry id.
+        u32 guid = 0;
+        u32 custom_name = 0;
+        u32 field_offset = 0;
+        u32 field_size = 0;
+    };
+
+    // "Level_0.txt" is cooked to "Level_0.scene".
+    static std::string get_binary_path(std::string const& file_path);
+
+    static u32 get_source_hash(std::string_view const source);
+
+    // "SCNB"
+    static u32 constexpr magic = 0x424E4353;
+
+    static u32 constexpr version = 1;
+
+    // References with external_reference set point outside the file, e.g. from a prefab into the scene. The rest of the bits
+    // are the index of the guid in the string table then.
+    static u32 constexpr null_reference = 0xFFFFFFFF;
+    static u32 constexpr external_reference = 0x80000000;
+};
+
+template<typename T>
+concept SerializedVector = std::is_same_v<T, std::vector<typename T::value_type>>;
+
+template<typename T, typename Base>
+concept SerializedReference = (std::is_same_v<T, std::shared_ptr<typename T::element_type>>
+                               || std::is_same_v<T, std::weak_ptr<typename T::element_type>>)
+                           && std::is_base_of_v<Base, typename T::element_type>;
+
+// Turns a parsed YAML file into a binary scene. Every entity and component has to be added first,
+// so references can be turned into indices, then the fields of each component are transcoded in order.
+class BinarySceneWriter
+{
+public:
+    explicit BinarySceneWriter(u32 const layout_hash);
+
+    u32 add_entity(std::string const& guid, std::string const& name, glm::vec3 const& translation, glm::vec3 const& rotation,
+                   glm::vec3 const& scale);
+    u32 add_component(u32 const entity, u32 const type, std::string const& guid, std::string const& custom_name);
+
+    void set_parent(u32 const entity, std::string const& parent_guid);
+
+    // Fields transcoded after this belong to the given component.
+    void begin_fields(u32 const component);
+
+    // A field missing from the YAML is stored as missing, so loading leaves the component's default value.
+    template<typename T>
+    void transcode_field(YAML::Node const& node)
+    {
+        if (!node.IsDefined())
+        {
+            m_fields.write<u8>(0);
+            return;
+        }
+
+        m_fields.write<u8>(1);
+        transcode<T>(node);
+    }
+
+    [[nodiscard]] std::vector<u8> finish(std::string const& scene_name, std::string_view const source);
+
+private:
+    template<typename T>
+    void transcode(YAML::Node const& node)
+    {
+        if constexpr (SerializedVector<T>)
+        {
+            m_fields.write(static_cast<u32>(node.size()));
+
+            for (auto const& element : node)
+                transcode<typename T::value_type>(element);
+        }
+        else if constexpr (SerializedReference<T, Component>)
+        {
+            m_fields.write(get_reference(node["guid"].as<std::string>(), m_component_indices));
+        }
+        else if constexpr (SerializedReference<T, Entity>)
+        {
+            m_fields.write(get_reference(node["guid"].as<std::string>(), m_entity_indices));
+        }
+        else if constexpr (std::is_same_v<T, std::shared_ptr<Material>>)
+        {
+            // Decoding a material loads its shader, so it's transcoded field by field.
+            transcode_material(node);
+        }
+        else
+        {
+            write_value(node.as<T>());
+        }
+    }
+
+    template<typename T>
+    void write_value(T const& value)
+    {
+        m_fields.write(value);
+    }
+
+    void write_value(std::string const& value);
+    void write_value(DialogueObject const& value);
+    void write_value(SpawnEvent const& value);
+
+    void transcode_material(YAML::Node const& node);
+
+    u32 add_string(std::string const& value);
+    u32 get_reference(std::string const& guid, std::unordered_map<std::string, u32> const& indices);
+
+    u32 m_layout_hash = 0;
+
+    std::vector<std::string> m_strings = {};
+    std::unordered_map<std::string, u32> m_string_indices = {};
+
+    std::vector<BinaryScene::EntityRecord> m_entities = {};
+    std::vector<BinaryScene::ComponentRecord> m_components = {};
+    std::unordered_map<std::string, u32> m_entity_indices = {};
+    std::unordered_map<std::string, u32> m_component_indices = {};
+
+    AK::BinaryWriter m_fields = {};
+};
+
+// A cooked file, validated once and read in place. Nothing in it changes after loading,
+// so a prefab template is one of these shared by every instance of the prefab.
+class BinarySceneFile
+{
+public:
+    // Returns nullptr if there is no cooked copy, or it doesn't match the source or the components anymore.
+    static std::shared_ptr<BinarySceneFile> load(std::string const& binary_path, std::string const& source_path, u32 const layout_hash);
+
+    // For files cooked in memory, e.g. from a YAML file without an up to date copy on disk.
+    static std::shared_ptr<BinarySceneFile> create(std::vector<u8>&& bytes, u32 const layout_hash);
+
+    explicit BinarySceneFile(AK::Badge<BinarySceneFile>, FileView const& file);
+
+    [[nodiscard]] std::string_view get_string(u32 const index) const;
+    [[nodiscard]] std::span<std::string_view const> get_strings() const;
+    [[nodiscard]] std::string_view get_scene_name() const;
+
+    [[nodiscard]] std::vector<BinaryScene::EntityRecord> const& get_entity_records() const;
+    [[nodiscard]] std::vector<BinaryScene::ComponentRecord> const& get_component_records() const;
+
+    [[nodiscard]] u8 const* get_field_data(u32 const component) const;
+
+private:
+    bool parse(u32 const layout_hash);
+
+    FileView m_file = {};
+
+    BinaryScene::Header m_header = {};
+    std::vector<std::string_view> m_strings = {};
+    std::vector<BinaryScene::EntityRecord> m_entities = {};
+    std::vector<BinaryScene::ComponentRecord> m_components = {};
+    u8 const* m_field_data = nullptr;
+};
+
+// Reads the fields of a BinarySceneFile. SceneSerializer creates every entity and component first and stores them here,
+// then reads the fields of each component, with references resolved through these tables.
+class BinarySceneReader
+{
+public:
+    explicit BinarySceneReader(std::shared_ptr<BinarySceneFile const> const& file);
+
+    [[nodiscard]] BinarySceneFile const& get_file() const;
+
+    void begin_fields(u32 const component);
+    [[nodiscard]] bool has_field();
+
+    template<typename T>
+    T read()
+    {
+        T value = {};
+        read_value(value);
+        return value;
+    }
+
+    // False once a field block turned out shorter than its fields.
+    [[nodiscard]] bool is_valid() const;
+
+    std::vector<std::shared_ptr<Entity>> entities = {};
+    std::vector<std::shared_ptr<Component>> components = {};
+
+private:
+    template<typename T>
+    void read_value(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>);
+        m_fields.read(value);
+    }
+
+    template<SerializedVector T>
+    void read_value(T& values)
+    {
+        u32 count = 0;
+        m_fields.read(count);
+
+        // Every element takes at least a byte, a bigger count can only come from a broken file.
+        if (count > m_field_size - m_fields.get_offset())
+        {
+            m_is_valid = false;
+            return;
+        }
+
+        values.resize(count);
+
+        for (auto& element : values)
+            read_value(element);
+    }
+
+    template<typename T>
+    requires SerializedReference<T, Component>
+    void read_value(T& value)
+    {
+        value = std::dynamic_pointer_cast<typename T::element_type>(resolve_component(read<u32>()));
+    }
+
+    template<typename T>
+    requires SerializedReference<T, Entity>
+    void read_value(T& value)
+    {
+        value = std::dynamic_pointer_cast<typename T::element_type>(resolve_entity(read<u32>()));
+    }
+
+    void read_value(std::string& value);
+    void read_value(DialogueObject& value);
+    void read_value(SpawnEvent& value);
+    void read_value(std::shared_ptr<Material>& value);
+
+    [[nodiscard]] std::shared_ptr<Component> resolve_component(u32 const reference) const;
+    [[nodiscard]] std::shared_ptr<Entity> resolve_entity(u32 const reference) const;
+
+    std::shared_ptr<BinarySceneFile const> m_file = nullptr;
+
+    AK::BinaryReader m_fields = {nullptr, 0};
+    u32 m_field_size = 0;
+    bool m_is_valid = true;
+};
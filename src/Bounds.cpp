@@ -1,5 +1,7 @@
 #include "Bounds.h"
 
+#include <glm/common.hpp>
+
 BoundingBox::BoundingBox(glm::vec3 const min, glm::vec3 const max) : min(min), max(max)
 {
     center = (max + min) * 0.5f;
@@ -53,3 +55,26 @@ bool BoundingBox::is_in_frustum(Frustum const& frustum) const
         && is_on_or_forward_plane(frustum.top_plane) && is_on_or_forward_plane(frustum.bottom_plane)
         && is_on_or_forward_plane(frustum.near_plane) && is_on_or_forward_plane(frustum.far_plane);
 }
+
+BoundingBox BoundingBox::get_transformed(glm::mat4 const& matrix) const
+{
+    // Arvo's method: every output axis is the translation plus the extremes of each rotated/scaled input axis.
+    // https://github.com/erich666/GraphicsGems/blob/master/gems/TransBox.c
+    glm::vec3 new_min = glm::vec3(matrix[3]);
+    glm::vec3 new_max = new_min;
+
+    for (u32 column = 0; column < 3; ++column)
+    {
+        glm::vec3 const a = glm::vec3(matrix[column]) * min[column];
+        glm::vec3 const b = glm::vec3(matrix[column]) * max[column];
+        new_min += glm::min(a, b);
+        new_max += glm::max(a, b);
+    }
+
+    return {new_min, new_max};
+}
+
+BoundingBox BoundingBox::merge(BoundingBox const& a, BoundingBox const& b)
+{
+    return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <glm/mat4x4.hpp>
 #include <glm/vec3.hpp>
 
 #include "AK/Types.h"
@@ -31,6 +32,11 @@ struct BoundingBox
     [[nodiscard]] bool is_on_or_forward_plane(Plane const& plane) const;
 
     [[nodiscard]] bool is_in_frustum(Frustum const& frustum) const;
+
+    // Axis-aligned box enclosing this box after transforming it by matrix.
+    [[nodiscard]] BoundingBox get_transformed(glm::mat4 const& matrix) const;
+
+    [[nodiscard]] static BoundingBox merge(BoundingBox const& a, BoundingBox const& b);
 };
 
 struct BoundingBoxShader
@@ -267,7 +267,7 @@ std::shared_ptr<Mesh> Button::create_sprite() const
     texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
 
     if (!m_path.empty())
-        diffuse_maps.emplace_back(ResourceManager::get_instance().load_texture(m_path, TextureType::Diffuse, texture_settings));
+        diffuse_maps.emplace_back(ResourceManager::get_instance().load_texture_async(m_path, TextureType::Diffuse, texture_settings));
 
     textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
 
@@ -1,3 +0,0 @@
-#pragma once
-
-#include "AK/Types.h"
@@ -0,0 +1,190 @@
+#include "ComponentRegistry.h"
+
+#include <array>
+#include <unordered_map>
+
+#include "AK/AK.h"
+#include "Component.h"
+// # Auto registry includes start
+#include "Button.h"
+#include "Camera.h"
+#include "Collider2D.h"
+#include "Cube.h"
+#include "Curve.h"
+#include "DebugInputController.h"
+#include "DialoguePromptController.h"
+#include "DirectionalLight.h"
+#include "ExampleDynamicText.h"
+#include "ExampleUIBar.h"
+#include "Floater.h"
+#include "FloatersManager.h"
+#include "FloeButton.h"
+#include "Game/Clock.h"
+#include "Game/Credits.h"
+#include "Game/Customer.h"
+#include "Game/CustomerManager.h"
+#include "Game/EndScreen.h"
+#include "Game/Factory.h"
+#include "Game/GameController.h"
+#include "Game/HovercraftWithoutKeeper.h"
+#include "Game/IceBound.h"
+#include "Game/LevelController.h"
+#include "Game/Lighthouse.h"
+#include "Game/LighthouseKeeper.h"
+#include "Game/LighthouseLight.h"
+#include "Game/Path.h"
+#include "Game/Player.h"
+#include "Game/Player/PlayerInput.h"
+#include "Game/Popup.h"
+#include "Game/Port.h"
+#include "Game/Ship.h"
+#include "Game/ShipEyes.h"
+#include "Game/ShipSpawner.h"
+#include "Game/Thanks.h"
+#include "Model.h"
+#include "NowPromptTrigger.h"
+#include "Panel.h"
+#include "ParticleSystem.h"
+#include "PointLight.h"
+#include "ScreenText.h"
+#include "SkinnedModel.h"
+#include "Sound.h"
+#include "SoundListener.h"
+#include "Sphere.h"
+#include "SpotLight.h"
+#include "Sprite.h"
+#include "Water.h"
+// # Auto registry includes end
+
+namespace
+{
+
+template<typename T>
+std::shared_ptr<Component> create_component()
+{
+    return T::create();
+}
+
+// Names are perfect-hashed: name_hash_seed is picked so that no two names share a slot, every lookup is a single probe.
+// Slots hold id + 1, 0 is empty.
+// # Auto registry start
+std::array<ComponentRegistry::ComponentType, 48> const component_types = {{
+    {"CameraComponent", "Camera", &create_component<Camera>, typeid(Camera)},
+    {"Collider2DComponent", "Collider2D", &create_component<Collider2D>, typeid(Collider2D)},
+    {"CurveComponent", "Curve", &create_component<Curve>, typeid(Curve)},
+    {"PathComponent", "Path", &create_component<Path>, typeid(Path)},
+    {"DebugInputControllerComponent", "Debug Input Controller", &create_component<DebugInputController>, typeid(DebugInputController)},
+    {"DialoguePromptControllerComponent", "Dialogue Prompt Controller", &create_component<DialoguePromptController>,
+     typeid(DialoguePromptController)},
+    {"ButtonComponent", "Button", &create_component<Button>, typeid(Button)},
+    {"ModelComponent", "Model", &create_component<Model>, typeid(Model)},
+    {"CubeComponent", "Cube", &create_component<Cube>, typeid(Cube)},
+    {"SphereComponent", "Sphere", &create_component<Sphere>, typeid(Sphere)},
+    {"SpriteComponent", "Sprite", &create_component<Sprite>, typeid(Sprite)},
+    {"WaterComponent", "Water", &create_component<Water>, typeid(Water)},
+    {"PanelComponent", "Panel", &create_component<Panel>, typeid(Panel)},
+    {"ScreenTextComponent", "Screen Text", &create_component<ScreenText>, typeid(ScreenText)},
+    {"SkinnedModelComponent", "Skinned Model", &create_component<SkinnedModel>, typeid(SkinnedModel)},
+    {"ExampleDynamicTextComponent", "Example Dynamic Text", &create_component<ExampleDynamicText>, typeid(ExampleDynamicText)},
+    {"ExampleUIBarComponent", "Example UIBar", &create_component<ExampleUIBar>, typeid(ExampleUIBar)},
+    {"FloaterComponent", "Floater", &create_component<Floater>, typeid(Floater)},
+    {"FloatersManagerComponent", "Floaters Manager", &create_component<FloatersManager>, typeid(FloatersManager)},
+    {"FloeButtonComponent", "Floe Button", &create_component<FloeButton>, typeid(FloeButton)},
+    {"DirectionalLightComponent", "Directional Light", &create_component<DirectionalLight>, typeid(DirectionalLight)},
+    {"PointLightComponent", "Point Light", &create_component<PointLight>, typeid(PointLight)},
+    {"SpotLightComponent", "Spot Light", &create_component<SpotLight>, typeid(SpotLight)},
+    {"NowPromptTriggerComponent", "Now Prompt Trigger", &create_component<NowPromptTrigger>, typeid(NowPromptTrigger)},
+    {"ParticleSystemComponent", "Particle System", &create_component<ParticleSystem>, typeid(ParticleSystem)},
+    {"SoundComponent", "Sound", &create_component<Sound>, typeid(Sound)},
+    {"SoundListenerComponent", "Sound Listener", &create_component<SoundListener>, typeid(SoundListener)},
+    {"ClockComponent", "Clock", &create_component<Clock>, typeid(Clock)},
+    {"CreditsComponent", "Credits", &create_component<Credits>, typeid(Credits)},
+    {"CustomerComponent", "Customer", &create_component<Customer>, typeid(Customer)},
+    {"CustomerManagerComponent", "Customer Manager", &create_component<CustomerManager>, typeid(CustomerManager)},
+    {"FactoryComponent", "Factory", &create_component<Factory>, typeid(Factory)},
+    {"GameControllerComponent", "Game Controller", &create_component<GameController>, typeid(GameController)},
+    {"HovercraftWithoutKeeperComponent", "Hovercraft Without Keeper", &create_component<HovercraftWithoutKeeper>,
+     typeid(HovercraftWithoutKeeper)},
+    {"IceBoundComponent", "Ice Bound", &create_component<IceBound>, typeid(IceBound)},
+    {"LevelControllerComponent", "Level Controller", &create_component<LevelController>, typeid(LevelController)},
+    {"LighthouseComponent", "Lighthouse", &create_component<Lighthouse>, typeid(Lighthouse)},
+    {"LighthouseKeeperComponent", "Lighthouse Keeper", &create_component<LighthouseKeeper>, typeid(LighthouseKeeper)},
+    {"LighthouseLightComponent", "Lighthouse Light", &create_component<LighthouseLight>, typeid(LighthouseLight)},
+    {"PlayerComponent", "Player", &create_component<Player>, typeid(Player)},
+    {"PopupComponent", "Popup", &create_component<Popup>, typeid(Popup)},
+    {"EndScreenComponent", "End Screen", &create_component<EndScreen>, typeid(EndScreen)},
+    {"PortComponent", "Port", &create_component<Port>, typeid(Port)},
+    {"ShipComponent", "Ship", &create_component<Ship>, typeid(Ship)},
+    {"ShipEyesComponent", "Ship Eyes", &create_component<ShipEyes>, typeid(ShipEyes)},
+    {"ShipSpawnerComponent", "Ship Spawner", &create_component<ShipSpawner>, typeid(ShipSpawner)},
+    {"ThanksComponent", "Thanks", &create_component<Thanks>, typeid(Thanks)},
+    {"PlayerInputComponent", "Player Input", &create_component<PlayerInput>, typeid(PlayerInput)},
+}};
+
+u64 constexpr name_hash_seed = 0xCBF29CE484222354;
+
+std::array<u8, 256> constexpr name_slots = {
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 41, 0, 0,
+    0, 0, 0, 0, 17, 0, 0, 0, 0, 0, 43, 0, 0, 0, 12, 0,
+    0, 0, 0, 0, 0, 34, 0, 0, 11, 0, 48, 0, 0, 33, 0, 0,
+    0, 0, 0, 0, 0, 29, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16,
+    0, 0, 25, 0, 10, 0, 26, 0, 47, 0, 0, 37, 18, 0, 0, 0,
+    5, 0, 0, 0, 0, 0, 0, 0, 0, 0, 3, 0, 0, 38, 0, 7,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 35, 0, 1, 23,
+    0, 32, 0, 0, 0, 0, 0, 6, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 21, 40, 0, 0, 0, 0, 20, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 46, 4, 0,
+    19, 13, 0, 0, 0, 0, 0, 0, 0, 0, 0, 45, 0, 0, 0, 0,
+    0, 36, 14, 0, 9, 0, 31, 0, 0, 24, 0, 0, 8, 22, 0, 0,
+    0, 0, 0, 30, 0, 2, 0, 0, 0, 0, 0, 0, 0, 44, 27, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 39,
+    15, 0, 0, 0, 0, 0, 0, 0, 42, 0, 0, 0, 0, 0, 0, 0,
+    0, 28, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+// # Auto registry end
+
+}
+
+std::span<ComponentRegistry::ComponentType const> ComponentRegistry::get_types()
+{
+    return component_types;
+}
+
+u32 ComponentRegistry::get_id(std::string_view const name)
+{
+    u64 const hash = AK::fnv_hash(name.data(), name.size(), name_hash_seed);
+    u8 const slot = name_slots[hash % name_slots.size()];
+
+    // A name that isn't registered can still land on a taken slot.
+    if (slot == 0 || component_types[slot - 1].name != name)
+        return invalid_id;
+
+    return slot - 1;
+}
+
+u32 ComponentRegistry::get_id(Component const& component)
+{
+    static std::unordered_map<std::type_index, u32> const ids = [] {
+        std::unordered_map<std::type_index, u32> type_ids = {};
+
+        for (u32 i = 0; i < component_types.size(); ++i)
+            type_ids.emplace(component_types[i].type, i);
+
+        return type_ids;
+    }();
+
+    auto const it = ids.find(typeid(component));
+
+    if (it == ids.end())
+        return invalid_id;
+
+    return it->second;
+}
+
+std::shared_ptr<Component> ComponentRegistry::create(u32 const id)
+{
+    if (id >= component_types.size())
+        return nullptr;
+
+    return component_types[id].create();
+}
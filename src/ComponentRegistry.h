@@ -0,0 +1,38 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string_view>
+#include <typeindex>
+
+#include "AK/Types.h"
+
+class Component;
+
+// Every component type that can be saved, generated by EngineHeaderTool into ComponentRegistry.cpp.
+// The id of a type is its index in get_types(). SceneSerializer switches on it when saving and loading, cooked scenes
+// store it, and the editor lists the types from here.
+class ComponentRegistry
+{
+public:
+    ComponentRegistry() = delete;
+
+    struct ComponentType
+    {
+        std::string_view name = {}; // As written in scene files, e.g. "CameraComponent".
+        std::string_view ui_name = {};
+        std::shared_ptr<Component> (*create)() = nullptr;
+        std::type_index type = typeid(void);
+    };
+
+    [[nodiscard]] static std::span<ComponentType const> get_types();
+
+    // Both return invalid_id for types that aren't registered.
+    [[nodiscard]] static u32 get_id(std::string_view const name);
+    [[nodiscard]] static u32 get_id(Component const& component);
+
+    // Returns nullptr for invalid_id.
+    [[nodiscard]] static std::shared_ptr<Component> create(u32 const id);
+
+    static u32 constexpr invalid_id = 0xFFFFFFFF;
+};
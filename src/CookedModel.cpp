@@ -0,0 +1,183 @@
+#include "CookedModel.h"
+
+#include "AK/AK.h"
+#include "AK/BinaryStream.h"
+#include "VirtualFileSystem.h"
+
+#include <array>
+#include <filesystem>
+
+std::string CookedModel::get_cooked_path(std::string const& model_path)
+{
+    std::filesystem::path cooked_path = model_path;
+    cooked_path.replace_extension(".mesh");
+    return cooked_path.string();
+}
+
+std::shared_ptr<CookedModel> CookedModel::load(std::string const& cooked_path, std::string const& source_path)
+{
+    FileView const file = VirtualFileSystem::read(cooked_path);
+
+    if (!file.is_valid())
+        return nullptr;
+
+    u8 const* data = file.get_bytes();
+    size_t const file_size = file.get_size();
+
+    AK::BinaryReader reader(data, file_size);
+
+    auto model = std::make_shared<CookedModel>(AK::Badge<CookedModel> {});
+    Header& header = model->header;
+
+    if (!reader.read(header) || header.magic != magic || header.version != version || header.vertex_stride != sizeof(StaticVertex))
+        return nullptr;
+
+    // Shipped builds may come with cooked models only, so a missing source is fine.
+    if (VirtualFileSystem::exists(source_path))
+    {
+        u64 source_size = 0;
+        u32 source_hash = 0;
+        if (!get_source_stamp(source_path, source_size, source_hash) || source_size != header.source_size
+            || source_hash != header.source_hash)
+        {
+            return nullptr;
+        }
+    }
+
+    if (header.submesh_count > file_size || header.lod_count > file_size || header.texture_count > file_size
+        || header.bone_count > file_size)
+    {
+        return nullptr;
+    }
+
+    model->submeshes.resize(header.submesh_count);
+    reader.read_bytes(model->submeshes.data(), model->submeshes.size() * sizeof(Submesh));
+
+    model->lods.resize(header.lod_count);
+    reader.read_bytes(model->lods.data(), model->lods.size() * sizeof(MeshLod));
+
+    model->textures.resize(header.texture_count);
+    for (auto& texture : model->textures)
+    {
+        u32 type = 0;
+        reader.read(type);
+        reader.read_string(texture.path);
+        texture.type = static_cast<TextureType>(type);
+    }
+
+    model->bones.resize(header.bone_count);
+    for (auto& bone : model->bones)
+    {
+        reader.read_string(bone.name);
+        reader.read(bone.offset);
+        reader.read(bone.bounds_min);
+        reader.read(bone.bounds_max);
+    }
+
+    if (!reader.is_valid())
+        return nullptr;
+
+    u64 const vertex_data_size = static_cast<u64>(header.vertex_count) * sizeof(StaticVertex);
+    u64 const skin_vertex_data_size = static_cast<u64>(header.vertex_count) * sizeof(SkinVertex);
+    u64 const index_data_size = static_cast<u64>(header.index_count) * sizeof(u32);
+    bool const has_skin = header.skin_vertex_data_offset != 0;
+
+    if (header.vertex_data_offset % data_alignment != 0 || header.index_data_offset % data_alignment != 0
+        || header.vertex_data_offset > file_size || vertex_data_size > file_size - header.vertex_data_offset
+        || header.index_data_offset > file_size || index_data_size > file_size - header.index_data_offset)
+    {
+        return nullptr;
+    }
+
+    if (has_skin
+        && (header.skin_vertex_data_offset % data_alignment != 0 || header.skin_vertex_data_offset > file_size
+            || skin_vertex_data_size > file_size - header.skin_vertex_data_offset))
+    {
+        return nullptr;
+    }
+
+    for (auto const& submesh : model->submeshes)
+    {
+        if (static_cast<u64>(submesh.first_vertex) + submesh.vertex_count > header.vertex_count
+            || static_cast<u64>(submesh.first_index) + submesh.index_count > header.index_count
+            || static_cast<u64>(submesh.first_texture) + submesh.texture_count > header.texture_count
+            || static_cast<u64>(submesh.first_lod) + submesh.lod_count > header.lod_count)
+        {
+            return nullptr;
+        }
+
+        if (submesh.skin_vertex_count != 0 && (!has_skin || submesh.skin_vertex_count != submesh.vertex_count))
+            return nullptr;
+
+        for (auto const& lod : model->get_lods(submesh))
+        {
+            if (static_cast<u64>(lod.first_index) + lod.index_count > submesh.index_count)
+                return nullptr;
+        }
+    }
+
+    // Loose files are mapped at page boundaries and packed ones at AssetPack::data_alignment, and the blobs are aligned
+    // within the file, so both can be used in place.
+    model->m_vertices = reinterpret_cast<StaticVertex const*>(data + header.vertex_data_offset);
+    model->m_skin_vertices = has_skin ? reinterpret_cast<SkinVertex const*>(data + header.skin_vertex_data_offset) : nullptr;
+    model->m_indices = reinterpret_cast<u32 const*>(data + header.index_data_offset);
+    model->m_file = file;
+
+    return model;
+}
+
+bool CookedModel::get_source_stamp(std::string const& source_path, u64& size, u32& hash)
+{
+    FileView const source_file = VirtualFileSystem::read(source_path);
+
+    if (!source_file.is_valid())
+        return false;
+
+    size = source_file.get_size();
+    hash = AK::murmur_hash(source_file.get_bytes(), source_file.get_size(), 0);
+
+    // glTF and OBJ keep the actual data in a file next to the one that is loaded.
+    std::array constexpr companion_extensions = {".bin", ".mtl"};
+    for (auto const extension : companion_extensions)
+    {
+        std::filesystem::path companion_path = source_path;
+        companion_path.replace_extension(extension);
+
+        FileView const companion_file = VirtualFileSystem::read(companion_path.string());
+
+        if (!companion_file.is_valid())
+            continue;
+
+        size += companion_file.get_size();
+        hash = AK::murmur_hash(companion_file.get_bytes(), companion_file.get_size(), hash);
+    }
+
+    return true;
+}
+
+CookedModel::CookedModel(AK::Badge<CookedModel>)
+{
+}
+
+std::span<StaticVertex const> CookedModel::get_vertices(Submesh const& submesh) const
+{
+    return {m_vertices + submesh.first_vertex, submesh.vertex_count};
+}
+
+std::span<SkinVertex const> CookedModel::get_skin_vertices(Submesh const& submesh) const
+{
+    if (submesh.skin_vertex_count == 0)
+        return {};
+
+    return {m_skin_vertices + submesh.first_vertex, submesh.skin_vertex_count};
+}
+
+std::span<u32 const> CookedModel::get_indices(Submesh const& submesh) const
+{
+    return {m_indices + submesh.first_index, submesh.index_count};
+}
+
+std::span<MeshLod const> CookedModel::get_lods(Submesh const& submesh) const
+{
+    return {lods.data() + submesh.first_lod, submesh.lod_count};
+}
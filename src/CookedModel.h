@@ -0,0 +1,120 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <glm/mat4x4.hpp>
+#include <glm/vec3.hpp>
+
+#include "AK/Badge.h"
+#include "AK/Types.h"
+#include "MeshLod.h"
+#include "Texture.h"
+#include "Vertex.h"
+#include "VirtualFileSystem.h"
+
+// Binary model written by MeshCooker. Vertex and index data are stored in the layout the GPU buffers use,
+// so meshes are created straight from the mapped file. A cooked model is only used while its source file
+// matches what it was cooked from, or when the source isn't shipped at all. The source is identified by
+// its size and a hash of its contents, since write times change with every checkout and differ between platforms.
+// Skinned models also store their skin vertices and bones, so SkinnedModel doesn't need Assimp either.
+class CookedModel
+{
+public:
+    struct Header
+    {
+        u32 magic = 0;
+        u32 version = 0;
+        u32 vertex_stride = 0;
+        u32 submesh_count = 0;
+        u32 texture_count = 0;
+        u32 vertex_count = 0;
+        u32 index_count = 0;
+        u32 lod_count = 0;
+        u32 bone_count = 0;
+        u32 source_hash = 0;
+        u64 source_size = 0;
+        u64 vertex_data_offset = 0;
+        u64 index_data_offset = 0;
+
+        // 0 if no submesh is skinned.
+        u64 skin_vertex_data_offset = 0;
+        glm::vec3 bounds_min = {};
+        glm::vec3 bounds_max = {};
+    };
+
+    // One per aiMesh, in the order Model visits the node hierarchy. Indices are relative to first_vertex.
+    // index_count covers every level of detail, the LOD table says where each of them starts.
+    // Skin vertices run parallel to the vertices, skin_vertex_count is vertex_count for skinned submeshes and 0 for static ones.
+    struct Submesh
+    {
+        u32 first_vertex = 0;
+        u32 vertex_count = 0;
+        u32 skin_vertex_count = 0;
+        u32 first_index = 0;
+        u32 index_count = 0;
+        u32 first_texture = 0;
+        u32 texture_count = 0;
+        u32 first_lod = 0;
+        u32 lod_count = 0;
+        glm::vec3 bounds_min = {};
+        glm::vec3 bounds_max = {};
+    };
+
+    // Paths are relative to the model's directory, like they are in the source file.
+    struct TextureReference
+    {
+        TextureType type = TextureType::None;
+        std::string path = {};
+    };
+
+    // Bones referenced by the skinned submeshes, indexed by the bone ID their skin vertices store.
+    // Offset is the inverse bind matrix, the bounds enclose the vertices weighted to the bone (min > max if there are none).
+    struct Bone
+    {
+        std::string name = {};
+        glm::mat4 offset = glm::mat4(1.0f);
+        glm::vec3 bounds_min = {};
+        glm::vec3 bounds_max = {};
+    };
+
+    static std::string get_cooked_path(std::string const& model_path);
+
+    static std::shared_ptr<CookedModel> load(std::string const& cooked_path, std::string const& source_path);
+
+    // Size and contents hash of the source, false if it can't be read.
+    static bool get_source_stamp(std::string const& source_path, u64& size, u32& hash);
+
+    explicit CookedModel(AK::Badge<CookedModel>);
+
+    [[nodiscard]] std::span<StaticVertex const> get_vertices(Submesh const& submesh) const;
+    [[nodiscard]] std::span<SkinVertex const> get_skin_vertices(Submesh const& submesh) const;
+    [[nodiscard]] std::span<u32 const> get_indices(Submesh const& submesh) const;
+
+    // Index ranges are relative to the submesh's first index.
+    [[nodiscard]] std::span<MeshLod const> get_lods(Submesh const& submesh) const;
+
+    Header header = {};
+    std::vector<Submesh> submeshes = {};
+    std::vector<MeshLod> lods = {};
+    std::vector<TextureReference> textures = {};
+    std::vector<Bone> bones = {};
+
+    // "MESH"
+    static u32 constexpr magic = 0x4853454D;
+
+    // Bump whenever the layout of the file, StaticVertex or SkinVertex changes, or when the cooked data would come out different.
+    static u32 constexpr version = 5;
+
+    // Vertex and index blobs start at multiples of this, so they can be read in place.
+    static u32 constexpr data_alignment = 16;
+
+private:
+    FileView m_file = {};
+
+    StaticVertex const* m_vertices = nullptr;
+    SkinVertex const* m_skin_vertices = nullptr;
+    u32 const* m_indices = nullptr;
+};
@@ -95,11 +95,11 @@ std::shared_ptr<Mesh> Cube::create_cube() const
 
     std::vector<std::shared_ptr<Texture>> diffuse_maps = {};
     if (!diffuse_texture_path.empty())
-        diffuse_maps.emplace_back(ResourceManager::get_instance().load_texture(diffuse_texture_path, TextureType::Diffuse));
+        diffuse_maps.emplace_back(ResourceManager::get_instance().load_texture_async(diffuse_texture_path, TextureType::Diffuse));
 
     std::vector<std::shared_ptr<Texture>> specular_maps = {};
     if (!specular_texture_path.empty())
-        specular_maps.emplace_back(ResourceManager::get_instance().load_texture(specular_texture_path, TextureType::Specular));
+        specular_maps.emplace_back(ResourceManager::get_instance().load_texture_async(specular_texture_path, TextureType::Specular));
 
     textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
     textures.insert(textures.end(), specular_maps.begin(), specular_maps.end());
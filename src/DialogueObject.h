@@ -4,7 +4,7 @@
 
 struct DialogueObject
 {
-    // If you add anything new here, don't forget to add serialization code in yaml-cpp-extensions.
+    // If you add anything new here, don't forget to add serialization code in yaml-cpp-extensions and BinaryScene.
     bool auto_end = true;
     std::string upper_line = "";
     std::string middle_line = "";
@@ -10,16 +10,20 @@
 #include <imgui_internal.h>
 #endif
 
+#include <chrono>
 #include <filesystem>
+#include <format>
 #include <glm/gtc/type_ptr.inl>
 #include <glm/gtx/string_cast.hpp>
 
 #include "AK/ScopeGuard.h"
 
+#include "AnimationEngine.h"
+#include "AssetPreloader.h"
 #include "Button.h"
 #include "Camera.h"
 #include "Collider2D.h"
-#include "ComponentList.h"
+#include "ComponentRegistry.h"
 #include "Cube.h"
 #include "Curve.h"
 #include "Debug.h"
@@ -68,6 +72,7 @@
 #include "ParticleSystem.h"
 #include "PointLight.h"
 #include "RendererDX11.h"
+#include "ResourceManager.h"
 #include "SceneSerializer.h"
 #include "ScreenText.h"
 #include "SkinnedModel.h"
@@ -94,6 +99,7 @@ Editor::Editor(AK::Badge<Editor>)
     add_scene_hierarchy();
 
     m_last_second = glfwGetTime();
+    m_last_autosave_time = glfwGetTime();
 
     load_assets();
 
@@ -107,6 +113,9 @@ Editor::Editor(AK::Badge<Editor>)
 
 Editor::~Editor()
 {
+    // Jobs still queued when the thread pool is destroyed are dropped.
+    wait_for_saves();
+
     std::filesystem::path const copied_entity_path = m_copied_entity_path;
 
     if (std::filesystem::exists(copied_entity_path))
@@ -128,6 +137,10 @@ std::shared_ptr<Editor> Editor::create()
 
 void Editor::draw()
 {
+    SceneSerializer::drop_saved_templates();
+    refresh_saved_scene();
+    autosave();
+
     if (!m_rendering_to_editor)
         return;
 
@@ -197,6 +210,46 @@ void Editor::draw_debug_window(std::shared_ptr<EditorWindow> const& window)
     ImGui::SameLine();
     ImGui::Checkbox("Show newest logs", &m_always_newest_logs);
     ImGui::Text("Application average %.3f ms/frame", m_average_ms_per_frame);
+    ImGui::Text("Animation update %.3f ms", AnimationEngine::get_instance()->get_last_update_time_ms());
+    ImGui::Text("Skinning upload %.1f KB/frame", RendererDX11::get_instance_dx11()->get_last_skinning_upload_bytes() / 1024.0f);
+    ImGui::Text("Textures decoding %u", ResourceManager::get_instance().get_pending_texture_count());
+    ImGui::Text("Resources resident %.1f MB, budget %.1f MB", ResourceManager::get_instance().get_resident_size() / (1024.0f * 1024.0f),
+                ResourceManager::get_instance().memory_budget / (1024.0f * 1024.0f));
+    if (ImGui::Button("Log resident resources"))
+    {
+        ResourceManager::get_instance().log_resident_resources();
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Unload unused resources"))
+    {
+        ResourceManager::get_instance().unload_unused();
+    }
+    if (ImGui::Button("Generate preload manifest"))
+    {
+        Engine::asset_preloader->generate_manifest(AssetPreloader::default_manifest_path,
+                                                   {m_scene_path + "scene.txt", m_scene_path + "MainScene.txt"}, m_prefab_path);
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Benchmark scene formats"))
+    {
+        std::vector<std::string> level_names = {};
+        for (auto const& entry : std::filesystem::directory_iterator(m_prefab_path))
+        {
+            if (entry.path().extension() == ".txt" && entry.path().stem().string().starts_with("Level_"))
+                level_names.emplace_back(entry.path().stem().string());
+        }
+
+        std::ranges::sort(level_names);
+        SceneSerializer::benchmark_formats(level_names, 5);
+    }
+    ImGui::Text("Animation LOD full %u, reduced %u, frozen %u", AnimationEngine::get_instance()->get_model_count(AnimationLOD::Full),
+                AnimationEngine::get_instance()->get_model_count(AnimationLOD::Reduced),
+                AnimationEngine::get_instance()->get_model_count(AnimationLOD::Frozen));
+    ImGui::DragFloat("Mesh LOD max error (px)", &Model::lod_settings.max_screen_error, 0.05f, 0.0f, 64.0f);
+    for (u32 i = 0; i < max_mesh_lod_count; ++i)
+    {
+        ImGui::Text("Mesh LOD %u: %u meshes, %u triangles", i, Model::get_lod_mesh_count(i), Model::get_lod_triangle_count(i));
+    }
     draw_scene_save();
 
     std::string const log_count = "Logs " + std::to_string(Debug::debug_messages.size());
@@ -558,6 +611,7 @@ void Editor::draw_game(std::shared_ptr<EditorWindow> const& window)
     if (was_transform_changed)
     {
         entity->transform->set_model_matrix(global_model);
+        SceneSerializer::mark_dirty(entity);
     }
 
     ImGui::End();
@@ -710,6 +764,7 @@ void Editor::entity_drag(std::shared_ptr<Entity> const& entity)
             if (auto const reparent_entity = MainScene::get_instance()->get_entity_by_guid(guid))
             {
                 reparent_entity->transform->set_parent(entity->transform);
+                SceneSerializer::mark_dirty(reparent_entity);
             }
         }
 
@@ -728,6 +783,7 @@ void Editor::entity_drag(std::shared_ptr<Entity> const& entity)
             if (auto const reparent_entity = MainScene::get_instance()->get_entity_by_guid(guid))
             {
                 reparent_entity->transform->set_parent(nullptr);
+                SceneSerializer::mark_dirty(reparent_entity);
             }
         }
         ImGui::EndDragDropTarget();
@@ -755,6 +811,9 @@ bool Editor::draw_entity_popup(std::shared_ptr<Entity> const& entity)
                 ImGui::CloseCurrentPopup();
             }
 
+            if (ImGui::IsItemEdited())
+                SceneSerializer::mark_dirty(entity);
+
             ImGui::EndPopup();
         }
 
@@ -859,6 +918,8 @@ void Editor::draw_window_menu_bar(std::shared_ptr<EditorWindow> const& window)
 
 void Editor::load_assets()
 {
+    wait_for_saves();
+
     m_assets.clear();
 
     for (auto const& entry : std::filesystem::recursive_directory_iterator(m_content_path))
@@ -1095,23 +1156,38 @@ void Editor::draw_inspector(std::shared_ptr<EditorWindow> const& window)
 
         std::ranges::transform(m_search_filter, m_search_filter.begin(), [](u8 const c) { return std::tolower(c); });
 
-#define CONCAT_CLASS(name) class name
-#define ENUMERATE_COMPONENT(name, ui_name)                                                                        \
-    {                                                                                                             \
-        std::string ui_name_lower(ui_name);                                                                       \
-        std::ranges::transform(ui_name_lower, ui_name_lower.begin(), [](u8 const c) { return std::tolower(c); }); \
-        if (m_search_filter.empty() || ui_name_lower.find(m_search_filter) != std::string::npos)                  \
-        {                                                                                                         \
-            if (ImGui::Button(ui_name, ImVec2(-FLT_MIN, 20)))                                                     \
-                entity->add_component<CONCAT_CLASS(name)>(##name::create());                                      \
-        }                                                                                                         \
-    }
+        for (auto const& type : ComponentRegistry::get_types())
+        {
+            std::string const ui_name(type.ui_name);
+            std::string ui_name_lower = ui_name;
+            std::ranges::transform(ui_name_lower, ui_name_lower.begin(), [](u8 const c) { return std::tolower(c); });
 
-#undef ENUMERATE_COMPONENT
+            if (m_search_filter.empty() || ui_name_lower.find(m_search_filter) != std::string::npos)
+            {
+                if (ImGui::Button(ui_name.c_str(), ImVec2(-FLT_MIN, 20)))
+                {
+                    entity->add_component(type.create());
+                    SceneSerializer::mark_dirty(entity);
+                }
+            }
+        }
 
         ImGui::EndListBox();
     }
 
+    // Fields and components write straight into the entity while they are edited, so whatever is active in this window
+    // changes the inspected entity. That isn't the selected one while the window is locked.
+    // The final value lands on the frame the item is released, when it isn't active anymore, and an autosave taken while
+    // it was held has already cleared the mark. So the item that was active on the previous frame counts as well.
+    ImGuiContext const& context = *ImGui::GetCurrentContext();
+    ImGuiWindow const* root_window = ImGui::GetCurrentWindow()->RootWindow;
+    bool const is_active = context.ActiveIdWindow != nullptr && context.ActiveIdWindow->RootWindow == root_window;
+    bool const was_active = context.ActiveIdPreviousFrame != 0 && context.ActiveIdPreviousFrameWindow != nullptr
+        && context.ActiveIdPreviousFrameWindow->RootWindow == root_window;
+
+    if (is_active || was_active)
+        SceneSerializer::mark_dirty(entity);
+
     ImGui::End();
 }
 
@@ -1216,10 +1292,65 @@ void Editor::save_scene() const
 
 void Editor::save_scene_as(std::string const& name) const
 {
+    save_scene_in_background("./res/scenes/" + name + ".txt", false);
+}
+
+void Editor::save_scene_in_background(std::string const& file_path, bool const skip_unchanged) const
+{
+    auto const start = std::chrono::steady_clock::now();
+
     auto const scene_serializer = std::make_shared<SceneSerializer>(m_open_scene);
     scene_serializer->set_instance(scene_serializer);
     ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
-    scene_serializer->serialize("./res/scenes/" + name + ".txt");
+
+    // Called between frames, so the scene is never read halfway through an update. Nothing after this touches it.
+    SceneSnapshot snapshot = scene_serializer->take_snapshot(file_path);
+
+    if (skip_unchanged && !snapshot.has_changes)
+        return;
+
+    double const elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    Debug::log(std::format("Saving {} in the background, {} entities emitted, {} unchanged, snapshot took {:.2f} ms", file_path,
+                           snapshot.emitted_count, snapshot.entity_blocks.size() - snapshot.emitted_count, elapsed_ms));
+
+    m_save_thread->submit([snapshot = std::move(snapshot)] { SceneSerializer::save_snapshot(snapshot); });
+}
+
+void Editor::autosave()
+{
+    // The running game isn't saved, see draw_scene_save(). Waits for refresh_saved_scene(), emitting the rest would stall the frame.
+    if (Engine::is_game_running() || SceneSerializer::has_missing_entity_blocks()
+        || glfwGetTime() - m_last_autosave_time < m_autosave_interval)
+        return;
+
+    m_last_autosave_time = glfwGetTime();
+
+    std::filesystem::path const autosave_path = m_autosave_path;
+
+    if (!std::filesystem::exists(autosave_path.parent_path()))
+    {
+        std::filesystem::create_directory(autosave_path.parent_path());
+    }
+
+    save_scene_in_background(m_autosave_path, true);
+}
+
+void Editor::refresh_saved_scene() const
+{
+    if (Engine::is_game_running() || !SceneSerializer::has_missing_entity_blocks())
+        return;
+
+    auto const scene_serializer = std::make_shared<SceneSerializer>(m_open_scene);
+    scene_serializer->set_instance(scene_serializer);
+    ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
+
+    scene_serializer->refresh_entity_blocks(m_refreshed_entities_per_frame);
+}
+
+void Editor::wait_for_saves() const
+{
+    m_save_thread->wait();
+    SceneSerializer::drop_saved_templates();
 }
 
 glm::vec2 Editor::get_game_size() const
@@ -1255,6 +1386,8 @@ bool Editor::load_scene() const
 
 bool Editor::load_scene_name(std::string const& name) const
 {
+    wait_for_saves();
+
     auto const scene_serializer = std::make_shared<SceneSerializer>(m_open_scene);
     scene_serializer->set_instance(scene_serializer);
     ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
@@ -1443,6 +1576,9 @@ void Editor::delete_selected_entity() const
 {
     if (!m_selected_entity.expired())
     {
+        // Other entities could reference it.
+        SceneSerializer::mark_destroyed(m_selected_entity.lock());
+
         m_selected_entity.lock()->destroy_immediate();
     }
 }
@@ -1597,6 +1733,9 @@ void Editor::handle_input()
             ImGui::CloseCurrentPopup();
         }
 
+        if (ImGui::IsItemEdited())
+            SceneSerializer::mark_dirty(m_selected_entity.lock());
+
         ImGui::EndPopup();
     }
 
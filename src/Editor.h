@@ -3,6 +3,7 @@
 #include "AK/Badge.h"
 #include "AK/Types.h"
 #include "Scene.h"
+#include "ThreadPool.h"
 #include "Transform.h"
 
 #include <array>
@@ -188,6 +189,16 @@ private:
     void draw_scene_hierarchy(std::shared_ptr<EditorWindow> const& window);
     void draw_scene_save();
 
+    // Snapshots the scene now and writes it on m_save_thread.
+    void save_scene_in_background(std::string const& file_path, bool const skip_unchanged) const;
+    void autosave();
+
+    // Re-emits the scene a few entities per frame after it was loaded or played, so the next save doesn't emit it all at once.
+    void refresh_saved_scene() const;
+
+    // For anything that reads scene files from disk.
+    void wait_for_saves() const;
+
     void draw_entity_recursively(std::shared_ptr<Transform> const& transform);
     static void entity_drag(std::shared_ptr<Entity> const& entity);
     bool draw_entity_popup(std::shared_ptr<Entity> const& entity);
@@ -219,6 +230,13 @@ private:
     bool m_debug_drawings_enabled = true;
 
     std::string m_copied_entity_path = "./.editor/copied_entity.txt";
+    std::string m_autosave_path = "./.editor/autosave.txt";
+
+    // One thread, so saves of the same file finish in the order they were made.
+    std::unique_ptr<ThreadPool> m_save_thread = std::make_unique<ThreadPool>(1);
+    double m_last_autosave_time = 0.0;
+    double m_autosave_interval = 60.0;
+    u32 m_refreshed_entities_per_frame = 32;
 
     glm::dvec2 m_last_mouse_position = glm::dvec2(1280.0 / 2.0, 720.0 / 2.0);
     float m_yaw = 0.0f;
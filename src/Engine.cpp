@@ -1,5 +1,6 @@
 #include "Engine.h"
 
+#include <format>
 #include <utility>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -9,6 +10,7 @@
 #include <miniaudio.h>
 
 #include "AssetPreloader.h"
+#include "Debug.h"
 #include "Editor.h"
 #include "Game/Game.h"
 #include "Globals.h"
@@ -18,7 +20,10 @@
 #include "Renderer.h"
 #include "RendererDX11.h"
 #include "RendererGL.h"
+#include "ResourceManager.h"
 #include "SceneSerializer.h"
+#include "SoundFileSystem.h"
+#include "VirtualFileSystem.h"
 #include "Window.h"
 
 #if EDITOR
@@ -31,6 +36,9 @@
 
 i32 Engine::initialize()
 {
+    // Before anything gets loaded. Without a pack, every asset is read from loose files.
+    VirtualFileSystem::mount(VirtualFileSystem::default_pack_path);
+
     if (auto const result = initialize_thirdparty_before_renderer(); result != 0)
         return result;
 
@@ -83,23 +91,10 @@ void Engine::create_game()
     auto const main_scene = std::make_shared<Scene>();
     MainScene::set_instance(main_scene);
 
-    asset_preloader->preload_text_asset("./res/scenes/MainScene.txt");
-    asset_preloader->preload_text_asset("./res/scenes/scene.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_0.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_1.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_2.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_3.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_4.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_5.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Level_6.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/ShipBig.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/ShipMedium.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/ShipPirates.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/ShipSmall.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/ShipTool.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Customer.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Keeper.txt");
-    asset_preloader->preload_text_asset("./res/prefabs/Buoy.txt");
+    // The manifest lists every scene and prefab the game uses, regenerate it from the editor's debug window after adding some.
+    double const preload_start = glfwGetTime();
+    asset_preloader->preload_manifest(AssetPreloader::default_manifest_path, preparse_scene_files);
+    double const preload_end = glfwGetTime();
 
 #if EDITOR
     m_editor->set_scene(main_scene);
@@ -141,12 +136,20 @@ void Engine::create_game()
 
     Engine::set_game_running(true);
 #endif
+
+    double const create_end = glfwGetTime();
+    Debug::log(std::format("Game created in {:.1f} ms ({:.1f} ms preloading, {:.1f} ms loading the scene), {:.1f} ms after startup",
+                           (create_end - preload_start) * 1000.0, (preload_end - preload_start) * 1000.0,
+                           (create_end - preload_end) * 1000.0, create_end * 1000.0));
 }
 
 void Engine::run()
 {
     double last_frame = 0.0; // Time of last frame
 
+    // Main thread time spent uploading asynchronously decoded textures per frame.
+    double constexpr texture_finalize_budget_ms = 2.0;
+
     // Main loop
     while (!glfwWindowShouldClose(window->get_glfw_window()) && !should_exit)
     {
@@ -157,6 +160,8 @@ void Engine::run()
         glfwPollEvents();
         Input::input->update_keys();
 
+        ResourceManager::get_instance().finalize_textures(texture_finalize_budget_ms);
+
 #if EDITOR
         // Start the Dear ImGui frame
         switch (Renderer::renderer_api)
@@ -220,11 +225,15 @@ void Engine::run()
         }
 
         Renderer::get_instance()->present();
+
+        // Resources released during the frame are destroyed here, once nothing can still be drawing them.
+        ResourceManager::get_instance().collect_garbage();
     }
 }
 
 void Engine::clean_up()
 {
+    ResourceManager::get_instance().stop_async_loading();
     Renderer::get_instance()->uninitialize();
 
     switch (Renderer::renderer_api)
@@ -280,6 +289,9 @@ void Engine::set_game_running(bool const is_running)
         initialize_miniaudio();
     }
 
+    // Playing changes the scene without the editor knowing what.
+    SceneSerializer::mark_all_dirty();
+
     m_is_game_running = is_running;
 }
 
@@ -408,6 +420,7 @@ i32 Engine::initialize_miniaudio()
     config.channels = 2;
     config.sampleRate = 48000;
     config.listenerCount = 1;
+    config.pResourceManagerVFS = SoundFileSystem::get_vfs();
 
     if (ma_engine_init(&config, &audio_engine) != MA_SUCCESS)
         return -1;
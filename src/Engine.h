@@ -39,6 +39,9 @@ public:
     inline static bool enable_vsync = false;
     inline static bool enable_mouse_capture = false;
 
+    // Scenes and prefabs are parsed on the preloading threads too, instead of every time one is loaded.
+    inline static bool preparse_scene_files = true;
+
     inline static ma_engine audio_engine;
 
     inline static std::shared_ptr<Window> window;
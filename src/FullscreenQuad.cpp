@@ -5,6 +5,7 @@
 #include "RendererDX11.h"
 #include "ResourceManager.h"
 #include "Vertex.h"
+#include "VertexPacking.h"
 
 FullscreenQuad::FullscreenQuad(AK::Badge<FullscreenQuad>)
 {
@@ -20,8 +21,14 @@ FullscreenQuad::FullscreenQuad(AK::Badge<FullscreenQuad>)
         0, 1, 2, 2, 1, 3,
     };
 
-    m_vertex_buffer =
-        std::make_shared<VertexBufferDX11>(RendererDX11::get_instance_dx11()->get_device(), quad_vertices.data(), quad_vertices.size());
+    std::array<StaticVertex, quad_vertices.size()> packed_vertices = {};
+    for (u32 i = 0; i < quad_vertices.size(); ++i)
+    {
+        packed_vertices[i] = VertexPacking::pack_static(quad_vertices[i]);
+    }
+
+    m_vertex_buffer = std::make_shared<VertexBufferDX11>(RendererDX11::get_instance_dx11()->get_device(), packed_vertices.data(),
+                                                         packed_vertices.size(), sizeof(StaticVertex));
     m_index_buffer =
         std::make_shared<IndexBufferDX11>(RendererDX11::get_instance_dx11()->get_device(), quad_indices.data(), quad_indices.size());
 }
@@ -37,10 +44,10 @@ std::shared_ptr<FullscreenQuad> FullscreenQuad::create()
 
 void FullscreenQuad::draw() const
 {
-    auto const device_context = RendererDX11::get_instance_dx11()->get_device_context();
-    u32 constexpr offset = 0;
+    auto const renderer = RendererDX11::get_instance_dx11();
+    auto const device_context = renderer->get_device_context();
     device_context->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    device_context->IASetVertexBuffers(0, 1, m_vertex_buffer->get_address_of(), m_vertex_buffer->stride_ptr(), &offset);
+    renderer->set_vertex_buffers(*m_vertex_buffer, nullptr);
     device_context->IASetIndexBuffer(m_index_buffer->get(), DXGI_FORMAT_R32_UINT, 0);
     device_context->DrawIndexed(6, 0, 0);
 }
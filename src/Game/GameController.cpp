@@ -50,6 +50,20 @@ void GameController::uninitialize()
 {
     Component::uninitialize();
 
+    if (m_next_level_load != nullptr)
+    {
+        // Destroying the new level's LevelController unsets the instance, the current level's stays until the new one is awoken.
+        auto const level_controller = LevelController::get_instance();
+
+        m_next_level_load->abandon();
+        m_next_level_load = nullptr;
+
+        if (level_controller != nullptr && level_controller->entity != nullptr)
+        {
+            LevelController::set_instance(level_controller);
+        }
+    }
+
     m_instance = nullptr;
 }
 
@@ -82,6 +96,8 @@ void GameController::awake()
 
     reset_level();
 
+    SceneSerializer::preload_prefab_async(get_next_level_name());
+
     Sound::play_sound("./res/audio/ost_loop.wav", true);
     auto const wind_sound = Sound::play_sound("./res/audio/wind.mp3", true);
     wind_sound->set_volume(0.5f);
@@ -93,9 +109,11 @@ void GameController::awake()
 
 void GameController::update()
 {
+    SceneSerializer::finish_preloaded_prefabs();
+
     if (Input::input->get_key_down(GLFW_KEY_F3))
     {
-        if (!m_move_to_next_scene)
+        if (!is_moving_to_next_scene())
         {
             GameController::get_instance()->dialog_manager.lock()->end_content();
             move_to_next_scene();
@@ -114,6 +132,12 @@ void GameController::update()
         restart_level();
     }
 
+    if (m_next_level_load != nullptr)
+    {
+        update_next_level_load();
+        return;
+    }
+
     if (!m_move_to_next_scene)
     {
         return;
@@ -162,7 +186,7 @@ void GameController::draw_editor()
 
 bool GameController::is_moving_to_next_scene() const
 {
-    return m_move_to_next_scene;
+    return m_move_to_next_scene || m_next_level_load != nullptr;
 }
 
 void GameController::reset_scene()
@@ -171,14 +195,11 @@ void GameController::reset_scene()
 
     m_level_number = 0;
 
-    next_scene = SceneSerializer::load_prefab(m_levels_order.back());
     m_levels_order.pop_back();
 
     reset_level();
 
     auto const path = entity->get_component<Path>();
-    m_current_position = path->points[path->points.size() - 1];
-    m_next_position = path->points[0];
 
     glm::vec2 const delta = path->points[path->points.size() - 1] - path->points[0];
 
@@ -209,24 +230,98 @@ void GameController::update_scenes_position() const
 
 void GameController::move_to_next_scene()
 {
-    LevelController::get_instance()->lighthouse.lock()->turn_light(false);
-    LevelController::get_instance()->destroy_mouse_prompt();
-    LevelController::get_instance()->destroy_immediate();
+    // The level being loaded is moved to once it's done.
+    if (m_next_level_load != nullptr)
+    {
+        return;
+    }
+
+    m_next_level_load = SceneSerializer::begin_load_prefab(get_next_level_name());
+
+    if (m_next_level_load == nullptr)
+    {
+        return;
+    }
+
+    m_next_level_controller = {};
+
+    auto const& path = entity->get_component<Path>();
+
+    if (m_levels_order.empty())
+    {
+        m_current_position = path->points[path->points.size() - 1];
+        m_next_position = path->points[0];
+    }
+    else
+    {
+        m_current_position = path->points[m_level_number];
+        m_next_position = path->points[m_level_number + 1];
+    }
+}
+
+void GameController::update_next_level_load()
+{
+    // The current level is played until the new one is fully awoken, so its LevelController stays the instance between the steps.
+    // The new one registers itself once created and is the instance while its own level is being prepared and awoken.
+    auto const level_controller = LevelController::get_instance();
+    LevelController::set_instance(m_next_level_controller.lock());
 
+    m_next_level_load->step(m_level_load_entities_per_frame, m_level_load_awakes_per_frame);
+
+    m_next_level_controller = LevelController::get_instance();
+    LevelController::set_instance(level_controller);
+
+    // Waits next to the current level until it's moved to.
+    if (next_scene.expired() && m_next_level_load->get_root() != nullptr)
+    {
+        next_scene = m_next_level_load->get_root();
+        update_scenes_position();
+    }
+
+    if (m_next_level_load->get_stage() != PrefabLoad::Stage::Done)
+    {
+        return;
+    }
+
+    m_next_level_load = nullptr;
+
+    switch_level_controller();
+    finish_move_to_next_scene();
+
+    SceneSerializer::preload_prefab_async(get_next_level_name());
+}
+
+void GameController::switch_level_controller()
+{
+    if (auto const level_controller = LevelController::get_instance(); level_controller != nullptr)
+    {
+        level_controller->lighthouse.lock()->turn_light(false);
+        level_controller->destroy_mouse_prompt();
+        level_controller->destroy_immediate();
+    }
+
+    if (m_next_level_controller.expired())
+    {
+        Debug::log("Level has no LevelController.", DebugType::Error);
+    }
+
+    LevelController::set_instance(m_next_level_controller.lock());
+    m_next_level_controller = {};
+}
+
+void GameController::finish_move_to_next_scene()
+{
     if (m_levels_order.empty())
     {
         reset_scene();
         return;
     }
 
-    next_scene = SceneSerializer::load_prefab(m_levels_order.back());
     m_levels_order.pop_back();
 
     reset_level();
 
     auto const& path = entity->get_component<Path>();
-    m_current_position = path->points[m_level_number];
-    m_next_position = path->points[m_level_number + 1];
 
     glm::vec2 const delta = path->points[m_level_number + 1] - path->points[m_level_number];
 
@@ -243,6 +338,17 @@ void GameController::move_to_next_scene()
     update_scenes_position();
 }
 
+std::string GameController::get_next_level_name() const
+{
+    // Starts over from the first level after the last one, see reset_scene().
+    if (m_levels_order.empty())
+    {
+        return m_levels_backup.back();
+    }
+
+    return m_levels_order.back();
+}
+
 void GameController::register_customer_manager_entity(std::shared_ptr<Entity> const& customer_manager_entity)
 {
     m_customer_manager_entity = customer_manager_entity;
@@ -268,6 +374,12 @@ void GameController::reset_level()
 
 void GameController::restart_level()
 {
+    // The next level replaces this one anyway.
+    if (m_next_level_load != nullptr)
+    {
+        return;
+    }
+
     m_level_number--;
 
     std::string scene_name = current_scene.lock()->name;
@@ -8,6 +8,9 @@
 
 #include <glm/vec2.hpp>
 
+class LevelController;
+class PrefabLoad;
+
 class GameController final : public Component
 {
 public:
@@ -45,6 +48,13 @@ private:
 
     void update_scenes_position() const;
 
+    // Steps the load of the next level, starts moving to it once it's done.
+    void update_next_level_load();
+    void switch_level_controller();
+    void finish_move_to_next_scene();
+
+    std::string get_next_level_name() const;
+
     inline static std::shared_ptr<GameController> m_instance;
 
     bool m_move_to_next_scene = false;
@@ -59,4 +69,11 @@ private:
     std::vector<glm::vec2> m_points_backup = {};
 
     std::weak_ptr<Entity> m_customer_manager_entity = {};
+
+    // The next level is created over several frames, the current one stays in play meanwhile.
+    std::shared_ptr<PrefabLoad> m_next_level_load = nullptr;
+    std::weak_ptr<LevelController> m_next_level_controller = {};
+
+    inline static u32 constexpr m_level_load_entities_per_frame = 8;
+    inline static u32 constexpr m_level_load_awakes_per_frame = 16;
 };
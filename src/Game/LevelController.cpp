@@ -39,6 +39,11 @@ std::shared_ptr<LevelController> LevelController::get_instance()
     return m_instance;
 }
 
+void LevelController::set_instance(std::shared_ptr<LevelController> const& instance)
+{
+    m_instance = instance;
+}
+
 void LevelController::uninitialize()
 {
     Component::uninitialize();
@@ -38,6 +38,9 @@ public:
 
     static std::shared_ptr<LevelController> get_instance();
 
+    // For GameController, which keeps the current level's instance while the next level is being loaded.
+    static void set_instance(std::shared_ptr<LevelController> const& instance);
+
     virtual void uninitialize() override;
 
     virtual void awake() override;
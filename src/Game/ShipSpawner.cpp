@@ -96,6 +96,10 @@ void ShipSpawner::awake()
 
     get_spawn_paths();
 
+    // Spawning then only instantiates the templates, without a hitch for the first ship of each type.
+    for (auto const& prefab_name : {"ShipSmall", "ShipMedium", "ShipBig", "ShipPirates", "ShipTool"})
+        SceneSerializer::preload_prefab(prefab_name);
+
     set_can_tick(true);
 }
 
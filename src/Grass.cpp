@@ -73,7 +73,7 @@ std::shared_ptr<Mesh> Grass::create_blade() const
 
     if (!m_diffuse_texture_path.empty())
         diffuse_maps.emplace_back(
-            ResourceManager::get_instance().load_texture(m_diffuse_texture_path, TextureType::Diffuse, texture_settings));
+            ResourceManager::get_instance().load_texture_async(m_diffuse_texture_path, TextureType::Diffuse, texture_settings));
 
     textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
 
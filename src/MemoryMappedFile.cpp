@@ -0,0 +1,119 @@
+#include "MemoryMappedFile.h"
+
+#if _WIN32
+#include <windows.h>
+
+#include "AK/AK.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if _WIN32
+std::shared_ptr<MemoryMappedFile> MemoryMappedFile::open(std::string const& path)
+{
+    auto mapped_file = std::make_shared<MemoryMappedFile>(AK::Badge<MemoryMappedFile> {});
+
+    HANDLE const file = CreateFileW(AK::string_to_wstring(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+    if (file == INVALID_HANDLE_VALUE)
+        return nullptr;
+
+    mapped_file->m_file = file;
+
+    LARGE_INTEGER file_size = {};
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+        return nullptr;
+
+    HANDLE const mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    if (mapping == nullptr)
+        return nullptr;
+
+    mapped_file->m_mapping = mapping;
+
+    void const* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+    if (view == nullptr)
+        return nullptr;
+
+    mapped_file->m_data = static_cast<u8 const*>(view);
+    mapped_file->m_size = static_cast<size_t>(file_size.QuadPart);
+
+    return mapped_file;
+}
+#else
+// Used by the offline tools, which also run on Linux.
+std::shared_ptr<MemoryMappedFile> MemoryMappedFile::open(std::string const& path)
+{
+    auto mapped_file = std::make_shared<MemoryMappedFile>(AK::Badge<MemoryMappedFile> {});
+
+    i32 const file = ::open(path.c_str(), O_RDONLY);
+
+    if (file == -1)
+        return nullptr;
+
+    mapped_file->m_file = reinterpret_cast<void*>(static_cast<intptr_t>(file) + 1);
+
+    struct stat file_stat = {};
+    if (fstat(file, &file_stat) != 0 || file_stat.st_size == 0)
+        return nullptr;
+
+    void* view = mmap(nullptr, static_cast<size_t>(file_stat.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+    if (view == MAP_FAILED)
+        return nullptr;
+
+    mapped_file->m_data = static_cast<u8 const*>(view);
+    mapped_file->m_size = static_cast<size_t>(file_stat.st_size);
+
+    return mapped_file;
+}
+#endif
+
+MemoryMappedFile::MemoryMappedFile(AK::Badge<MemoryMappedFile>)
+{
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    close();
+}
+
+u8 const* MemoryMappedFile::get_data() const
+{
+    return m_data;
+}
+
+size_t MemoryMappedFile::get_size() const
+{
+    return m_size;
+}
+
+void MemoryMappedFile::close()
+{
+#if _WIN32
+    if (m_data != nullptr)
+        UnmapViewOfFile(m_data);
+
+    if (m_mapping != nullptr)
+        CloseHandle(m_mapping);
+
+    if (m_file != nullptr)
+        CloseHandle(m_file);
+#else
+    if (m_data != nullptr)
+        munmap(const_cast<u8*>(m_data), m_size);
+
+    if (m_file != nullptr)
+        ::close(static_cast<i32>(reinterpret_cast<intptr_t>(m_file) - 1));
+#endif
+
+    m_data = nullptr;
+    m_mapping = nullptr;
+    m_file = nullptr;
+    m_size = 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "AK/Badge.h"
+#include "AK/Types.h"
+
+// Read-only view of a whole file. The file stays mapped for as long as the object is alive.
+class MemoryMappedFile
+{
+public:
+    static std::shared_ptr<MemoryMappedFile> open(std::string const& path);
+
+    explicit MemoryMappedFile(AK::Badge<MemoryMappedFile>);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(MemoryMappedFile const&) = delete;
+    void operator=(MemoryMappedFile const&) = delete;
+
+    [[nodiscard]] u8 const* get_data() const;
+    [[nodiscard]] size_t get_size() const;
+
+private:
+    void close();
+
+    // Win32 HANDLEs, kept as void* so this header doesn't pull in windows.h. Elsewhere m_file holds the descriptor plus one.
+    void* m_file = nullptr;
+    void* m_mapping = nullptr;
+
+    u8 const* m_data = nullptr;
+    size_t m_size = 0;
+};
@@ -8,26 +8,38 @@
 #include "Texture.h"
 #include "Vertex.h"
 
-Mesh::Mesh(std::vector<Vertex> const& vertices, std::vector<u32> const& indices, std::vector<std::shared_ptr<Texture>> const& textures,
-           DrawType const draw_type, std::shared_ptr<Material> const& material, DrawFunctionType const draw_function)
-    : material(material), m_vertices(vertices), m_indices(indices), m_textures(textures), m_draw_type(draw_type),
+Mesh::Mesh(u32 const vertex_count, u32 const index_count, std::span<MeshLod const> const lods, VertexLayout const vertex_layout,
+           std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type, std::shared_ptr<Material> const& material,
+           DrawFunctionType const draw_function, BoundingBox const& local_bounds)
+    : material(material), m_vertex_count(vertex_count), m_index_count(index_count), m_lods(lods.begin(), lods.end()),
+      m_vertex_layout(vertex_layout), m_local_bounds(local_bounds), m_textures(textures), m_draw_type(draw_type),
       m_draw_function(draw_function)
 {
+    if (m_lods.empty())
+        m_lods.push_back({0, index_count, 0.0f});
 }
 
 void Mesh::calculate_bounding_box()
 {
-    if (m_vertices.empty())
+    if (m_vertex_count == 0)
         return;
 
-    float lowest_x = m_vertices[0].position.x;
-    float lowest_y = m_vertices[0].position.y;
-    float lowest_z = m_vertices[0].position.z;
-    float highest_x = m_vertices[0].position.x;
-    float highest_y = m_vertices[0].position.y;
-    float highest_z = m_vertices[0].position.z;
+    bounds = m_local_bounds;
+}
+
+BoundingBox Mesh::calculate_local_bounds(std::span<StaticVertex const> const vertices)
+{
+    if (vertices.empty())
+        return {};
 
-    for (auto const& vertex : m_vertices)
+    float lowest_x = vertices[0].position.x;
+    float lowest_y = vertices[0].position.y;
+    float lowest_z = vertices[0].position.z;
+    float highest_x = vertices[0].position.x;
+    float highest_y = vertices[0].position.y;
+    float highest_z = vertices[0].position.z;
+
+    for (auto const& vertex : vertices)
     {
         if (vertex.position.x < lowest_x)
             lowest_x = vertex.position.x;
@@ -44,7 +56,18 @@ void Mesh::calculate_bounding_box()
             highest_z = vertex.position.z;
     }
 
-    this->bounds = {glm::vec3(lowest_x, lowest_y, lowest_z), glm::vec3(highest_x, highest_y, highest_z)};
+    return {glm::vec3(lowest_x, lowest_y, lowest_z), glm::vec3(highest_x, highest_y, highest_z)};
+}
+
+std::span<MeshLod const> Mesh::get_lods() const
+{
+    return m_lods;
+}
+
+u64 Mesh::get_size() const
+{
+    u64 const skin_size = m_vertex_layout == VertexLayout::Skinned ? sizeof(SkinVertex) : 0;
+    return static_cast<u64>(m_vertex_count) * (sizeof(StaticVertex) + skin_size) + static_cast<u64>(m_index_count) * sizeof(u32);
 }
 
 void Mesh::adjust_bounding_box(glm::mat4 const& model_matrix)
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <span>
 #include <vector>
 
 #include "AK/Types.h"
 #include "Bounds.h"
 #include "DrawType.h"
 #include "Drawable.h"
+#include "MeshLod.h"
 #include "Texture.h"
 #include "Vertex.h"
 
@@ -14,7 +16,9 @@ class Mesh
 public:
     virtual ~Mesh() = default;
 
+    // Draws the full detail level.
     void virtual draw() const = 0;
+    void virtual draw_lod(u32 const lod) const = 0;
     void virtual draw(u32 const size, void const* offset) const = 0;
     void virtual draw_instanced(i32 const size) const = 0;
 
@@ -25,18 +29,31 @@ public:
     void adjust_bounding_box(glm::mat4 const& model_matrix);
     [[nodiscard]] BoundingBox get_adjusted_bounding_box(glm::mat4 const& model_matrix) const;
 
+    [[nodiscard]] static BoundingBox calculate_local_bounds(std::span<StaticVertex const> const vertices);
+
+    // Level 0 is the full mesh, meshes that weren't simplified only have that one.
+    [[nodiscard]] std::span<MeshLod const> get_lods() const;
+
+    // Bytes of the GPU buffers.
+    [[nodiscard]] u64 get_size() const;
+
     BoundingBox bounds = {};
 
     std::shared_ptr<Material> material;
 
 protected:
-    Mesh(std::vector<Vertex> const& vertices, std::vector<u32> const& indices, std::vector<std::shared_ptr<Texture>> const& textures,
-         DrawType const draw_type, std::shared_ptr<Material> const& material, DrawFunctionType const draw_function);
+    // Vertex data only lives on the GPU, meshes keep the counts and the bounds they need afterwards.
+    Mesh(u32 const vertex_count, u32 const index_count, std::span<MeshLod const> const lods, VertexLayout const vertex_layout,
+         std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type, std::shared_ptr<Material> const& material,
+         DrawFunctionType const draw_function, BoundingBox const& local_bounds);
 
     [[nodiscard]] BoundingBox calculate_adjusted_bounding_box(glm::mat4 const& model_matrix) const;
 
-    std::vector<Vertex> m_vertices;
-    std::vector<u32> m_indices;
+    u32 m_vertex_count = 0;
+    u32 m_index_count = 0;
+    std::vector<MeshLod> m_lods = {};
+    VertexLayout m_vertex_layout = VertexLayout::Static;
+    BoundingBox m_local_bounds = {};
     std::vector<std::shared_ptr<Texture>> m_textures;
 
     DrawType m_draw_type;
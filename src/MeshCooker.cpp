@@ -0,0 +1,430 @@
+#include "MeshCooker.h"
+
+#include "AK/BinaryStream.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
+#include "VertexPacking.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+
+#include <assimp/Importer.hpp>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <glm/common.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include <glm/matrix.hpp>
+
+namespace
+{
+
+u64 align_offset(u64 const offset)
+{
+    return (offset + CookedModel::data_alignment - 1) / CookedModel::data_alignment * CookedModel::data_alignment;
+}
+
+void pad_to(AK::BinaryWriter& writer, u64 const offset)
+{
+    std::array<u8, CookedModel::data_alignment> constexpr zeros = {};
+    writer.write_bytes(zeros.data(), offset - writer.get_buffer().size());
+}
+
+}
+
+bool MeshCooker::cook(std::string const& model_path, std::string const& cooked_path)
+{
+    ImportedModel model = {};
+    return import_model(model_path, model) && write_cooked_model(model_path, model, cooked_path);
+}
+
+bool MeshCooker::write_cooked_model(std::string const& model_path, ImportedModel const& model, std::string const& cooked_path)
+{
+    CookedModel::Header header = {};
+    header.magic = CookedModel::magic;
+    header.version = CookedModel::version;
+    header.vertex_stride = sizeof(StaticVertex);
+    header.submesh_count = static_cast<u32>(model.submeshes.size());
+    header.texture_count = static_cast<u32>(model.textures.size());
+    header.vertex_count = static_cast<u32>(model.vertices.size());
+    header.index_count = static_cast<u32>(model.indices.size());
+    header.lod_count = static_cast<u32>(model.lods.size());
+    header.bone_count = static_cast<u32>(model.bones.size());
+
+    if (!CookedModel::get_source_stamp(model_path, header.source_size, header.source_hash))
+        return false;
+
+    bool has_bounds = false;
+    for (auto const& submesh : model.submeshes)
+    {
+        if (submesh.vertex_count == 0)
+            continue;
+
+        header.bounds_min = has_bounds ? glm::min(header.bounds_min, submesh.bounds_min) : submesh.bounds_min;
+        header.bounds_max = has_bounds ? glm::max(header.bounds_max, submesh.bounds_max) : submesh.bounds_max;
+        has_bounds = true;
+    }
+
+    AK::BinaryWriter tables;
+    tables.write_bytes(model.submeshes.data(), model.submeshes.size() * sizeof(CookedModel::Submesh));
+    tables.write_bytes(model.lods.data(), model.lods.size() * sizeof(MeshLod));
+
+    for (auto const& texture : model.textures)
+    {
+        tables.write(static_cast<u32>(texture.type));
+        tables.write_string(texture.path);
+    }
+
+    for (auto const& bone : model.bones)
+    {
+        tables.write_string(bone.name);
+        tables.write(bone.offset);
+        tables.write(bone.bounds_min);
+        tables.write(bone.bounds_max);
+    }
+
+    bool const has_skin = !model.skin_vertices.empty();
+
+    header.vertex_data_offset = align_offset(sizeof(CookedModel::Header) + tables.get_buffer().size());
+    header.index_data_offset = align_offset(header.vertex_data_offset + model.vertices.size() * sizeof(StaticVertex));
+
+    u64 const index_data_end = header.index_data_offset + model.indices.size() * sizeof(u32);
+    header.skin_vertex_data_offset = has_skin ? align_offset(index_data_end) : 0;
+
+    AK::BinaryWriter writer;
+    writer.write(header);
+    writer.write_bytes(tables.get_buffer().data(), tables.get_buffer().size());
+    pad_to(writer, header.vertex_data_offset);
+    writer.write_bytes(model.vertices.data(), model.vertices.size() * sizeof(StaticVertex));
+    pad_to(writer, header.index_data_offset);
+    writer.write_bytes(model.indices.data(), model.indices.size() * sizeof(u32));
+
+    if (has_skin)
+    {
+        // Static meshes after the last skinned one don't add skin vertices, the rest of the stream is zeros.
+        std::vector<SkinVertex> skin_vertices = model.skin_vertices;
+        skin_vertices.resize(model.vertices.size());
+
+        pad_to(writer, header.skin_vertex_data_offset);
+        writer.write_bytes(skin_vertices.data(), skin_vertices.size() * sizeof(SkinVertex));
+    }
+
+    std::ofstream file(cooked_path, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        std::cout << "Error. Failed writing a cooked model: " << cooked_path << "\n";
+        return false;
+    }
+
+    auto const& buffer = writer.get_buffer();
+    file.write(reinterpret_cast<char const*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+
+    return file.good();
+}
+
+bool MeshCooker::cook_directory(std::string const& directory, bool const verify)
+{
+    std::array const model_extensions = {".gltf", ".glb", ".fbx", ".obj"};
+
+    u32 cooked_count = 0;
+    u32 failed_count = 0;
+
+    std::error_code error;
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(directory, error))
+    {
+        if (!entry.is_regular_file())
+            continue;
+
+        std::string const extension = entry.path().extension().string();
+        if (std::ranges::find(model_extensions, extension) == model_extensions.end())
+            continue;
+
+        std::string const model_path = entry.path().generic_string();
+        std::string const cooked_path = CookedModel::get_cooked_path(model_path);
+
+        ImportedModel model = {};
+        if (!import_model(model_path, model) || !write_cooked_model(model_path, model, cooked_path)
+            || (verify && !verify_model(model_path, cooked_path)))
+        {
+            std::cout << "Error. Failed cooking a model: " << model_path << "\n";
+            ++failed_count;
+            continue;
+        }
+
+        float const triangle_count = static_cast<float>(std::max(model.triangle_count, 1u));
+        std::cout << std::format("Cooked {} ({} KB), {} triangles, ACMR {:.3f} -> {:.3f}\n", model_path,
+                                 std::filesystem::file_size(cooked_path, error) / 1024, model.triangle_count,
+                                 model.acmr_before / triangle_count, model.acmr_after / triangle_count);
+
+        std::string lod_triangles = {};
+        for (u32 i = 1; i < max_mesh_lod_count && model.lod_triangle_counts[i] > 0; ++i)
+        {
+            lod_triangles += std::format(" -> {}", model.lod_triangle_counts[i]);
+        }
+
+        if (!lod_triangles.empty())
+            std::cout << std::format("    LOD triangles {}{}\n", model.lod_triangle_counts[0], lod_triangles);
+
+        ++cooked_count;
+    }
+
+    std::cout << "Cooked " << cooked_count << " models, " << failed_count << " failed.\n";
+
+    return failed_count == 0;
+}
+
+bool MeshCooker::verify_model(std::string const& model_path, std::string const& cooked_path)
+{
+    ImportedModel expected = {};
+    if (!import_model(model_path, expected))
+        return false;
+
+    auto const cooked = CookedModel::load(cooked_path, model_path);
+
+    if (cooked == nullptr)
+    {
+        std::cout << "Error. Cooked model is missing, stale or corrupted: " << cooked_path << "\n";
+        return false;
+    }
+
+    if (cooked->submeshes.size() != expected.submeshes.size() || cooked->textures.size() != expected.textures.size()
+        || cooked->bones.size() != expected.bones.size())
+    {
+        std::cout << "Error. Cooked model has a different number of submeshes, textures or bones: " << cooked_path << "\n";
+        return false;
+    }
+
+    for (u32 i = 0; i < expected.textures.size(); ++i)
+    {
+        if (cooked->textures[i].type != expected.textures[i].type || cooked->textures[i].path != expected.textures[i].path)
+        {
+            std::cout << "Error. Cooked model texture " << i << " doesn't match: " << cooked_path << "\n";
+            return false;
+        }
+    }
+
+    for (u32 i = 0; i < expected.bones.size(); ++i)
+    {
+        auto const& bone = cooked->bones[i];
+        auto const& expected_bone = expected.bones[i];
+
+        if (bone.name != expected_bone.name || bone.offset != expected_bone.offset || bone.bounds_min != expected_bone.bounds_min
+            || bone.bounds_max != expected_bone.bounds_max)
+        {
+            std::cout << "Error. Cooked model bone " << i << " doesn't match: " << cooked_path << "\n";
+            return false;
+        }
+    }
+
+    for (u32 i = 0; i < expected.submeshes.size(); ++i)
+    {
+        auto const& submesh = expected.submeshes[i];
+        auto const vertices = cooked->get_vertices(cooked->submeshes[i]);
+        auto const skin_vertices = cooked->get_skin_vertices(cooked->submeshes[i]);
+        auto const indices = cooked->get_indices(cooked->submeshes[i]);
+        auto const lods = cooked->get_lods(cooked->submeshes[i]);
+
+        // All structs are tightly packed, so comparing bytes also compares every field.
+        if (std::memcmp(&cooked->submeshes[i], &submesh, sizeof(CookedModel::Submesh)) != 0
+            || std::memcmp(vertices.data(), expected.vertices.data() + submesh.first_vertex, vertices.size_bytes()) != 0
+            || (!skin_vertices.empty()
+                && std::memcmp(skin_vertices.data(), expected.skin_vertices.data() + submesh.first_vertex, skin_vertices.size_bytes()) != 0)
+            || std::memcmp(indices.data(), expected.indices.data() + submesh.first_index, indices.size_bytes()) != 0
+            || std::memcmp(lods.data(), expected.lods.data() + submesh.first_lod, lods.size_bytes()) != 0)
+        {
+            std::cout << "Error. Cooked model submesh " << i << " doesn't match: " << cooked_path << "\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool MeshCooker::import_model(std::string const& model_path, ImportedModel& model)
+{
+    // Same flags as Model::load_model(), cooked and imported models have to be identical. SkinnedModel also asks for
+    // aiProcess_PopulateArmatureData, which only links bones to their nodes and doesn't change the vertices or the weights.
+    Assimp::Importer importer;
+    aiScene const* scene = importer.ReadFile(model_path, aiProcess_Triangulate | aiProcess_FlipUVs);
+
+    if (scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || scene->mRootNode == nullptr)
+    {
+        std::cout << "Error. Failed loading a model: " << importer.GetErrorString() << "\n";
+        return false;
+    }
+
+    process_node(scene->mRootNode, scene, model);
+
+    return true;
+}
+
+void MeshCooker::process_node(aiNode const* node, aiScene const* scene, ImportedModel& model)
+{
+    for (u32 i = 0; i < node->mNumMeshes; ++i)
+    {
+        process_mesh(scene->mMeshes[node->mMeshes[i]], scene, model);
+    }
+
+    for (u32 i = 0; i < node->mNumChildren; ++i)
+    {
+        process_node(node->mChildren[i], scene, model);
+    }
+}
+
+void MeshCooker::process_mesh(aiMesh const* mesh, aiScene const* scene, ImportedModel& model)
+{
+    CookedModel::Submesh submesh = {};
+    submesh.first_vertex = static_cast<u32>(model.vertices.size());
+    submesh.vertex_count = mesh->mNumVertices;
+    submesh.first_index = static_cast<u32>(model.indices.size());
+    submesh.first_texture = static_cast<u32>(model.textures.size());
+
+    std::vector<Vertex> vertices(mesh->mNumVertices);
+    std::vector<u32> indices = {};
+
+    for (u32 i = 0; i < mesh->mNumVertices; ++i)
+    {
+        Vertex& vertex = vertices[i];
+
+        vertex.position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+
+        if (mesh->HasNormals())
+            vertex.normal = glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z);
+        else
+            vertex.normal = glm::vec3(0.0f);
+
+        if (mesh->mTextureCoords[0] != nullptr)
+            vertex.texture_coordinates = glm::vec2(mesh->mTextureCoords[0][i].x, mesh->mTextureCoords[0][i].y);
+        else
+            vertex.texture_coordinates = glm::vec2(0.0f, 0.0f);
+
+        submesh.bounds_min = i == 0 ? vertex.position : glm::min(submesh.bounds_min, vertex.position);
+        submesh.bounds_max = i == 0 ? vertex.position : glm::max(submesh.bounds_max, vertex.position);
+    }
+
+    if (mesh->HasBones())
+    {
+        add_bone_weights(mesh, vertices, model);
+        submesh.skin_vertex_count = mesh->mNumVertices;
+    }
+
+    for (u32 i = 0; i < mesh->mNumFaces; ++i)
+    {
+        aiFace const& face = mesh->mFaces[i];
+        indices.insert(indices.end(), face.mIndices, face.mIndices + face.mNumIndices);
+    }
+
+    // Same reordering that ResourceManager does for meshes that aren't cooked.
+    u32 const triangle_count = static_cast<u32>(indices.size() / 3);
+    model.triangle_count += triangle_count;
+    model.acmr_before += MeshOptimizer::calculate_acmr(indices, mesh->mNumVertices) * triangle_count;
+
+    MeshOptimizer::optimize(vertices, indices, true);
+
+    model.acmr_after += MeshOptimizer::calculate_acmr(indices, mesh->mNumVertices) * triangle_count;
+
+    std::vector<MeshLod> lods = {};
+    MeshSimplifier::build_lods(vertices, indices, lods);
+
+    for (u32 i = 0; i < lods.size(); ++i)
+    {
+        model.lod_triangle_counts[i] += lods[i].index_count / 3;
+    }
+
+    submesh.first_lod = static_cast<u32>(model.lods.size());
+    submesh.lod_count = static_cast<u32>(lods.size());
+    model.lods.insert(model.lods.end(), lods.begin(), lods.end());
+
+    for (auto const& vertex : vertices)
+    {
+        model.vertices.emplace_back(VertexPacking::pack_static(vertex));
+    }
+
+    if (submesh.skin_vertex_count != 0)
+    {
+        model.skin_vertices.resize(submesh.first_vertex);
+
+        for (auto const& vertex : vertices)
+        {
+            model.skin_vertices.emplace_back(VertexPacking::pack_skin(vertex));
+        }
+    }
+
+    model.indices.insert(model.indices.end(), indices.begin(), indices.end());
+    submesh.index_count = static_cast<u32>(indices.size());
+
+    aiMaterial const* material = scene->mMaterials[mesh->mMaterialIndex];
+    add_textures(material, aiTextureType_DIFFUSE, TextureType::Diffuse, model);
+    add_textures(material, aiTextureType_SPECULAR, TextureType::Specular, model);
+
+    submesh.texture_count = static_cast<u32>(model.textures.size()) - submesh.first_texture;
+
+    model.submeshes.emplace_back(submesh);
+}
+
+void MeshCooker::add_bone_weights(aiMesh const* mesh, std::vector<Vertex>& vertices, ImportedModel& model)
+{
+    for (u32 bone_index = 0; bone_index < mesh->mNumBones; ++bone_index)
+    {
+        aiBone const* assimp_bone = mesh->mBones[bone_index];
+
+        auto const [it, is_new] = model.bone_ids.try_emplace(assimp_bone->mName.C_Str(), static_cast<u32>(model.bones.size()));
+        u32 const bone_id = it->second;
+
+        if (is_new)
+        {
+            // Assimp matrices are row-major.
+            CookedModel::Bone bone = {};
+            bone.name = assimp_bone->mName.C_Str();
+            bone.offset = glm::transpose(glm::make_mat4(&assimp_bone->mOffsetMatrix.a1));
+            bone.bounds_min = glm::vec3(FLT_MAX);
+            bone.bounds_max = glm::vec3(-FLT_MAX);
+            model.bones.emplace_back(bone);
+        }
+
+        CookedModel::Bone& bone = model.bones[bone_id];
+
+        for (u32 weight_index = 0; weight_index < assimp_bone->mNumWeights; ++weight_index)
+        {
+            aiVertexWeight const& vertex_weight = assimp_bone->mWeights[weight_index];
+            Vertex& vertex = vertices[vertex_weight.mVertexId];
+
+            // First free influence, more than four are dropped.
+            for (u32 i = 0; i < 4; ++i)
+            {
+                if (vertex.skin_indices[i] < 0 || vertex.skin_weights[i] < 0.000001f)
+                {
+                    vertex.skin_indices[i] = static_cast<i32>(bone_id);
+                    vertex.skin_weights[i] = vertex_weight.mWeight;
+                    break;
+                }
+            }
+
+            if (vertex_weight.mWeight > 0.0f)
+            {
+                bone.bounds_min = glm::min(bone.bounds_min, vertex.position);
+                bone.bounds_max = glm::max(bone.bounds_max, vertex.position);
+            }
+        }
+    }
+}
+
+void MeshCooker::add_textures(aiMaterial const* material, aiTextureType const type, TextureType const texture_type,
+                              ImportedModel& model)
+{
+    u32 const texture_count = material->GetTextureCount(type);
+    for (u32 i = 0; i < texture_count; ++i)
+    {
+        aiString path;
+        material->GetTexture(type, i, &path);
+
+        model.textures.push_back({texture_type, path.C_Str()});
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <array>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <assimp/material.h>
+
+#include "AK/Types.h"
+#include "CookedModel.h"
+
+struct aiMaterial;
+struct aiMesh;
+struct aiNode;
+struct aiScene;
+
+// Offline conversion of source models into CookedModel files. Doesn't touch the renderer, so it also runs
+// from tools/MeshCooker on machines without a GPU.
+class MeshCooker
+{
+public:
+    MeshCooker() = delete;
+
+    static bool cook(std::string const& model_path, std::string const& cooked_path);
+
+    // Cooks every model found under directory and optionally verifies it, returns false if any of them failed.
+    // Prints the vertex cache efficiency (ACMR) of every model before and after optimization, and the triangles of every LOD.
+    static bool cook_directory(std::string const& directory, bool const verify);
+
+    // Loads cooked_path back and compares it against a fresh import of model_path.
+    static bool verify_model(std::string const& model_path, std::string const& cooked_path);
+
+private:
+    struct ImportedModel
+    {
+        std::vector<CookedModel::Submesh> submeshes = {};
+        std::vector<CookedModel::TextureReference> textures = {};
+        std::vector<StaticVertex> vertices = {};
+        std::vector<SkinVertex> skin_vertices = {};
+        std::vector<u32> indices = {};
+        std::vector<MeshLod> lods = {};
+        std::vector<CookedModel::Bone> bones = {};
+
+        // Bone IDs by name. A bone gets the next free ID the first time a mesh references it, like in SkinnedModel.
+        std::map<std::string, u32> bone_ids = {};
+
+        // Triangles of each level of detail, summed over the submeshes.
+        std::array<u32, max_mesh_lod_count> lod_triangle_counts = {};
+
+        // Triangle weighted sums of every submesh's ACMR before and after MeshOptimizer.
+        u32 triangle_count = 0;
+        float acmr_before = 0.0f;
+        float acmr_after = 0.0f;
+    };
+
+    static bool import_model(std::string const& model_path, ImportedModel& model);
+    static bool write_cooked_model(std::string const& model_path, ImportedModel const& model, std::string const& cooked_path);
+    static void process_node(aiNode const* node, aiScene const* scene, ImportedModel& model);
+    static void process_mesh(aiMesh const* mesh, aiScene const* scene, ImportedModel& model);
+    static void add_bone_weights(aiMesh const* mesh, std::vector<Vertex>& vertices, ImportedModel& model);
+    static void add_textures(aiMaterial const* material, aiTextureType const type, TextureType const texture_type,
+                             ImportedModel& model);
+};
@@ -7,10 +7,13 @@
 #include <TextureLoader.h>
 #include <TextureLoaderDX11.h>
 
-MeshDX11::MeshDX11(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
-                   std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
-                   std::shared_ptr<Material> const& material, DrawFunctionType const draw_function)
-    : Mesh(vertices, indices, textures, draw_type, material, draw_function)
+MeshDX11::MeshDX11(AK::Badge<MeshFactory>, std::span<StaticVertex const> const vertices,
+                   std::span<SkinVertex const> const skin_vertices, std::span<u32 const> const indices,
+                   std::span<MeshLod const> const lods, std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
+                   std::shared_ptr<Material> const& material, DrawFunctionType const draw_function, BoundingBox const& local_bounds)
+    : Mesh(static_cast<u32>(vertices.size()), static_cast<u32>(indices.size()), lods,
+           skin_vertices.empty() ? VertexLayout::Static : VertexLayout::Skinned, textures, draw_type, material, draw_function,
+           local_bounds)
 {
     switch (draw_type)
     {
@@ -45,29 +48,34 @@ MeshDX11::MeshDX11(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices,
 
     ID3D11Device* device = RendererDX11::get_instance_dx11()->get_device();
 
-    m_vertex_buffer = std::make_shared<VertexBufferDX11>(device, vertices.data(), vertices.size());
-    m_index_buffer = std::make_shared<IndexBufferDX11>(device, indices.data(), indices.size());
+    m_vertex_buffer = std::make_shared<VertexBufferDX11>(device, vertices.data(), m_vertex_count, sizeof(StaticVertex));
+
+    if (m_vertex_layout == VertexLayout::Skinned)
+        m_skin_buffer = std::make_shared<VertexBufferDX11>(device, skin_vertices.data(), m_vertex_count, sizeof(SkinVertex));
+
+    m_index_buffer = std::make_shared<IndexBufferDX11>(device, indices.data(), m_index_count);
 }
 
 MeshDX11::MeshDX11(MeshDX11&& mesh) noexcept
-    : Mesh(mesh.m_vertices, mesh.m_indices, mesh.m_textures, mesh.m_draw_type, mesh.material, mesh.m_draw_function)
+    : Mesh(mesh.m_vertex_count, mesh.m_index_count, mesh.m_lods, mesh.m_vertex_layout, mesh.m_textures, mesh.m_draw_type,
+           mesh.material, mesh.m_draw_function, mesh.m_local_bounds)
 {
     m_vertex_buffer = mesh.m_vertex_buffer;
     mesh.m_vertex_buffer = nullptr;
 
+    m_skin_buffer = mesh.m_skin_buffer;
+    mesh.m_skin_buffer = nullptr;
+
     m_index_buffer = mesh.m_index_buffer;
     mesh.m_index_buffer = nullptr;
 
-    mesh.m_vertices.clear();
-    mesh.m_indices.clear();
+    mesh.m_vertex_count = 0;
+    mesh.m_index_count = 0;
     mesh.m_textures.clear();
 }
 
 MeshDX11::~MeshDX11()
 {
-    m_vertices.clear();
-    m_indices.clear();
-
     // FIXME: Managing lifetime of models and textures should be handled in ResourceManager
     for (auto const& texture : m_textures)
     {
@@ -91,16 +99,21 @@ MeshDX11::~MeshDX11()
 }
 
 void MeshDX11::draw() const
+{
+    draw_lod(0);
+}
+
+void MeshDX11::draw_lod(u32 const lod) const
 {
     bind_textures();
 
-    auto const device_context = RendererDX11::get_instance_dx11()->get_device_context();
+    auto const renderer = RendererDX11::get_instance_dx11();
+    auto const device_context = renderer->get_device_context();
 
-    u32 constexpr offset = 0;
     device_context->IASetPrimitiveTopology(m_primitive_topology);
-    device_context->IASetVertexBuffers(0, 1, m_vertex_buffer->get_address_of(), m_vertex_buffer->stride_ptr(), &offset);
+    renderer->set_vertex_buffers(*m_vertex_buffer, m_skin_buffer.get());
     device_context->IASetIndexBuffer(m_index_buffer->get(), DXGI_FORMAT_R32_UINT, 0);
-    device_context->DrawIndexed(m_index_buffer->buffer_size(), 0, 0);
+    device_context->DrawIndexed(m_lods[lod].index_count, m_lods[lod].first_index, 0);
 
     unbind_textures();
 }
@@ -10,14 +10,16 @@ class MeshFactory;
 class MeshDX11 final : public Mesh
 {
 public:
-    MeshDX11(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
+    MeshDX11(AK::Badge<MeshFactory>, std::span<StaticVertex const> const vertices, std::span<SkinVertex const> const skin_vertices,
+             std::span<u32 const> const indices, std::span<MeshLod const> const lods,
              std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type, std::shared_ptr<Material> const& material,
-             DrawFunctionType const draw_function);
+             DrawFunctionType const draw_function, BoundingBox const& local_bounds);
 
     MeshDX11(MeshDX11&& mesh) noexcept;
     ~MeshDX11() override;
 
     void virtual draw() const override;
+    void virtual draw_lod(u32 const lod) const override;
     void virtual draw(u32 const size, void const* offset) const override;
     void virtual draw_instanced(i32 const size) const override;
 
@@ -26,6 +28,7 @@ public:
 
 private:
     std::shared_ptr<VertexBufferDX11> m_vertex_buffer;
+    std::shared_ptr<VertexBufferDX11> m_skin_buffer;
     std::shared_ptr<IndexBufferDX11> m_index_buffer;
 
     D3D_PRIMITIVE_TOPOLOGY m_primitive_topology = D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST;
@@ -4,21 +4,25 @@
 #include "MeshGL.h"
 #include "Renderer.h"
 
-std::shared_ptr<Mesh> MeshFactory::create(std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
-                                          std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
-                                          std::shared_ptr<Material> const& material, DrawFunctionType const draw_function)
+std::shared_ptr<Mesh> MeshFactory::create(std::span<StaticVertex const> const vertices,
+                                          std::span<SkinVertex const> const skin_vertices, std::span<u32 const> const indices,
+                                          std::span<MeshLod const> const lods, std::vector<std::shared_ptr<Texture>> const& textures,
+                                          DrawType const draw_type, std::shared_ptr<Material> const& material,
+                                          DrawFunctionType const draw_function, BoundingBox const& local_bounds)
 {
     switch (Renderer::renderer_api)
     {
     case Renderer::RendererApi::OpenGL:
     {
-        auto mesh = std::make_shared<MeshGL>(AK::Badge<MeshFactory> {}, vertices, indices, textures, draw_type, material, draw_function);
+        auto mesh = std::make_shared<MeshGL>(AK::Badge<MeshFactory> {}, vertices, skin_vertices, indices, lods, textures, draw_type,
+                                             material, draw_function, local_bounds);
         return mesh;
     }
 
     case Renderer::RendererApi::DirectX11:
     {
-        auto mesh = std::make_shared<MeshDX11>(AK::Badge<MeshFactory> {}, vertices, indices, textures, draw_type, material, draw_function);
+        auto mesh = std::make_shared<MeshDX11>(AK::Badge<MeshFactory> {}, vertices, skin_vertices, indices, lods, textures, draw_type,
+                                               material, draw_function, local_bounds);
         return mesh;
     }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <span>
 
 #include "AK/Types.h"
 #include "DrawType.h"
@@ -17,8 +18,11 @@ public:
     friend class ResourceManager;
 
 private:
-    static std::shared_ptr<Mesh> create(std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
+    // Vertices and indices are only read during the call, so they can point straight into a mapped file.
+    // Skin vertices are empty for static meshes. Every level of detail is a range of indices.
+    static std::shared_ptr<Mesh> create(std::span<StaticVertex const> const vertices, std::span<SkinVertex const> const skin_vertices,
+                                        std::span<u32 const> const indices, std::span<MeshLod const> const lods,
                                         std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
-                                        std::shared_ptr<Material> const& material,
-                                        DrawFunctionType const draw_function = DrawFunctionType::Indexed);
+                                        std::shared_ptr<Material> const& material, DrawFunctionType const draw_function,
+                                        BoundingBox const& local_bounds);
 };
@@ -6,10 +6,13 @@
 #include "Globals.h"
 #include "Texture.h"
 
-MeshGL::MeshGL(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
+MeshGL::MeshGL(AK::Badge<MeshFactory>, std::span<StaticVertex const> const vertices, std::span<SkinVertex const> const skin_vertices,
+               std::span<u32 const> const indices, std::span<MeshLod const> const lods,
                std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type, std::shared_ptr<Material> const& material,
-               DrawFunctionType const draw_function)
-    : Mesh(vertices, indices, textures, draw_type, material, draw_function)
+               DrawFunctionType const draw_function, BoundingBox const& local_bounds)
+    : Mesh(static_cast<u32>(vertices.size()), static_cast<u32>(indices.size()), lods,
+           skin_vertices.empty() ? VertexLayout::Static : VertexLayout::Skinned, textures, draw_type, material, draw_function,
+           local_bounds)
 {
     switch (draw_type)
     {
@@ -48,24 +51,39 @@ MeshGL::MeshGL(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std:
     glBindVertexArray(m_VAO);
 
     glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size_bytes(), vertices.data(), GL_STATIC_DRAW);
 
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(u32), indices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size_bytes(), indices.data(), GL_STATIC_DRAW);
 
     // FIXME: Not all shaders have all these attributes
 
     // Vertex positions
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(StaticVertex), (void*)0);
 
-    // Vertex normals
+    // Vertex normals, octahedral encoded
     glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+    glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(StaticVertex), (void*)offsetof(StaticVertex, normal));
 
     // Vertex texture coordinates
     glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texture_coordinates));
+    glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(StaticVertex), (void*)offsetof(StaticVertex, texture_coordinates));
+
+    if (m_vertex_layout == VertexLayout::Skinned)
+    {
+        glGenBuffers(1, &m_skin_VBO);
+        glBindBuffer(GL_ARRAY_BUFFER, m_skin_VBO);
+        glBufferData(GL_ARRAY_BUFFER, skin_vertices.size_bytes(), skin_vertices.data(), GL_STATIC_DRAW);
+
+        // Skin indices
+        glEnableVertexAttribArray(3);
+        glVertexAttribIPointer(3, 4, GL_UNSIGNED_BYTE, sizeof(SkinVertex), (void*)offsetof(SkinVertex, skin_indices));
+
+        // Skin weights
+        glEnableVertexAttribArray(4);
+        glVertexAttribPointer(4, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SkinVertex), (void*)offsetof(SkinVertex, skin_weights));
+    }
 
     if (draw_type == DrawType::Patches)
     {
@@ -78,18 +96,21 @@ MeshGL::MeshGL(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std:
 }
 
 MeshGL::MeshGL(MeshGL&& mesh) noexcept
-    : Mesh(mesh.m_vertices, mesh.m_indices, mesh.m_textures, mesh.m_draw_type, mesh.material, mesh.m_draw_function)
+    : Mesh(mesh.m_vertex_count, mesh.m_index_count, mesh.m_lods, mesh.m_vertex_layout, mesh.m_textures, mesh.m_draw_type,
+           mesh.material, mesh.m_draw_function, mesh.m_local_bounds)
 {
     m_VAO = mesh.m_VAO;
     m_VBO = mesh.m_VBO;
+    m_skin_VBO = mesh.m_skin_VBO;
     m_EBO = mesh.m_EBO;
 
     mesh.m_VAO = 0;
     mesh.m_VBO = 0;
+    mesh.m_skin_VBO = 0;
     mesh.m_EBO = 0;
 
-    mesh.m_vertices.clear();
-    mesh.m_indices.clear();
+    mesh.m_vertex_count = 0;
+    mesh.m_index_count = 0;
     mesh.m_textures.clear();
 }
 
@@ -100,16 +121,20 @@ MeshGL::~MeshGL()
         glDeleteTextures(1, &texture->id);
     }
 
-    m_vertices.clear();
-    m_indices.clear();
     m_textures.clear();
 
     glDeleteBuffers(1, &m_EBO);
+    glDeleteBuffers(1, &m_skin_VBO);
     glDeleteBuffers(1, &m_VBO);
     glDeleteVertexArrays(1, &m_VAO);
 }
 
 void MeshGL::draw() const
+{
+    draw_lod(0);
+}
+
+void MeshGL::draw_lod(u32 const lod) const
 {
     bind_textures();
 
@@ -117,9 +142,10 @@ void MeshGL::draw() const
     glBindVertexArray(m_VAO);
 
     if (m_draw_function == DrawFunctionType::NotIndexed)
-        glDrawArrays(m_draw_typeGL, 0, static_cast<i32>(m_vertices.size()));
+        glDrawArrays(m_draw_typeGL, 0, static_cast<i32>(m_vertex_count));
     else
-        glDrawElements(m_draw_typeGL, static_cast<i32>(m_indices.size()), GL_UNSIGNED_INT, 0);
+        glDrawElements(m_draw_typeGL, static_cast<i32>(m_lods[lod].index_count), GL_UNSIGNED_INT,
+                       (void*)(sizeof(u32) * m_lods[lod].first_index));
 
     glBindVertexArray(0);
 
@@ -152,7 +178,7 @@ void MeshGL::draw_instanced(i32 const size) const
     bind_textures();
 
     glBindVertexArray(m_VAO);
-    glDrawElementsInstanced(GL_TRIANGLES, m_indices.size(), GL_UNSIGNED_INT, (void*)0, size);
+    glDrawElementsInstanced(GL_TRIANGLES, m_lods[0].index_count, GL_UNSIGNED_INT, (void*)0, size);
 
     unbind_textures();
 }
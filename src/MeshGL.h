@@ -7,14 +7,16 @@ class MeshFactory;
 class MeshGL final : public Mesh
 {
 public:
-    MeshGL(AK::Badge<MeshFactory>, std::vector<Vertex> const& vertices, std::vector<u32> const& indices,
+    MeshGL(AK::Badge<MeshFactory>, std::span<StaticVertex const> const vertices, std::span<SkinVertex const> const skin_vertices,
+           std::span<u32 const> const indices, std::span<MeshLod const> const lods,
            std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type, std::shared_ptr<Material> const& material,
-           DrawFunctionType const draw_function);
+           DrawFunctionType const draw_function, BoundingBox const& local_bounds);
 
     MeshGL(MeshGL&& mesh) noexcept;
     ~MeshGL() override;
 
     virtual void draw() const override;
+    virtual void draw_lod(u32 const lod) const override;
     virtual void draw(u32 const size, void const* offset) const override;
     virtual void draw_instanced(i32 const size) const override;
 
@@ -25,4 +27,5 @@ private:
     u32 m_draw_typeGL = 0;
 
     u32 m_VAO = 0, m_VBO = 0, m_EBO = 0;
+    u32 m_skin_VBO = 0;
 };
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "AK/Types.h"
+
+// One level of detail of a mesh, a range of its index buffer. All levels share the vertex buffer.
+struct MeshLod
+{
+    u32 first_index = 0;
+    u32 index_count = 0;
+
+    // Largest distance between the simplified and the original surface, relative to the mesh's bounding radius.
+    float error = 0.0f;
+};
+
+// Including the full detail one.
+u32 constexpr max_mesh_lod_count = 4;
+
+struct MeshLodSettings
+{
+    // A level is used while its error covers at most this many pixels on screen.
+    float max_screen_error = 1.0f;
+
+    // Fraction the projected error has to move past max_screen_error before the level changes, so meshes don't flicker
+    // between two levels at a fixed distance.
+    float hysteresis = 0.2f;
+};
@@ -0,0 +1,368 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+#include <glm/geometric.hpp>
+
+namespace
+{
+
+// Scores are tuned for a bigger cache than the hardware has, see https://tomforsyth1000.github.io/papers/fast_vert_cache_opt.html
+u32 constexpr forsyth_cache_size = 32;
+
+// Cache used to find the cluster boundaries for overdraw ordering, close to what GPUs actually have.
+u32 constexpr overdraw_cache_size = 16;
+
+float calculate_vertex_score(i32 const cache_position, u32 const remaining_triangles)
+{
+    if (remaining_triangles == 0)
+        return -1.0f;
+
+    float score = 0.0f;
+
+    if (cache_position >= 0)
+    {
+        // The last triangle's vertices get a fixed score, so the next one doesn't just reuse the same edge.
+        if (cache_position < 3)
+            score = 0.75f;
+        else
+            score = std::pow(1.0f - static_cast<float>(cache_position - 3) / (forsyth_cache_size - 3), 1.5f);
+    }
+
+    // Prefer vertices with few triangles left, so they leave the cache for good.
+    return score + 2.0f / std::sqrt(static_cast<float>(remaining_triangles));
+}
+
+}
+
+void MeshOptimizer::optimize(std::vector<Vertex>& vertices, std::span<u32> const indices, bool const reorder_for_overdraw)
+{
+    if (!is_triangle_list(indices, static_cast<u32>(vertices.size())))
+        return;
+
+    optimize_vertex_cache(indices, static_cast<u32>(vertices.size()));
+
+    if (reorder_for_overdraw)
+        optimize_overdraw(indices, vertices);
+
+    optimize_vertex_fetch(indices, vertices);
+}
+
+void MeshOptimizer::optimize_vertex_cache(std::span<u32> const indices, u32 const vertex_count)
+{
+    if (!is_triangle_list(indices, vertex_count))
+        return;
+
+    u32 const triangle_count = static_cast<u32>(indices.size() / 3);
+
+    // Triangles of each vertex, the ones that were already emitted are moved past remaining_triangles.
+    std::vector<u32> triangle_offsets(vertex_count + 1, 0);
+    for (u32 const index : indices)
+    {
+        ++triangle_offsets[index + 1];
+    }
+
+    for (u32 i = 0; i < vertex_count; ++i)
+    {
+        triangle_offsets[i + 1] += triangle_offsets[i];
+    }
+
+    std::vector<u32> vertex_triangles(indices.size());
+    std::vector<u32> remaining_triangles(vertex_count, 0);
+
+    for (u32 i = 0; i < indices.size(); ++i)
+    {
+        u32 const index = indices[i];
+        vertex_triangles[triangle_offsets[index] + remaining_triangles[index]] = i / 3;
+        ++remaining_triangles[index];
+    }
+
+    std::vector<i32> cache_positions(vertex_count, -1);
+    std::vector<float> vertex_scores(vertex_count);
+
+    for (u32 i = 0; i < vertex_count; ++i)
+    {
+        vertex_scores[i] = calculate_vertex_score(-1, remaining_triangles[i]);
+    }
+
+    auto const calculate_triangle_score = [&](u32 const triangle) {
+        return vertex_scores[indices[triangle * 3]] + vertex_scores[indices[triangle * 3 + 1]] + vertex_scores[indices[triangle * 3 + 2]];
+    };
+
+    i32 best_triangle = 0;
+    float best_score = calculate_triangle_score(0);
+
+    for (u32 i = 1; i < triangle_count; ++i)
+    {
+        float const score = calculate_triangle_score(i);
+        if (score > best_score)
+        {
+            best_score = score;
+            best_triangle = static_cast<i32>(i);
+        }
+    }
+
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<u32> optimized_indices = {};
+    optimized_indices.reserve(indices.size());
+
+    std::vector<u32> cache = {};
+    std::vector<u32> new_cache = {};
+    cache.reserve(forsyth_cache_size + 3);
+    new_cache.reserve(forsyth_cache_size + 3);
+
+    u32 next_unemitted = 0;
+
+    for (u32 emitted_count = 0; emitted_count < triangle_count; ++emitted_count)
+    {
+        // Nothing in the cache has triangles left, continue with any triangle that wasn't emitted yet.
+        if (best_triangle < 0)
+        {
+            while (emitted[next_unemitted])
+                ++next_unemitted;
+
+            best_triangle = static_cast<i32>(next_unemitted);
+        }
+
+        u32 const triangle = static_cast<u32>(best_triangle);
+        emitted[triangle] = true;
+
+        new_cache.clear();
+
+        for (u32 i = 0; i < 3; ++i)
+        {
+            u32 const index = indices[triangle * 3 + i];
+            optimized_indices.emplace_back(index);
+
+            u32* triangles_begin = vertex_triangles.data() + triangle_offsets[index];
+            u32* triangles_end = triangles_begin + remaining_triangles[index];
+            std::iter_swap(std::find(triangles_begin, triangles_end, triangle), triangles_end - 1);
+            --remaining_triangles[index];
+
+            if (std::ranges::find(new_cache, index) == new_cache.end())
+                new_cache.emplace_back(index);
+        }
+
+        for (u32 const index : cache)
+        {
+            if (std::ranges::find(new_cache, index) == new_cache.end())
+                new_cache.emplace_back(index);
+        }
+
+        // Vertices pushed out of the cache lose their cache score.
+        for (u32 i = forsyth_cache_size; i < new_cache.size(); ++i)
+        {
+            cache_positions[new_cache[i]] = -1;
+            vertex_scores[new_cache[i]] = calculate_vertex_score(-1, remaining_triangles[new_cache[i]]);
+        }
+
+        new_cache.resize(std::min(static_cast<u32>(new_cache.size()), forsyth_cache_size));
+        std::swap(cache, new_cache);
+
+        for (u32 i = 0; i < cache.size(); ++i)
+        {
+            cache_positions[cache[i]] = static_cast<i32>(i);
+            vertex_scores[cache[i]] = calculate_vertex_score(static_cast<i32>(i), remaining_triangles[cache[i]]);
+        }
+
+        // Only triangles touching the cache changed their score, the next one is picked from them.
+        best_triangle = -1;
+        best_score = -1.0f;
+
+        for (u32 const index : cache)
+        {
+            for (u32 i = 0; i < remaining_triangles[index]; ++i)
+            {
+                u32 const candidate = vertex_triangles[triangle_offsets[index] + i];
+                float const score = calculate_triangle_score(candidate);
+
+                if (score > best_score)
+                {
+                    best_score = score;
+                    best_triangle = static_cast<i32>(candidate);
+                }
+            }
+        }
+    }
+
+    std::ranges::copy(optimized_indices, indices.begin());
+}
+
+void MeshOptimizer::optimize_overdraw(std::span<u32> const indices, std::span<Vertex const> const vertices, float const threshold)
+{
+    if (!is_triangle_list(indices, static_cast<u32>(vertices.size())))
+        return;
+
+    u32 const triangle_count = static_cast<u32>(indices.size() / 3);
+    float const original_acmr = calculate_acmr(indices, static_cast<u32>(vertices.size()), overdraw_cache_size);
+
+    // A triangle that misses the cache with all of its vertices starts a new cluster. Moving whole clusters around
+    // keeps most of the cache locality that optimize_vertex_cache() created.
+    std::vector<u32> cluster_starts = {};
+    std::vector<u32> timestamps(vertices.size(), 0);
+    u32 time = overdraw_cache_size + 1;
+
+    for (u32 i = 0; i < triangle_count; ++i)
+    {
+        u32 misses = 0;
+        for (u32 j = 0; j < 3; ++j)
+        {
+            u32 const index = indices[i * 3 + j];
+            if (time - timestamps[index] > overdraw_cache_size)
+            {
+                timestamps[index] = time++;
+                ++misses;
+            }
+        }
+
+        if (i == 0 || misses == 3)
+            cluster_starts.emplace_back(i);
+    }
+
+    if (cluster_starts.size() < 2)
+        return;
+
+    cluster_starts.emplace_back(triangle_count);
+
+    struct Cluster
+    {
+        u32 first_triangle = 0;
+        u32 triangle_count = 0;
+        float sort_key = 0.0f;
+    };
+
+    glm::vec3 mesh_center = {};
+    float mesh_area = 0.0f;
+
+    std::vector<Cluster> clusters(cluster_starts.size() - 1);
+    std::vector<glm::vec3> cluster_centers(clusters.size());
+    std::vector<glm::vec3> cluster_normals(clusters.size());
+
+    for (u32 i = 0; i < clusters.size(); ++i)
+    {
+        clusters[i].first_triangle = cluster_starts[i];
+        clusters[i].triangle_count = cluster_starts[i + 1] - cluster_starts[i];
+
+        glm::vec3 center = {};
+        glm::vec3 normal = {};
+        float area = 0.0f;
+
+        for (u32 triangle = cluster_starts[i]; triangle < cluster_starts[i + 1]; ++triangle)
+        {
+            glm::vec3 const a = vertices[indices[triangle * 3]].position;
+            glm::vec3 const b = vertices[indices[triangle * 3 + 1]].position;
+            glm::vec3 const c = vertices[indices[triangle * 3 + 2]].position;
+
+            // Length of the cross product is twice the area, both only weigh triangles against each other.
+            glm::vec3 const cross = glm::cross(b - a, c - a);
+            float const triangle_area = glm::length(cross);
+
+            center += (a + b + c) / 3.0f * triangle_area;
+            normal += cross;
+            area += triangle_area;
+        }
+
+        mesh_center += center;
+        mesh_area += area;
+
+        cluster_centers[i] = area > 0.0f ? center / area : center;
+        cluster_normals[i] = glm::length(normal) > 0.0f ? glm::normalize(normal) : normal;
+    }
+
+    if (mesh_area > 0.0f)
+        mesh_center /= mesh_area;
+
+    // Clusters that face away from the center are more likely to be in front of the rest, draw them first.
+    for (u32 i = 0; i < clusters.size(); ++i)
+    {
+        clusters[i].sort_key = glm::dot(cluster_centers[i] - mesh_center, cluster_normals[i]);
+    }
+
+    std::ranges::stable_sort(clusters, [](Cluster const& lhs, Cluster const& rhs) { return lhs.sort_key > rhs.sort_key; });
+
+    std::vector<u32> sorted_indices = {};
+    sorted_indices.reserve(indices.size());
+
+    for (auto const& cluster : clusters)
+    {
+        auto const begin = indices.begin() + cluster.first_triangle * 3;
+        sorted_indices.insert(sorted_indices.end(), begin, begin + cluster.triangle_count * 3);
+    }
+
+    if (calculate_acmr(sorted_indices, static_cast<u32>(vertices.size()), overdraw_cache_size) > original_acmr * threshold)
+        return;
+
+    std::ranges::copy(sorted_indices, indices.begin());
+}
+
+float MeshOptimizer::calculate_acmr(std::span<u32 const> const indices, u32 const vertex_count, u32 const cache_size)
+{
+    if (indices.size() < 3)
+        return 0.0f;
+
+    // A vertex is in the FIFO cache if it was one of the last cache_size vertices that missed it.
+    std::vector<u32> timestamps(vertex_count, 0);
+    u32 time = cache_size + 1;
+    u32 misses = 0;
+
+    for (u32 const index : indices)
+    {
+        if (index >= vertex_count)
+            continue;
+
+        if (time - timestamps[index] > cache_size)
+        {
+            timestamps[index] = time++;
+            ++misses;
+        }
+    }
+
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+bool MeshOptimizer::is_triangle_list(std::span<u32 const> const indices, u32 const vertex_count)
+{
+    if (indices.empty() || indices.size() % 3 != 0)
+        return false;
+
+    if (std::ranges::any_of(indices, [vertex_count](u32 const index) { return index >= vertex_count; }))
+    {
+        std::cout << "Error. Mesh has indices past its vertices, it won't be optimized."
+                  << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+std::vector<u32> MeshOptimizer::remap_for_vertex_fetch(std::span<u32> const indices, u32 const vertex_count)
+{
+    u32 constexpr unused = std::numeric_limits<u32>::max();
+
+    std::vector<u32> new_indices(vertex_count, unused);
+    std::vector<u32> fetch_order = {};
+    fetch_order.reserve(vertex_count);
+
+    for (u32& index : indices)
+    {
+        if (new_indices[index] == unused)
+        {
+            new_indices[index] = static_cast<u32>(fetch_order.size());
+            fetch_order.emplace_back(index);
+        }
+
+        index = new_indices[index];
+    }
+
+    // Unreferenced vertices are kept at the end, so vertex counts and bounds don't change.
+    for (u32 i = 0; i < vertex_count; ++i)
+    {
+        if (new_indices[i] == unused)
+            fetch_order.emplace_back(i);
+    }
+
+    return fetch_order;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "AK/Types.h"
+#include "Vertex.h"
+
+// Reorders indexed triangle lists for the GPU: triangles for the post-transform vertex cache (Forsyth),
+// clusters of them for less overdraw, and vertices in the order they are first fetched.
+// The mesh stays the same, only the order of its triangles and vertices changes.
+class MeshOptimizer
+{
+public:
+    MeshOptimizer() = delete;
+
+    // Runs every stage in the right order. Does nothing if the indices aren't a valid triangle list.
+    static void optimize(std::vector<Vertex>& vertices, std::span<u32> const indices, bool const reorder_for_overdraw);
+
+    static void optimize_vertex_cache(std::span<u32> const indices, u32 const vertex_count);
+
+    // Expects indices that were already optimized for the vertex cache. Sorts the clusters of triangles between cache flushes so
+    // that the ones facing away from the center come first. The new order is dropped if it raises ACMR above threshold times the old one.
+    static void optimize_overdraw(std::span<u32> const indices, std::span<Vertex const> const vertices, float const threshold = 1.05f);
+
+    template<typename T>
+    static void optimize_vertex_fetch(std::span<u32> const indices, std::vector<T>& vertices)
+    {
+        std::vector<u32> const fetch_order = remap_for_vertex_fetch(indices, static_cast<u32>(vertices.size()));
+
+        std::vector<T> reordered_vertices = {};
+        reordered_vertices.reserve(vertices.size());
+
+        for (u32 const old_index : fetch_order)
+        {
+            reordered_vertices.emplace_back(vertices[old_index]);
+        }
+
+        vertices = std::move(reordered_vertices);
+    }
+
+    // Average cache miss ratio, vertex shader invocations per triangle of a FIFO cache. 3.0 is the worst, 0.5 the best for big grids.
+    [[nodiscard]] static float calculate_acmr(std::span<u32 const> const indices, u32 const vertex_count, u32 const cache_size = 16);
+
+    [[nodiscard]] static bool is_triangle_list(std::span<u32 const> const indices, u32 const vertex_count);
+
+private:
+    // Rewrites indices to the new vertex order and returns the old index of every new vertex.
+    static std::vector<u32> remap_for_vertex_fetch(std::span<u32> const indices, u32 const vertex_count);
+};
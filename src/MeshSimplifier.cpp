@@ -0,0 +1,345 @@
+#include "MeshSimplifier.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <unordered_map>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+
+#include "MeshOptimizer.h"
+
+namespace
+{
+
+// Symmetric 4x4 matrix of the squared distances to a set of planes, weighted by triangle area.
+struct Quadric
+{
+    float a00 = 0.0f, a01 = 0.0f, a02 = 0.0f, a11 = 0.0f, a12 = 0.0f, a22 = 0.0f;
+    float b0 = 0.0f, b1 = 0.0f, b2 = 0.0f;
+    float c = 0.0f;
+    float weight = 0.0f;
+
+    static Quadric from_plane(glm::vec3 const& normal, float const distance, float const weight)
+    {
+        Quadric quadric = {};
+        quadric.a00 = weight * normal.x * normal.x;
+        quadric.a01 = weight * normal.x * normal.y;
+        quadric.a02 = weight * normal.x * normal.z;
+        quadric.a11 = weight * normal.y * normal.y;
+        quadric.a12 = weight * normal.y * normal.z;
+        quadric.a22 = weight * normal.z * normal.z;
+        quadric.b0 = weight * normal.x * distance;
+        quadric.b1 = weight * normal.y * distance;
+        quadric.b2 = weight * normal.z * distance;
+        quadric.c = weight * distance * distance;
+        quadric.weight = weight;
+        return quadric;
+    }
+
+    Quadric& operator+=(Quadric const& other)
+    {
+        a00 += other.a00;
+        a01 += other.a01;
+        a02 += other.a02;
+        a11 += other.a11;
+        a12 += other.a12;
+        a22 += other.a22;
+        b0 += other.b0;
+        b1 += other.b1;
+        b2 += other.b2;
+        c += other.c;
+        weight += other.weight;
+        return *this;
+    }
+
+    // Weighted mean of the squared distances from p to the planes.
+    [[nodiscard]] float evaluate(glm::vec3 const& p) const
+    {
+        float const result = a00 * p.x * p.x + a11 * p.y * p.y + a22 * p.z * p.z
+                           + 2.0f * (a01 * p.x * p.y + a02 * p.x * p.z + a12 * p.y * p.z) + 2.0f * (b0 * p.x + b1 * p.y + b2 * p.z) + c;
+
+        return weight > 0.0f ? glm::max(result, 0.0f) / weight : 0.0f;
+    }
+};
+
+struct Collapse
+{
+    u32 from = 0;
+    u32 to = 0;
+    float cost = 0.0f;
+};
+
+u64 get_edge_key(u32 const a, u32 const b)
+{
+    return (static_cast<u64>(glm::min(a, b)) << 32) | glm::max(a, b);
+}
+
+bool is_degenerate(u32 const* triangle)
+{
+    return triangle[0] == triangle[1] || triangle[1] == triangle[2] || triangle[0] == triangle[2];
+}
+
+}
+
+std::vector<u32> MeshSimplifier::simplify(std::span<Vertex const> const vertices, std::span<u32 const> const indices,
+                                          u32 const target_index_count, float const max_error, float& error)
+{
+    error = 0.0f;
+
+    std::vector<u32> result(indices.begin(), indices.end());
+
+    if (!MeshOptimizer::is_triangle_list(indices, static_cast<u32>(vertices.size())))
+        return result;
+
+    u32 const vertex_count = static_cast<u32>(vertices.size());
+
+    // Work in a unit sized space, so errors come out relative to the mesh size.
+    glm::vec3 bounds_min = vertices[indices[0]].position;
+    glm::vec3 bounds_max = bounds_min;
+
+    for (u32 const index : indices)
+    {
+        bounds_min = glm::min(bounds_min, vertices[index].position);
+        bounds_max = glm::max(bounds_max, vertices[index].position);
+    }
+
+    glm::vec3 const center = (bounds_min + bounds_max) * 0.5f;
+    float const radius = glm::max(glm::length(bounds_max - bounds_min) * 0.5f, 1e-6f);
+
+    std::vector<glm::vec3> positions(vertex_count);
+    for (u32 i = 0; i < vertex_count; ++i)
+    {
+        positions[i] = (vertices[i].position - center) / radius;
+    }
+
+    // Edges used by a single triangle lie on a border or a seam, edges used by more than two are non-manifold.
+    // Their vertices are locked in place.
+    std::unordered_map<u64, u32> edge_uses = {};
+    edge_uses.reserve(indices.size());
+
+    for (u32 i = 0; i < indices.size(); i += 3)
+    {
+        for (u32 j = 0; j < 3; ++j)
+        {
+            ++edge_uses[get_edge_key(indices[i + j], indices[i + (j + 1) % 3])];
+        }
+    }
+
+    std::vector<bool> locked(vertex_count, false);
+
+    for (u32 i = 0; i < indices.size(); i += 3)
+    {
+        for (u32 j = 0; j < 3; ++j)
+        {
+            u32 const a = indices[i + j];
+            u32 const b = indices[i + (j + 1) % 3];
+
+            if (edge_uses[get_edge_key(a, b)] != 2)
+            {
+                locked[a] = true;
+                locked[b] = true;
+            }
+        }
+    }
+
+    std::vector<Quadric> quadrics(vertex_count);
+
+    for (u32 i = 0; i < indices.size(); i += 3)
+    {
+        glm::vec3 const& p0 = positions[indices[i]];
+        glm::vec3 const& p1 = positions[indices[i + 1]];
+        glm::vec3 const& p2 = positions[indices[i + 2]];
+
+        glm::vec3 const cross = glm::cross(p1 - p0, p2 - p0);
+        float const length = glm::length(cross);
+
+        if (length <= 0.0f)
+            continue;
+
+        glm::vec3 const normal = cross / length;
+        Quadric const quadric = Quadric::from_plane(normal, -glm::dot(normal, p0), length * 0.5f);
+
+        quadrics[indices[i]] += quadric;
+        quadrics[indices[i + 1]] += quadric;
+        quadrics[indices[i + 2]] += quadric;
+    }
+
+    std::vector<u32> triangle_offsets(vertex_count + 1);
+    std::vector<u32> vertex_triangles = {};
+    std::vector<Collapse> collapses = {};
+    std::vector<bool> touched(vertex_count);
+
+    float const max_cost = max_error * max_error;
+
+    // Every pass collapses the cheapest edges whose neighborhoods don't overlap, then rebuilds the triangle list.
+    while (result.size() > target_index_count)
+    {
+        std::ranges::fill(triangle_offsets, 0);
+        for (u32 const index : result)
+        {
+            ++triangle_offsets[index + 1];
+        }
+
+        for (u32 i = 0; i < vertex_count; ++i)
+        {
+            triangle_offsets[i + 1] += triangle_offsets[i];
+        }
+
+        vertex_triangles.resize(result.size());
+        std::vector<u32> fill_offsets(triangle_offsets.begin(), triangle_offsets.end() - 1);
+
+        for (u32 i = 0; i < result.size(); ++i)
+        {
+            vertex_triangles[fill_offsets[result[i]]++] = i / 3;
+        }
+
+        collapses.clear();
+
+        for (u32 i = 0; i < result.size(); i += 3)
+        {
+            for (u32 j = 0; j < 3; ++j)
+            {
+                u32 const a = result[i + j];
+                u32 const b = result[i + (j + 1) % 3];
+
+                // Every inner edge is shared by two triangles, only look at it once. Degenerate edges can't collapse.
+                if (a >= b || (locked[a] && locked[b]))
+                    continue;
+
+                Quadric quadric = quadrics[a];
+                quadric += quadrics[b];
+
+                float const cost_to_b = locked[a] ? max_cost + 1.0f : quadric.evaluate(positions[b]);
+                float const cost_to_a = locked[b] ? max_cost + 1.0f : quadric.evaluate(positions[a]);
+
+                if (cost_to_b <= cost_to_a)
+                    collapses.push_back({a, b, cost_to_b});
+                else
+                    collapses.push_back({b, a, cost_to_a});
+            }
+        }
+
+        std::ranges::sort(collapses, [](Collapse const& lhs, Collapse const& rhs) { return lhs.cost < rhs.cost; });
+
+        // Interior collapses remove two triangles each.
+        u32 const triangles_to_remove = static_cast<u32>(result.size() - target_index_count) / 3;
+        u32 const collapse_goal = glm::max(triangles_to_remove / 2, 1u);
+        u32 collapse_count = 0;
+
+        std::fill(touched.begin(), touched.end(), false);
+
+        for (auto const& collapse : collapses)
+        {
+            if (collapse.cost > max_cost || collapse_count >= collapse_goal)
+                break;
+
+            if (touched[collapse.from] || touched[collapse.to])
+                continue;
+
+            // Moving the vertex must not flip any of the triangles that stay.
+            bool flips = false;
+            for (u32 i = triangle_offsets[collapse.from]; i < triangle_offsets[collapse.from + 1] && !flips; ++i)
+            {
+                u32 const* triangle = &result[vertex_triangles[i] * 3];
+
+                if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+                    continue;
+
+                std::array<glm::vec3, 3> before = {positions[triangle[0]], positions[triangle[1]], positions[triangle[2]]};
+                std::array<glm::vec3, 3> after = before;
+
+                for (u32 j = 0; j < 3; ++j)
+                {
+                    if (triangle[j] == collapse.from)
+                        after[j] = positions[collapse.to];
+                }
+
+                glm::vec3 const normal_before = glm::cross(before[1] - before[0], before[2] - before[0]);
+                glm::vec3 const normal_after = glm::cross(after[1] - after[0], after[2] - after[0]);
+
+                flips = glm::dot(normal_before, normal_after) <= 0.0f;
+            }
+
+            if (flips)
+                continue;
+
+            // The whole neighborhood changes, nothing else in it can collapse in this pass.
+            for (u32 i = triangle_offsets[collapse.from]; i < triangle_offsets[collapse.from + 1]; ++i)
+            {
+                u32 const* triangle = &result[vertex_triangles[i] * 3];
+                touched[triangle[0]] = true;
+                touched[triangle[1]] = true;
+                touched[triangle[2]] = true;
+            }
+
+            quadrics[collapse.to] += quadrics[collapse.from];
+
+            for (u32 i = triangle_offsets[collapse.from]; i < triangle_offsets[collapse.from + 1]; ++i)
+            {
+                u32* triangle = &result[vertex_triangles[i] * 3];
+
+                for (u32 j = 0; j < 3; ++j)
+                {
+                    if (triangle[j] == collapse.from)
+                        triangle[j] = collapse.to;
+                }
+            }
+
+            error = glm::max(error, std::sqrt(collapse.cost));
+            ++collapse_count;
+        }
+
+        if (collapse_count == 0)
+            break;
+
+        u32 write_offset = 0;
+        for (u32 i = 0; i < result.size(); i += 3)
+        {
+            if (is_degenerate(&result[i]))
+                continue;
+
+            std::copy_n(&result[i], 3, &result[write_offset]);
+            write_offset += 3;
+        }
+
+        result.resize(write_offset);
+    }
+
+    return result;
+}
+
+void MeshSimplifier::build_lods(std::span<Vertex const> const vertices, std::vector<u32>& indices, std::vector<MeshLod>& lods)
+{
+    lods.clear();
+    lods.push_back({0, static_cast<u32>(indices.size()), 0.0f});
+
+    if (!MeshOptimizer::is_triangle_list(indices, static_cast<u32>(vertices.size())))
+        return;
+
+    while (lods.size() < max_mesh_lod_count)
+    {
+        MeshLod const previous = lods.back();
+
+        float const remaining_error = max_lod_error - previous.error;
+
+        if (previous.index_count / 3 < min_lod_triangle_count || remaining_error <= 0.0f)
+            break;
+
+        std::span<u32 const> const source = std::span(indices).subspan(previous.first_index, previous.index_count);
+
+        float error = 0.0f;
+        u32 const target_index_count = previous.index_count / 6 * 3;
+        std::vector<u32> simplified = simplify(vertices, source, target_index_count, remaining_error, error);
+
+        // A level that barely drops any triangles costs memory without making anything faster.
+        if (simplified.empty() || simplified.size() > previous.index_count * 3 / 4)
+            break;
+
+        MeshOptimizer::optimize_vertex_cache(simplified, static_cast<u32>(vertices.size()));
+
+        lods.push_back({static_cast<u32>(indices.size()), static_cast<u32>(simplified.size()), previous.error + error});
+        indices.insert(indices.end(), simplified.begin(), simplified.end());
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "AK/Types.h"
+#include "MeshLod.h"
+#include "Vertex.h"
+
+// Quadric error edge collapse (Garland and Heckbert). Vertices are only ever collapsed onto a neighbor, so the
+// simplified indices still point into the original vertices and every level of detail shares one vertex buffer.
+// Vertices on open borders and on UV or normal seams never move, which keeps the silhouette and texturing intact.
+class MeshSimplifier
+{
+public:
+    MeshSimplifier() = delete;
+
+    // Collapses edges until the index count reaches target_index_count, which is a goal, not a limit. Collapsing stops
+    // earlier when the next one would exceed max_error, so the result can have more indices than the target.
+    // error receives the largest collapse error, relative to the bounding radius of the vertices.
+    static std::vector<u32> simplify(std::span<Vertex const> const vertices, std::span<u32 const> const indices,
+                                     u32 const target_index_count, float const max_error, float& error);
+
+    // Appends coarser copies of the triangle list to indices, halving the triangle count each time, until another level
+    // wouldn't pay off. lods always starts with the original indices.
+    static void build_lods(std::span<Vertex const> const vertices, std::vector<u32>& indices, std::vector<MeshLod>& lods);
+
+    // Meshes with fewer triangles don't get any coarser levels.
+    static u32 constexpr min_lod_triangle_count = 256;
+
+    // Simplification stops once the surface would be further off than this fraction of the bounding radius.
+    static constexpr float max_lod_error = 0.25f;
+};
@@ -1,6 +1,9 @@
 #include "Model.h"
 
 #include "AK/Types.h"
+#include "AssimpFileSystem.h"
+#include "Camera.h"
+#include "CookedModel.h"
 #include "Entity.h"
 #include "Globals.h"
 #include "Mesh.h"
@@ -82,6 +85,18 @@ void Model::draw_editor()
     {
         m_rasterizer_draw_type = static_cast<RasterizerDrawType>(current_item_index);
     }
+
+    for (u32 i = 0; i < m_meshes.size(); ++i)
+    {
+        std::string lod_triangles = {};
+        for (auto const& lod : m_meshes[i]->get_lods())
+        {
+            lod_triangles += (lod_triangles.empty() ? "" : " / ") + std::to_string(lod.index_count / 3);
+        }
+
+        u32 const current_lod = i < m_mesh_lods.size() ? m_mesh_lods[i] : 0;
+        ImGui::Text("Mesh %u LOD %u, triangles %s", i, current_lod, lod_triangles.c_str());
+    }
 }
 #endif
 
@@ -127,12 +142,97 @@ void Model::draw() const
     // Either wireframe or solid for individual model
     Renderer::get_instance()->set_rasterizer_draw_type(m_rasterizer_draw_type);
 
-    for (auto const& mesh : m_meshes)
-        mesh->draw();
+    select_lods();
+
+    for (u32 i = 0; i < m_meshes.size(); ++i)
+        m_meshes[i]->draw_lod(m_mesh_lods[i]);
 
     Renderer::get_instance()->restore_default_rasterizer_draw_type();
 }
 
+void Model::begin_lod_frame()
+{
+    m_last_lod_mesh_counts = m_lod_mesh_counts;
+    m_last_lod_triangle_counts = m_lod_triangle_counts;
+    m_lod_mesh_counts = {};
+    m_lod_triangle_counts = {};
+    ++m_frame;
+}
+
+u32 Model::get_lod_mesh_count(u32 const lod)
+{
+    return m_last_lod_mesh_counts[lod];
+}
+
+u32 Model::get_lod_triangle_count(u32 const lod)
+{
+    return m_last_lod_triangle_counts[lod];
+}
+
+void Model::select_lods() const
+{
+    if (m_lod_frame == m_frame && m_mesh_lods.size() == m_meshes.size())
+        return;
+
+    m_lod_frame = m_frame;
+    m_mesh_lods.resize(m_meshes.size(), 0);
+
+    std::shared_ptr<Camera> const camera = Camera::get_main_camera();
+
+    // Screen pixels covered by one radian of the vertical field of view, around the center of the screen.
+    float pixels_per_radian = 0.0f;
+    glm::vec3 camera_position = {};
+
+    if (camera != nullptr)
+    {
+        pixels_per_radian = static_cast<float>(Renderer::screen_height) * 0.5f / glm::tan(camera->fov * 0.5f);
+        camera_position = camera->get_position();
+    }
+
+    for (u32 i = 0; i < m_meshes.size(); ++i)
+    {
+        auto const& mesh = m_meshes[i];
+
+        m_mesh_lods[i] = camera != nullptr ? select_lod(mesh, m_mesh_lods[i], camera_position, pixels_per_radian) : 0;
+
+        m_lod_mesh_counts[m_mesh_lods[i]] += 1;
+        m_lod_triangle_counts[m_mesh_lods[i]] += mesh->get_lods()[m_mesh_lods[i]].index_count / 3;
+    }
+}
+
+u32 Model::select_lod(std::shared_ptr<Mesh> const& mesh, u32 const current_lod, glm::vec3 const& camera_position,
+                      float const pixels_per_radian) const
+{
+    std::span<MeshLod const> const lods = mesh->get_lods();
+
+    if (lods.size() < 2)
+        return 0;
+
+    BoundingBox const world_bounds = mesh->get_adjusted_bounding_box(entity->transform->get_model_matrix());
+    float const radius = glm::length(world_bounds.extents);
+    float const distance = glm::distance(camera_position, world_bounds.center);
+
+    // Inside the bounds the mesh covers the whole screen anyway.
+    if (distance <= radius)
+        return 0;
+
+    // LOD errors are relative to the bounding radius, so this turns them into pixels.
+    float const radius_in_pixels = radius / distance * pixels_per_radian;
+    float const max_error = lod_settings.max_screen_error;
+    float const hysteresis = 1.0f + lod_settings.hysteresis;
+
+    u32 lod = glm::min(current_lod, static_cast<u32>(lods.size()) - 1);
+
+    // Coarser levels have to stay below the threshold by a margin, the current one is kept until it's clearly above it.
+    while (lod + 1 < lods.size() && lods[lod + 1].error * radius_in_pixels * hysteresis <= max_error)
+        ++lod;
+
+    while (lod > 0 && lods[lod].error * radius_in_pixels > max_error * hysteresis)
+        --lod;
+
+    return lod;
+}
+
 void Model::draw_instanced(i32 const size)
 {
     for (auto const& mesh : m_meshes)
@@ -166,7 +266,14 @@ void Model::reprepare()
 
 void Model::load_model(std::string const& path)
 {
+    std::filesystem::path const filesystem_path = path;
+    m_directory = filesystem_path.parent_path().string();
+
+    if (load_cooked_model(path))
+        return;
+
     Assimp::Importer importer;
+    importer.SetIOHandler(new AssimpFileSystem);
     aiScene const* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
 
     if (scene == nullptr || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || scene->mRootNode == nullptr)
@@ -175,12 +282,37 @@ void Model::load_model(std::string const& path)
         return;
     }
 
-    std::filesystem::path const filesystem_path = path;
-    m_directory = filesystem_path.parent_path().string();
-
     proccess_node(scene->mRootNode, scene);
 }
 
+bool Model::load_cooked_model(std::string const& path)
+{
+    auto const cooked_model = CookedModel::load(CookedModel::get_cooked_path(path), path);
+
+    if (cooked_model == nullptr)
+        return false;
+
+    for (auto const& submesh : cooked_model->submeshes)
+    {
+        std::vector<std::shared_ptr<Texture>> textures;
+        textures.reserve(submesh.texture_count);
+
+        for (u32 i = submesh.first_texture; i < submesh.first_texture + submesh.texture_count; ++i)
+        {
+            auto const& texture = cooked_model->textures[i];
+            textures.push_back(load_material_texture(texture.path, texture.type));
+        }
+
+        BoundingBox const local_bounds = {submesh.bounds_min, submesh.bounds_max};
+        m_meshes.emplace_back(ResourceManager::get_instance().load_mesh(m_meshes.size(), model_path, cooked_model->get_vertices(submesh),
+                                                                        {}, cooked_model->get_indices(submesh),
+                                                                        cooked_model->get_lods(submesh), local_bounds, textures,
+                                                                        m_draw_type, material));
+    }
+
+    return true;
+}
+
 void Model::proccess_node(aiNode const* node, aiScene const* scene)
 {
     for (u32 i = 0; i < node->mNumMeshes; ++i)
@@ -243,7 +375,8 @@ std::shared_ptr<Mesh> Model::proccess_mesh(aiMesh const* mesh, aiScene const* sc
         load_material_textures(assimp_material, aiTextureType_SPECULAR, TextureType::Specular);
     textures.insert(textures.end(), specular_maps.begin(), specular_maps.end());
 
-    return ResourceManager::get_instance().load_mesh(m_meshes.size(), model_path, vertices, indices, textures, m_draw_type, material);
+    return ResourceManager::get_instance().load_mesh(m_meshes.size(), model_path, vertices, indices, textures, m_draw_type, material,
+                                                     DrawFunctionType::Indexed, true);
 }
 
 std::vector<std::shared_ptr<Texture>> Model::load_material_textures(aiMaterial const* material, aiTextureType const type,
@@ -271,19 +404,53 @@ std::vector<std::shared_ptr<Texture>> Model::load_material_textures(aiMaterial c
         if (is_already_loaded)
             continue;
 
-        auto file_path = std::string(str.C_Str());
-        file_path = m_directory + '/' + file_path;
+        textures.push_back(load_material_texture(str.C_Str(), type_name));
+    }
 
-        TextureSettings settings = {};
-        settings.flip_vertically = false;
-        settings.filtering_min = TextureFiltering::Nearest;
-        settings.filtering_max = TextureFiltering::Nearest;
-        settings.filtering_mipmap = TextureFiltering::Nearest;
+    return textures;
+}
 
-        std::shared_ptr<Texture> texture = ResourceManager::get_instance().load_texture(file_path, type_name, settings);
-        textures.push_back(texture);
-        m_loaded_textures.push_back(texture);
-    }
+std::shared_ptr<Texture> Model::load_material_texture(std::string const& relative_path, TextureType const type)
+{
+    std::shared_ptr<Texture> texture = request_material_texture(m_directory + '/' + relative_path, type);
+    m_loaded_textures.push_back(texture);
+
+    return texture;
+}
+
+std::shared_ptr<Texture> Model::request_material_texture(std::string const& file_path, TextureType const type)
+{
+    TextureSettings settings = {};
+    settings.flip_vertically = false;
+    settings.filtering_min = TextureFiltering::Nearest;
+    settings.filtering_max = TextureFiltering::Nearest;
+    settings.filtering_mipmap = TextureFiltering::Nearest;
+
+    return ResourceManager::get_instance().load_texture_async(file_path, type, settings);
+}
+
+std::vector<Model::TextureRequest> Model::get_cooked_textures(std::string const& model_path)
+{
+    auto const cooked_model = CookedModel::load(CookedModel::get_cooked_path(model_path), model_path);
+
+    if (cooked_model == nullptr)
+        return {};
+
+    // Same directory load_model() resolves the texture paths against.
+    std::string const directory = std::filesystem::path(model_path).parent_path().string();
+
+    std::vector<TextureRequest> textures = {};
+    textures.reserve(cooked_model->textures.size());
+
+    for (auto const& texture : cooked_model->textures)
+        textures.push_back({directory + '/' + texture.path, texture.type});
 
     return textures;
 }
+
+void Model::preload_textures(std::vector<TextureRequest> const& textures)
+{
+    // Cached by ResourceManager, the Model gets the same textures once it loads.
+    for (auto const& texture : textures)
+        request_material_texture(texture.path, texture.type);
+}
@@ -1,4 +1,5 @@
 #pragma once
+#include <array>
 #include <string>
 #include <vector>
 
@@ -40,6 +41,27 @@ public:
     virtual void adjust_bounding_box() override;
     virtual BoundingBox get_adjusted_bounding_box(glm::mat4 const& model_matrix) const override;
 
+    // Publishes the LOD statistics of the last frame and starts counting the next one.
+    static void begin_lod_frame();
+
+    // Meshes drawn at each level of detail last frame, and their triangles.
+    static u32 get_lod_mesh_count(u32 const lod);
+    static u32 get_lod_triangle_count(u32 const lod);
+
+    struct TextureRequest
+    {
+        std::string path = {};
+        TextureType type = TextureType::None;
+    };
+
+    // Textures a Model loading the cooked model would load. Doesn't load anything, safe to call from any thread.
+    static std::vector<TextureRequest> get_cooked_textures(std::string const& model_path);
+
+    // Starts decoding them, so they are ready before a Model loads them. Main thread only, placeholders are created right away.
+    static void preload_textures(std::vector<TextureRequest> const& textures);
+
+    inline static MeshLodSettings lod_settings = {};
+
     std::string model_path = "";
 
 protected:
@@ -50,11 +72,29 @@ protected:
 
 private:
     void load_model(std::string const& path);
+    bool load_cooked_model(std::string const& path);
     void proccess_node(aiNode const* node, aiScene const* scene);
     std::shared_ptr<Mesh> proccess_mesh(aiMesh const* mesh, aiScene const* scene);
     std::vector<std::shared_ptr<Texture>> load_material_textures(aiMaterial const* material, aiTextureType type,
                                                                  TextureType const type_name);
+    std::shared_ptr<Texture> load_material_texture(std::string const& relative_path, TextureType const type);
+    static std::shared_ptr<Texture> request_material_texture(std::string const& file_path, TextureType const type);
+
+    // Selects once per frame, the shadow and the main pass then draw the same level.
+    void select_lods() const;
+    [[nodiscard]] u32 select_lod(std::shared_ptr<Mesh> const& mesh, u32 const current_lod, glm::vec3 const& camera_position,
+                                 float const pixels_per_radian) const;
 
     std::string m_directory;
     std::vector<std::shared_ptr<Texture>> m_loaded_textures;
+
+    // Selected level of each mesh, only changes from const draw().
+    mutable std::vector<u32> m_mesh_lods = {};
+    mutable u64 m_lod_frame = 0;
+
+    inline static u64 m_frame = 1;
+    inline static std::array<u32, max_mesh_lod_count> m_lod_mesh_counts = {};
+    inline static std::array<u32, max_mesh_lod_count> m_lod_triangle_counts = {};
+    inline static std::array<u32, max_mesh_lod_count> m_last_lod_mesh_counts = {};
+    inline static std::array<u32, max_mesh_lod_count> m_last_lod_triangle_counts = {};
 };
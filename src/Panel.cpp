@@ -91,7 +91,8 @@ std::shared_ptr<Mesh> Panel::create_sprite() const
     texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
 
     if (!background_path.empty())
-        diffuse_maps.emplace_back(ResourceManager::get_instance().load_texture(background_path, TextureType::Diffuse, texture_settings));
+        diffuse_maps.emplace_back(
+            ResourceManager::get_instance().load_texture_async(background_path, TextureType::Diffuse, texture_settings));
 
     textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
 
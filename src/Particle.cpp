@@ -303,7 +303,7 @@ std::shared_ptr<Mesh> Particle::create_sprite() const
     texture_settings.wrap_mode_y = TextureWrapMode::ClampToEdge;
 
     if (!path.empty())
-        diffuse_maps.emplace_back(ResourceManager::get_instance().load_texture(path, TextureType::Diffuse, texture_settings));
+        diffuse_maps.emplace_back(ResourceManager::get_instance().load_texture_async(path, TextureType::Diffuse, texture_settings));
 
     textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
 
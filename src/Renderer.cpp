@@ -12,6 +12,7 @@
 #include "Debug.h"
 #include "Engine.h"
 #include "Entity.h"
+#include "Model.h"
 #include "ShaderFactory.h"
 #include "Skybox.h"
 
@@ -255,6 +256,8 @@ void Renderer::begin_frame() const
 {
     glfwGetFramebufferSize(Engine::window->get_glfw_window(), &screen_width, &screen_height);
 
+    Model::begin_lod_frame();
+
     // Update camera
     if (Camera::get_main_camera() != nullptr)
     {
@@ -14,11 +14,14 @@
 #include "Input.h"
 #include "Model.h"
 #include "ResourceManager.h"
+#include "ShaderDX11.h"
 #include "ShaderFactory.h"
 #include "ShadingDefines.h"
+#include "SkinnedModel.h"
 #include "Skybox.h"
 #include "SkyboxFactory.h"
 #include "TextureLoaderDX11.h"
+#include "VertexBufferDX11.h"
 #include "Water.h"
 
 std::shared_ptr<RendererDX11> RendererDX11::create()
@@ -85,6 +88,9 @@ std::shared_ptr<RendererDX11> RendererDX11::create()
 
     assert(SUCCEEDED(hr));
 
+    SkinVertex constexpr no_skinning = {};
+    renderer->m_static_skin_buffer = std::make_shared<VertexBufferDX11>(renderer->get_device(), &no_skinning, 1, sizeof(SkinVertex));
+
     glfwSetWindowSizeCallback(Engine::window->get_glfw_window(), on_window_resize);
 
     D3D11_BUFFER_DESC light_buffer_desc = {};
@@ -231,6 +237,9 @@ void RendererDX11::begin_frame() const
 {
     get_instance_dx11()->update_rasterizer_state();
 
+    m_last_skinning_upload_bytes = m_skinning_upload_bytes;
+    m_skinning_upload_bytes = 0;
+
     Renderer::begin_frame();
 
     float const clear_color_with_alpha[4] = {clear_color_glm.x * clear_color_glm.w, clear_color_glm.y * clear_color_glm.w,
@@ -616,7 +625,15 @@ void RendererDX11::update_object(std::shared_ptr<Drawable> const& drawable, std:
     get_device_context()->VSSetConstantBuffers(0, 1, &m_constant_buffer_per_object);
     get_device_context()->PSSetConstantBuffers(10, 1, &m_constant_buffer_per_object);
     set_particle_buffer(drawable, material);
-    // set_skinning_buffer(bones);
+
+    // All skinned models share a single buffer, so each palette has to be uploaded right before its own draw.
+    if (drawable->is_skinned_model())
+    {
+        auto const skinned_model = std::static_pointer_cast<SkinnedModel>(drawable);
+        m_skinning_upload_bytes += set_skinning_buffer(drawable, skinned_model->get_skinning_matrices(),
+                                                       static_cast<u32>(skinned_model->skinning_matrices.size()));
+    }
+
     set_light_buffer();
     set_camera_position_buffer(drawable);
 }
@@ -800,30 +817,48 @@ void RendererDX11::set_particle_buffer(std::shared_ptr<Drawable> const& drawable
     get_instance_dx11()->get_device_context()->PSSetConstantBuffers(4, 1, &m_constant_buffer_particle);
 }
 
-void RendererDX11::set_skinning_buffer(std::shared_ptr<Drawable> const& drawable, glm::mat4 const* bones) const
+u32 RendererDX11::get_last_skinning_upload_bytes() const
 {
-    if (bones == nullptr)
-        return;
+    return m_last_skinning_upload_bytes;
+}
 
-    if (!drawable->is_skinned_model())
-        return;
+u32 RendererDX11::set_skinning_buffer(std::shared_ptr<Drawable> const& drawable, glm::mat4 const* bones, u32 const bone_count) const
+{
+    if (bones == nullptr || bone_count == 0)
+        return 0;
 
-    SkinningBuffer skinning_data = {};
+    if (!drawable->is_skinned_model())
+        return 0;
 
-    for (u16 i = 0; i < SKINNING_BUFFER_SIZE; i++)
-    {
-        skinning_data.bones[i] = bones[i];
-    }
+    assert(bone_count <= static_cast<u32>(SKINNING_BUFFER_SIZE));
 
     D3D11_MAPPED_SUBRESOURCE skinning_mapped_resource = {};
     HRESULT const hr = get_instance_dx11()->get_device_context()->Map(m_constant_buffer_skinning, 0, D3D11_MAP_WRITE_DISCARD, 0,
                                                                       &skinning_mapped_resource);
     assert(SUCCEEDED(hr));
 
-    CopyMemory(skinning_mapped_resource.pData, &skinning_data, sizeof(SkinningBuffer));
+    // Write straight into the mapped buffer and only the used range of it. The shader never indexes past the model's bone count,
+    // so whatever WRITE_DISCARD left in the rest of the buffer is never read.
+    u32 const size = glm::min(bone_count, static_cast<u32>(SKINNING_BUFFER_SIZE)) * sizeof(glm::mat4);
+    CopyMemory(skinning_mapped_resource.pData, bones, size);
 
     get_instance_dx11()->get_device_context()->Unmap(m_constant_buffer_skinning, 0);
     get_instance_dx11()->get_device_context()->VSSetConstantBuffers(4, 1, &m_constant_buffer_skinning);
+
+    return size;
+}
+
+void RendererDX11::set_vertex_buffers(VertexBufferDX11 const& vertex_buffer, VertexBufferDX11 const* skin_buffer) const
+{
+    bool const is_skinned = skin_buffer != nullptr;
+    VertexBufferDX11 const& skin_stream = is_skinned ? *skin_buffer : *m_static_skin_buffer;
+
+    std::array const buffers = {vertex_buffer.get(), skin_stream.get()};
+    std::array const strides = {vertex_buffer.stride(), skin_stream.stride()};
+    std::array<u32, 2> constexpr offsets = {};
+
+    ShaderDX11::set_vertex_layout(is_skinned ? VertexLayout::Skinned : VertexLayout::Static);
+    get_device_context()->IASetVertexBuffers(0, static_cast<u32>(buffers.size()), buffers.data(), strides.data(), offsets.data());
 }
 
 void RendererDX11::set_camera_position_buffer(std::shared_ptr<Drawable> const& drawable) const
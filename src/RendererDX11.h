@@ -6,6 +6,8 @@
 #include "Renderer.h"
 #include "SSAO.h"
 
+class VertexBufferDX11;
+
 class RendererDX11 final : public Renderer
 {
 public:
@@ -41,7 +43,13 @@ public:
 
     virtual void set_rasterizer_draw_type(RasterizerDrawType const rasterizer_draw_type) override;
     virtual void restore_default_rasterizer_draw_type() override;
-    void set_skinning_buffer(std::shared_ptr<Drawable> const& drawable, glm::mat4 const* bones) const;
+    u32 set_skinning_buffer(std::shared_ptr<Drawable> const& drawable, glm::mat4 const* bones, u32 const bone_count) const;
+
+    // Palette bytes uploaded for the draws of the last frame, once per pass a skinned model is drawn in.
+    [[nodiscard]] u32 get_last_skinning_upload_bytes() const;
+
+    // Binds the vertex streams and the matching input layout of the current shader. Without a skin buffer the mesh is drawn as static.
+    void set_vertex_buffers(VertexBufferDX11 const& vertex_buffer, VertexBufferDX11 const* skin_buffer) const;
 
 protected:
     virtual void update_shader(std::shared_ptr<Shader> const& shader, glm::mat4 const& projection_view,
@@ -118,6 +126,9 @@ private:
     ID3D11Buffer* m_constant_buffer_psmisc = nullptr;
     ID3D11Buffer* m_constant_buffer_particle = nullptr;
     ID3D11Buffer* m_constant_buffer_skinning = nullptr;
+    mutable u32 m_skinning_upload_bytes = 0;
+    mutable u32 m_last_skinning_upload_bytes = 0;
+    std::shared_ptr<VertexBufferDX11> m_static_skin_buffer = nullptr;
     ID3D11DepthStencilView* m_depth_stencil_view = nullptr;
     ID3D11Texture2D* m_depth_stencil_buffer = nullptr;
     ID3D11DepthStencilState* m_depth_stencil_state = nullptr;
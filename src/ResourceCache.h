@@ -0,0 +1,179 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "AK/Types.h"
+
+// 64-bit hash of everything that identifies a resource, see ResourceManager::generate_key().
+using ResourceKey = u64;
+
+// Thread-safe map from keys to shared resources. Keys are spread over stripes with their own lock, so threads
+// looking up different resources rarely wait for each other, and lookups only take a shared lock.
+// The first request for a key runs the loader. Requests for the same key made meanwhile wait for its result instead of loading it again.
+template<typename T>
+class ResourceCache
+{
+public:
+    struct Entry
+    {
+        std::shared_future<std::shared_ptr<T>> resource = {};
+
+        // Interned copy of the path or name the key was generated from, only used for reports.
+        std::string name = {};
+
+        u64 size = 0;
+        std::atomic<u64> last_used_frame = 0;
+
+        // Failed loads are removed before they are ready, nullptr is only checked to be safe.
+        [[nodiscard]] bool is_loaded() const
+        {
+            return resource.wait_for(std::chrono::seconds(0)) == std::future_status::ready && resource.get() != nullptr;
+        }
+    };
+
+    template<typename Loader>
+    std::shared_ptr<T> get_or_load(ResourceKey const key, std::string_view const name, u64 const frame, Loader&& loader)
+    {
+        Stripe& stripe = get_stripe(key);
+        std::shared_future<std::shared_ptr<T>> resource = {};
+
+        {
+            std::shared_lock const lock(stripe.mutex);
+
+            if (auto const it = stripe.entries.find(key); it != stripe.entries.end())
+            {
+                it->second.last_used_frame.store(frame, std::memory_order_relaxed);
+                resource = it->second.resource;
+            }
+        }
+
+        if (resource.valid())
+            return resource.get();
+
+        std::promise<std::shared_ptr<T>> promise = {};
+
+        {
+            std::unique_lock const lock(stripe.mutex);
+
+            // Another thread might have started loading it since the lookup.
+            auto const [it, inserted] = stripe.entries.try_emplace(key);
+            it->second.last_used_frame.store(frame, std::memory_order_relaxed);
+
+            if (!inserted)
+            {
+                resource = it->second.resource;
+            }
+            else
+            {
+                it->second.resource = promise.get_future().share();
+                it->second.name = name;
+            }
+        }
+
+        if (resource.valid())
+            return resource.get();
+
+        std::shared_ptr<T> loaded_resource = nullptr;
+
+        // Failed loads aren't cached, the next request tries again. They are removed before the result is set,
+        // so no one finds a ready entry without a resource. Requests already waiting get the result anyway.
+        try
+        {
+            loaded_resource = loader();
+        }
+        catch (...)
+        {
+            erase(stripe, key);
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+
+        if (loaded_resource == nullptr)
+            erase(stripe, key);
+
+        promise.set_value(loaded_resource);
+
+        return loaded_resource;
+    }
+
+    // Visits every loaded resource. Locks one stripe at a time, f must not call back into the cache.
+    template<typename F>
+    void for_each(F&& f)
+    {
+        for (auto& stripe : m_stripes)
+        {
+            std::unique_lock const lock(stripe.mutex);
+
+            for (auto& [key, entry] : stripe.entries)
+            {
+                if (entry.is_loaded())
+                    f(key, entry);
+            }
+        }
+    }
+
+    template<typename F>
+    void for_each(F&& f) const
+    {
+        for (auto const& stripe : m_stripes)
+        {
+            std::shared_lock const lock(stripe.mutex);
+
+            for (auto const& [key, entry] : stripe.entries)
+            {
+                if (entry.is_loaded())
+                    f(key, entry);
+            }
+        }
+    }
+
+    // Removes the resource if the cache holds the only reference to it and returns it, so the caller destroys it.
+    std::shared_ptr<T> remove_unreferenced(ResourceKey const key)
+    {
+        Stripe& stripe = get_stripe(key);
+        std::unique_lock const lock(stripe.mutex);
+
+        auto const it = stripe.entries.find(key);
+
+        if (it == stripe.entries.end() || !it->second.is_loaded() || it->second.resource.get().use_count() > 1)
+            return nullptr;
+
+        std::shared_ptr<T> resource = it->second.resource.get();
+        stripe.entries.erase(it);
+
+        return resource;
+    }
+
+private:
+    struct Stripe
+    {
+        mutable std::shared_mutex mutex = {};
+        std::unordered_map<ResourceKey, Entry> entries = {};
+    };
+
+    static void erase(Stripe& stripe, ResourceKey const key)
+    {
+        std::unique_lock const lock(stripe.mutex);
+        stripe.entries.erase(key);
+    }
+
+    Stripe& get_stripe(ResourceKey const key)
+    {
+        // Low bits pick the bucket inside the stripe's map, use the high ones here.
+        return m_stripes[(key >> 60) % stripe_count];
+    }
+
+    static u32 constexpr stripe_count = 16;
+
+    std::array<Stripe, stripe_count> m_stripes = {};
+};
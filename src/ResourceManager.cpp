@@ -2,12 +2,70 @@
 
 #include "Globals.h"
 
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <format>
 #include <iostream>
-#include <sstream>
+#include <thread>
+#include <utility>
 
+#include "AK/AK.h"
+#include "AnimationFactory.h"
+#include "Debug.h"
 #include "MeshFactory.h"
+#include "MeshOptimizer.h"
+#include "MeshSimplifier.h"
 #include "ShaderFactory.h"
 #include "TextureLoader.h"
+#include "VertexPacking.h"
+
+namespace
+{
+
+u64 get_resource_size(Texture const& texture)
+{
+    return static_cast<u64>(texture.width) * texture.height * texture.number_of_components * texture.layer_count;
+}
+
+u64 get_resource_size(Mesh const& mesh)
+{
+    return mesh.get_size();
+}
+
+u64 get_resource_size(Shader const&)
+{
+    return 0;
+}
+
+u64 get_resource_size(Animation const& animation)
+{
+    u64 size = sizeof(Animation);
+    for (auto const& bone : animation.bones)
+    {
+        size += sizeof(Bone) + bone.get_keys_size();
+    }
+
+    return size;
+}
+
+char const* get_type_name(ResourceType const type)
+{
+    switch (type)
+    {
+    case ResourceType::Texture:
+        return "Texture";
+    case ResourceType::Mesh:
+        return "Mesh";
+    case ResourceType::Shader:
+        return "Shader";
+    case ResourceType::Animation:
+        return "Animation";
+    default:
+        std::unreachable();
+    }
+}
+
+}
 
 ResourceManager& ResourceManager::get_instance()
 {
@@ -17,177 +75,371 @@ ResourceManager& ResourceManager::get_instance()
 
 std::shared_ptr<Texture> ResourceManager::load_texture(std::string const& path, TextureType const type, TextureSettings const& settings)
 {
-    std::string const& key = path; // No need to even call generate_key()
-    std::shared_ptr<Texture> resource_ptr = get_from_vector<Texture>(key);
+    auto const resource_ptr = get_or_load<Texture>(generate_key({path}), path, [&] {
+        return TextureLoader::get_instance()->load_texture(path, type, settings);
+    });
 
-    if (resource_ptr != nullptr)
-        return resource_ptr;
-
-    resource_ptr = TextureLoader::get_instance()->load_texture(path, type, settings);
-    m_textures.emplace_back(resource_ptr);
-    names_to_textures.insert(std::pair<std::string, u16>(key, m_textures.size() - 1));
+    if (!resource_ptr->is_loaded)
+        wait_for_texture(resource_ptr);
 
     return resource_ptr;
 }
 
-std::shared_ptr<Texture> ResourceManager::load_cubemap(std::vector<std::string> const& paths, TextureType const type,
-                                                       TextureSettings const& settings)
+std::shared_ptr<Texture> ResourceManager::load_texture_async(std::string const& path, TextureType const type,
+                                                             TextureSettings const& settings)
 {
-    assert(paths.size() >= 6);
+    return get_or_load<Texture>(generate_key({path}), path, [&] {
+        auto const texture_loader = TextureLoader::get_instance();
+        auto texture = texture_loader->load_placeholder(path, type);
 
-    std::stringstream stream;
-    stream << paths[0] << paths[1] << paths[2] << paths[3] << paths[4] << paths[5];
-    std::string const& key = generate_key(stream);
-    std::shared_ptr<Texture> resource_ptr = get_from_vector<Texture>(key);
+        std::lock_guard const lock(m_texture_decode_queue_mutex);
 
-    if (resource_ptr != nullptr)
-        return resource_ptr;
+        if (m_texture_decode_queue == nullptr)
+        {
+            // Leave one core for the main thread.
+            u32 const thread_count = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+            m_texture_decode_queue = std::make_unique<TextureDecodeQueue>(thread_count);
+        }
 
-    resource_ptr = TextureLoader::get_instance()->load_cubemap(paths, type, settings);
-    m_textures.emplace_back(resource_ptr);
-    names_to_textures.insert(std::make_pair(key, m_textures.size() - 1));
+        m_texture_decode_queue->push({texture, settings, texture_loader->get_decode_channels()});
+        m_pending_textures += 1;
 
-    return resource_ptr;
+        return texture;
+    });
 }
 
-std::shared_ptr<Texture> ResourceManager::load_cubemap(std::string const& path, TextureType const type, TextureSettings const& settings)
+void ResourceManager::finalize_textures(double const budget_ms)
 {
-    std::stringstream stream;
-    stream << path;
-    std::string const& key = generate_key(stream);
-    std::shared_ptr<Texture> resource_ptr = get_from_vector<Texture>(key);
+    if (m_pending_textures == 0)
+        return;
 
-    if (resource_ptr != nullptr)
-        return resource_ptr;
+    double const start = glfwGetTime();
+    TextureDecodeQueue::Result result = {};
 
-    resource_ptr = TextureLoader::get_instance()->load_cubemap(path, type, settings);
-    m_textures.emplace_back(resource_ptr);
-    names_to_textures.insert(std::make_pair(key, m_textures.size() - 1));
+    do
+    {
+        if (!m_texture_decode_queue->pop_finished(result))
+            break;
 
-    return resource_ptr;
+        finalize_texture(result);
+    } while ((glfwGetTime() - start) * 1000.0 < budget_ms);
 }
 
-std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& compute_path)
+void ResourceManager::finish_textures()
 {
-    std::stringstream stream;
-    stream << compute_path;
-    std::string const& key = generate_key(stream);
-    auto resource_ptr = get_from_vector<Shader>(key);
+    TextureDecodeQueue::Result result = {};
 
-    if (resource_ptr != nullptr)
-        return resource_ptr;
+    while (m_pending_textures > 0)
+    {
+        m_texture_decode_queue->wait_for_finished();
 
-    resource_ptr = ShaderFactory::create(compute_path);
-    m_shaders.emplace_back(resource_ptr);
-    names_to_shaders.insert(std::make_pair(key, m_shaders.size() - 1));
+        while (m_texture_decode_queue->pop_finished(result))
+            finalize_texture(result);
+    }
+}
 
-    return resource_ptr;
+void ResourceManager::stop_async_loading()
+{
+    // Joins the workers, textures that weren't decoded yet keep their placeholders.
+    m_texture_decode_queue = nullptr;
+    m_pending_textures = 0;
 }
 
-std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& vertex_path, std::string const& fragment_path)
+u32 ResourceManager::get_pending_texture_count() const
 {
-    std::stringstream stream;
-    stream << vertex_path << fragment_path;
-    std::string const& key = generate_key(stream);
+    return m_pending_textures;
+}
 
-    auto resource_ptr = get_from_vector<Shader>(key);
+void ResourceManager::wait_for_texture(std::shared_ptr<Texture> const& texture)
+{
+    TextureDecodeQueue::Result result = {};
 
-    if (resource_ptr != nullptr)
-        return resource_ptr;
+    while (!texture->is_loaded && m_texture_decode_queue != nullptr)
+    {
+        m_texture_decode_queue->wait_for_finished();
 
-    resource_ptr = ShaderFactory::create(vertex_path, fragment_path);
-    m_shaders.emplace_back(resource_ptr);
-    names_to_shaders.insert(std::make_pair(key, m_shaders.size() - 1));
+        while (m_texture_decode_queue->pop_finished(result))
+            finalize_texture(result);
+    }
+}
 
-    return resource_ptr;
+void ResourceManager::finalize_texture(TextureDecodeQueue::Result const& result)
+{
+    TextureLoader::get_instance()->finalize_texture(*result.texture, result.image, result.settings);
+    m_pending_textures -= 1;
 }
 
-std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& vertex_path, std::string const& fragment_path,
-                                                     std::string const& geometry_path)
+std::shared_ptr<Texture> ResourceManager::load_cubemap(std::vector<std::string> const& paths, TextureType const type,
+                                                       TextureSettings const& settings)
 {
-    std::stringstream stream;
-    stream << vertex_path << fragment_path << geometry_path;
-    std::string const& key = generate_key(stream);
+    assert(paths.size() >= 6);
 
-    auto resource_ptr = get_from_vector<Shader>(key);
+    return get_or_load<Texture>(generate_key({paths[0], paths[1], paths[2], paths[3], paths[4], paths[5]}), paths[0], [&] {
+        return TextureLoader::get_instance()->load_cubemap(paths, type, settings);
+    });
+}
 
-    if (resource_ptr != nullptr)
-        return resource_ptr;
+std::shared_ptr<Texture> ResourceManager::load_cubemap(std::string const& path, TextureType const type, TextureSettings const& settings)
+{
+    return get_or_load<Texture>(generate_key({path}), path,
+                                [&] { return TextureLoader::get_instance()->load_cubemap(path, type, settings); });
+}
 
-    resource_ptr = ShaderFactory::create(vertex_path, fragment_path, geometry_path);
-    m_shaders.emplace_back(resource_ptr);
-    names_to_shaders.insert(std::make_pair(key, m_shaders.size() - 1));
+std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& compute_path)
+{
+    return get_or_load<Shader>(generate_key({compute_path}), compute_path, [&] { return ShaderFactory::create(compute_path); });
+}
 
-    return resource_ptr;
+std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& vertex_path, std::string const& fragment_path)
+{
+    return get_or_load<Shader>(generate_key({vertex_path, fragment_path}), fragment_path,
+                               [&] { return ShaderFactory::create(vertex_path, fragment_path); });
+}
+
+std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& vertex_path, std::string const& fragment_path,
+                                                     std::string const& geometry_path)
+{
+    return get_or_load<Shader>(generate_key({vertex_path, fragment_path, geometry_path}), fragment_path,
+                               [&] { return ShaderFactory::create(vertex_path, fragment_path, geometry_path); });
 }
 
 std::shared_ptr<Shader> ResourceManager::load_shader(std::string const& vertex_path, std::string const& tessellation_control_path,
                                                      std::string const& tessellation_evaluation_path, std::string const& fragment_path)
 {
-    std::stringstream stream;
-    stream << vertex_path << tessellation_control_path << tessellation_evaluation_path << fragment_path;
-    std::string const& key = generate_key(stream);
+    return get_or_load<Shader>(
+        generate_key({vertex_path, tessellation_control_path, tessellation_evaluation_path, fragment_path}), fragment_path,
+        [&] { return ShaderFactory::create(vertex_path, tessellation_control_path, tessellation_evaluation_path, fragment_path); });
+}
 
-    auto resource_ptr = get_from_vector<Shader>(key);
+std::shared_ptr<Mesh> ResourceManager::load_mesh(u32 const array_id, std::string const& name, std::span<Vertex const> const vertices,
+                                                 std::span<u32 const> const indices, std::vector<std::shared_ptr<Texture>> const& textures,
+                                                 DrawType const draw_type, std::shared_ptr<Material> const& material,
+                                                 DrawFunctionType const draw_function, bool const generate_lods)
+{
+    return get_or_load<Mesh>(generate_mesh_key(array_id, name, textures), name, [&] {
+        return create_mesh(vertices, indices, textures, draw_type, material, draw_function, generate_lods);
+    });
+}
 
-    if (resource_ptr != nullptr)
-        return resource_ptr;
+std::shared_ptr<Mesh> ResourceManager::create_mesh(std::span<Vertex const> const vertices, std::span<u32 const> const indices,
+                                                   std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
+                                                   std::shared_ptr<Material> const& material, DrawFunctionType const draw_function,
+                                                   bool const generate_lods)
+{
+    std::vector<MeshLod> lods = {};
+    std::vector<Vertex> optimized_vertices = {};
+    std::vector<u32> optimized_indices = {};
+    std::span<Vertex const> mesh_vertices = vertices;
+    std::span<u32 const> mesh_indices = indices;
+
+    // Only triangle lists can be reordered, strips and patches depend on the order they were generated in.
+    if (draw_type == DrawType::Triangles && draw_function == DrawFunctionType::Indexed && !indices.empty())
+    {
+        optimized_vertices.assign(vertices.begin(), vertices.end());
+        optimized_indices.assign(indices.begin(), indices.end());
+        MeshOptimizer::optimize(optimized_vertices, optimized_indices, true);
 
-    resource_ptr = ShaderFactory::create(vertex_path, tessellation_control_path, tessellation_evaluation_path, fragment_path);
-    m_shaders.emplace_back(resource_ptr);
-    names_to_shaders.insert(std::make_pair(key, m_shaders.size() - 1));
+        if (generate_lods)
+            MeshSimplifier::build_lods(optimized_vertices, optimized_indices, lods);
 
-    return resource_ptr;
+        mesh_vertices = optimized_vertices;
+        mesh_indices = optimized_indices;
+    }
+
+    std::vector<StaticVertex> static_vertices = {};
+    std::vector<SkinVertex> skin_vertices = {};
+    VertexPacking::pack(mesh_vertices, static_vertices, skin_vertices);
+
+    return MeshFactory::create(static_vertices, skin_vertices, mesh_indices, lods, textures, draw_type, material, draw_function,
+                               Mesh::calculate_local_bounds(static_vertices));
 }
 
-std::shared_ptr<Mesh> ResourceManager::load_mesh(u32 const array_id, std::string const& name, std::vector<Vertex> const& vertices,
-                                                 std::vector<u32> const& indices, std::vector<std::shared_ptr<Texture>> const& textures,
-                                                 DrawType const draw_type, std::shared_ptr<Material> const& material,
-                                                 DrawFunctionType const draw_function)
+std::shared_ptr<Mesh> ResourceManager::load_mesh(u32 const array_id, std::string const& name, std::span<StaticVertex const> const vertices,
+                                                 std::span<SkinVertex const> const skin_vertices, std::span<u32 const> const indices,
+                                                 std::span<MeshLod const> const lods, BoundingBox const& local_bounds,
+                                                 std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
+                                                 std::shared_ptr<Material> const& material, DrawFunctionType const draw_function)
+{
+    return get_or_load<Mesh>(generate_mesh_key(array_id, name, textures), name, [&] {
+        return MeshFactory::create(vertices, skin_vertices, indices, lods, textures, draw_type, material, draw_function, local_bounds);
+    });
+}
+
+std::shared_ptr<Animation> ResourceManager::load_animation(std::string const& model_path, std::string const& anim_path,
+                                                           ModelSkin const& skin)
 {
-    std::stringstream stream;
-    stream << name << array_id;
+    // Bone IDs depend on the skinned meshes, so the same clip played on a different model is a different resource.
+    return get_or_load<Animation>(generate_key({model_path, anim_path}), anim_path,
+                                  [&] { return AnimationFactory::create(model_path, anim_path, skin); });
+}
+
+void ResourceManager::reset_state() const
+{
+    // NOTE: When unloading a scene all entities should have already been destroyed,
+    //       and their drawables, and thus materials, uninitialized - unregistered.
+    m_shaders.for_each([](ResourceKey, ResourceCache<Shader>::Entry const& entry) { entry.resource.get()->materials.clear(); });
+
+    initialize_default_material();
+}
+
+ResourceKey ResourceManager::generate_key(std::initializer_list<std::string_view> const parts, ResourceKey const seed)
+{
+    ResourceKey key = seed;
+
+    for (auto const part : parts)
+    {
+        u64 const size = part.size();
+        key = AK::fnv_hash(part.data(), part.size(), key);
+        key = AK::fnv_hash(&size, sizeof(size), key);
+    }
+
+    return key;
+}
+
+ResourceKey ResourceManager::generate_mesh_key(u32 const array_id, std::string const& name,
+                                               std::vector<std::shared_ptr<Texture>> const& textures)
+{
+    ResourceKey key = generate_key({name});
+    key = AK::fnv_hash(&array_id, sizeof(array_id), key);
 
     for (auto const& texture : textures)
     {
-        stream << texture->path;
+        key = generate_key({texture->path}, key);
     }
 
-    std::string const& key = generate_key(stream);
+    return key;
+}
+
+template<typename T>
+void ResourceManager::collect_entries(ResourceType const type, u64& resident_size, std::vector<ResidentResource>& unreferenced)
+{
+    u64 const frame = m_frame.load(std::memory_order_relaxed);
+
+    get_cache<T>().for_each([&](ResourceKey const key, typename ResourceCache<T>::Entry& entry) {
+        std::shared_ptr<T> const& resource = entry.resource.get();
+
+        if (resource == nullptr)
+            return;
+
+        entry.size = get_resource_size(*resource);
+        resident_size += entry.size;
+
+        // ResourceManager's own reference is the only one left.
+        if (resource.use_count() > 1)
+            entry.last_used_frame.store(frame, std::memory_order_relaxed);
+        else
+            unreferenced.push_back({type, key, entry.name, entry.size, 0, frame - entry.last_used_frame.load(std::memory_order_relaxed)});
+    });
+}
+
+template<typename T>
+bool ResourceManager::evict(ResourceKey const key)
+{
+    // Another thread may have picked the resource up again since it was collected, then it stays.
+    std::shared_ptr<T> const resource = get_cache<T>().remove_unreferenced(key);
+
+    if (resource == nullptr)
+        return false;
 
-    // HACK: We currently don't unload any resources including meshes, even in the editor.
-    //       Changing water parameters inside editor recreates the mesh (very similar to changing Sphere's parameters),
-    //       which creates lots of big meshes. To work around this we just unload the water mesh everytime someone asks for it.
-    if (name == "WATER")
+    // Textures are plain structs, their GPU objects are owned by the loader.
+    if constexpr (std::is_same_v<T, Texture>)
+        TextureLoader::get_instance()->release_texture(*resource);
+
+    return true;
+}
+
+void ResourceManager::collect_garbage()
+{
+    u64 resident_size = 0;
+    std::vector<ResidentResource> unreferenced = {};
+
+    collect_entries<Texture>(ResourceType::Texture, resident_size, unreferenced);
+    collect_entries<Mesh>(ResourceType::Mesh, resident_size, unreferenced);
+    collect_entries<Shader>(ResourceType::Shader, resident_size, unreferenced);
+    collect_entries<Animation>(ResourceType::Animation, resident_size, unreferenced);
+
+    if (resident_size > memory_budget || m_unload_unused)
     {
-        names_to_meshes.erase(key);
+        std::ranges::sort(unreferenced,
+                          [](ResidentResource const& lhs, ResidentResource const& rhs) { return lhs.frames_unused > rhs.frames_unused; });
+
+        for (auto const& resource : unreferenced)
+        {
+            // Everything unreferenced goes when unloading, even resources that don't count towards the budget.
+            if (resident_size <= memory_budget && !m_unload_unused)
+                break;
+
+            if (evict(resource))
+                resident_size -= resource.size;
+        }
     }
 
-    auto resource_ptr = get_from_vector<Mesh>(key);
+    m_resident_size = resident_size;
+    m_unload_unused = false;
+    ++m_frame;
+}
 
-    if (resource_ptr != nullptr)
-        return resource_ptr;
+void ResourceManager::unload_unused()
+{
+    m_unload_unused = true;
+}
 
-    resource_ptr = MeshFactory::create(vertices, indices, textures, draw_type, material, draw_function);
-    m_meshes.emplace_back(resource_ptr);
-    names_to_meshes.insert(std::make_pair(key, m_meshes.size() - 1));
+u64 ResourceManager::get_resident_size() const
+{
+    return m_resident_size;
+}
 
-    return resource_ptr;
+std::vector<ResidentResource> ResourceManager::get_resident_resources() const
+{
+    std::vector<ResidentResource> resources = {};
+    u64 const frame = m_frame.load(std::memory_order_relaxed);
+
+    auto const add_resources = [&](ResourceType const type, auto const& cache) {
+        cache.for_each([&](ResourceKey const key, auto const& entry) {
+            auto const& resource = entry.resource.get();
+            resources.push_back({type, key, entry.name, get_resource_size(*resource), static_cast<u32>(resource.use_count() - 1),
+                                 frame - entry.last_used_frame.load(std::memory_order_relaxed)});
+        });
+    };
+
+    add_resources(ResourceType::Texture, m_textures);
+    add_resources(ResourceType::Mesh, m_meshes);
+    add_resources(ResourceType::Shader, m_shaders);
+    add_resources(ResourceType::Animation, m_animations);
+
+    std::ranges::sort(resources, [](ResidentResource const& lhs, ResidentResource const& rhs) { return lhs.size > rhs.size; });
+
+    return resources;
 }
 
-void ResourceManager::reset_state() const
+void ResourceManager::log_resident_resources() const
 {
-    // NOTE: When unloading a scene all entities should have already been destroyed,
-    //       and their drawables, and thus materials, uninitialized - unregistered.
-    for (auto const& shader : m_shaders)
+    auto const resources = get_resident_resources();
+
+    u64 total_size = 0;
+    for (auto const& resource : resources)
     {
-        shader->materials.clear();
+        Debug::log(std::format("{} {}: {} KB, {} references, unused for {} frames", get_type_name(resource.type), resource.name,
+                               resource.size / 1024, resource.reference_count, resource.frames_unused));
+        total_size += resource.size;
     }
 
-    initialize_default_material();
+    Debug::log(std::format("{} resident resources, {} KB of {} KB budget", resources.size(), total_size / 1024, memory_budget / 1024));
 }
 
-std::string ResourceManager::generate_key(std::stringstream const& stream) const
+bool ResourceManager::evict(ResidentResource const& resource)
 {
-    return stream.str();
+    switch (resource.type)
+    {
+    case ResourceType::Texture:
+        return evict<Texture>(resource.key);
+    case ResourceType::Mesh:
+        return evict<Mesh>(resource.key);
+    case ResourceType::Shader:
+        return evict<Shader>(resource.key);
+    case ResourceType::Animation:
+        return evict<Animation>(resource.key);
+    default:
+        std::unreachable();
+    }
 }
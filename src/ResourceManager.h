@@ -1,20 +1,59 @@
 #pragma once
 
-#include <unordered_map>
+#include <atomic>
+#include <initializer_list>
+#include <mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include "AK/AK.h"
 #include "AK/Types.h"
 #include "Mesh.h"
 #include "Model.h"
+#include "ResourceCache.h"
+#include "Rig.h"
 #include "Shader.h"
 #include "Texture.h"
+#include "TextureDecodeQueue.h"
+
+enum class ResourceType
+{
+    Texture,
+    Mesh,
+    Shader,
+    Animation,
+};
+
+struct ResidentResource
+{
+    ResourceType type = ResourceType::Texture;
+    ResourceKey key = 0;
+    std::string name = {};
+
+    // Estimated from the resource's dimensions, shaders are counted as 0.
+    u64 size = 0;
+
+    // Owners other than ResourceManager. Resources with 0 can be evicted.
+    u32 reference_count = 0;
+    u64 frames_unused = 0;
+};
 
 // How ResourceManager works:
 //
-// 1. Generate key (each function may have its own implementation) and save it in a local variable.
-// 2. Call template method get_from_vector() specifying desired <TYPE> and providing the key. It will return either nullptr or a valid resource.
-// 3a. If a valid resource is returned by get_from_vector(), you've got your resource!
-// 3b. If a nullptr is returned by get_from_vector(), an internal loading function is called and the returned value is added to vector along with key and ID to the map.
+// 1. Generate a 64-bit key by hashing the paths and any additional data that identify the resource.
+// 2. Call template method get_or_load() specifying desired <TYPE>, the key, a name for reports and a function that loads the resource.
+// 3a. If the resource is cached, or another thread is already loading it, you get that one.
+// 3b. Otherwise the function is called and its result is cached.
+//
+// Every load_*() function can be called from any thread. With OpenGL, resources that create GPU objects still have to be loaded
+// on the main thread, since that's where the context is current. DirectX 11 devices are free-threaded.
+//
+// The returned shared_ptr is the handle. ResourceManager keeps its own reference, so a resource is never destroyed when its last
+// user drops it in the middle of a frame. collect_garbage() destroys unreferenced resources at the end of the frame,
+// least recently used first, but only while the resident resources take more than memory_budget.
 class ResourceManager
 {
 public:
@@ -25,6 +64,17 @@ public:
     static ResourceManager& get_instance();
 
     std::shared_ptr<Texture> load_texture(std::string const& path, TextureType const type, TextureSettings const& settings = {});
+
+    // Returns a placeholder right away and decodes the image on a worker thread, finalize_textures() uploads it later.
+    // Use load_texture() when the texture's data or size is needed immediately. load_texture() waits for textures that are still
+    // being decoded and uploads them, so it has to be called on the main thread once a texture was requested asynchronously.
+    std::shared_ptr<Texture> load_texture_async(std::string const& path, TextureType const type, TextureSettings const& settings = {});
+
+    // Uploads decoded textures until budget_ms runs out, but always at least one. Call once per frame on the main thread.
+    void finalize_textures(double const budget_ms);
+    void finish_textures();
+    void stop_async_loading();
+    [[nodiscard]] u32 get_pending_texture_count() const;
     std::shared_ptr<Texture> load_cubemap(std::vector<std::string> const& paths, TextureType const type,
                                           TextureSettings const& settings = {});
     std::shared_ptr<Texture> load_cubemap(std::string const& path, TextureType const type, TextureSettings const& settings = {});
@@ -35,65 +85,98 @@ public:
     std::shared_ptr<Shader> load_shader(std::string const& vertex_path, std::string const& tessellation_control_path,
                                         std::string const& tessellation_evaluation_path, std::string const& fragment_path);
 
-    std::shared_ptr<Mesh> load_mesh(u32 const array_id, std::string const& name, std::vector<Vertex> const& vertices,
-                                    std::vector<u32> const& indices, std::vector<std::shared_ptr<Texture>> const& textures,
+    // Vertices are packed into the GPU vertex formats and bounds calculated from them, but only if the mesh isn't loaded yet.
+    // Indexed triangle lists are also reordered by MeshOptimizer first and, with generate_lods, simplified into levels of detail.
+    std::shared_ptr<Mesh> load_mesh(u32 const array_id, std::string const& name, std::span<Vertex const> const vertices,
+                                    std::span<u32 const> const indices, std::vector<std::shared_ptr<Texture>> const& textures,
                                     DrawType const draw_type, std::shared_ptr<Material> const& material,
+                                    DrawFunctionType const draw_function = DrawFunctionType::Indexed, bool const generate_lods = false);
+
+    // For data that is already packed, e.g. a cooked model. Skin vertices are empty for static meshes.
+    std::shared_ptr<Mesh> load_mesh(u32 const array_id, std::string const& name, std::span<StaticVertex const> const vertices,
+                                    std::span<SkinVertex const> const skin_vertices, std::span<u32 const> const indices,
+                                    std::span<MeshLod const> const lods, BoundingBox const& local_bounds,
+                                    std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
+                                    std::shared_ptr<Material> const& material,
                                     DrawFunctionType const draw_function = DrawFunctionType::Indexed);
 
+    std::shared_ptr<Animation> load_animation(std::string const& model_path, std::string const& anim_path,
+                                              ModelSkin const& skin);
+
     void reset_state() const;
 
+    // Call once per frame, after rendering.
+    void collect_garbage();
+
+    // Destroys every unreferenced resource in the next collect_garbage(), regardless of the budget.
+    void unload_unused();
+
+    [[nodiscard]] u64 get_resident_size() const;
+    [[nodiscard]] std::vector<ResidentResource> get_resident_resources() const;
+    void log_resident_resources() const;
+
+    // Bytes unreferenced resources may keep occupying before they are evicted.
+    u64 memory_budget = 512ull * 1024 * 1024;
+
 private:
     ResourceManager() = default;
 
     template<typename T>
-    std::shared_ptr<T> get_from_vector(std::string const& key)
+    ResourceCache<T>& get_cache()
     {
-        i32 id = -1;
-
         // TODO: This can be automatized by extending EngineHeaderTool.
         // For now it's good enough.
         if constexpr (std::is_same_v<T, Texture>)
-        {
-            auto const it = names_to_textures.find(key);
-            if (it != names_to_textures.end())
-            {
-                id = it->second;
-                return m_textures[id];
-            }
-        }
+            return m_textures;
         else if constexpr (std::is_same_v<T, Mesh>)
-        {
-            auto const it = names_to_meshes.find(key);
-            if (it != names_to_meshes.end())
-            {
-                id = it->second;
-                return m_meshes[id];
-            }
-        }
+            return m_meshes;
         else if constexpr (std::is_same_v<T, Shader>)
-        {
-            auto const it = names_to_shaders.find(key);
-            if (it != names_to_shaders.end())
-            {
-                id = it->second;
-                return m_shaders[id];
-            }
-        }
-
-        return nullptr;
+            return m_shaders;
+        else if constexpr (std::is_same_v<T, Animation>)
+            return m_animations;
     }
 
-    [[nodiscard]] std::string generate_key(std::stringstream const& stream) const;
+    template<typename T, typename Loader>
+    std::shared_ptr<T> get_or_load(ResourceKey const key, std::string_view const name, Loader&& loader)
+    {
+        return get_cache<T>().get_or_load(key, name, m_frame.load(std::memory_order_relaxed), std::forward<Loader>(loader));
+    }
+
+    template<typename T>
+    void collect_entries(ResourceType const type, u64& resident_size, std::vector<ResidentResource>& unreferenced);
+
+    // Return false if the resource was picked up again or is already gone, it then still occupies its memory or never did.
+    template<typename T>
+    bool evict(ResourceKey const key);
+
+    bool evict(ResidentResource const& resource);
+
+    static std::shared_ptr<Mesh> create_mesh(std::span<Vertex const> const vertices, std::span<u32 const> const indices,
+                                             std::vector<std::shared_ptr<Texture>> const& textures, DrawType const draw_type,
+                                             std::shared_ptr<Material> const& material, DrawFunctionType const draw_function,
+                                             bool const generate_lods);
+
+    // Hashes every part together with its length, so ("ab", "c") and ("a", "bc") get different keys.
+    [[nodiscard]] static ResourceKey generate_key(std::initializer_list<std::string_view> const parts,
+                                                  ResourceKey const seed = AK::fnv_offset_basis);
+    [[nodiscard]] static ResourceKey generate_mesh_key(u32 const array_id, std::string const& name,
+                                                       std::vector<std::shared_ptr<Texture>> const& textures);
+
+    void wait_for_texture(std::shared_ptr<Texture> const& texture);
+    void finalize_texture(TextureDecodeQueue::Result const& result);
+
+    ResourceCache<Texture> m_textures = {};
+    ResourceCache<Mesh> m_meshes = {};
+    ResourceCache<Shader> m_shaders = {};
+    ResourceCache<Animation> m_animations = {};
 
-    // NOTE: RM currently doesn't allow unloadading any resources that were previously loaded.
-    std::vector<std::shared_ptr<Texture>> m_textures = {};
-    std::vector<std::shared_ptr<Mesh>> m_meshes = {};
-    std::vector<std::shared_ptr<Shader>> m_shaders = {};
+    std::atomic<u64> m_frame = 0;
+    u64 m_resident_size = 0;
+    bool m_unload_unused = false;
 
-    // KEYS (usually generated from path and optionally additional data) | INDICES, in a respective vector.
-    std::unordered_map<std::string, u16> names_to_textures = {};
-    std::unordered_map<std::string, u16> names_to_meshes = {};
-    std::unordered_map<std::string, u16> names_to_shaders = {};
+    std::mutex m_texture_decode_queue_mutex = {};
+    std::unique_ptr<TextureDecodeQueue> m_texture_decode_queue = nullptr;
+    std::atomic<u32> m_pending_textures = 0;
 
     inline static std::shared_ptr<ResourceManager> m_instance;
 };
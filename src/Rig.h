@@ -1,20 +1,65 @@
 #pragma once
 
 #include "AK/Math.h"
-#include "assimp/Importer.hpp"
-#include "assimp/anim.h"
+#include "Bounds.h"
+#include "VirtualFileSystem.h"
+#include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtx/quaternion.hpp"
 
+#include <algorithm>
+#include <array>
 #include <map>
+#include <span>
 #include <string>
 #include <vector>
 
+// Flattened joint hierarchy, built once at load time. Joints are stored in depth-first order,
+// so a parent always has a lower index than any of its children and the pose can be evaluated in a single linear pass.
 struct Rig
 {
     std::vector<std::string> bone_names = {};
     std::vector<i32> parents = {};
+
+    // Distance from the root joint, used to drop the finest joints at lower animation LODs.
+    std::vector<u32> depths = {};
+
+    // Local bind pose split into components. Scale lives next to the xforms because xform has no room for it.
     std::vector<AK::xform> ref_pose = {};
+    std::vector<glm::vec3> ref_pose_scales = {};
     u32 num_bones = 0;
+
+    // Local bind transform of every joint, the source ref_pose and ref_pose_scales are built from.
+    std::vector<glm::mat4> ref_pose_matrices = {};
+
+    // Index into Animation::bones, -1 if the joint isn't animated by the clip.
+    std::vector<i32> channels = {};
+
+    // Index into the skinning palette, -1 if no vertex is skinned to the joint.
+    std::vector<i32> palette_ids = {};
+    std::vector<glm::mat4> offsets = {};
+
+    // Number of matrices in the skinning palette, equal to the number of bones the model's vertices reference.
+    u32 palette_size = 0;
+
+    void build_ref_pose()
+    {
+        ref_pose.resize(ref_pose_matrices.size());
+        ref_pose_scales.resize(ref_pose_matrices.size());
+
+        for (size_t i = 0; i < ref_pose_matrices.size(); ++i)
+        {
+            glm::mat4 const& matrix = ref_pose_matrices[i];
+            glm::vec3 const scale = {glm::length(glm::vec3(matrix[0])), glm::length(glm::vec3(matrix[1])),
+                                     glm::length(glm::vec3(matrix[2]))};
+
+            // Strip the scale before extracting the rotation, quat_cast expects an orthonormal matrix.
+            glm::mat3 const rotation = {glm::vec3(matrix[0]) / scale.x, glm::vec3(matrix[1]) / scale.y, glm::vec3(matrix[2]) / scale.z};
+
+            ref_pose[i].pos = glm::vec3(matrix[3]);
+            ref_pose[i].rot = glm::normalize(glm::quat_cast(rotation));
+            ref_pose_scales[i] = scale;
+        }
+    }
 };
 
 struct BoneInfo
@@ -23,126 +68,184 @@ struct BoneInfo
     glm::mat4 offset = glm::mat4(1.0f);
 };
 
-struct KeyPosition
+// What a skinned model's meshes tell its clips: bone IDs and offsets, and for every bone ID
+// the bind pose box of the vertices it influences (min > max if it influences none).
+struct ModelSkin
 {
-    glm::vec3 position = {0.0f, 0.0f, 0.0f};
-    float time_stamp = 0.0f;
+    std::map<std::string, BoneInfo> bone_info_map = {};
+    std::vector<BoundingBox> joint_bounds = {};
 };
 
-struct KeyRotation
+// Compressed keyframe. time_stamp is the key time quantized to 1/65535 of the clip duration.
+// For Vec3Track value holds the key quantized relative to the track bounds,
+// for QuatTrack it's a 48-bit smallest-three quaternion (see QuatTrack::decode).
+struct QuantizedKey
 {
-    glm::quat orientation = {1.0f, 0.0f, 0.0f, 0.0f};
-    float time_stamp = 0.0f;
+    u16 time_stamp = 0;
+    std::array<u16, 3> value = {};
 };
 
-struct Bone
+// Last keyframe index sampled on each channel of a bone. Owned by whoever plays the clip,
+// so playback that only moves forward finds the next key in O(1) instead of scanning from the start.
+struct BoneCursor
 {
-    std::vector<KeyPosition> positions = {};
-    std::vector<KeyRotation> rotations = {};
+    u32 position = 0;
+    u32 rotation = 0;
+    u32 scale = 0;
+};
 
-    u32 num_positions = 0;
-    u32 num_rotations = 0;
+// Returns index i of the key segment [i, i + 1] containing animation_time. Requires at least two keys.
+// Times outside the clip are clamped to the first or last segment.
+template<typename Key>
+u32 find_key_index(std::span<Key const> const keys, float const animation_time, u32& cursor)
+{
+    u32 const last_segment = static_cast<u32>(keys.size()) - 2;
 
-    glm::mat4 local_transform = glm::mat4(1.0f);
-    std::string name = "";
-    i32 id = -1;
+    if (animation_time <= keys[0].time_stamp)
+    {
+        cursor = 0;
+        return cursor;
+    }
 
-    void init(std::string const& name, i32 id, aiNodeAnim const* channel)
+    if (animation_time >= keys[last_segment + 1].time_stamp)
     {
-        this->name = name;
-        this->id = id;
-        num_positions = channel->mNumPositionKeys;
+        cursor = last_segment;
+        return cursor;
+    }
 
-        for (int position_index = 0; position_index < num_positions; ++position_index)
+    // Monotonic playback: the answer is the cached segment or one of the next few.
+    u32 constexpr max_forward_steps = 4;
+    u32 index = std::min(cursor, last_segment);
+    if (keys[index].time_stamp <= animation_time)
+    {
+        for (u32 step = 0; step < max_forward_steps && index <= last_segment; ++step, ++index)
         {
-            aiVector3D ai_position = channel->mPositionKeys[position_index].mValue;
-            float const time_stamp = channel->mPositionKeys[position_index].mTime;
-            KeyPosition data;
-            data.position = {ai_position.x, ai_position.y, ai_position.z};
-            data.time_stamp = time_stamp;
-            positions.push_back(data);
+            if (animation_time < keys[index + 1].time_stamp)
+            {
+                cursor = index;
+                return cursor;
+            }
         }
+    }
 
-        num_rotations = channel->mNumRotationKeys;
+    // Seek or loop: fall back to binary search.
+    auto const it = std::upper_bound(keys.begin(), keys.end(), animation_time,
+                                     [](float const time, Key const& key) { return time < key.time_stamp; });
+    cursor = static_cast<u32>(it - keys.begin()) - 1;
+    return cursor;
+}
 
-        for (int rotation_index = 0; rotation_index < num_rotations; ++rotation_index)
-        {
-            aiQuaternion ai_orientation = channel->mRotationKeys[rotation_index].mValue;
-            float const time_stamp = channel->mRotationKeys[rotation_index].mTime;
-            KeyRotation data;
-            data.orientation = {ai_orientation.w, ai_orientation.x, ai_orientation.y, ai_orientation.z};
-            data.time_stamp = time_stamp;
-            rotations.push_back(data);
-        }
-    }
+// Clamped, so sampling before the first or past the last key holds the end pose.
+inline float get_interpolation_factor(float last_time_stamp, float next_time_stamp, float animation_time)
+{
+    float const mid_way_length = animation_time - last_time_stamp;
+    float const frames_diff = next_time_stamp - last_time_stamp;
+
+    if (frames_diff <= 0.0f)
+        return 0.0f;
+
+    return glm::clamp(mid_way_length / frames_diff, 0.0f, 1.0f);
+}
 
-    void update(float animation_time)
+// Tracks don't own their keys, they point into the key storage of the Animation they belong to.
+struct Vec3Track
+{
+    std::span<QuantizedKey const> keys = {};
+    glm::vec3 min = {0.0f, 0.0f, 0.0f};
+    glm::vec3 extent = {0.0f, 0.0f, 0.0f};
+
+    glm::vec3 decode(QuantizedKey const& key) const
     {
-        glm::mat4 const translation = interpolate_position(animation_time);
-        glm::mat4 const rotation = interpolate_rotation(animation_time);
-        local_transform = translation * rotation * glm::mat4(1.0f); // skalujesz zalujesz
+        return min + extent * (glm::vec3(key.value[0], key.value[1], key.value[2]) / 65535.0f);
     }
 
-    u32 get_position_index(float animation_time)
+    glm::vec3 sample(float key_time, u32& cursor, glm::vec3 const& fallback) const
     {
-        for (int index = 0; index < num_positions - 1; ++index)
-        {
-            if (animation_time < positions[index + 1].time_stamp)
-                return index;
-        }
-        assert(false);
-        std::unreachable();
+        if (keys.empty())
+            return fallback;
+
+        if (keys.size() == 1)
+            return decode(keys[0]);
+
+        auto const p0_index = find_key_index(keys, key_time, cursor);
+        auto const p1_index = p0_index + 1;
+        return glm::mix(decode(keys[p0_index]), decode(keys[p1_index]),
+                        get_interpolation_factor(keys[p0_index].time_stamp, keys[p1_index].time_stamp, key_time));
     }
+};
+
+struct QuatTrack
+{
+    std::span<QuantizedKey const> keys = {};
 
-    u32 get_rotation_index(float animation_time)
+    // Smallest three: the largest component (by magnitude) is dropped and rebuilt from the unit length constraint.
+    // Top bits of the first two words hold its index, the low 15 bits of each word store one of the remaining three
+    // components, which always lie in [-1/sqrt(2), 1/sqrt(2)].
+    static glm::quat decode(QuantizedKey const& key)
     {
-        for (int index = 0; index < num_rotations - 1; ++index)
+        float constexpr range = 0.70710678f;
+        u32 const largest = ((key.value[0] >> 15) << 1) | (key.value[1] >> 15);
+
+        std::array<float, 3> small = {};
+        float sum = 0.0f;
+        for (u32 i = 0; i < 3; ++i)
         {
-            if (animation_time < rotations[index + 1].time_stamp)
-                return index;
+            small[i] = (static_cast<float>(key.value[i] & 0x7FFF) / 32767.0f * 2.0f - 1.0f) * range;
+            sum += small[i] * small[i];
         }
-        assert(false);
-        std::unreachable();
+
+        std::array<float, 4> xyzw = {};
+        u32 small_index = 0;
+        for (u32 i = 0; i < 4; ++i)
+            xyzw[i] = i == largest ? glm::sqrt(glm::max(0.0f, 1.0f - sum)) : small[small_index++];
+
+        return glm::normalize(glm::quat(xyzw[3], xyzw[0], xyzw[1], xyzw[2]));
     }
 
-    glm::mat4 interpolate_position(float animation_time)
+    glm::quat sample(float key_time, u32& cursor) const
     {
-        if (num_positions == 1)
-            return glm::translate(glm::mat4(1.0f), positions[0].position);
+        if (keys.empty())
+            return {1.0f, 0.0f, 0.0f, 0.0f};
 
-        auto const p0_index = get_position_index(animation_time);
-        auto const p1_index = p0_index + 1;
-        glm::vec3 const final_position =
-            glm::mix(positions[p0_index].position, positions[p1_index].position,
-                     get_scale_factor(positions[p0_index].time_stamp, positions[p1_index].time_stamp, animation_time));
+        if (keys.size() == 1)
+            return decode(keys[0]);
 
-        return glm::translate(glm::mat4(1.0f), final_position);
+        auto const p0_index = find_key_index(keys, key_time, cursor);
+        auto const p1_index = p0_index + 1;
+        glm::quat const final_rotation =
+            glm::slerp(decode(keys[p0_index]), decode(keys[p1_index]),
+                       get_interpolation_factor(keys[p0_index].time_stamp, keys[p1_index].time_stamp, key_time));
+        return glm::normalize(final_rotation);
     }
+};
 
-    glm::mat4 interpolate_rotation(float animation_time)
+struct Bone
+{
+    Vec3Track positions = {};
+    QuatTrack rotations = {};
+    Vec3Track scales = {};
+
+    // Converts animation time (in ticks) into the quantized key time domain.
+    float time_to_key = 0.0f;
+
+    std::string name = "";
+    i32 id = -1;
+
+    // Bone data is shared between every instance playing the clip, so all playback state lives in the cursor.
+    // Tracks without keys leave the passed in (bind pose) value untouched.
+    void sample(float animation_time, BoneCursor& cursor, glm::vec3& position, glm::quat& rotation, glm::vec3& scale) const
     {
-        if (num_rotations == 1)
-        {
-            auto const rotation = glm::normalize(rotations[0].orientation);
-            return glm::toMat4(rotation);
-        }
+        float const key_time = animation_time * time_to_key;
 
-        auto const p0_index = get_rotation_index(animation_time);
-        auto const p1_index = p0_index + 1;
-        glm::quat final_rotation =
-            glm::slerp(rotations[p0_index].orientation, rotations[p1_index].orientation,
-                       get_scale_factor(rotations[p0_index].time_stamp, rotations[p1_index].time_stamp, animation_time));
-        final_rotation = glm::normalize(final_rotation);
-        return glm::toMat4(final_rotation);
+        position = positions.sample(key_time, cursor.position, position);
+        if (!rotations.keys.empty())
+            rotation = rotations.sample(key_time, cursor.rotation);
+        scale = scales.sample(key_time, cursor.scale, scale);
     }
 
-    float get_scale_factor(float last_time_stamp, float next_time_stamp, float animation_time)
+    [[nodiscard]] size_t get_keys_size() const
     {
-        float scaleFactor = 0.0f;
-        float const mid_way_length = animation_time - last_time_stamp;
-        float const frames_diff = next_time_stamp - last_time_stamp;
-        scaleFactor = mid_way_length / frames_diff;
-        return scaleFactor;
+        return (positions.keys.size() + rotations.keys.size() + scales.keys.size()) * sizeof(QuantizedKey);
     }
 };
 
@@ -154,6 +257,7 @@ struct AssimpNodeData
     std::vector<AssimpNodeData> children = {};
 };
 
+// Immutable clip and rig data. Loaded once per model and animation pair by ResourceManager and shared between instances.
 struct Animation
 {
     float duration = 0.0f;
@@ -161,4 +265,69 @@ struct Animation
     std::vector<Bone> bones = {};
     AssimpNodeData root_node = {};
     std::map<std::string, BoneInfo> bone_info_map = {};
+    Rig rig = {};
+
+    // Keys of every track. Imported clips own them, cached ones point straight into the mapped cache file.
+    std::vector<QuantizedKey> key_storage = {};
+    FileView key_file = {};
+
+    // Model space box enclosing the skinned mesh over the whole clip, see AnimationFactory::calculate_bounds.
+    BoundingBox bounds = {};
+    bool has_bounds = false;
+};
+
+enum class AnimationLOD
+{
+    Full,
+    Reduced,
+    Frozen,
+    Count
+};
+
+struct AnimationLODSettings
+{
+    // Models closer to the camera than this are evaluated every frame.
+    float full_distance = 25.0f;
+
+    // Time between pose evaluations of Reduced models, in seconds.
+    float reduced_update_interval = 1.0f / 15.0f;
+
+    // Joints deeper than this keep their bind pose on Reduced models.
+    u32 reduced_max_joint_depth = 8;
+};
+
+// Lightweight per-instance playback state.
+struct AnimationPlayback
+{
+    double time = 0.0;
+    float speed = 1.0f;
+    bool loop = true;
+
+    // Picked by AnimationEngine every frame. Reduced evaluates the pose only every few frames and blends
+    // between the last two evaluations, Frozen only advances the time.
+    AnimationLOD lod = AnimationLOD::Full;
+    double time_since_evaluation = 0.0;
+
+    // One keyframe cursor per animated bone, indexed the same as Animation::bones.
+    std::vector<BoneCursor> cursors = {};
+
+    void advance(Animation const& animation, double const delta)
+    {
+        if (animation.duration <= 0.0f)
+            return;
+
+        time += animation.ticks_per_second * speed * delta;
+
+        if (loop)
+        {
+            time = fmod(time, animation.duration);
+
+            if (time < 0.0)
+                time += animation.duration;
+        }
+        else
+        {
+            time = glm::clamp(time, 0.0, static_cast<double>(animation.duration));
+        }
+    }
 };
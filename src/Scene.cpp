@@ -17,6 +17,10 @@ void Scene::unload()
 
     for (auto const& entity : top_level_entities)
     {
+        // Destroying an entity can destroy others, e.g. GameController destroys the level it was still loading.
+        if (std::ranges::find(entities, entity) == entities.end())
+            continue;
+
         entity->destroy_immediate();
     }
 
@@ -2,17 +2,25 @@
 
 #include "AssetPreloader.h"
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <format>
 #include <fstream>
+#include <functional>
+#include <future>
 #include <iostream>
+#include <iterator>
 #include <unordered_set>
 
 #include <yaml-cpp/yaml.h>
 
 #include "AK/ScopeGuard.h"
+#include "BinaryScene.h"
 #include "Button.h"
 #include "Camera.h"
 #include "Collider2D.h"
+#include "ComponentRegistry.h"
 #include "Cube.h"
 #include "Curve.h"
 #include "DebugDrawing.h"
@@ -64,10 +72,20 @@
 #include "Sphere.h"
 #include "SpotLight.h"
 #include "Sprite.h"
+#include "VirtualFileSystem.h"
 #include "Water.h"
 #include "yaml-cpp-extensions.h"
 // # Put new header here
 
+namespace
+{
+
+// # Auto binary layout start
+u32 constexpr binary_scene_layout_hash = 0x1DF4FBE0;
+// # Auto binary layout end
+
+}
+
 SceneSerializer::SceneSerializer(std::shared_ptr<Scene> const& scene) : m_scene(scene)
 {
 }
@@ -127,26 +145,39 @@ std::shared_ptr<Entity> SceneSerializer::get_entity_from_pool(std::string const&
 
 void SceneSerializer::auto_serialize_component(YAML::Emitter& out, std::shared_ptr<Component> const& component)
 {
+    u32 const type = ComponentRegistry::get_id(*component);
+
+    if (type == ComponentRegistry::invalid_id)
+    {
+        // NOTE: This only returns unmangled name while using the MSVC compiler
+        std::string const name = typeid(*component).name();
+        std::cout << "Error. Serialization of component " << name.substr(6) << " failed."
+                  << "\n";
+        return;
+    }
+
+    out << YAML::BeginMap;
+    out << YAML::Key << "ComponentName" << YAML::Value << std::string(ComponentRegistry::get_types()[type].name);
+    out << YAML::Key << "guid" << YAML::Value << component->guid;
+    out << YAML::Key << "custom_name" << YAML::Value << component->custom_name;
+
+    switch (type)
+    {
     // # Auto serialization start
-    if (auto const camera = std::dynamic_pointer_cast<class Camera>(component); camera != nullptr)
+    case 0: // CameraComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "CameraComponent";
-        out << YAML::Key << "guid" << YAML::Value << camera->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << camera->custom_name;
+        auto const camera = std::static_pointer_cast<class Camera>(component);
         out << YAML::Key << "width" << YAML::Value << camera->width;
         out << YAML::Key << "height" << YAML::Value << camera->height;
         out << YAML::Key << "fov" << YAML::Value << camera->fov;
         out << YAML::Key << "near_plane" << YAML::Value << camera->near_plane;
         out << YAML::Key << "far_plane" << YAML::Value << camera->far_plane;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const collider2d = std::dynamic_pointer_cast<class Collider2D>(component); collider2d != nullptr)
+
+    case 1: // Collider2DComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "Collider2DComponent";
-        out << YAML::Key << "guid" << YAML::Value << collider2d->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << collider2d->custom_name;
+        auto const collider2d = std::static_pointer_cast<class Collider2D>(component);
         out << YAML::Key << "offset" << YAML::Value << collider2d->offset;
         out << YAML::Key << "is_trigger" << YAML::Value << collider2d->is_trigger;
         out << YAML::Key << "is_static" << YAML::Value << collider2d->is_static;
@@ -156,45 +187,34 @@ void SceneSerializer::auto_serialize_component(YAML::Emitter& out, std::shared_p
         out << YAML::Key << "radius" << YAML::Value << collider2d->radius;
         out << YAML::Key << "drag" << YAML::Value << collider2d->drag;
         out << YAML::Key << "velocity" << YAML::Value << collider2d->velocity;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const curve = std::dynamic_pointer_cast<class Curve>(component); curve != nullptr)
+
+    case 2: // CurveComponent
     {
-        out << YAML::BeginMap;
-        // # Put new Curve kid here
-        if (auto const path = std::dynamic_pointer_cast<class Path>(component); path != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "PathComponent";
-            out << YAML::Key << "guid" << YAML::Value << path->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << path->custom_name;
-        }
-        else
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "CurveComponent";
-            out << YAML::Key << "guid" << YAML::Value << curve->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << curve->custom_name;
-        }
+        auto const curve = std::static_pointer_cast<class Curve>(component);
         out << YAML::Key << "points" << YAML::Value << curve->points;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const debuginputcontroller = std::dynamic_pointer_cast<class DebugInputController>(component);
-             debuginputcontroller != nullptr)
+
+    case 3: // PathComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "DebugInputControllerComponent";
-        out << YAML::Key << "guid" << YAML::Value << debuginputcontroller->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << debuginputcontroller->custom_name;
+        auto const path = std::static_pointer_cast<class Path>(component);
+        out << YAML::Key << "points" << YAML::Value << path->points;
+        break;
+    }
+
+    case 4: // DebugInputControllerComponent
+    {
+        auto const debuginputcontroller = std::static_pointer_cast<class DebugInputController>(component);
         out << YAML::Key << "gamma" << YAML::Value << debuginputcontroller->gamma;
         out << YAML::Key << "exposure" << YAML::Value << debuginputcontroller->exposure;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const dialoguepromptcontroller = std::dynamic_pointer_cast<class DialoguePromptController>(component);
-             dialoguepromptcontroller != nullptr)
+
+    case 5: // DialoguePromptControllerComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "DialoguePromptControllerComponent";
-        out << YAML::Key << "guid" << YAML::Value << dialoguepromptcontroller->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << dialoguepromptcontroller->custom_name;
+        auto const dialoguepromptcontroller = std::static_pointer_cast<class DialoguePromptController>(component);
         out << YAML::Key << "interp_speed" << YAML::Value << dialoguepromptcontroller->interp_speed;
         out << YAML::Key << "dialogue_panel" << YAML::Value << dialoguepromptcontroller->dialogue_panel;
         out << YAML::Key << "panel_parent" << YAML::Value << dialoguepromptcontroller->panel_parent;
@@ -203,224 +223,206 @@ void SceneSerializer::auto_serialize_component(YAML::Emitter& out, std::shared_p
         out << YAML::Key << "middle_text" << YAML::Value << dialoguepromptcontroller->middle_text;
         out << YAML::Key << "lower_text" << YAML::Value << dialoguepromptcontroller->lower_text;
         out << YAML::Key << "dialogue_objects" << YAML::Value << dialoguepromptcontroller->dialogue_objects;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const drawable = std::dynamic_pointer_cast<class Drawable>(component); drawable != nullptr)
+
+    case 6: // ButtonComponent
     {
-        out << YAML::BeginMap;
-        // # Put new Drawable kid here
-        if (auto const skinnedmodel = std::dynamic_pointer_cast<class SkinnedModel>(component); skinnedmodel != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "SkinnedModelComponent";
-            out << YAML::Key << "guid" << YAML::Value << skinnedmodel->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << skinnedmodel->custom_name;
-            out << YAML::Key << "model_path" << YAML::Value << skinnedmodel->model_path;
-            out << YAML::Key << "anim_path" << YAML::Value << skinnedmodel->anim_path;
-        }
-        else if (auto const screentext = std::dynamic_pointer_cast<class ScreenText>(component); screentext != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "ScreenTextComponent";
-            out << YAML::Key << "guid" << YAML::Value << screentext->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << screentext->custom_name;
-            out << YAML::Key << "text" << YAML::Value << screentext->text;
-            out << YAML::Key << "position" << YAML::Value << screentext->position;
-            out << YAML::Key << "font_size" << YAML::Value << screentext->font_size;
-            out << YAML::Key << "color" << YAML::Value << screentext->color;
-            out << YAML::Key << "flags" << YAML::Value << screentext->flags;
-            out << YAML::Key << "font_name" << YAML::Value << screentext->font_name;
-            out << YAML::Key << "bold" << YAML::Value << screentext->bold;
-            out << YAML::Key << "button_ref" << YAML::Value << screentext->button_ref;
-        }
-        else if (auto const panel = std::dynamic_pointer_cast<class Panel>(component); panel != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "PanelComponent";
-            out << YAML::Key << "guid" << YAML::Value << panel->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << panel->custom_name;
-            out << YAML::Key << "background_path" << YAML::Value << panel->background_path;
-        }
-        else if (auto const model = std::dynamic_pointer_cast<class Model>(component); model != nullptr)
-        {
-            // # Put new Model kid here
-            if (auto const water = std::dynamic_pointer_cast<class Water>(component); water != nullptr)
-            {
-                out << YAML::Key << "ComponentName" << YAML::Value << "WaterComponent";
-                out << YAML::Key << "guid" << YAML::Value << water->guid;
-                out << YAML::Key << "custom_name" << YAML::Value << water->custom_name;
-                out << YAML::Key << "waves" << YAML::Value << water->waves;
-                out << YAML::Key << "m_ps_buffer" << YAML::Value << water->m_ps_buffer;
-                out << YAML::Key << "tesselation_level" << YAML::Value << water->tesselation_level;
-            }
-            else if (auto const sprite = std::dynamic_pointer_cast<class Sprite>(component); sprite != nullptr)
-            {
-                out << YAML::Key << "ComponentName" << YAML::Value << "SpriteComponent";
-                out << YAML::Key << "guid" << YAML::Value << sprite->guid;
-                out << YAML::Key << "custom_name" << YAML::Value << sprite->custom_name;
-                out << YAML::Key << "diffuse_texture_path" << YAML::Value << sprite->diffuse_texture_path;
-            }
-            else if (auto const sphere = std::dynamic_pointer_cast<class Sphere>(component); sphere != nullptr)
-            {
-                out << YAML::Key << "ComponentName" << YAML::Value << "SphereComponent";
-                out << YAML::Key << "guid" << YAML::Value << sphere->guid;
-                out << YAML::Key << "custom_name" << YAML::Value << sphere->custom_name;
-                out << YAML::Key << "sector_count" << YAML::Value << sphere->sector_count;
-                out << YAML::Key << "stack_count" << YAML::Value << sphere->stack_count;
-                out << YAML::Key << "texture_path" << YAML::Value << sphere->texture_path;
-                out << YAML::Key << "radius" << YAML::Value << sphere->radius;
-            }
-            else if (auto const cube = std::dynamic_pointer_cast<class Cube>(component); cube != nullptr)
-            {
-                out << YAML::Key << "ComponentName" << YAML::Value << "CubeComponent";
-                out << YAML::Key << "guid" << YAML::Value << cube->guid;
-                out << YAML::Key << "custom_name" << YAML::Value << cube->custom_name;
-                out << YAML::Key << "diffuse_texture_path" << YAML::Value << cube->diffuse_texture_path;
-                out << YAML::Key << "specular_texture_path" << YAML::Value << cube->specular_texture_path;
-            }
-            else
-            {
-                out << YAML::Key << "ComponentName" << YAML::Value << "ModelComponent";
-                out << YAML::Key << "guid" << YAML::Value << model->guid;
-                out << YAML::Key << "custom_name" << YAML::Value << model->custom_name;
-            }
-            out << YAML::Key << "model_path" << YAML::Value << model->model_path;
-        }
-        else if (auto const button = std::dynamic_pointer_cast<class Button>(component); button != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "ButtonComponent";
-            out << YAML::Key << "guid" << YAML::Value << button->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << button->custom_name;
-            out << YAML::Key << "path_default" << YAML::Value << button->path_default;
-            out << YAML::Key << "path_hovered" << YAML::Value << button->path_hovered;
-            out << YAML::Key << "path_pressed" << YAML::Value << button->path_pressed;
-            out << YAML::Key << "top_left_corner" << YAML::Value << button->top_left_corner;
-            out << YAML::Key << "top_right_corner" << YAML::Value << button->top_right_corner;
-            out << YAML::Key << "bottom_left_corner" << YAML::Value << button->bottom_left_corner;
-            out << YAML::Key << "bottom_right_corner" << YAML::Value << button->bottom_right_corner;
-        }
-        else
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "DrawableComponent";
-            out << YAML::Key << "guid" << YAML::Value << drawable->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << drawable->custom_name;
-        }
-        out << YAML::Key << "material" << YAML::Value << drawable->material;
-        out << YAML::EndMap;
+        auto const button = std::static_pointer_cast<class Button>(component);
+        out << YAML::Key << "path_default" << YAML::Value << button->path_default;
+        out << YAML::Key << "path_hovered" << YAML::Value << button->path_hovered;
+        out << YAML::Key << "path_pressed" << YAML::Value << button->path_pressed;
+        out << YAML::Key << "top_left_corner" << YAML::Value << button->top_left_corner;
+        out << YAML::Key << "top_right_corner" << YAML::Value << button->top_right_corner;
+        out << YAML::Key << "bottom_left_corner" << YAML::Value << button->bottom_left_corner;
+        out << YAML::Key << "bottom_right_corner" << YAML::Value << button->bottom_right_corner;
+        out << YAML::Key << "material" << YAML::Value << button->material;
+        break;
     }
-    else if (auto const exampledynamictext = std::dynamic_pointer_cast<class ExampleDynamicText>(component); exampledynamictext != nullptr)
+
+    case 7: // ModelComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ExampleDynamicTextComponent";
-        out << YAML::Key << "guid" << YAML::Value << exampledynamictext->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << exampledynamictext->custom_name;
-        out << YAML::EndMap;
+        auto const model = std::static_pointer_cast<class Model>(component);
+        out << YAML::Key << "model_path" << YAML::Value << model->model_path;
+        out << YAML::Key << "material" << YAML::Value << model->material;
+        break;
     }
-    else if (auto const exampleuibar = std::dynamic_pointer_cast<class ExampleUIBar>(component); exampleuibar != nullptr)
+
+    case 8: // CubeComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ExampleUIBarComponent";
-        out << YAML::Key << "guid" << YAML::Value << exampleuibar->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << exampleuibar->custom_name;
+        auto const cube = std::static_pointer_cast<class Cube>(component);
+        out << YAML::Key << "diffuse_texture_path" << YAML::Value << cube->diffuse_texture_path;
+        out << YAML::Key << "specular_texture_path" << YAML::Value << cube->specular_texture_path;
+        out << YAML::Key << "model_path" << YAML::Value << cube->model_path;
+        out << YAML::Key << "material" << YAML::Value << cube->material;
+        break;
+    }
+
+    case 9: // SphereComponent
+    {
+        auto const sphere = std::static_pointer_cast<class Sphere>(component);
+        out << YAML::Key << "sector_count" << YAML::Value << sphere->sector_count;
+        out << YAML::Key << "stack_count" << YAML::Value << sphere->stack_count;
+        out << YAML::Key << "texture_path" << YAML::Value << sphere->texture_path;
+        out << YAML::Key << "radius" << YAML::Value << sphere->radius;
+        out << YAML::Key << "model_path" << YAML::Value << sphere->model_path;
+        out << YAML::Key << "material" << YAML::Value << sphere->material;
+        break;
+    }
+
+    case 10: // SpriteComponent
+    {
+        auto const sprite = std::static_pointer_cast<class Sprite>(component);
+        out << YAML::Key << "diffuse_texture_path" << YAML::Value << sprite->diffuse_texture_path;
+        out << YAML::Key << "model_path" << YAML::Value << sprite->model_path;
+        out << YAML::Key << "material" << YAML::Value << sprite->material;
+        break;
+    }
+
+    case 11: // WaterComponent
+    {
+        auto const water = std::static_pointer_cast<class Water>(component);
+        out << YAML::Key << "waves" << YAML::Value << water->waves;
+        out << YAML::Key << "m_ps_buffer" << YAML::Value << water->m_ps_buffer;
+        out << YAML::Key << "tesselation_level" << YAML::Value << water->tesselation_level;
+        out << YAML::Key << "model_path" << YAML::Value << water->model_path;
+        out << YAML::Key << "material" << YAML::Value << water->material;
+        break;
+    }
+
+    case 12: // PanelComponent
+    {
+        auto const panel = std::static_pointer_cast<class Panel>(component);
+        out << YAML::Key << "background_path" << YAML::Value << panel->background_path;
+        out << YAML::Key << "material" << YAML::Value << panel->material;
+        break;
+    }
+
+    case 13: // ScreenTextComponent
+    {
+        auto const screentext = std::static_pointer_cast<class ScreenText>(component);
+        out << YAML::Key << "text" << YAML::Value << screentext->text;
+        out << YAML::Key << "position" << YAML::Value << screentext->position;
+        out << YAML::Key << "font_size" << YAML::Value << screentext->font_size;
+        out << YAML::Key << "color" << YAML::Value << screentext->color;
+        out << YAML::Key << "flags" << YAML::Value << screentext->flags;
+        out << YAML::Key << "font_name" << YAML::Value << screentext->font_name;
+        out << YAML::Key << "bold" << YAML::Value << screentext->bold;
+        out << YAML::Key << "button_ref" << YAML::Value << screentext->button_ref;
+        out << YAML::Key << "material" << YAML::Value << screentext->material;
+        break;
+    }
+
+    case 14: // SkinnedModelComponent
+    {
+        auto const skinnedmodel = std::static_pointer_cast<class SkinnedModel>(component);
+        out << YAML::Key << "model_path" << YAML::Value << skinnedmodel->model_path;
+        out << YAML::Key << "anim_path" << YAML::Value << skinnedmodel->anim_path;
+        out << YAML::Key << "material" << YAML::Value << skinnedmodel->material;
+        break;
+    }
+
+    case 15: // ExampleDynamicTextComponent
+        break;
+
+    case 16: // ExampleUIBarComponent
+    {
+        auto const exampleuibar = std::static_pointer_cast<class ExampleUIBar>(component);
         out << YAML::Key << "value" << YAML::Value << exampleuibar->value;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const floater = std::dynamic_pointer_cast<class Floater>(component); floater != nullptr)
+
+    case 17: // FloaterComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "FloaterComponent";
-        out << YAML::Key << "guid" << YAML::Value << floater->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << floater->custom_name;
+        auto const floater = std::static_pointer_cast<class Floater>(component);
         out << YAML::Key << "sink" << YAML::Value << floater->sink;
         out << YAML::Key << "side_floaters_offset" << YAML::Value << floater->side_floaters_offset;
         out << YAML::Key << "side_roation_strength" << YAML::Value << floater->side_roation_strength;
         out << YAML::Key << "forward_rotation_strength" << YAML::Value << floater->forward_rotation_strength;
         out << YAML::Key << "forward_floaters_offest" << YAML::Value << floater->forward_floaters_offest;
         out << YAML::Key << "water" << YAML::Value << floater->water;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const floatersmanager = std::dynamic_pointer_cast<class FloatersManager>(component); floatersmanager != nullptr)
+
+    case 18: // FloatersManagerComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "FloatersManagerComponent";
-        out << YAML::Key << "guid" << YAML::Value << floatersmanager->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << floatersmanager->custom_name;
+        auto const floatersmanager = std::static_pointer_cast<class FloatersManager>(component);
         out << YAML::Key << "big_boat_settings" << YAML::Value << floatersmanager->big_boat_settings;
         out << YAML::Key << "small_boat_settings" << YAML::Value << floatersmanager->small_boat_settings;
         out << YAML::Key << "medium_boat_settings" << YAML::Value << floatersmanager->medium_boat_settings;
         out << YAML::Key << "tool_boat_settings" << YAML::Value << floatersmanager->tool_boat_settings;
         out << YAML::Key << "pirate_boat_settings" << YAML::Value << floatersmanager->pirate_boat_settings;
         out << YAML::Key << "water" << YAML::Value << floatersmanager->water;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const floebutton = std::dynamic_pointer_cast<class FloeButton>(component); floebutton != nullptr)
+
+    case 19: // FloeButtonComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "FloeButtonComponent";
-        out << YAML::Key << "guid" << YAML::Value << floebutton->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << floebutton->custom_name;
+        auto const floebutton = std::static_pointer_cast<class FloeButton>(component);
         out << YAML::Key << "floe_button_type" << YAML::Value << floebutton->floe_button_type;
-        out << YAML::EndMap;
-    }
-    else if (auto const light = std::dynamic_pointer_cast<class Light>(component); light != nullptr)
-    {
-        out << YAML::BeginMap;
-        // # Put new Light kid here
-        if (auto const spotlight = std::dynamic_pointer_cast<class SpotLight>(component); spotlight != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "SpotLightComponent";
-            out << YAML::Key << "guid" << YAML::Value << spotlight->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << spotlight->custom_name;
-            out << YAML::Key << "constant" << YAML::Value << spotlight->constant;
-            out << YAML::Key << "linear" << YAML::Value << spotlight->linear;
-            out << YAML::Key << "quadratic" << YAML::Value << spotlight->quadratic;
-            out << YAML::Key << "scattering_factor" << YAML::Value << spotlight->scattering_factor;
-            out << YAML::Key << "cut_off" << YAML::Value << spotlight->cut_off;
-            out << YAML::Key << "outer_cut_off" << YAML::Value << spotlight->outer_cut_off;
-        }
-        else if (auto const pointlight = std::dynamic_pointer_cast<class PointLight>(component); pointlight != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "PointLightComponent";
-            out << YAML::Key << "guid" << YAML::Value << pointlight->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << pointlight->custom_name;
-            out << YAML::Key << "constant" << YAML::Value << pointlight->constant;
-            out << YAML::Key << "linear" << YAML::Value << pointlight->linear;
-            out << YAML::Key << "quadratic" << YAML::Value << pointlight->quadratic;
-        }
-        else if (auto const directionallight = std::dynamic_pointer_cast<class DirectionalLight>(component); directionallight != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "DirectionalLightComponent";
-            out << YAML::Key << "guid" << YAML::Value << directionallight->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << directionallight->custom_name;
-        }
-        else
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "LightComponent";
-            out << YAML::Key << "guid" << YAML::Value << light->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << light->custom_name;
-        }
-        out << YAML::Key << "ambient" << YAML::Value << light->ambient;
-        out << YAML::Key << "diffuse" << YAML::Value << light->diffuse;
-        out << YAML::Key << "specular" << YAML::Value << light->specular;
-        out << YAML::Key << "m_near_plane" << YAML::Value << light->m_near_plane;
-        out << YAML::Key << "m_far_plane" << YAML::Value << light->m_far_plane;
-        out << YAML::Key << "m_blocker_search_num_samples" << YAML::Value << light->m_blocker_search_num_samples;
-        out << YAML::Key << "m_pcf_num_samples" << YAML::Value << light->m_pcf_num_samples;
-        out << YAML::Key << "m_light_world_size" << YAML::Value << light->m_light_world_size;
-        out << YAML::Key << "m_light_frustum_width" << YAML::Value << light->m_light_frustum_width;
-        out << YAML::EndMap;
-    }
-    else if (auto const nowprompttrigger = std::dynamic_pointer_cast<class NowPromptTrigger>(component); nowprompttrigger != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "NowPromptTriggerComponent";
-        out << YAML::Key << "guid" << YAML::Value << nowprompttrigger->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << nowprompttrigger->custom_name;
-        out << YAML::EndMap;
-    }
-    else if (auto const particlesystem = std::dynamic_pointer_cast<class ParticleSystem>(component); particlesystem != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ParticleSystemComponent";
-        out << YAML::Key << "guid" << YAML::Value << particlesystem->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << particlesystem->custom_name;
+        break;
+    }
+
+    case 20: // DirectionalLightComponent
+    {
+        auto const directionallight = std::static_pointer_cast<class DirectionalLight>(component);
+        out << YAML::Key << "ambient" << YAML::Value << directionallight->ambient;
+        out << YAML::Key << "diffuse" << YAML::Value << directionallight->diffuse;
+        out << YAML::Key << "specular" << YAML::Value << directionallight->specular;
+        out << YAML::Key << "m_near_plane" << YAML::Value << directionallight->m_near_plane;
+        out << YAML::Key << "m_far_plane" << YAML::Value << directionallight->m_far_plane;
+        out << YAML::Key << "m_blocker_search_num_samples" << YAML::Value << directionallight->m_blocker_search_num_samples;
+        out << YAML::Key << "m_pcf_num_samples" << YAML::Value << directionallight->m_pcf_num_samples;
+        out << YAML::Key << "m_light_world_size" << YAML::Value << directionallight->m_light_world_size;
+        out << YAML::Key << "m_light_frustum_width" << YAML::Value << directionallight->m_light_frustum_width;
+        break;
+    }
+
+    case 21: // PointLightComponent
+    {
+        auto const pointlight = std::static_pointer_cast<class PointLight>(component);
+        out << YAML::Key << "constant" << YAML::Value << pointlight->constant;
+        out << YAML::Key << "linear" << YAML::Value << pointlight->linear;
+        out << YAML::Key << "quadratic" << YAML::Value << pointlight->quadratic;
+        out << YAML::Key << "ambient" << YAML::Value << pointlight->ambient;
+        out << YAML::Key << "diffuse" << YAML::Value << pointlight->diffuse;
+        out << YAML::Key << "specular" << YAML::Value << pointlight->specular;
+        out << YAML::Key << "m_near_plane" << YAML::Value << pointlight->m_near_plane;
+        out << YAML::Key << "m_far_plane" << YAML::Value << pointlight->m_far_plane;
+        out << YAML::Key << "m_blocker_search_num_samples" << YAML::Value << pointlight->m_blocker_search_num_samples;
+        out << YAML::Key << "m_pcf_num_samples" << YAML::Value << pointlight->m_pcf_num_samples;
+        out << YAML::Key << "m_light_world_size" << YAML::Value << pointlight->m_light_world_size;
+        out << YAML::Key << "m_light_frustum_width" << YAML::Value << pointlight->m_light_frustum_width;
+        break;
+    }
+
+    case 22: // SpotLightComponent
+    {
+        auto const spotlight = std::static_pointer_cast<class SpotLight>(component);
+        out << YAML::Key << "constant" << YAML::Value << spotlight->constant;
+        out << YAML::Key << "linear" << YAML::Value << spotlight->linear;
+        out << YAML::Key << "quadratic" << YAML::Value << spotlight->quadratic;
+        out << YAML::Key << "scattering_factor" << YAML::Value << spotlight->scattering_factor;
+        out << YAML::Key << "cut_off" << YAML::Value << spotlight->cut_off;
+        out << YAML::Key << "outer_cut_off" << YAML::Value << spotlight->outer_cut_off;
+        out << YAML::Key << "ambient" << YAML::Value << spotlight->ambient;
+        out << YAML::Key << "diffuse" << YAML::Value << spotlight->diffuse;
+        out << YAML::Key << "specular" << YAML::Value << spotlight->specular;
+        out << YAML::Key << "m_near_plane" << YAML::Value << spotlight->m_near_plane;
+        out << YAML::Key << "m_far_plane" << YAML::Value << spotlight->m_far_plane;
+        out << YAML::Key << "m_blocker_search_num_samples" << YAML::Value << spotlight->m_blocker_search_num_samples;
+        out << YAML::Key << "m_pcf_num_samples" << YAML::Value << spotlight->m_pcf_num_samples;
+        out << YAML::Key << "m_light_world_size" << YAML::Value << spotlight->m_light_world_size;
+        out << YAML::Key << "m_light_frustum_width" << YAML::Value << spotlight->m_light_frustum_width;
+        break;
+    }
+
+    case 23: // NowPromptTriggerComponent
+        break;
+
+    case 24: // ParticleSystemComponent
+    {
+        auto const particlesystem = std::static_pointer_cast<class ParticleSystem>(component);
         out << YAML::Key << "particle_type" << YAML::Value << particlesystem->particle_type;
         out << YAML::Key << "play_once" << YAML::Value << particlesystem->play_once;
         out << YAML::Key << "rotate_particles" << YAML::Value << particlesystem->rotate_particles;
@@ -442,112 +444,77 @@ void SceneSerializer::auto_serialize_component(YAML::Emitter& out, std::shared_p
         out << YAML::Key << "lifetime_1" << YAML::Value << particlesystem->lifetime_1;
         out << YAML::Key << "lifetime_2" << YAML::Value << particlesystem->lifetime_2;
         out << YAML::Key << "m_simulate_in_world_space" << YAML::Value << particlesystem->m_simulate_in_world_space;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const sound = std::dynamic_pointer_cast<class Sound>(component); sound != nullptr)
+
+    case 25: // SoundComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "SoundComponent";
-        out << YAML::Key << "guid" << YAML::Value << sound->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << sound->custom_name;
+        auto const sound = std::static_pointer_cast<class Sound>(component);
         out << YAML::Key << "path" << YAML::Value << sound->path;
         out << YAML::Key << "volume" << YAML::Value << sound->volume;
         out << YAML::Key << "play_on_awake" << YAML::Value << sound->play_on_awake;
         out << YAML::Key << "is_positional" << YAML::Value << sound->is_positional;
-        out << YAML::EndMap;
-    }
-    else if (auto const soundlistener = std::dynamic_pointer_cast<class SoundListener>(component); soundlistener != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "SoundListenerComponent";
-        out << YAML::Key << "guid" << YAML::Value << soundlistener->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << soundlistener->custom_name;
-        out << YAML::EndMap;
-    }
-    else if (auto const clock = std::dynamic_pointer_cast<class Clock>(component); clock != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ClockComponent";
-        out << YAML::Key << "guid" << YAML::Value << clock->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << clock->custom_name;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const credits = std::dynamic_pointer_cast<class Credits>(component); credits != nullptr)
+
+    case 26: // SoundListenerComponent
+        break;
+
+    case 27: // ClockComponent
+        break;
+
+    case 28: // CreditsComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "CreditsComponent";
-        out << YAML::Key << "guid" << YAML::Value << credits->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << credits->custom_name;
+        auto const credits = std::static_pointer_cast<class Credits>(component);
         out << YAML::Key << "back_to_menu_button" << YAML::Value << credits->back_to_menu_button;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const customer = std::dynamic_pointer_cast<class Customer>(component); customer != nullptr)
+
+    case 29: // CustomerComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "CustomerComponent";
-        out << YAML::Key << "guid" << YAML::Value << customer->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << customer->custom_name;
+        auto const customer = std::static_pointer_cast<class Customer>(component);
         out << YAML::Key << "collider" << YAML::Value << customer->collider;
         out << YAML::Key << "left_hand" << YAML::Value << customer->left_hand;
         out << YAML::Key << "right_hand" << YAML::Value << customer->right_hand;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const customermanager = std::dynamic_pointer_cast<class CustomerManager>(component); customermanager != nullptr)
+
+    case 30: // CustomerManagerComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "CustomerManagerComponent";
-        out << YAML::Key << "guid" << YAML::Value << customermanager->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << customermanager->custom_name;
+        auto const customermanager = std::static_pointer_cast<class CustomerManager>(component);
         out << YAML::Key << "destinations_after_feeding" << YAML::Value << customermanager->destinations_after_feeding;
         out << YAML::Key << "destination_curve" << YAML::Value << customermanager->destination_curve;
         out << YAML::Key << "customer_prefab" << YAML::Value << customermanager->customer_prefab;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const factory = std::dynamic_pointer_cast<class Factory>(component); factory != nullptr)
+
+    case 31: // FactoryComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "FactoryComponent";
-        out << YAML::Key << "guid" << YAML::Value << factory->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << factory->custom_name;
+        auto const factory = std::static_pointer_cast<class Factory>(component);
         out << YAML::Key << "type" << YAML::Value << factory->type;
         out << YAML::Key << "lights" << YAML::Value << factory->lights;
         out << YAML::Key << "factory_light" << YAML::Value << factory->factory_light;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const gamecontroller = std::dynamic_pointer_cast<class GameController>(component); gamecontroller != nullptr)
+
+    case 32: // GameControllerComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "GameControllerComponent";
-        out << YAML::Key << "guid" << YAML::Value << gamecontroller->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << gamecontroller->custom_name;
+        auto const gamecontroller = std::static_pointer_cast<class GameController>(component);
         out << YAML::Key << "current_scene" << YAML::Value << gamecontroller->current_scene;
         out << YAML::Key << "next_scene" << YAML::Value << gamecontroller->next_scene;
         out << YAML::Key << "dialog_manager" << YAML::Value << gamecontroller->dialog_manager;
-        out << YAML::EndMap;
-    }
-    else if (auto const hovercraftwithoutkeeper = std::dynamic_pointer_cast<class HovercraftWithoutKeeper>(component);
-             hovercraftwithoutkeeper != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "HovercraftWithoutKeeperComponent";
-        out << YAML::Key << "guid" << YAML::Value << hovercraftwithoutkeeper->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << hovercraftwithoutkeeper->custom_name;
-        out << YAML::EndMap;
-    }
-    else if (auto const icebound = std::dynamic_pointer_cast<class IceBound>(component); icebound != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "IceBoundComponent";
-        out << YAML::Key << "guid" << YAML::Value << icebound->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << icebound->custom_name;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const levelcontroller = std::dynamic_pointer_cast<class LevelController>(component); levelcontroller != nullptr)
+
+    case 33: // HovercraftWithoutKeeperComponent
+        break;
+
+    case 34: // IceBoundComponent
+        break;
+
+    case 35: // LevelControllerComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "LevelControllerComponent";
-        out << YAML::Key << "guid" << YAML::Value << levelcontroller->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << levelcontroller->custom_name;
+        auto const levelcontroller = std::static_pointer_cast<class LevelController>(component);
         out << YAML::Key << "map_time" << YAML::Value << levelcontroller->map_time;
         out << YAML::Key << "map_food" << YAML::Value << levelcontroller->map_food;
         out << YAML::Key << "maximum_lighthouse_level" << YAML::Value << levelcontroller->maximum_lighthouse_level;
@@ -570,25 +537,21 @@ void SceneSerializer::auto_serialize_component(YAML::Emitter& out, std::shared_p
         out << YAML::Key << "is_tutorial" << YAML::Value << levelcontroller->is_tutorial;
         out << YAML::Key << "starting_packages" << YAML::Value << levelcontroller->starting_packages;
         out << YAML::Key << "tutorial_level" << YAML::Value << levelcontroller->tutorial_level;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const lighthouse = std::dynamic_pointer_cast<class Lighthouse>(component); lighthouse != nullptr)
+
+    case 36: // LighthouseComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "LighthouseComponent";
-        out << YAML::Key << "guid" << YAML::Value << lighthouse->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << lighthouse->custom_name;
+        auto const lighthouse = std::static_pointer_cast<class Lighthouse>(component);
         out << YAML::Key << "light" << YAML::Value << lighthouse->light;
         out << YAML::Key << "water" << YAML::Value << lighthouse->water;
         out << YAML::Key << "spawn_position" << YAML::Value << lighthouse->spawn_position;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const lighthousekeeper = std::dynamic_pointer_cast<class LighthouseKeeper>(component); lighthousekeeper != nullptr)
+
+    case 37: // LighthouseKeeperComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "LighthouseKeeperComponent";
-        out << YAML::Key << "guid" << YAML::Value << lighthousekeeper->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << lighthousekeeper->custom_name;
+        auto const lighthousekeeper = std::static_pointer_cast<class LighthouseKeeper>(component);
         out << YAML::Key << "maximum_speed" << YAML::Value << lighthousekeeper->maximum_speed;
         out << YAML::Key << "acceleration" << YAML::Value << lighthousekeeper->acceleration;
         out << YAML::Key << "deceleration" << YAML::Value << lighthousekeeper->deceleration;
@@ -597,91 +560,67 @@ void SceneSerializer::auto_serialize_component(YAML::Emitter& out, std::shared_p
         out << YAML::Key << "keeper_dust" << YAML::Value << lighthousekeeper->keeper_dust;
         out << YAML::Key << "keeper_splash" << YAML::Value << lighthousekeeper->keeper_splash;
         out << YAML::Key << "packages" << YAML::Value << lighthousekeeper->packages;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const lighthouselight = std::dynamic_pointer_cast<class LighthouseLight>(component); lighthouselight != nullptr)
+
+    case 38: // LighthouseLightComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "LighthouseLightComponent";
-        out << YAML::Key << "guid" << YAML::Value << lighthouselight->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << lighthouselight->custom_name;
+        auto const lighthouselight = std::static_pointer_cast<class LighthouseLight>(component);
         out << YAML::Key << "spotlight" << YAML::Value << lighthouselight->spotlight;
         out << YAML::Key << "spotlight_beam_width" << YAML::Value << lighthouselight->spotlight_beam_width;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const player = std::dynamic_pointer_cast<class Player>(component); player != nullptr)
+
+    case 39: // PlayerComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "PlayerComponent";
-        out << YAML::Key << "guid" << YAML::Value << player->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << player->custom_name;
+        auto const player = std::static_pointer_cast<class Player>(component);
         out << YAML::Key << "packages_text" << YAML::Value << player->packages_text;
         out << YAML::Key << "flashes_text" << YAML::Value << player->flashes_text;
         out << YAML::Key << "level_text" << YAML::Value << player->level_text;
         out << YAML::Key << "clock_text" << YAML::Value << player->clock_text;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const popup = std::dynamic_pointer_cast<class Popup>(component); popup != nullptr)
+
+    case 40: // PopupComponent
+        break;
+
+    case 41: // EndScreenComponent
     {
-        out << YAML::BeginMap;
-        // # Put new Popup kid here
-        if (auto const endscreen = std::dynamic_pointer_cast<class EndScreen>(component); endscreen != nullptr)
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "EndScreenComponent";
-            out << YAML::Key << "guid" << YAML::Value << endscreen->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << endscreen->custom_name;
-            out << YAML::Key << "is_failed" << YAML::Value << endscreen->is_failed;
-            out << YAML::Key << "number_of_stars" << YAML::Value << endscreen->number_of_stars;
-            out << YAML::Key << "stars" << YAML::Value << endscreen->stars;
-            out << YAML::Key << "star_scale" << YAML::Value << endscreen->star_scale;
-            out << YAML::Key << "next_level_button" << YAML::Value << endscreen->next_level_button;
-            out << YAML::Key << "restart_button" << YAML::Value << endscreen->restart_button;
-            out << YAML::Key << "menu_button" << YAML::Value << endscreen->menu_button;
-        }
-        else
-        {
-            out << YAML::Key << "ComponentName" << YAML::Value << "PopupComponent";
-            out << YAML::Key << "guid" << YAML::Value << popup->guid;
-            out << YAML::Key << "custom_name" << YAML::Value << popup->custom_name;
-        }
-        out << YAML::EndMap;
+        auto const endscreen = std::static_pointer_cast<class EndScreen>(component);
+        out << YAML::Key << "is_failed" << YAML::Value << endscreen->is_failed;
+        out << YAML::Key << "number_of_stars" << YAML::Value << endscreen->number_of_stars;
+        out << YAML::Key << "stars" << YAML::Value << endscreen->stars;
+        out << YAML::Key << "star_scale" << YAML::Value << endscreen->star_scale;
+        out << YAML::Key << "next_level_button" << YAML::Value << endscreen->next_level_button;
+        out << YAML::Key << "restart_button" << YAML::Value << endscreen->restart_button;
+        out << YAML::Key << "menu_button" << YAML::Value << endscreen->menu_button;
+        break;
     }
-    else if (auto const port = std::dynamic_pointer_cast<class Port>(component); port != nullptr)
+
+    case 42: // PortComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "PortComponent";
-        out << YAML::Key << "guid" << YAML::Value << port->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << port->custom_name;
+        auto const port = std::static_pointer_cast<class Port>(component);
         out << YAML::Key << "lights" << YAML::Value << port->lights;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const ship = std::dynamic_pointer_cast<class Ship>(component); ship != nullptr)
+
+    case 43: // ShipComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ShipComponent";
-        out << YAML::Key << "guid" << YAML::Value << ship->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << ship->custom_name;
+        auto const ship = std::static_pointer_cast<class Ship>(component);
         out << YAML::Key << "type" << YAML::Value << ship->type;
         out << YAML::Key << "light" << YAML::Value << ship->light;
         out << YAML::Key << "spawner" << YAML::Value << ship->spawner;
         out << YAML::Key << "eyes" << YAML::Value << ship->eyes;
         out << YAML::Key << "my_light" << YAML::Value << ship->my_light;
-        out << YAML::EndMap;
-    }
-    else if (auto const shipeyes = std::dynamic_pointer_cast<class ShipEyes>(component); shipeyes != nullptr)
-    {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ShipEyesComponent";
-        out << YAML::Key << "guid" << YAML::Value << shipeyes->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << shipeyes->custom_name;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const shipspawner = std::dynamic_pointer_cast<class ShipSpawner>(component); shipspawner != nullptr)
+
+    case 44: // ShipEyesComponent
+        break;
+
+    case 45: // ShipSpawnerComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ShipSpawnerComponent";
-        out << YAML::Key << "guid" << YAML::Value << shipspawner->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << shipspawner->custom_name;
+        auto const shipspawner = std::static_pointer_cast<class ShipSpawner>(component);
         out << YAML::Key << "paths" << YAML::Value << shipspawner->paths;
         out << YAML::Key << "floaters_manager" << YAML::Value << shipspawner->floaters_manager;
         out << YAML::Key << "light" << YAML::Value << shipspawner->light;
@@ -689,35 +628,30 @@ void SceneSerializer::auto_serialize_component(YAML::Emitter& out, std::shared_p
         out << YAML::Key << "last_chance_time_threshold" << YAML::Value << shipspawner->last_chance_time_threshold;
         out << YAML::Key << "main_event_spawn" << YAML::Value << shipspawner->main_event_spawn;
         out << YAML::Key << "backup_spawn" << YAML::Value << shipspawner->backup_spawn;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const thanks = std::dynamic_pointer_cast<class Thanks>(component); thanks != nullptr)
+
+    case 46: // ThanksComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "ThanksComponent";
-        out << YAML::Key << "guid" << YAML::Value << thanks->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << thanks->custom_name;
+        auto const thanks = std::static_pointer_cast<class Thanks>(component);
         out << YAML::Key << "back_to_menu_button" << YAML::Value << thanks->back_to_menu_button;
-        out << YAML::EndMap;
+        break;
     }
-    else if (auto const playerinput = std::dynamic_pointer_cast<class PlayerInput>(component); playerinput != nullptr)
+
+    case 47: // PlayerInputComponent
     {
-        out << YAML::BeginMap;
-        out << YAML::Key << "ComponentName" << YAML::Value << "PlayerInputComponent";
-        out << YAML::Key << "guid" << YAML::Value << playerinput->guid;
-        out << YAML::Key << "custom_name" << YAML::Value << playerinput->custom_name;
+        auto const playerinput = std::static_pointer_cast<class PlayerInput>(component);
         out << YAML::Key << "player_speed" << YAML::Value << playerinput->player_speed;
         out << YAML::Key << "camera_speed" << YAML::Value << playerinput->camera_speed;
-        out << YAML::EndMap;
+        break;
     }
-    else
-    {
-        // NOTE: This only returns unmangled name while using the MSVC compiler
-        std::string const name = typeid(*component).name();
-        std::cout << "Error. Serialization of component " << name.substr(6) << " failed."
-                  << "\n";
+
+    // # Auto serialization end
+    default:
+        break;
     }
-    // # Put new serialization here
+
+    out << YAML::EndMap;
 }
 
 void SceneSerializer::serialize_entity(YAML::Emitter& out, std::shared_ptr<Entity> const& entity)
@@ -789,2106 +723,3067 @@ void SceneSerializer::serialize_entity_recursively(YAML::Emitter& out, std::shar
     }
 }
 
+void SceneSerializer::append_entity_block(std::string& text, std::shared_ptr<Entity> const& entity)
+{
+    YAML::Emitter out;
+    out << YAML::BeginSeq;
+    serialize_entity(out, entity);
+    out << YAML::EndSeq;
+
+    // Indented as the whole file's emitter would indent it, so files look the same as before incremental saves.
+    std::string_view block(out.c_str(), out.size());
+
+    while (!block.empty())
+    {
+        size_t const line_end = std::min(block.find('\n'), block.size());
+        text += "  ";
+        text.append(block.substr(0, line_end));
+        text += '\n';
+        block.remove_prefix(std::min(line_end + 1, block.size()));
+    }
+}
+
 void SceneSerializer::auto_deserialize_component(YAML::Node const& component, std::shared_ptr<Entity> const& deserialized_entity,
                                                  bool const first_pass)
 {
-    auto component_name = component["ComponentName"].as<std::string>();
-    // # Auto deserialization start
-    if (component_name == "CameraComponent")
+    auto const component_name = component["ComponentName"].as<std::string>();
+    u32 const type = ComponentRegistry::get_id(component_name);
+
+    if (type == ComponentRegistry::invalid_id)
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = Camera::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Camera>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["width"].IsDefined())
-            {
-                deserialized_component->width = component["width"].as<float>();
-            }
-            if (component["height"].IsDefined())
-            {
-                deserialized_component->height = component["height"].as<float>();
-            }
-            if (component["fov"].IsDefined())
-            {
-                deserialized_component->fov = component["fov"].as<float>();
-            }
-            if (component["near_plane"].IsDefined())
-            {
-                deserialized_component->near_plane = component["near_plane"].as<float>();
-            }
-            if (component["far_plane"].IsDefined())
-            {
-                deserialized_component->far_plane = component["far_plane"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+        std::cout << "Error. Deserialization of component " << component_name << " failed."
+                  << "\n";
+        return;
     }
-    else if (component_name == "Collider2DComponent")
+
+    if (first_pass)
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = Collider2D::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class Collider2D>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["offset"].IsDefined())
-            {
-                deserialized_component->offset = component["offset"].as<glm::vec2>();
-            }
-            if (component["is_trigger"].IsDefined())
-            {
-                deserialized_component->is_trigger = component["is_trigger"].as<bool>();
-            }
-            if (component["is_static"].IsDefined())
-            {
-                deserialized_component->is_static = component["is_static"].as<bool>();
-            }
-            if (component["collider_type"].IsDefined())
-            {
-                deserialized_component->collider_type = component["collider_type"].as<ColliderType2D>();
-            }
-            if (component["width"].IsDefined())
-            {
-                deserialized_component->width = component["width"].as<float>();
-            }
-            if (component["height"].IsDefined())
-            {
-                deserialized_component->height = component["height"].as<float>();
-            }
-            if (component["radius"].IsDefined())
-            {
-                deserialized_component->radius = component["radius"].as<float>();
-            }
-            if (component["drag"].IsDefined())
-            {
-                deserialized_component->drag = component["drag"].as<float>();
-            }
-            if (component["velocity"].IsDefined())
-            {
-                deserialized_component->velocity = component["velocity"].as<glm::vec2>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "CurveComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Curve::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Curve>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["points"].IsDefined())
-            {
-                deserialized_component->points = component["points"].as<std::vector<glm::vec2>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "PathComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Path::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Path>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["points"].IsDefined())
-            {
-                deserialized_component->points = component["points"].as<std::vector<glm::vec2>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "DebugInputControllerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = DebugInputController::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class DebugInputController>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["gamma"].IsDefined())
-            {
-                deserialized_component->gamma = component["gamma"].as<float>();
-            }
-            if (component["exposure"].IsDefined())
-            {
-                deserialized_component->exposure = component["exposure"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "DialoguePromptControllerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = DialoguePromptController::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class DialoguePromptController>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["interp_speed"].IsDefined())
-            {
-                deserialized_component->interp_speed = component["interp_speed"].as<float>();
-            }
-            if (component["dialogue_panel"].IsDefined())
-            {
-                deserialized_component->dialogue_panel = component["dialogue_panel"].as<std::weak_ptr<Button>>();
-            }
-            if (component["panel_parent"].IsDefined())
-            {
-                deserialized_component->panel_parent = component["panel_parent"].as<std::weak_ptr<Entity>>();
-            }
-            if (component["keeper_sprite"].IsDefined())
-            {
-                deserialized_component->keeper_sprite = component["keeper_sprite"].as<std::weak_ptr<Entity>>();
-            }
-            if (component["upper_text"].IsDefined())
-            {
-                deserialized_component->upper_text = component["upper_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            if (component["middle_text"].IsDefined())
-            {
-                deserialized_component->middle_text = component["middle_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            if (component["lower_text"].IsDefined())
-            {
-                deserialized_component->lower_text = component["lower_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            if (component["dialogue_objects"].IsDefined())
-            {
-                deserialized_component->dialogue_objects = component["dialogue_objects"].as<std::vector<DialogueObject>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "ButtonComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Button::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Button>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["path_default"].IsDefined())
-            {
-                deserialized_component->path_default = component["path_default"].as<std::string>();
-            }
-            if (component["path_hovered"].IsDefined())
-            {
-                deserialized_component->path_hovered = component["path_hovered"].as<std::string>();
-            }
-            if (component["path_pressed"].IsDefined())
-            {
-                deserialized_component->path_pressed = component["path_pressed"].as<std::string>();
-            }
-            if (component["top_left_corner"].IsDefined())
-            {
-                deserialized_component->top_left_corner = component["top_left_corner"].as<glm::vec2>();
-            }
-            if (component["top_right_corner"].IsDefined())
-            {
-                deserialized_component->top_right_corner = component["top_right_corner"].as<glm::vec2>();
-            }
-            if (component["bottom_left_corner"].IsDefined())
-            {
-                deserialized_component->bottom_left_corner = component["bottom_left_corner"].as<glm::vec2>();
-            }
-            if (component["bottom_right_corner"].IsDefined())
-            {
-                deserialized_component->bottom_right_corner = component["bottom_right_corner"].as<glm::vec2>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "ModelComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Model::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Model>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["model_path"].IsDefined())
-            {
-                deserialized_component->model_path = component["model_path"].as<std::string>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "CubeComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Cube::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Cube>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["diffuse_texture_path"].IsDefined())
-            {
-                deserialized_component->diffuse_texture_path = component["diffuse_texture_path"].as<std::string>();
-            }
-            if (component["specular_texture_path"].IsDefined())
-            {
-                deserialized_component->specular_texture_path = component["specular_texture_path"].as<std::string>();
-            }
-            if (component["model_path"].IsDefined())
-            {
-                deserialized_component->model_path = component["model_path"].as<std::string>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "SphereComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Sphere::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Sphere>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["sector_count"].IsDefined())
-            {
-                deserialized_component->sector_count = component["sector_count"].as<u32>();
-            }
-            if (component["stack_count"].IsDefined())
-            {
-                deserialized_component->stack_count = component["stack_count"].as<u32>();
-            }
-            if (component["texture_path"].IsDefined())
-            {
-                deserialized_component->texture_path = component["texture_path"].as<std::string>();
-            }
-            if (component["radius"].IsDefined())
-            {
-                deserialized_component->radius = component["radius"].as<float>();
-            }
-            if (component["model_path"].IsDefined())
-            {
-                deserialized_component->model_path = component["model_path"].as<std::string>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "SpriteComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Sprite::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Sprite>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["diffuse_texture_path"].IsDefined())
-            {
-                deserialized_component->diffuse_texture_path = component["diffuse_texture_path"].as<std::string>();
-            }
-            if (component["model_path"].IsDefined())
-            {
-                deserialized_component->model_path = component["model_path"].as<std::string>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "WaterComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Water::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Water>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["waves"].IsDefined())
-            {
-                deserialized_component->waves = component["waves"].as<std::vector<DXWave>>();
-            }
-            if (component["m_ps_buffer"].IsDefined())
-            {
-                deserialized_component->m_ps_buffer = component["m_ps_buffer"].as<ConstantBufferWater>();
-            }
-            if (component["tesselation_level"].IsDefined())
-            {
-                deserialized_component->tesselation_level = component["tesselation_level"].as<u32>();
-            }
-            if (component["model_path"].IsDefined())
-            {
-                deserialized_component->model_path = component["model_path"].as<std::string>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "PanelComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Panel::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Panel>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["background_path"].IsDefined())
-            {
-                deserialized_component->background_path = component["background_path"].as<std::string>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "ScreenTextComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = ScreenText::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class ScreenText>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["text"].IsDefined())
-            {
-                deserialized_component->text = component["text"].as<std::string>();
-            }
-            if (component["position"].IsDefined())
-            {
-                deserialized_component->position = component["position"].as<glm::vec2>();
-            }
-            if (component["font_size"].IsDefined())
-            {
-                deserialized_component->font_size = component["font_size"].as<float>();
-            }
-            if (component["color"].IsDefined())
-            {
-                deserialized_component->color = component["color"].as<u32>();
-            }
-            if (component["flags"].IsDefined())
-            {
-                deserialized_component->flags = component["flags"].as<u16>();
-            }
-            if (component["font_name"].IsDefined())
-            {
-                deserialized_component->font_name = component["font_name"].as<std::string>();
-            }
-            if (component["bold"].IsDefined())
-            {
-                deserialized_component->bold = component["bold"].as<bool>();
-            }
-            if (component["button_ref"].IsDefined())
-            {
-                deserialized_component->button_ref = component["button_ref"].as<std::weak_ptr<Button>>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "SkinnedModelComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = SkinnedModel::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class SkinnedModel>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["model_path"].IsDefined())
-            {
-                deserialized_component->model_path = component["model_path"].as<std::string>();
-            }
-            if (component["anim_path"].IsDefined())
-            {
-                deserialized_component->anim_path = component["anim_path"].as<std::string>();
-            }
-            if (component["material"].IsDefined())
-            {
-                deserialized_component->material = component["material"].as<std::shared_ptr<Material>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "ExampleDynamicTextComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = ExampleDynamicText::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class ExampleDynamicText>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "ExampleUIBarComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = ExampleUIBar::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class ExampleUIBar>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["value"].IsDefined())
-            {
-                deserialized_component->value = component["value"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "FloaterComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Floater::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class Floater>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["sink"].IsDefined())
-            {
-                deserialized_component->sink = component["sink"].as<float>();
-            }
-            if (component["side_floaters_offset"].IsDefined())
-            {
-                deserialized_component->side_floaters_offset = component["side_floaters_offset"].as<float>();
-            }
-            if (component["side_roation_strength"].IsDefined())
-            {
-                deserialized_component->side_roation_strength = component["side_roation_strength"].as<float>();
-            }
-            if (component["forward_rotation_strength"].IsDefined())
-            {
-                deserialized_component->forward_rotation_strength = component["forward_rotation_strength"].as<float>();
-            }
-            if (component["forward_floaters_offest"].IsDefined())
-            {
-                deserialized_component->forward_floaters_offest = component["forward_floaters_offest"].as<float>();
-            }
-            if (component["water"].IsDefined())
-            {
-                deserialized_component->water = component["water"].as<std::weak_ptr<Water>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "FloatersManagerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = FloatersManager::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class FloatersManager>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["big_boat_settings"].IsDefined())
-            {
-                deserialized_component->big_boat_settings = component["big_boat_settings"].as<FloaterSettings>();
-            }
-            if (component["small_boat_settings"].IsDefined())
-            {
-                deserialized_component->small_boat_settings = component["small_boat_settings"].as<FloaterSettings>();
-            }
-            if (component["medium_boat_settings"].IsDefined())
-            {
-                deserialized_component->medium_boat_settings = component["medium_boat_settings"].as<FloaterSettings>();
-            }
-            if (component["tool_boat_settings"].IsDefined())
-            {
-                deserialized_component->tool_boat_settings = component["tool_boat_settings"].as<FloaterSettings>();
-            }
-            if (component["pirate_boat_settings"].IsDefined())
-            {
-                deserialized_component->pirate_boat_settings = component["pirate_boat_settings"].as<FloaterSettings>();
-            }
-            if (component["water"].IsDefined())
-            {
-                deserialized_component->water = component["water"].as<std::weak_ptr<Water>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "FloeButtonComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = FloeButton::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class FloeButton>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["floe_button_type"].IsDefined())
-            {
-                deserialized_component->floe_button_type = component["floe_button_type"].as<FloeButtonType>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "DirectionalLightComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = DirectionalLight::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class DirectionalLight>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["ambient"].IsDefined())
-            {
-                deserialized_component->ambient = component["ambient"].as<glm::vec3>();
-            }
-            if (component["diffuse"].IsDefined())
-            {
-                deserialized_component->diffuse = component["diffuse"].as<glm::vec3>();
-            }
-            if (component["specular"].IsDefined())
-            {
-                deserialized_component->specular = component["specular"].as<glm::vec3>();
-            }
-            if (component["m_near_plane"].IsDefined())
-            {
-                deserialized_component->m_near_plane = component["m_near_plane"].as<float>();
-            }
-            if (component["m_far_plane"].IsDefined())
-            {
-                deserialized_component->m_far_plane = component["m_far_plane"].as<float>();
-            }
-            if (component["m_blocker_search_num_samples"].IsDefined())
-            {
-                deserialized_component->m_blocker_search_num_samples = component["m_blocker_search_num_samples"].as<u32>();
-            }
-            if (component["m_pcf_num_samples"].IsDefined())
-            {
-                deserialized_component->m_pcf_num_samples = component["m_pcf_num_samples"].as<u32>();
-            }
-            if (component["m_light_world_size"].IsDefined())
-            {
-                deserialized_component->m_light_world_size = component["m_light_world_size"].as<float>();
-            }
-            if (component["m_light_frustum_width"].IsDefined())
-            {
-                deserialized_component->m_light_frustum_width = component["m_light_frustum_width"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "PointLightComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = PointLight::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class PointLight>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["constant"].IsDefined())
-            {
-                deserialized_component->constant = component["constant"].as<float>();
-            }
-            if (component["linear"].IsDefined())
-            {
-                deserialized_component->linear = component["linear"].as<float>();
-            }
-            if (component["quadratic"].IsDefined())
-            {
-                deserialized_component->quadratic = component["quadratic"].as<float>();
-            }
-            if (component["ambient"].IsDefined())
-            {
-                deserialized_component->ambient = component["ambient"].as<glm::vec3>();
-            }
-            if (component["diffuse"].IsDefined())
-            {
-                deserialized_component->diffuse = component["diffuse"].as<glm::vec3>();
-            }
-            if (component["specular"].IsDefined())
-            {
-                deserialized_component->specular = component["specular"].as<glm::vec3>();
-            }
-            if (component["m_near_plane"].IsDefined())
-            {
-                deserialized_component->m_near_plane = component["m_near_plane"].as<float>();
-            }
-            if (component["m_far_plane"].IsDefined())
-            {
-                deserialized_component->m_far_plane = component["m_far_plane"].as<float>();
-            }
-            if (component["m_blocker_search_num_samples"].IsDefined())
-            {
-                deserialized_component->m_blocker_search_num_samples = component["m_blocker_search_num_samples"].as<u32>();
-            }
-            if (component["m_pcf_num_samples"].IsDefined())
-            {
-                deserialized_component->m_pcf_num_samples = component["m_pcf_num_samples"].as<u32>();
-            }
-            if (component["m_light_world_size"].IsDefined())
-            {
-                deserialized_component->m_light_world_size = component["m_light_world_size"].as<float>();
-            }
-            if (component["m_light_frustum_width"].IsDefined())
-            {
-                deserialized_component->m_light_frustum_width = component["m_light_frustum_width"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "SpotLightComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = SpotLight::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class SpotLight>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["constant"].IsDefined())
-            {
-                deserialized_component->constant = component["constant"].as<float>();
-            }
-            if (component["linear"].IsDefined())
-            {
-                deserialized_component->linear = component["linear"].as<float>();
-            }
-            if (component["quadratic"].IsDefined())
-            {
-                deserialized_component->quadratic = component["quadratic"].as<float>();
-            }
-            if (component["scattering_factor"].IsDefined())
-            {
-                deserialized_component->scattering_factor = component["scattering_factor"].as<float>();
-            }
-            if (component["cut_off"].IsDefined())
-            {
-                deserialized_component->cut_off = component["cut_off"].as<float>();
-            }
-            if (component["outer_cut_off"].IsDefined())
-            {
-                deserialized_component->outer_cut_off = component["outer_cut_off"].as<float>();
-            }
-            if (component["ambient"].IsDefined())
-            {
-                deserialized_component->ambient = component["ambient"].as<glm::vec3>();
-            }
-            if (component["diffuse"].IsDefined())
-            {
-                deserialized_component->diffuse = component["diffuse"].as<glm::vec3>();
-            }
-            if (component["specular"].IsDefined())
-            {
-                deserialized_component->specular = component["specular"].as<glm::vec3>();
-            }
-            if (component["m_near_plane"].IsDefined())
-            {
-                deserialized_component->m_near_plane = component["m_near_plane"].as<float>();
-            }
-            if (component["m_far_plane"].IsDefined())
-            {
-                deserialized_component->m_far_plane = component["m_far_plane"].as<float>();
-            }
-            if (component["m_blocker_search_num_samples"].IsDefined())
-            {
-                deserialized_component->m_blocker_search_num_samples = component["m_blocker_search_num_samples"].as<u32>();
-            }
-            if (component["m_pcf_num_samples"].IsDefined())
-            {
-                deserialized_component->m_pcf_num_samples = component["m_pcf_num_samples"].as<u32>();
-            }
-            if (component["m_light_world_size"].IsDefined())
-            {
-                deserialized_component->m_light_world_size = component["m_light_world_size"].as<float>();
-            }
-            if (component["m_light_frustum_width"].IsDefined())
-            {
-                deserialized_component->m_light_frustum_width = component["m_light_frustum_width"].as<float>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "NowPromptTriggerComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = NowPromptTrigger::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class NowPromptTrigger>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "ParticleSystemComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = ParticleSystem::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class ParticleSystem>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["particle_type"].IsDefined())
-            {
-                deserialized_component->particle_type = component["particle_type"].as<ParticleType>();
-            }
-            if (component["play_once"].IsDefined())
-            {
-                deserialized_component->play_once = component["play_once"].as<bool>();
-            }
-            if (component["rotate_particles"].IsDefined())
-            {
-                deserialized_component->rotate_particles = component["rotate_particles"].as<bool>();
-            }
-            if (component["spawn_instantly"].IsDefined())
-            {
-                deserialized_component->spawn_instantly = component["spawn_instantly"].as<bool>();
-            }
-            if (component["sprite_path"].IsDefined())
-            {
-                deserialized_component->sprite_path = component["sprite_path"].as<std::string>();
-            }
-            if (component["min_spawn_interval"].IsDefined())
-            {
-                deserialized_component->min_spawn_interval = component["min_spawn_interval"].as<float>();
-            }
-            if (component["max_spawn_interval"].IsDefined())
-            {
-                deserialized_component->max_spawn_interval = component["max_spawn_interval"].as<float>();
-            }
-            if (component["start_velocity_1"].IsDefined())
-            {
-                deserialized_component->start_velocity_1 = component["start_velocity_1"].as<glm::vec3>();
-            }
-            if (component["start_velocity_2"].IsDefined())
-            {
-                deserialized_component->start_velocity_2 = component["start_velocity_2"].as<glm::vec3>();
-            }
-            if (component["min_spawn_alpha"].IsDefined())
-            {
-                deserialized_component->min_spawn_alpha = component["min_spawn_alpha"].as<float>();
-            }
-            if (component["max_spawn_alpha"].IsDefined())
-            {
-                deserialized_component->max_spawn_alpha = component["max_spawn_alpha"].as<float>();
-            }
-            if (component["start_min_particle_size"].IsDefined())
-            {
-                deserialized_component->start_min_particle_size = component["start_min_particle_size"].as<glm::vec3>();
-            }
-            if (component["start_max_particle_size"].IsDefined())
-            {
-                deserialized_component->start_max_particle_size = component["start_max_particle_size"].as<glm::vec3>();
-            }
-            if (component["emitter_bounds"].IsDefined())
-            {
-                deserialized_component->emitter_bounds = component["emitter_bounds"].as<float>();
-            }
-            if (component["min_spawn_count"].IsDefined())
-            {
-                deserialized_component->min_spawn_count = component["min_spawn_count"].as<i32>();
-            }
-            if (component["max_spawn_count"].IsDefined())
-            {
-                deserialized_component->max_spawn_count = component["max_spawn_count"].as<i32>();
-            }
-            if (component["start_color_1"].IsDefined())
-            {
-                deserialized_component->start_color_1 = component["start_color_1"].as<glm::vec4>();
-            }
-            if (component["end_color_1"].IsDefined())
-            {
-                deserialized_component->end_color_1 = component["end_color_1"].as<glm::vec4>();
-            }
-            if (component["lifetime_1"].IsDefined())
-            {
-                deserialized_component->lifetime_1 = component["lifetime_1"].as<float>();
-            }
-            if (component["lifetime_2"].IsDefined())
-            {
-                deserialized_component->lifetime_2 = component["lifetime_2"].as<float>();
-            }
-            if (component["m_simulate_in_world_space"].IsDefined())
-            {
-                deserialized_component->m_simulate_in_world_space = component["m_simulate_in_world_space"].as<bool>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "SoundComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Sound::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Sound>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["path"].IsDefined())
-            {
-                deserialized_component->path = component["path"].as<std::string>();
-            }
-            if (component["volume"].IsDefined())
-            {
-                deserialized_component->volume = component["volume"].as<float>();
-            }
-            if (component["play_on_awake"].IsDefined())
-            {
-                deserialized_component->play_on_awake = component["play_on_awake"].as<bool>();
-            }
-            if (component["is_positional"].IsDefined())
-            {
-                deserialized_component->is_positional = component["is_positional"].as<bool>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+        auto const deserialized_component = ComponentRegistry::create(type);
+        deserialized_component->guid = component["guid"].as<std::string>();
+        deserialized_component->custom_name = component["custom_name"].as<std::string>();
+        deserialized_pool.emplace_back(deserialized_component);
+        return;
     }
-    else if (component_name == "SoundListenerComponent")
+
+    auto const deserialized_component = get_from_pool(component["guid"].as<std::string>());
+
+    switch (type)
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = SoundListener::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class SoundListener>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+    // # Auto deserialization start
+    case 0: // CameraComponent
+    {
+        auto const camera = std::static_pointer_cast<class Camera>(deserialized_component);
+        if (component["width"].IsDefined())
+            camera->width = component["width"].as<float>();
+        if (component["height"].IsDefined())
+            camera->height = component["height"].as<float>();
+        if (component["fov"].IsDefined())
+            camera->fov = component["fov"].as<float>();
+        if (component["near_plane"].IsDefined())
+            camera->near_plane = component["near_plane"].as<float>();
+        if (component["far_plane"].IsDefined())
+            camera->far_plane = component["far_plane"].as<float>();
+        break;
+    }
+
+    case 1: // Collider2DComponent
+    {
+        auto const collider2d = std::static_pointer_cast<class Collider2D>(deserialized_component);
+        if (component["offset"].IsDefined())
+            collider2d->offset = component["offset"].as<glm::vec2>();
+        if (component["is_trigger"].IsDefined())
+            collider2d->is_trigger = component["is_trigger"].as<bool>();
+        if (component["is_static"].IsDefined())
+            collider2d->is_static = component["is_static"].as<bool>();
+        if (component["collider_type"].IsDefined())
+            collider2d->collider_type = component["collider_type"].as<ColliderType2D>();
+        if (component["width"].IsDefined())
+            collider2d->width = component["width"].as<float>();
+        if (component["height"].IsDefined())
+            collider2d->height = component["height"].as<float>();
+        if (component["radius"].IsDefined())
+            collider2d->radius = component["radius"].as<float>();
+        if (component["drag"].IsDefined())
+            collider2d->drag = component["drag"].as<float>();
+        if (component["velocity"].IsDefined())
+            collider2d->velocity = component["velocity"].as<glm::vec2>();
+        break;
+    }
+
+    case 2: // CurveComponent
+    {
+        auto const curve = std::static_pointer_cast<class Curve>(deserialized_component);
+        if (component["points"].IsDefined())
+            curve->points = component["points"].as<std::vector<glm::vec2>>();
+        break;
+    }
+
+    case 3: // PathComponent
+    {
+        auto const path = std::static_pointer_cast<class Path>(deserialized_component);
+        if (component["points"].IsDefined())
+            path->points = component["points"].as<std::vector<glm::vec2>>();
+        break;
+    }
+
+    case 4: // DebugInputControllerComponent
+    {
+        auto const debuginputcontroller = std::static_pointer_cast<class DebugInputController>(deserialized_component);
+        if (component["gamma"].IsDefined())
+            debuginputcontroller->gamma = component["gamma"].as<float>();
+        if (component["exposure"].IsDefined())
+            debuginputcontroller->exposure = component["exposure"].as<float>();
+        break;
+    }
+
+    case 5: // DialoguePromptControllerComponent
+    {
+        auto const dialoguepromptcontroller = std::static_pointer_cast<class DialoguePromptController>(deserialized_component);
+        if (component["interp_speed"].IsDefined())
+            dialoguepromptcontroller->interp_speed = component["interp_speed"].as<float>();
+        if (component["dialogue_panel"].IsDefined())
+            dialoguepromptcontroller->dialogue_panel = component["dialogue_panel"].as<std::weak_ptr<Button>>();
+        if (component["panel_parent"].IsDefined())
+            dialoguepromptcontroller->panel_parent = component["panel_parent"].as<std::weak_ptr<Entity>>();
+        if (component["keeper_sprite"].IsDefined())
+            dialoguepromptcontroller->keeper_sprite = component["keeper_sprite"].as<std::weak_ptr<Entity>>();
+        if (component["upper_text"].IsDefined())
+            dialoguepromptcontroller->upper_text = component["upper_text"].as<std::weak_ptr<ScreenText>>();
+        if (component["middle_text"].IsDefined())
+            dialoguepromptcontroller->middle_text = component["middle_text"].as<std::weak_ptr<ScreenText>>();
+        if (component["lower_text"].IsDefined())
+            dialoguepromptcontroller->lower_text = component["lower_text"].as<std::weak_ptr<ScreenText>>();
+        if (component["dialogue_objects"].IsDefined())
+            dialoguepromptcontroller->dialogue_objects = component["dialogue_objects"].as<std::vector<DialogueObject>>();
+        break;
+    }
+
+    case 6: // ButtonComponent
+    {
+        auto const button = std::static_pointer_cast<class Button>(deserialized_component);
+        if (component["path_default"].IsDefined())
+            button->path_default = component["path_default"].as<std::string>();
+        if (component["path_hovered"].IsDefined())
+            button->path_hovered = component["path_hovered"].as<std::string>();
+        if (component["path_pressed"].IsDefined())
+            button->path_pressed = component["path_pressed"].as<std::string>();
+        if (component["top_left_corner"].IsDefined())
+            button->top_left_corner = component["top_left_corner"].as<glm::vec2>();
+        if (component["top_right_corner"].IsDefined())
+            button->top_right_corner = component["top_right_corner"].as<glm::vec2>();
+        if (component["bottom_left_corner"].IsDefined())
+            button->bottom_left_corner = component["bottom_left_corner"].as<glm::vec2>();
+        if (component["bottom_right_corner"].IsDefined())
+            button->bottom_right_corner = component["bottom_right_corner"].as<glm::vec2>();
+        if (component["material"].IsDefined())
+            button->material = component["material"].as<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 7: // ModelComponent
+    {
+        auto const model = std::static_pointer_cast<class Model>(deserialized_component);
+        if (component["model_path"].IsDefined())
+            model->model_path = component["model_path"].as<std::string>();
+        if (component["material"].IsDefined())
+            model->material = component["material"].as<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 8: // CubeComponent
+    {
+        auto const cube = std::static_pointer_cast<class Cube>(deserialized_component);
+        if (component["diffuse_texture_path"].IsDefined())
+            cube->diffuse_texture_path = component["diffuse_texture_path"].as<std::string>();
+        if (component["specular_texture_path"].IsDefined())
+            cube->specular_texture_path = component["specular_texture_path"].as<std::string>();
+        if (component["model_path"].IsDefined())
+            cube->model_path = component["model_path"].as<std::string>();
+        if (component["material"].IsDefined())
+            cube->material = component["material"].as<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 9: // SphereComponent
+    {
+        auto const sphere = std::static_pointer_cast<class Sphere>(deserialized_component);
+        if (component["sector_count"].IsDefined())
+            sphere->sector_count = component["sector_count"].as<u32>();
+        if (component["stack_count"].IsDefined())
+            sphere->stack_count = component["stack_count"].as<u32>();
+        if (component["texture_path"].IsDefined())
+            sphere->texture_path = component["texture_path"].as<std::string>();
+        if (component["radius"].IsDefined())
+            sphere->radius = component["radius"].as<float>();
+        if (component["model_path"].IsDefined())
+            sphere->model_path = component["model_path"].as<std::string>();
+        if (component["material"].IsDefined())
+            sphere->material = component["material"].as<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 10: // SpriteComponent
+    {
+        auto const sprite = std::static_pointer_cast<class Sprite>(deserialized_component);
+        if (component["diffuse_texture_path"].IsDefined())
+            sprite->diffuse_texture_path = component["diffuse_texture_path"].as<std::string>();
+        if (component["model_path"].IsDefined())
+            sprite->model_path = component["model_path"].as<std::string>();
+        if (component["material"].IsDefined())
+            sprite->material = component["material"].as<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 11: // WaterComponent
+    {
+        auto const water = std::static_pointer_cast<class Water>(deserialized_component);
+        if (component["waves"].IsDefined())
+            water->waves = component["waves"].as<std::vector<DXWave>>();
+        if (component["m_ps_buffer"].IsDefined())
+            water->m_ps_buffer = component["m_ps_buffer"].as<ConstantBufferWater>();
+        if (component["tesselation_level"].IsDefined())
+            water->tesselation_level = component["tesselation_level"].as<u32>();
+        if (component["model_path"].IsDefined())
+            water->model_path = component["model_path"].as<std::string>();
+        if (component["material"].IsDefined())
+            water->material = component["material"].as<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 12: // PanelComponent
+    {
+        auto const panel = std::static_pointer_cast<class Panel>(deserialized_component);
+        if (component["background_path"].IsDefined())
+            panel->background_path = component["background_path"].as<std::string>();
+        if (component["material"].IsDefined())
+            panel->material = component["material"].as<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 13: // ScreenTextComponent
+    {
+        auto const screentext = std::static_pointer_cast<class ScreenText>(deserialized_component);
+        if (component["text"].IsDefined())
+            screentext->text = component["text"].as<std::string>();
+        if (component["position"].IsDefined())
+            screentext->position = component["position"].as<glm::vec2>();
+        if (component["font_size"].IsDefined())
+            screentext->font_size = component["font_size"].as<float>();
+        if (component["color"].IsDefined())
+            screentext->color = component["color"].as<u32>();
+        if (component["flags"].IsDefined())
+            screentext->flags = component["flags"].as<u16>();
+        if (component["font_name"].IsDefined())
+            screentext->font_name = component["font_name"].as<std::string>();
+        if (component["bold"].IsDefined())
+            screentext->bold = component["bold"].as<bool>();
+        if (component["button_ref"].IsDefined())
+            screentext->button_ref = component["button_ref"].as<std::weak_ptr<Button>>();
+        if (component["material"].IsDefined())
+            screentext->material = component["material"].as<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 14: // SkinnedModelComponent
+    {
+        auto const skinnedmodel = std::static_pointer_cast<class SkinnedModel>(deserialized_component);
+        if (component["model_path"].IsDefined())
+            skinnedmodel->model_path = component["model_path"].as<std::string>();
+        if (component["anim_path"].IsDefined())
+            skinnedmodel->anim_path = component["anim_path"].as<std::string>();
+        if (component["material"].IsDefined())
+            skinnedmodel->material = component["material"].as<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 15: // ExampleDynamicTextComponent
+        break;
+
+    case 16: // ExampleUIBarComponent
+    {
+        auto const exampleuibar = std::static_pointer_cast<class ExampleUIBar>(deserialized_component);
+        if (component["value"].IsDefined())
+            exampleuibar->value = component["value"].as<float>();
+        break;
+    }
+
+    case 17: // FloaterComponent
+    {
+        auto const floater = std::static_pointer_cast<class Floater>(deserialized_component);
+        if (component["sink"].IsDefined())
+            floater->sink = component["sink"].as<float>();
+        if (component["side_floaters_offset"].IsDefined())
+            floater->side_floaters_offset = component["side_floaters_offset"].as<float>();
+        if (component["side_roation_strength"].IsDefined())
+            floater->side_roation_strength = component["side_roation_strength"].as<float>();
+        if (component["forward_rotation_strength"].IsDefined())
+            floater->forward_rotation_strength = component["forward_rotation_strength"].as<float>();
+        if (component["forward_floaters_offest"].IsDefined())
+            floater->forward_floaters_offest = component["forward_floaters_offest"].as<float>();
+        if (component["water"].IsDefined())
+            floater->water = component["water"].as<std::weak_ptr<Water>>();
+        break;
+    }
+
+    case 18: // FloatersManagerComponent
+    {
+        auto const floatersmanager = std::static_pointer_cast<class FloatersManager>(deserialized_component);
+        if (component["big_boat_settings"].IsDefined())
+            floatersmanager->big_boat_settings = component["big_boat_settings"].as<FloaterSettings>();
+        if (component["small_boat_settings"].IsDefined())
+            floatersmanager->small_boat_settings = component["small_boat_settings"].as<FloaterSettings>();
+        if (component["medium_boat_settings"].IsDefined())
+            floatersmanager->medium_boat_settings = component["medium_boat_settings"].as<FloaterSettings>();
+        if (component["tool_boat_settings"].IsDefined())
+            floatersmanager->tool_boat_settings = component["tool_boat_settings"].as<FloaterSettings>();
+        if (component["pirate_boat_settings"].IsDefined())
+            floatersmanager->pirate_boat_settings = component["pirate_boat_settings"].as<FloaterSettings>();
+        if (component["water"].IsDefined())
+            floatersmanager->water = component["water"].as<std::weak_ptr<Water>>();
+        break;
+    }
+
+    case 19: // FloeButtonComponent
+    {
+        auto const floebutton = std::static_pointer_cast<class FloeButton>(deserialized_component);
+        if (component["floe_button_type"].IsDefined())
+            floebutton->floe_button_type = component["floe_button_type"].as<FloeButtonType>();
+        break;
+    }
+
+    case 20: // DirectionalLightComponent
+    {
+        auto const directionallight = std::static_pointer_cast<class DirectionalLight>(deserialized_component);
+        if (component["ambient"].IsDefined())
+            directionallight->ambient = component["ambient"].as<glm::vec3>();
+        if (component["diffuse"].IsDefined())
+            directionallight->diffuse = component["diffuse"].as<glm::vec3>();
+        if (component["specular"].IsDefined())
+            directionallight->specular = component["specular"].as<glm::vec3>();
+        if (component["m_near_plane"].IsDefined())
+            directionallight->m_near_plane = component["m_near_plane"].as<float>();
+        if (component["m_far_plane"].IsDefined())
+            directionallight->m_far_plane = component["m_far_plane"].as<float>();
+        if (component["m_blocker_search_num_samples"].IsDefined())
+            directionallight->m_blocker_search_num_samples = component["m_blocker_search_num_samples"].as<u32>();
+        if (component["m_pcf_num_samples"].IsDefined())
+            directionallight->m_pcf_num_samples = component["m_pcf_num_samples"].as<u32>();
+        if (component["m_light_world_size"].IsDefined())
+            directionallight->m_light_world_size = component["m_light_world_size"].as<float>();
+        if (component["m_light_frustum_width"].IsDefined())
+            directionallight->m_light_frustum_width = component["m_light_frustum_width"].as<float>();
+        break;
+    }
+
+    case 21: // PointLightComponent
+    {
+        auto const pointlight = std::static_pointer_cast<class PointLight>(deserialized_component);
+        if (component["constant"].IsDefined())
+            pointlight->constant = component["constant"].as<float>();
+        if (component["linear"].IsDefined())
+            pointlight->linear = component["linear"].as<float>();
+        if (component["quadratic"].IsDefined())
+            pointlight->quadratic = component["quadratic"].as<float>();
+        if (component["ambient"].IsDefined())
+            pointlight->ambient = component["ambient"].as<glm::vec3>();
+        if (component["diffuse"].IsDefined())
+            pointlight->diffuse = component["diffuse"].as<glm::vec3>();
+        if (component["specular"].IsDefined())
+            pointlight->specular = component["specular"].as<glm::vec3>();
+        if (component["m_near_plane"].IsDefined())
+            pointlight->m_near_plane = component["m_near_plane"].as<float>();
+        if (component["m_far_plane"].IsDefined())
+            pointlight->m_far_plane = component["m_far_plane"].as<float>();
+        if (component["m_blocker_search_num_samples"].IsDefined())
+            pointlight->m_blocker_search_num_samples = component["m_blocker_search_num_samples"].as<u32>();
+        if (component["m_pcf_num_samples"].IsDefined())
+            pointlight->m_pcf_num_samples = component["m_pcf_num_samples"].as<u32>();
+        if (component["m_light_world_size"].IsDefined())
+            pointlight->m_light_world_size = component["m_light_world_size"].as<float>();
+        if (component["m_light_frustum_width"].IsDefined())
+            pointlight->m_light_frustum_width = component["m_light_frustum_width"].as<float>();
+        break;
+    }
+
+    case 22: // SpotLightComponent
+    {
+        auto const spotlight = std::static_pointer_cast<class SpotLight>(deserialized_component);
+        if (component["constant"].IsDefined())
+            spotlight->constant = component["constant"].as<float>();
+        if (component["linear"].IsDefined())
+            spotlight->linear = component["linear"].as<float>();
+        if (component["quadratic"].IsDefined())
+            spotlight->quadratic = component["quadratic"].as<float>();
+        if (component["scattering_factor"].IsDefined())
+            spotlight->scattering_factor = component["scattering_factor"].as<float>();
+        if (component["cut_off"].IsDefined())
+            spotlight->cut_off = component["cut_off"].as<float>();
+        if (component["outer_cut_off"].IsDefined())
+            spotlight->outer_cut_off = component["outer_cut_off"].as<float>();
+        if (component["ambient"].IsDefined())
+            spotlight->ambient = component["ambient"].as<glm::vec3>();
+        if (component["diffuse"].IsDefined())
+            spotlight->diffuse = component["diffuse"].as<glm::vec3>();
+        if (component["specular"].IsDefined())
+            spotlight->specular = component["specular"].as<glm::vec3>();
+        if (component["m_near_plane"].IsDefined())
+            spotlight->m_near_plane = component["m_near_plane"].as<float>();
+        if (component["m_far_plane"].IsDefined())
+            spotlight->m_far_plane = component["m_far_plane"].as<float>();
+        if (component["m_blocker_search_num_samples"].IsDefined())
+            spotlight->m_blocker_search_num_samples = component["m_blocker_search_num_samples"].as<u32>();
+        if (component["m_pcf_num_samples"].IsDefined())
+            spotlight->m_pcf_num_samples = component["m_pcf_num_samples"].as<u32>();
+        if (component["m_light_world_size"].IsDefined())
+            spotlight->m_light_world_size = component["m_light_world_size"].as<float>();
+        if (component["m_light_frustum_width"].IsDefined())
+            spotlight->m_light_frustum_width = component["m_light_frustum_width"].as<float>();
+        break;
+    }
+
+    case 23: // NowPromptTriggerComponent
+        break;
+
+    case 24: // ParticleSystemComponent
+    {
+        auto const particlesystem = std::static_pointer_cast<class ParticleSystem>(deserialized_component);
+        if (component["particle_type"].IsDefined())
+            particlesystem->particle_type = component["particle_type"].as<ParticleType>();
+        if (component["play_once"].IsDefined())
+            particlesystem->play_once = component["play_once"].as<bool>();
+        if (component["rotate_particles"].IsDefined())
+            particlesystem->rotate_particles = component["rotate_particles"].as<bool>();
+        if (component["spawn_instantly"].IsDefined())
+            particlesystem->spawn_instantly = component["spawn_instantly"].as<bool>();
+        if (component["sprite_path"].IsDefined())
+            particlesystem->sprite_path = component["sprite_path"].as<std::string>();
+        if (component["min_spawn_interval"].IsDefined())
+            particlesystem->min_spawn_interval = component["min_spawn_interval"].as<float>();
+        if (component["max_spawn_interval"].IsDefined())
+            particlesystem->max_spawn_interval = component["max_spawn_interval"].as<float>();
+        if (component["start_velocity_1"].IsDefined())
+            particlesystem->start_velocity_1 = component["start_velocity_1"].as<glm::vec3>();
+        if (component["start_velocity_2"].IsDefined())
+            particlesystem->start_velocity_2 = component["start_velocity_2"].as<glm::vec3>();
+        if (component["min_spawn_alpha"].IsDefined())
+            particlesystem->min_spawn_alpha = component["min_spawn_alpha"].as<float>();
+        if (component["max_spawn_alpha"].IsDefined())
+            particlesystem->max_spawn_alpha = component["max_spawn_alpha"].as<float>();
+        if (component["start_min_particle_size"].IsDefined())
+            particlesystem->start_min_particle_size = component["start_min_particle_size"].as<glm::vec3>();
+        if (component["start_max_particle_size"].IsDefined())
+            particlesystem->start_max_particle_size = component["start_max_particle_size"].as<glm::vec3>();
+        if (component["emitter_bounds"].IsDefined())
+            particlesystem->emitter_bounds = component["emitter_bounds"].as<float>();
+        if (component["min_spawn_count"].IsDefined())
+            particlesystem->min_spawn_count = component["min_spawn_count"].as<i32>();
+        if (component["max_spawn_count"].IsDefined())
+            particlesystem->max_spawn_count = component["max_spawn_count"].as<i32>();
+        if (component["start_color_1"].IsDefined())
+            particlesystem->start_color_1 = component["start_color_1"].as<glm::vec4>();
+        if (component["end_color_1"].IsDefined())
+            particlesystem->end_color_1 = component["end_color_1"].as<glm::vec4>();
+        if (component["lifetime_1"].IsDefined())
+            particlesystem->lifetime_1 = component["lifetime_1"].as<float>();
+        if (component["lifetime_2"].IsDefined())
+            particlesystem->lifetime_2 = component["lifetime_2"].as<float>();
+        if (component["m_simulate_in_world_space"].IsDefined())
+            particlesystem->m_simulate_in_world_space = component["m_simulate_in_world_space"].as<bool>();
+        break;
+    }
+
+    case 25: // SoundComponent
+    {
+        auto const sound = std::static_pointer_cast<class Sound>(deserialized_component);
+        if (component["path"].IsDefined())
+            sound->path = component["path"].as<std::string>();
+        if (component["volume"].IsDefined())
+            sound->volume = component["volume"].as<float>();
+        if (component["play_on_awake"].IsDefined())
+            sound->play_on_awake = component["play_on_awake"].as<bool>();
+        if (component["is_positional"].IsDefined())
+            sound->is_positional = component["is_positional"].as<bool>();
+        break;
+    }
+
+    case 26: // SoundListenerComponent
+        break;
+
+    case 27: // ClockComponent
+        break;
+
+    case 28: // CreditsComponent
+    {
+        auto const credits = std::static_pointer_cast<class Credits>(deserialized_component);
+        if (component["back_to_menu_button"].IsDefined())
+            credits->back_to_menu_button = component["back_to_menu_button"].as<std::weak_ptr<Button>>();
+        break;
+    }
+
+    case 29: // CustomerComponent
+    {
+        auto const customer = std::static_pointer_cast<class Customer>(deserialized_component);
+        if (component["collider"].IsDefined())
+            customer->collider = component["collider"].as<std::weak_ptr<Collider2D>>();
+        if (component["left_hand"].IsDefined())
+            customer->left_hand = component["left_hand"].as<std::weak_ptr<Entity>>();
+        if (component["right_hand"].IsDefined())
+            customer->right_hand = component["right_hand"].as<std::weak_ptr<Entity>>();
+        break;
+    }
+
+    case 30: // CustomerManagerComponent
+    {
+        auto const customermanager = std::static_pointer_cast<class CustomerManager>(deserialized_component);
+        if (component["destinations_after_feeding"].IsDefined())
+            customermanager->destinations_after_feeding = component["destinations_after_feeding"].as<std::vector<std::weak_ptr<Entity>>>();
+        if (component["destination_curve"].IsDefined())
+            customermanager->destination_curve = component["destination_curve"].as<std::weak_ptr<Curve>>();
+        if (component["customer_prefab"].IsDefined())
+            customermanager->customer_prefab = component["customer_prefab"].as<std::string>();
+        break;
+    }
+
+    case 31: // FactoryComponent
+    {
+        auto const factory = std::static_pointer_cast<class Factory>(deserialized_component);
+        if (component["type"].IsDefined())
+            factory->type = component["type"].as<FactoryType>();
+        if (component["lights"].IsDefined())
+            factory->lights = component["lights"].as<std::vector<std::weak_ptr<PointLight>>>();
+        if (component["factory_light"].IsDefined())
+            factory->factory_light = component["factory_light"].as<std::weak_ptr<PointLight>>();
+        break;
+    }
+
+    case 32: // GameControllerComponent
+    {
+        auto const gamecontroller = std::static_pointer_cast<class GameController>(deserialized_component);
+        if (component["current_scene"].IsDefined())
+            gamecontroller->current_scene = component["current_scene"].as<std::weak_ptr<Entity>>();
+        if (component["next_scene"].IsDefined())
+            gamecontroller->next_scene = component["next_scene"].as<std::weak_ptr<Entity>>();
+        if (component["dialog_manager"].IsDefined())
+            gamecontroller->dialog_manager = component["dialog_manager"].as<std::weak_ptr<DialoguePromptController>>();
+        break;
+    }
+
+    case 33: // HovercraftWithoutKeeperComponent
+        break;
+
+    case 34: // IceBoundComponent
+        break;
+
+    case 35: // LevelControllerComponent
+    {
+        auto const levelcontroller = std::static_pointer_cast<class LevelController>(deserialized_component);
+        if (component["map_time"].IsDefined())
+            levelcontroller->map_time = component["map_time"].as<float>();
+        if (component["map_food"].IsDefined())
+            levelcontroller->map_food = component["map_food"].as<u32>();
+        if (component["maximum_lighthouse_level"].IsDefined())
+            levelcontroller->maximum_lighthouse_level = component["maximum_lighthouse_level"].as<i32>();
+        if (component["factories"].IsDefined())
+            levelcontroller->factories = component["factories"].as<std::vector<std::weak_ptr<Factory>>>();
+        if (component["port"].IsDefined())
+            levelcontroller->port = component["port"].as<std::weak_ptr<Port>>();
+        if (component["lighthouse"].IsDefined())
+            levelcontroller->lighthouse = component["lighthouse"].as<std::weak_ptr<Lighthouse>>();
+        if (component["customer_manager"].IsDefined())
+            levelcontroller->customer_manager = component["customer_manager"].as<std::weak_ptr<CustomerManager>>();
+        if (component["playfield_width"].IsDefined())
+            levelcontroller->playfield_width = component["playfield_width"].as<float>();
+        if (component["playfield_additional_width"].IsDefined())
+            levelcontroller->playfield_additional_width = component["playfield_additional_width"].as<float>();
+        if (component["playfield_height"].IsDefined())
+            levelcontroller->playfield_height = component["playfield_height"].as<float>();
+        if (component["playfield_y_shift"].IsDefined())
+            levelcontroller->playfield_y_shift = component["playfield_y_shift"].as<float>();
+        if (component["ships_limit_curve"].IsDefined())
+            levelcontroller->ships_limit_curve = component["ships_limit_curve"].as<std::weak_ptr<Curve>>();
+        if (component["ships_limit"].IsDefined())
+            levelcontroller->ships_limit = component["ships_limit"].as<u32>();
+        if (component["ships_speed_curve"].IsDefined())
+            levelcontroller->ships_speed_curve = component["ships_speed_curve"].as<std::weak_ptr<Curve>>();
+        if (component["ships_speed"].IsDefined())
+            levelcontroller->ships_speed = component["ships_speed"].as<float>();
+        if (component["ships_range_curve"].IsDefined())
+            levelcontroller->ships_range_curve = component["ships_range_curve"].as<std::weak_ptr<Curve>>();
+        if (component["ships_turn_curve"].IsDefined())
+            levelcontroller->ships_turn_curve = component["ships_turn_curve"].as<std::weak_ptr<Curve>>();
+        if (component["ships_additional_speed_curve"].IsDefined())
+            levelcontroller->ships_additional_speed_curve = component["ships_additional_speed_curve"].as<std::weak_ptr<Curve>>();
+        if (component["pirates_in_control_curve"].IsDefined())
+            levelcontroller->pirates_in_control_curve = component["pirates_in_control_curve"].as<std::weak_ptr<Curve>>();
+        if (component["is_tutorial"].IsDefined())
+            levelcontroller->is_tutorial = component["is_tutorial"].as<bool>();
+        if (component["starting_packages"].IsDefined())
+            levelcontroller->starting_packages = component["starting_packages"].as<u32>();
+        if (component["tutorial_level"].IsDefined())
+            levelcontroller->tutorial_level = component["tutorial_level"].as<u32>();
+        break;
+    }
+
+    case 36: // LighthouseComponent
+    {
+        auto const lighthouse = std::static_pointer_cast<class Lighthouse>(deserialized_component);
+        if (component["light"].IsDefined())
+            lighthouse->light = component["light"].as<std::weak_ptr<LighthouseLight>>();
+        if (component["water"].IsDefined())
+            lighthouse->water = component["water"].as<std::weak_ptr<Water>>();
+        if (component["spawn_position"].IsDefined())
+            lighthouse->spawn_position = component["spawn_position"].as<std::weak_ptr<Entity>>();
+        break;
+    }
+
+    case 37: // LighthouseKeeperComponent
+    {
+        auto const lighthousekeeper = std::static_pointer_cast<class LighthouseKeeper>(deserialized_component);
+        if (component["maximum_speed"].IsDefined())
+            lighthousekeeper->maximum_speed = component["maximum_speed"].as<float>();
+        if (component["acceleration"].IsDefined())
+            lighthousekeeper->acceleration = component["acceleration"].as<float>();
+        if (component["deceleration"].IsDefined())
+            lighthousekeeper->deceleration = component["deceleration"].as<float>();
+        if (component["lighthouse"].IsDefined())
+            lighthousekeeper->lighthouse = component["lighthouse"].as<std::weak_ptr<Lighthouse>>();
+        if (component["port"].IsDefined())
+            lighthousekeeper->port = component["port"].as<std::weak_ptr<Port>>();
+        if (component["keeper_dust"].IsDefined())
+            lighthousekeeper->keeper_dust = component["keeper_dust"].as<std::weak_ptr<ParticleSystem>>();
+        if (component["keeper_splash"].IsDefined())
+            lighthousekeeper->keeper_splash = component["keeper_splash"].as<std::weak_ptr<ParticleSystem>>();
+        if (component["packages"].IsDefined())
+            lighthousekeeper->packages = component["packages"].as<std::vector<std::weak_ptr<Entity>>>();
+        break;
+    }
+
+    case 38: // LighthouseLightComponent
+    {
+        auto const lighthouselight = std::static_pointer_cast<class LighthouseLight>(deserialized_component);
+        if (component["spotlight"].IsDefined())
+            lighthouselight->spotlight = component["spotlight"].as<std::weak_ptr<SpotLight>>();
+        if (component["spotlight_beam_width"].IsDefined())
+            lighthouselight->spotlight_beam_width = component["spotlight_beam_width"].as<float>();
+        break;
+    }
+
+    case 39: // PlayerComponent
+    {
+        auto const player = std::static_pointer_cast<class Player>(deserialized_component);
+        if (component["packages_text"].IsDefined())
+            player->packages_text = component["packages_text"].as<std::weak_ptr<ScreenText>>();
+        if (component["flashes_text"].IsDefined())
+            player->flashes_text = component["flashes_text"].as<std::weak_ptr<ScreenText>>();
+        if (component["level_text"].IsDefined())
+            player->level_text = component["level_text"].as<std::weak_ptr<ScreenText>>();
+        if (component["clock_text"].IsDefined())
+            player->clock_text = component["clock_text"].as<std::weak_ptr<ScreenText>>();
+        break;
+    }
+
+    case 40: // PopupComponent
+        break;
+
+    case 41: // EndScreenComponent
+    {
+        auto const endscreen = std::static_pointer_cast<class EndScreen>(deserialized_component);
+        if (component["is_failed"].IsDefined())
+            endscreen->is_failed = component["is_failed"].as<bool>();
+        if (component["number_of_stars"].IsDefined())
+            endscreen->number_of_stars = component["number_of_stars"].as<u32>();
+        if (component["stars"].IsDefined())
+            endscreen->stars = component["stars"].as<std::vector<std::weak_ptr<Entity>>>();
+        if (component["star_scale"].IsDefined())
+            endscreen->star_scale = component["star_scale"].as<glm::vec2>();
+        if (component["next_level_button"].IsDefined())
+            endscreen->next_level_button = component["next_level_button"].as<std::weak_ptr<Button>>();
+        if (component["restart_button"].IsDefined())
+            endscreen->restart_button = component["restart_button"].as<std::weak_ptr<Button>>();
+        if (component["menu_button"].IsDefined())
+            endscreen->menu_button = component["menu_button"].as<std::weak_ptr<Button>>();
+        break;
+    }
+
+    case 42: // PortComponent
+    {
+        auto const port = std::static_pointer_cast<class Port>(deserialized_component);
+        if (component["lights"].IsDefined())
+            port->lights = component["lights"].as<std::vector<std::weak_ptr<Entity>>>();
+        break;
+    }
+
+    case 43: // ShipComponent
+    {
+        auto const ship = std::static_pointer_cast<class Ship>(deserialized_component);
+        if (component["type"].IsDefined())
+            ship->type = component["type"].as<ShipType>();
+        if (component["light"].IsDefined())
+            ship->light = component["light"].as<std::weak_ptr<LighthouseLight>>();
+        if (component["spawner"].IsDefined())
+            ship->spawner = component["spawner"].as<std::weak_ptr<ShipSpawner>>();
+        if (component["eyes"].IsDefined())
+            ship->eyes = component["eyes"].as<std::weak_ptr<ShipEyes>>();
+        if (component["my_light"].IsDefined())
+            ship->my_light = component["my_light"].as<std::weak_ptr<PointLight>>();
+        break;
+    }
+
+    case 44: // ShipEyesComponent
+        break;
+
+    case 45: // ShipSpawnerComponent
+    {
+        auto const shipspawner = std::static_pointer_cast<class ShipSpawner>(deserialized_component);
+        if (component["paths"].IsDefined())
+            shipspawner->paths = component["paths"].as<std::vector<std::weak_ptr<Path>>>();
+        if (component["floaters_manager"].IsDefined())
+            shipspawner->floaters_manager = component["floaters_manager"].as<std::weak_ptr<FloatersManager>>();
+        if (component["light"].IsDefined())
+            shipspawner->light = component["light"].as<std::weak_ptr<LighthouseLight>>();
+        if (component["last_chance_food_threshold"].IsDefined())
+            shipspawner->last_chance_food_threshold = component["last_chance_food_threshold"].as<u32>();
+        if (component["last_chance_time_threshold"].IsDefined())
+            shipspawner->last_chance_time_threshold = component["last_chance_time_threshold"].as<float>();
+        if (component["main_event_spawn"].IsDefined())
+            shipspawner->main_event_spawn = component["main_event_spawn"].as<std::vector<SpawnEvent>>();
+        if (component["backup_spawn"].IsDefined())
+            shipspawner->backup_spawn = component["backup_spawn"].as<std::vector<SpawnEvent>>();
+        break;
+    }
+
+    case 46: // ThanksComponent
+    {
+        auto const thanks = std::static_pointer_cast<class Thanks>(deserialized_component);
+        if (component["back_to_menu_button"].IsDefined())
+            thanks->back_to_menu_button = component["back_to_menu_button"].as<std::weak_ptr<Button>>();
+        break;
+    }
+
+    case 47: // PlayerInputComponent
+    {
+        auto const playerinput = std::static_pointer_cast<class PlayerInput>(deserialized_component);
+        if (component["player_speed"].IsDefined())
+            playerinput->player_speed = component["player_speed"].as<float>();
+        if (component["camera_speed"].IsDefined())
+            playerinput->camera_speed = component["camera_speed"].as<float>();
+        break;
+    }
+
+    // # Auto deserialization end
+    default:
+        break;
+    }
+
+    deserialized_entity->add_component(deserialized_component);
+    deserialized_component->reprepare();
+}
+
+void SceneSerializer::auto_transcode_component(YAML::Node const& component, u32 const type, BinarySceneWriter& out)
+{
+    switch (type)
+    {
+    // # Auto binary transcoding start
+    case 0: // CameraComponent
+        out.transcode_field<float>(component["width"]);
+        out.transcode_field<float>(component["height"]);
+        out.transcode_field<float>(component["fov"]);
+        out.transcode_field<float>(component["near_plane"]);
+        out.transcode_field<float>(component["far_plane"]);
+        break;
+
+    case 1: // Collider2DComponent
+        out.transcode_field<glm::vec2>(component["offset"]);
+        out.transcode_field<bool>(component["is_trigger"]);
+        out.transcode_field<bool>(component["is_static"]);
+        out.transcode_field<ColliderType2D>(component["collider_type"]);
+        out.transcode_field<float>(component["width"]);
+        out.transcode_field<float>(component["height"]);
+        out.transcode_field<float>(component["radius"]);
+        out.transcode_field<float>(component["drag"]);
+        out.transcode_field<glm::vec2>(component["velocity"]);
+        break;
+
+    case 2: // CurveComponent
+        out.transcode_field<std::vector<glm::vec2>>(component["points"]);
+        break;
+
+    case 3: // PathComponent
+        out.transcode_field<std::vector<glm::vec2>>(component["points"]);
+        break;
+
+    case 4: // DebugInputControllerComponent
+        out.transcode_field<float>(component["gamma"]);
+        out.transcode_field<float>(component["exposure"]);
+        break;
+
+    case 5: // DialoguePromptControllerComponent
+        out.transcode_field<float>(component["interp_speed"]);
+        out.transcode_field<std::weak_ptr<Button>>(component["dialogue_panel"]);
+        out.transcode_field<std::weak_ptr<Entity>>(component["panel_parent"]);
+        out.transcode_field<std::weak_ptr<Entity>>(component["keeper_sprite"]);
+        out.transcode_field<std::weak_ptr<ScreenText>>(component["upper_text"]);
+        out.transcode_field<std::weak_ptr<ScreenText>>(component["middle_text"]);
+        out.transcode_field<std::weak_ptr<ScreenText>>(component["lower_text"]);
+        out.transcode_field<std::vector<DialogueObject>>(component["dialogue_objects"]);
+        break;
+
+    case 6: // ButtonComponent
+        out.transcode_field<std::string>(component["path_default"]);
+        out.transcode_field<std::string>(component["path_hovered"]);
+        out.transcode_field<std::string>(component["path_pressed"]);
+        out.transcode_field<glm::vec2>(component["top_left_corner"]);
+        out.transcode_field<glm::vec2>(component["top_right_corner"]);
+        out.transcode_field<glm::vec2>(component["bottom_left_corner"]);
+        out.transcode_field<glm::vec2>(component["bottom_right_corner"]);
+        out.transcode_field<std::shared_ptr<Material>>(component["material"]);
+        break;
+
+    case 7: // ModelComponent
+        out.transcode_field<std::string>(component["model_path"]);
+        out.transcode_field<std::shared_ptr<Material>>(component["material"]);
+        break;
+
+    case 8: // CubeComponent
+        out.transcode_field<std::string>(component["diffuse_texture_path"]);
+        out.transcode_field<std::string>(component["specular_texture_path"]);
+        out.transcode_field<std::string>(component["model_path"]);
+        out.transcode_field<std::shared_ptr<Material>>(component["material"]);
+        break;
+
+    case 9: // SphereComponent
+        out.transcode_field<u32>(component["sector_count"]);
+        out.transcode_field<u32>(component["stack_count"]);
+        out.transcode_field<std::string>(component["texture_path"]);
+        out.transcode_field<float>(component["radius"]);
+        out.transcode_field<std::string>(component["model_path"]);
+        out.transcode_field<std::shared_ptr<Material>>(component["material"]);
+        break;
+
+    case 10: // SpriteComponent
+        out.transcode_field<std::string>(component["diffuse_texture_path"]);
+        out.transcode_field<std::string>(component["model_path"]);
+        out.transcode_field<std::shared_ptr<Material>>(component["material"]);
+        break;
+
+    case 11: // WaterComponent
+        out.transcode_field<std::vector<DXWave>>(component["waves"]);
+        out.transcode_field<ConstantBufferWater>(component["m_ps_buffer"]);
+        out.transcode_field<u32>(component["tesselation_level"]);
+        out.transcode_field<std::string>(component["model_path"]);
+        out.transcode_field<std::shared_ptr<Material>>(component["material"]);
+        break;
+
+    case 12: // PanelComponent
+        out.transcode_field<std::string>(component["background_path"]);
+        out.transcode_field<std::shared_ptr<Material>>(component["material"]);
+        break;
+
+    case 13: // ScreenTextComponent
+        out.transcode_field<std::string>(component["text"]);
+        out.transcode_field<glm::vec2>(component["position"]);
+        out.transcode_field<float>(component["font_size"]);
+        out.transcode_field<u32>(component["color"]);
+        out.transcode_field<u16>(component["flags"]);
+        out.transcode_field<std::string>(component["font_name"]);
+        out.transcode_field<bool>(component["bold"]);
+        out.transcode_field<std::weak_ptr<Button>>(component["button_ref"]);
+        out.transcode_field<std::shared_ptr<Material>>(component["material"]);
+        break;
+
+    case 14: // SkinnedModelComponent
+        out.transcode_field<std::string>(component["model_path"]);
+        out.transcode_field<std::string>(component["anim_path"]);
+        out.transcode_field<std::shared_ptr<Material>>(component["material"]);
+        break;
+
+    case 15: // ExampleDynamicTextComponent
+        break;
+
+    case 16: // ExampleUIBarComponent
+        out.transcode_field<float>(component["value"]);
+        break;
+
+    case 17: // FloaterComponent
+        out.transcode_field<float>(component["sink"]);
+        out.transcode_field<float>(component["side_floaters_offset"]);
+        out.transcode_field<float>(component["side_roation_strength"]);
+        out.transcode_field<float>(component["forward_rotation_strength"]);
+        out.transcode_field<float>(component["forward_floaters_offest"]);
+        out.transcode_field<std::weak_ptr<Water>>(component["water"]);
+        break;
+
+    case 18: // FloatersManagerComponent
+        out.transcode_field<FloaterSettings>(component["big_boat_settings"]);
+        out.transcode_field<FloaterSettings>(component["small_boat_settings"]);
+        out.transcode_field<FloaterSettings>(component["medium_boat_settings"]);
+        out.transcode_field<FloaterSettings>(component["tool_boat_settings"]);
+        out.transcode_field<FloaterSettings>(component["pirate_boat_settings"]);
+        out.transcode_field<std::weak_ptr<Water>>(component["water"]);
+        break;
+
+    case 19: // FloeButtonComponent
+        out.transcode_field<FloeButtonType>(component["floe_button_type"]);
+        break;
+
+    case 20: // DirectionalLightComponent
+        out.transcode_field<glm::vec3>(component["ambient"]);
+        out.transcode_field<glm::vec3>(component["diffuse"]);
+        out.transcode_field<glm::vec3>(component["specular"]);
+        out.transcode_field<float>(component["m_near_plane"]);
+        out.transcode_field<float>(component["m_far_plane"]);
+        out.transcode_field<u32>(component["m_blocker_search_num_samples"]);
+        out.transcode_field<u32>(component["m_pcf_num_samples"]);
+        out.transcode_field<float>(component["m_light_world_size"]);
+        out.transcode_field<float>(component["m_light_frustum_width"]);
+        break;
+
+    case 21: // PointLightComponent
+        out.transcode_field<float>(component["constant"]);
+        out.transcode_field<float>(component["linear"]);
+        out.transcode_field<float>(component["quadratic"]);
+        out.transcode_field<glm::vec3>(component["ambient"]);
+        out.transcode_field<glm::vec3>(component["diffuse"]);
+        out.transcode_field<glm::vec3>(component["specular"]);
+        out.transcode_field<float>(component["m_near_plane"]);
+        out.transcode_field<float>(component["m_far_plane"]);
+        out.transcode_field<u32>(component["m_blocker_search_num_samples"]);
+        out.transcode_field<u32>(component["m_pcf_num_samples"]);
+        out.transcode_field<float>(component["m_light_world_size"]);
+        out.transcode_field<float>(component["m_light_frustum_width"]);
+        break;
+
+    case 22: // SpotLightComponent
+        out.transcode_field<float>(component["constant"]);
+        out.transcode_field<float>(component["linear"]);
+        out.transcode_field<float>(component["quadratic"]);
+        out.transcode_field<float>(component["scattering_factor"]);
+        out.transcode_field<float>(component["cut_off"]);
+        out.transcode_field<float>(component["outer_cut_off"]);
+        out.transcode_field<glm::vec3>(component["ambient"]);
+        out.transcode_field<glm::vec3>(component["diffuse"]);
+        out.transcode_field<glm::vec3>(component["specular"]);
+        out.transcode_field<float>(component["m_near_plane"]);
+        out.transcode_field<float>(component["m_far_plane"]);
+        out.transcode_field<u32>(component["m_blocker_search_num_samples"]);
+        out.transcode_field<u32>(component["m_pcf_num_samples"]);
+        out.transcode_field<float>(component["m_light_world_size"]);
+        out.transcode_field<float>(component["m_light_frustum_width"]);
+        break;
+
+    case 23: // NowPromptTriggerComponent
+        break;
+
+    case 24: // ParticleSystemComponent
+        out.transcode_field<ParticleType>(component["particle_type"]);
+        out.transcode_field<bool>(component["play_once"]);
+        out.transcode_field<bool>(component["rotate_particles"]);
+        out.transcode_field<bool>(component["spawn_instantly"]);
+        out.transcode_field<std::string>(component["sprite_path"]);
+        out.transcode_field<float>(component["min_spawn_interval"]);
+        out.transcode_field<float>(component["max_spawn_interval"]);
+        out.transcode_field<glm::vec3>(component["start_velocity_1"]);
+        out.transcode_field<glm::vec3>(component["start_velocity_2"]);
+        out.transcode_field<float>(component["min_spawn_alpha"]);
+        out.transcode_field<float>(component["max_spawn_alpha"]);
+        out.transcode_field<glm::vec3>(component["start_min_particle_size"]);
+        out.transcode_field<glm::vec3>(component["start_max_particle_size"]);
+        out.transcode_field<float>(component["emitter_bounds"]);
+        out.transcode_field<i32>(component["min_spawn_count"]);
+        out.transcode_field<i32>(component["max_spawn_count"]);
+        out.transcode_field<glm::vec4>(component["start_color_1"]);
+        out.transcode_field<glm::vec4>(component["end_color_1"]);
+        out.transcode_field<float>(component["lifetime_1"]);
+        out.transcode_field<float>(component["lifetime_2"]);
+        out.transcode_field<bool>(component["m_simulate_in_world_space"]);
+        break;
+
+    case 25: // SoundComponent
+        out.transcode_field<std::string>(component["path"]);
+        out.transcode_field<float>(component["volume"]);
+        out.transcode_field<bool>(component["play_on_awake"]);
+        out.transcode_field<bool>(component["is_positional"]);
+        break;
+
+    case 26: // SoundListenerComponent
+        break;
+
+    case 27: // ClockComponent
+        break;
+
+    case 28: // CreditsComponent
+        out.transcode_field<std::weak_ptr<Button>>(component["back_to_menu_button"]);
+        break;
+
+    case 29: // CustomerComponent
+        out.transcode_field<std::weak_ptr<Collider2D>>(component["collider"]);
+        out.transcode_field<std::weak_ptr<Entity>>(component["left_hand"]);
+        out.transcode_field<std::weak_ptr<Entity>>(component["right_hand"]);
+        break;
+
+    case 30: // CustomerManagerComponent
+        out.transcode_field<std::vector<std::weak_ptr<Entity>>>(component["destinations_after_feeding"]);
+        out.transcode_field<std::weak_ptr<Curve>>(component["destination_curve"]);
+        out.transcode_field<std::string>(component["customer_prefab"]);
+        break;
+
+    case 31: // FactoryComponent
+        out.transcode_field<FactoryType>(component["type"]);
+        out.transcode_field<std::vector<std::weak_ptr<PointLight>>>(component["lights"]);
+        out.transcode_field<std::weak_ptr<PointLight>>(component["factory_light"]);
+        break;
+
+    case 32: // GameControllerComponent
+        out.transcode_field<std::weak_ptr<Entity>>(component["current_scene"]);
+        out.transcode_field<std::weak_ptr<Entity>>(component["next_scene"]);
+        out.transcode_field<std::weak_ptr<DialoguePromptController>>(component["dialog_manager"]);
+        break;
+
+    case 33: // HovercraftWithoutKeeperComponent
+        break;
+
+    case 34: // IceBoundComponent
+        break;
+
+    case 35: // LevelControllerComponent
+        out.transcode_field<float>(component["map_time"]);
+        out.transcode_field<u32>(component["map_food"]);
+        out.transcode_field<i32>(component["maximum_lighthouse_level"]);
+        out.transcode_field<std::vector<std::weak_ptr<Factory>>>(component["factories"]);
+        out.transcode_field<std::weak_ptr<Port>>(component["port"]);
+        out.transcode_field<std::weak_ptr<Lighthouse>>(component["lighthouse"]);
+        out.transcode_field<std::weak_ptr<CustomerManager>>(component["customer_manager"]);
+        out.transcode_field<float>(component["playfield_width"]);
+        out.transcode_field<float>(component["playfield_additional_width"]);
+        out.transcode_field<float>(component["playfield_height"]);
+        out.transcode_field<float>(component["playfield_y_shift"]);
+        out.transcode_field<std::weak_ptr<Curve>>(component["ships_limit_curve"]);
+        out.transcode_field<u32>(component["ships_limit"]);
+        out.transcode_field<std::weak_ptr<Curve>>(component["ships_speed_curve"]);
+        out.transcode_field<float>(component["ships_speed"]);
+        out.transcode_field<std::weak_ptr<Curve>>(component["ships_range_curve"]);
+        out.transcode_field<std::weak_ptr<Curve>>(component["ships_turn_curve"]);
+        out.transcode_field<std::weak_ptr<Curve>>(component["ships_additional_speed_curve"]);
+        out.transcode_field<std::weak_ptr<Curve>>(component["pirates_in_control_curve"]);
+        out.transcode_field<bool>(component["is_tutorial"]);
+        out.transcode_field<u32>(component["starting_packages"]);
+        out.transcode_field<u32>(component["tutorial_level"]);
+        break;
+
+    case 36: // LighthouseComponent
+        out.transcode_field<std::weak_ptr<LighthouseLight>>(component["light"]);
+        out.transcode_field<std::weak_ptr<Water>>(component["water"]);
+        out.transcode_field<std::weak_ptr<Entity>>(component["spawn_position"]);
+        break;
+
+    case 37: // LighthouseKeeperComponent
+        out.transcode_field<float>(component["maximum_speed"]);
+        out.transcode_field<float>(component["acceleration"]);
+        out.transcode_field<float>(component["deceleration"]);
+        out.transcode_field<std::weak_ptr<Lighthouse>>(component["lighthouse"]);
+        out.transcode_field<std::weak_ptr<Port>>(component["port"]);
+        out.transcode_field<std::weak_ptr<ParticleSystem>>(component["keeper_dust"]);
+        out.transcode_field<std::weak_ptr<ParticleSystem>>(component["keeper_splash"]);
+        out.transcode_field<std::vector<std::weak_ptr<Entity>>>(component["packages"]);
+        break;
+
+    case 38: // LighthouseLightComponent
+        out.transcode_field<std::weak_ptr<SpotLight>>(component["spotlight"]);
+        out.transcode_field<float>(component["spotlight_beam_width"]);
+        break;
+
+    case 39: // PlayerComponent
+        out.transcode_field<std::weak_ptr<ScreenText>>(component["packages_text"]);
+        out.transcode_field<std::weak_ptr<ScreenText>>(component["flashes_text"]);
+        out.transcode_field<std::weak_ptr<ScreenText>>(component["level_text"]);
+        out.transcode_field<std::weak_ptr<ScreenText>>(component["clock_text"]);
+        break;
+
+    case 40: // PopupComponent
+        break;
+
+    case 41: // EndScreenComponent
+        out.transcode_field<bool>(component["is_failed"]);
+        out.transcode_field<u32>(component["number_of_stars"]);
+        out.transcode_field<std::vector<std::weak_ptr<Entity>>>(component["stars"]);
+        out.transcode_field<glm::vec2>(component["star_scale"]);
+        out.transcode_field<std::weak_ptr<Button>>(component["next_level_button"]);
+        out.transcode_field<std::weak_ptr<Button>>(component["restart_button"]);
+        out.transcode_field<std::weak_ptr<Button>>(component["menu_button"]);
+        break;
+
+    case 42: // PortComponent
+        out.transcode_field<std::vector<std::weak_ptr<Entity>>>(component["lights"]);
+        break;
+
+    case 43: // ShipComponent
+        out.transcode_field<ShipType>(component["type"]);
+        out.transcode_field<std::weak_ptr<LighthouseLight>>(component["light"]);
+        out.transcode_field<std::weak_ptr<ShipSpawner>>(component["spawner"]);
+        out.transcode_field<std::weak_ptr<ShipEyes>>(component["eyes"]);
+        out.transcode_field<std::weak_ptr<PointLight>>(component["my_light"]);
+        break;
+
+    case 44: // ShipEyesComponent
+        break;
+
+    case 45: // ShipSpawnerComponent
+        out.transcode_field<std::vector<std::weak_ptr<Path>>>(component["paths"]);
+        out.transcode_field<std::weak_ptr<FloatersManager>>(component["floaters_manager"]);
+        out.transcode_field<std::weak_ptr<LighthouseLight>>(component["light"]);
+        out.transcode_field<u32>(component["last_chance_food_threshold"]);
+        out.transcode_field<float>(component["last_chance_time_threshold"]);
+        out.transcode_field<std::vector<SpawnEvent>>(component["main_event_spawn"]);
+        out.transcode_field<std::vector<SpawnEvent>>(component["backup_spawn"]);
+        break;
+
+    case 46: // ThanksComponent
+        out.transcode_field<std::weak_ptr<Button>>(component["back_to_menu_button"]);
+        break;
+
+    case 47: // PlayerInputComponent
+        out.transcode_field<float>(component["player_speed"]);
+        out.transcode_field<float>(component["camera_speed"]);
+        break;
+
+    // # Auto binary transcoding end
+    default:
+        break;
     }
-    else if (component_name == "ClockComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = Clock::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Clock>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+}
+
+void SceneSerializer::auto_deserialize_component_binary(BinarySceneReader& in, u32 const type, std::shared_ptr<Component> const& component)
+{
+    switch (type)
+    {
+    // # Auto binary deserialization start
+    case 0: // CameraComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Camera>(component);
+        if (in.has_field())
+            deserialized_component->width = in.read<float>();
+        if (in.has_field())
+            deserialized_component->height = in.read<float>();
+        if (in.has_field())
+            deserialized_component->fov = in.read<float>();
+        if (in.has_field())
+            deserialized_component->near_plane = in.read<float>();
+        if (in.has_field())
+            deserialized_component->far_plane = in.read<float>();
+        break;
+    }
+
+    case 1: // Collider2DComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Collider2D>(component);
+        if (in.has_field())
+            deserialized_component->offset = in.read<glm::vec2>();
+        if (in.has_field())
+            deserialized_component->is_trigger = in.read<bool>();
+        if (in.has_field())
+            deserialized_component->is_static = in.read<bool>();
+        if (in.has_field())
+            deserialized_component->collider_type = in.read<ColliderType2D>();
+        if (in.has_field())
+            deserialized_component->width = in.read<float>();
+        if (in.has_field())
+            deserialized_component->height = in.read<float>();
+        if (in.has_field())
+            deserialized_component->radius = in.read<float>();
+        if (in.has_field())
+            deserialized_component->drag = in.read<float>();
+        if (in.has_field())
+            deserialized_component->velocity = in.read<glm::vec2>();
+        break;
+    }
+
+    case 2: // CurveComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Curve>(component);
+        if (in.has_field())
+            deserialized_component->points = in.read<std::vector<glm::vec2>>();
+        break;
+    }
+
+    case 3: // PathComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Path>(component);
+        if (in.has_field())
+            deserialized_component->points = in.read<std::vector<glm::vec2>>();
+        break;
+    }
+
+    case 4: // DebugInputControllerComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class DebugInputController>(component);
+        if (in.has_field())
+            deserialized_component->gamma = in.read<float>();
+        if (in.has_field())
+            deserialized_component->exposure = in.read<float>();
+        break;
+    }
+
+    case 5: // DialoguePromptControllerComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class DialoguePromptController>(component);
+        if (in.has_field())
+            deserialized_component->interp_speed = in.read<float>();
+        if (in.has_field())
+            deserialized_component->dialogue_panel = in.read<std::weak_ptr<Button>>();
+        if (in.has_field())
+            deserialized_component->panel_parent = in.read<std::weak_ptr<Entity>>();
+        if (in.has_field())
+            deserialized_component->keeper_sprite = in.read<std::weak_ptr<Entity>>();
+        if (in.has_field())
+            deserialized_component->upper_text = in.read<std::weak_ptr<ScreenText>>();
+        if (in.has_field())
+            deserialized_component->middle_text = in.read<std::weak_ptr<ScreenText>>();
+        if (in.has_field())
+            deserialized_component->lower_text = in.read<std::weak_ptr<ScreenText>>();
+        if (in.has_field())
+            deserialized_component->dialogue_objects = in.read<std::vector<DialogueObject>>();
+        break;
+    }
+
+    case 6: // ButtonComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Button>(component);
+        if (in.has_field())
+            deserialized_component->path_default = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->path_hovered = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->path_pressed = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->top_left_corner = in.read<glm::vec2>();
+        if (in.has_field())
+            deserialized_component->top_right_corner = in.read<glm::vec2>();
+        if (in.has_field())
+            deserialized_component->bottom_left_corner = in.read<glm::vec2>();
+        if (in.has_field())
+            deserialized_component->bottom_right_corner = in.read<glm::vec2>();
+        if (in.has_field())
+            deserialized_component->material = in.read<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 7: // ModelComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Model>(component);
+        if (in.has_field())
+            deserialized_component->model_path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->material = in.read<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 8: // CubeComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Cube>(component);
+        if (in.has_field())
+            deserialized_component->diffuse_texture_path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->specular_texture_path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->model_path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->material = in.read<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 9: // SphereComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Sphere>(component);
+        if (in.has_field())
+            deserialized_component->sector_count = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->stack_count = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->texture_path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->radius = in.read<float>();
+        if (in.has_field())
+            deserialized_component->model_path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->material = in.read<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 10: // SpriteComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Sprite>(component);
+        if (in.has_field())
+            deserialized_component->diffuse_texture_path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->model_path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->material = in.read<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 11: // WaterComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Water>(component);
+        if (in.has_field())
+            deserialized_component->waves = in.read<std::vector<DXWave>>();
+        if (in.has_field())
+            deserialized_component->m_ps_buffer = in.read<ConstantBufferWater>();
+        if (in.has_field())
+            deserialized_component->tesselation_level = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->model_path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->material = in.read<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 12: // PanelComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Panel>(component);
+        if (in.has_field())
+            deserialized_component->background_path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->material = in.read<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 13: // ScreenTextComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class ScreenText>(component);
+        if (in.has_field())
+            deserialized_component->text = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->position = in.read<glm::vec2>();
+        if (in.has_field())
+            deserialized_component->font_size = in.read<float>();
+        if (in.has_field())
+            deserialized_component->color = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->flags = in.read<u16>();
+        if (in.has_field())
+            deserialized_component->font_name = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->bold = in.read<bool>();
+        if (in.has_field())
+            deserialized_component->button_ref = in.read<std::weak_ptr<Button>>();
+        if (in.has_field())
+            deserialized_component->material = in.read<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 14: // SkinnedModelComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class SkinnedModel>(component);
+        if (in.has_field())
+            deserialized_component->model_path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->anim_path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->material = in.read<std::shared_ptr<Material>>();
+        break;
+    }
+
+    case 15: // ExampleDynamicTextComponent
+        break;
+
+    case 16: // ExampleUIBarComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class ExampleUIBar>(component);
+        if (in.has_field())
+            deserialized_component->value = in.read<float>();
+        break;
+    }
+
+    case 17: // FloaterComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Floater>(component);
+        if (in.has_field())
+            deserialized_component->sink = in.read<float>();
+        if (in.has_field())
+            deserialized_component->side_floaters_offset = in.read<float>();
+        if (in.has_field())
+            deserialized_component->side_roation_strength = in.read<float>();
+        if (in.has_field())
+            deserialized_component->forward_rotation_strength = in.read<float>();
+        if (in.has_field())
+            deserialized_component->forward_floaters_offest = in.read<float>();
+        if (in.has_field())
+            deserialized_component->water = in.read<std::weak_ptr<Water>>();
+        break;
+    }
+
+    case 18: // FloatersManagerComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class FloatersManager>(component);
+        if (in.has_field())
+            deserialized_component->big_boat_settings = in.read<FloaterSettings>();
+        if (in.has_field())
+            deserialized_component->small_boat_settings = in.read<FloaterSettings>();
+        if (in.has_field())
+            deserialized_component->medium_boat_settings = in.read<FloaterSettings>();
+        if (in.has_field())
+            deserialized_component->tool_boat_settings = in.read<FloaterSettings>();
+        if (in.has_field())
+            deserialized_component->pirate_boat_settings = in.read<FloaterSettings>();
+        if (in.has_field())
+            deserialized_component->water = in.read<std::weak_ptr<Water>>();
+        break;
+    }
+
+    case 19: // FloeButtonComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class FloeButton>(component);
+        if (in.has_field())
+            deserialized_component->floe_button_type = in.read<FloeButtonType>();
+        break;
+    }
+
+    case 20: // DirectionalLightComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class DirectionalLight>(component);
+        if (in.has_field())
+            deserialized_component->ambient = in.read<glm::vec3>();
+        if (in.has_field())
+            deserialized_component->diffuse = in.read<glm::vec3>();
+        if (in.has_field())
+            deserialized_component->specular = in.read<glm::vec3>();
+        if (in.has_field())
+            deserialized_component->m_near_plane = in.read<float>();
+        if (in.has_field())
+            deserialized_component->m_far_plane = in.read<float>();
+        if (in.has_field())
+            deserialized_component->m_blocker_search_num_samples = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->m_pcf_num_samples = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->m_light_world_size = in.read<float>();
+        if (in.has_field())
+            deserialized_component->m_light_frustum_width = in.read<float>();
+        break;
+    }
+
+    case 21: // PointLightComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class PointLight>(component);
+        if (in.has_field())
+            deserialized_component->constant = in.read<float>();
+        if (in.has_field())
+            deserialized_component->linear = in.read<float>();
+        if (in.has_field())
+            deserialized_component->quadratic = in.read<float>();
+        if (in.has_field())
+            deserialized_component->ambient = in.read<glm::vec3>();
+        if (in.has_field())
+            deserialized_component->diffuse = in.read<glm::vec3>();
+        if (in.has_field())
+            deserialized_component->specular = in.read<glm::vec3>();
+        if (in.has_field())
+            deserialized_component->m_near_plane = in.read<float>();
+        if (in.has_field())
+            deserialized_component->m_far_plane = in.read<float>();
+        if (in.has_field())
+            deserialized_component->m_blocker_search_num_samples = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->m_pcf_num_samples = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->m_light_world_size = in.read<float>();
+        if (in.has_field())
+            deserialized_component->m_light_frustum_width = in.read<float>();
+        break;
+    }
+
+    case 22: // SpotLightComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class SpotLight>(component);
+        if (in.has_field())
+            deserialized_component->constant = in.read<float>();
+        if (in.has_field())
+            deserialized_component->linear = in.read<float>();
+        if (in.has_field())
+            deserialized_component->quadratic = in.read<float>();
+        if (in.has_field())
+            deserialized_component->scattering_factor = in.read<float>();
+        if (in.has_field())
+            deserialized_component->cut_off = in.read<float>();
+        if (in.has_field())
+            deserialized_component->outer_cut_off = in.read<float>();
+        if (in.has_field())
+            deserialized_component->ambient = in.read<glm::vec3>();
+        if (in.has_field())
+            deserialized_component->diffuse = in.read<glm::vec3>();
+        if (in.has_field())
+            deserialized_component->specular = in.read<glm::vec3>();
+        if (in.has_field())
+            deserialized_component->m_near_plane = in.read<float>();
+        if (in.has_field())
+            deserialized_component->m_far_plane = in.read<float>();
+        if (in.has_field())
+            deserialized_component->m_blocker_search_num_samples = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->m_pcf_num_samples = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->m_light_world_size = in.read<float>();
+        if (in.has_field())
+            deserialized_component->m_light_frustum_width = in.read<float>();
+        break;
+    }
+
+    case 23: // NowPromptTriggerComponent
+        break;
+
+    case 24: // ParticleSystemComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class ParticleSystem>(component);
+        if (in.has_field())
+            deserialized_component->particle_type = in.read<ParticleType>();
+        if (in.has_field())
+            deserialized_component->play_once = in.read<bool>();
+        if (in.has_field())
+            deserialized_component->rotate_particles = in.read<bool>();
+        if (in.has_field())
+            deserialized_component->spawn_instantly = in.read<bool>();
+        if (in.has_field())
+            deserialized_component->sprite_path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->min_spawn_interval = in.read<float>();
+        if (in.has_field())
+            deserialized_component->max_spawn_interval = in.read<float>();
+        if (in.has_field())
+            deserialized_component->start_velocity_1 = in.read<glm::vec3>();
+        if (in.has_field())
+            deserialized_component->start_velocity_2 = in.read<glm::vec3>();
+        if (in.has_field())
+            deserialized_component->min_spawn_alpha = in.read<float>();
+        if (in.has_field())
+            deserialized_component->max_spawn_alpha = in.read<float>();
+        if (in.has_field())
+            deserialized_component->start_min_particle_size = in.read<glm::vec3>();
+        if (in.has_field())
+            deserialized_component->start_max_particle_size = in.read<glm::vec3>();
+        if (in.has_field())
+            deserialized_component->emitter_bounds = in.read<float>();
+        if (in.has_field())
+            deserialized_component->min_spawn_count = in.read<i32>();
+        if (in.has_field())
+            deserialized_component->max_spawn_count = in.read<i32>();
+        if (in.has_field())
+            deserialized_component->start_color_1 = in.read<glm::vec4>();
+        if (in.has_field())
+            deserialized_component->end_color_1 = in.read<glm::vec4>();
+        if (in.has_field())
+            deserialized_component->lifetime_1 = in.read<float>();
+        if (in.has_field())
+            deserialized_component->lifetime_2 = in.read<float>();
+        if (in.has_field())
+            deserialized_component->m_simulate_in_world_space = in.read<bool>();
+        break;
+    }
+
+    case 25: // SoundComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Sound>(component);
+        if (in.has_field())
+            deserialized_component->path = in.read<std::string>();
+        if (in.has_field())
+            deserialized_component->volume = in.read<float>();
+        if (in.has_field())
+            deserialized_component->play_on_awake = in.read<bool>();
+        if (in.has_field())
+            deserialized_component->is_positional = in.read<bool>();
+        break;
+    }
+
+    case 26: // SoundListenerComponent
+        break;
+
+    case 27: // ClockComponent
+        break;
+
+    case 28: // CreditsComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Credits>(component);
+        if (in.has_field())
+            deserialized_component->back_to_menu_button = in.read<std::weak_ptr<Button>>();
+        break;
+    }
+
+    case 29: // CustomerComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Customer>(component);
+        if (in.has_field())
+            deserialized_component->collider = in.read<std::weak_ptr<Collider2D>>();
+        if (in.has_field())
+            deserialized_component->left_hand = in.read<std::weak_ptr<Entity>>();
+        if (in.has_field())
+            deserialized_component->right_hand = in.read<std::weak_ptr<Entity>>();
+        break;
+    }
+
+    case 30: // CustomerManagerComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class CustomerManager>(component);
+        if (in.has_field())
+            deserialized_component->destinations_after_feeding = in.read<std::vector<std::weak_ptr<Entity>>>();
+        if (in.has_field())
+            deserialized_component->destination_curve = in.read<std::weak_ptr<Curve>>();
+        if (in.has_field())
+            deserialized_component->customer_prefab = in.read<std::string>();
+        break;
+    }
+
+    case 31: // FactoryComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Factory>(component);
+        if (in.has_field())
+            deserialized_component->type = in.read<FactoryType>();
+        if (in.has_field())
+            deserialized_component->lights = in.read<std::vector<std::weak_ptr<PointLight>>>();
+        if (in.has_field())
+            deserialized_component->factory_light = in.read<std::weak_ptr<PointLight>>();
+        break;
+    }
+
+    case 32: // GameControllerComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class GameController>(component);
+        if (in.has_field())
+            deserialized_component->current_scene = in.read<std::weak_ptr<Entity>>();
+        if (in.has_field())
+            deserialized_component->next_scene = in.read<std::weak_ptr<Entity>>();
+        if (in.has_field())
+            deserialized_component->dialog_manager = in.read<std::weak_ptr<DialoguePromptController>>();
+        break;
+    }
+
+    case 33: // HovercraftWithoutKeeperComponent
+        break;
+
+    case 34: // IceBoundComponent
+        break;
+
+    case 35: // LevelControllerComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class LevelController>(component);
+        if (in.has_field())
+            deserialized_component->map_time = in.read<float>();
+        if (in.has_field())
+            deserialized_component->map_food = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->maximum_lighthouse_level = in.read<i32>();
+        if (in.has_field())
+            deserialized_component->factories = in.read<std::vector<std::weak_ptr<Factory>>>();
+        if (in.has_field())
+            deserialized_component->port = in.read<std::weak_ptr<Port>>();
+        if (in.has_field())
+            deserialized_component->lighthouse = in.read<std::weak_ptr<Lighthouse>>();
+        if (in.has_field())
+            deserialized_component->customer_manager = in.read<std::weak_ptr<CustomerManager>>();
+        if (in.has_field())
+            deserialized_component->playfield_width = in.read<float>();
+        if (in.has_field())
+            deserialized_component->playfield_additional_width = in.read<float>();
+        if (in.has_field())
+            deserialized_component->playfield_height = in.read<float>();
+        if (in.has_field())
+            deserialized_component->playfield_y_shift = in.read<float>();
+        if (in.has_field())
+            deserialized_component->ships_limit_curve = in.read<std::weak_ptr<Curve>>();
+        if (in.has_field())
+            deserialized_component->ships_limit = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->ships_speed_curve = in.read<std::weak_ptr<Curve>>();
+        if (in.has_field())
+            deserialized_component->ships_speed = in.read<float>();
+        if (in.has_field())
+            deserialized_component->ships_range_curve = in.read<std::weak_ptr<Curve>>();
+        if (in.has_field())
+            deserialized_component->ships_turn_curve = in.read<std::weak_ptr<Curve>>();
+        if (in.has_field())
+            deserialized_component->ships_additional_speed_curve = in.read<std::weak_ptr<Curve>>();
+        if (in.has_field())
+            deserialized_component->pirates_in_control_curve = in.read<std::weak_ptr<Curve>>();
+        if (in.has_field())
+            deserialized_component->is_tutorial = in.read<bool>();
+        if (in.has_field())
+            deserialized_component->starting_packages = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->tutorial_level = in.read<u32>();
+        break;
+    }
+
+    case 36: // LighthouseComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Lighthouse>(component);
+        if (in.has_field())
+            deserialized_component->light = in.read<std::weak_ptr<LighthouseLight>>();
+        if (in.has_field())
+            deserialized_component->water = in.read<std::weak_ptr<Water>>();
+        if (in.has_field())
+            deserialized_component->spawn_position = in.read<std::weak_ptr<Entity>>();
+        break;
+    }
+
+    case 37: // LighthouseKeeperComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class LighthouseKeeper>(component);
+        if (in.has_field())
+            deserialized_component->maximum_speed = in.read<float>();
+        if (in.has_field())
+            deserialized_component->acceleration = in.read<float>();
+        if (in.has_field())
+            deserialized_component->deceleration = in.read<float>();
+        if (in.has_field())
+            deserialized_component->lighthouse = in.read<std::weak_ptr<Lighthouse>>();
+        if (in.has_field())
+            deserialized_component->port = in.read<std::weak_ptr<Port>>();
+        if (in.has_field())
+            deserialized_component->keeper_dust = in.read<std::weak_ptr<ParticleSystem>>();
+        if (in.has_field())
+            deserialized_component->keeper_splash = in.read<std::weak_ptr<ParticleSystem>>();
+        if (in.has_field())
+            deserialized_component->packages = in.read<std::vector<std::weak_ptr<Entity>>>();
+        break;
+    }
+
+    case 38: // LighthouseLightComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class LighthouseLight>(component);
+        if (in.has_field())
+            deserialized_component->spotlight = in.read<std::weak_ptr<SpotLight>>();
+        if (in.has_field())
+            deserialized_component->spotlight_beam_width = in.read<float>();
+        break;
+    }
+
+    case 39: // PlayerComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Player>(component);
+        if (in.has_field())
+            deserialized_component->packages_text = in.read<std::weak_ptr<ScreenText>>();
+        if (in.has_field())
+            deserialized_component->flashes_text = in.read<std::weak_ptr<ScreenText>>();
+        if (in.has_field())
+            deserialized_component->level_text = in.read<std::weak_ptr<ScreenText>>();
+        if (in.has_field())
+            deserialized_component->clock_text = in.read<std::weak_ptr<ScreenText>>();
+        break;
+    }
+
+    case 40: // PopupComponent
+        break;
+
+    case 41: // EndScreenComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class EndScreen>(component);
+        if (in.has_field())
+            deserialized_component->is_failed = in.read<bool>();
+        if (in.has_field())
+            deserialized_component->number_of_stars = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->stars = in.read<std::vector<std::weak_ptr<Entity>>>();
+        if (in.has_field())
+            deserialized_component->star_scale = in.read<glm::vec2>();
+        if (in.has_field())
+            deserialized_component->next_level_button = in.read<std::weak_ptr<Button>>();
+        if (in.has_field())
+            deserialized_component->restart_button = in.read<std::weak_ptr<Button>>();
+        if (in.has_field())
+            deserialized_component->menu_button = in.read<std::weak_ptr<Button>>();
+        break;
+    }
+
+    case 42: // PortComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Port>(component);
+        if (in.has_field())
+            deserialized_component->lights = in.read<std::vector<std::weak_ptr<Entity>>>();
+        break;
+    }
+
+    case 43: // ShipComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Ship>(component);
+        if (in.has_field())
+            deserialized_component->type = in.read<ShipType>();
+        if (in.has_field())
+            deserialized_component->light = in.read<std::weak_ptr<LighthouseLight>>();
+        if (in.has_field())
+            deserialized_component->spawner = in.read<std::weak_ptr<ShipSpawner>>();
+        if (in.has_field())
+            deserialized_component->eyes = in.read<std::weak_ptr<ShipEyes>>();
+        if (in.has_field())
+            deserialized_component->my_light = in.read<std::weak_ptr<PointLight>>();
+        break;
+    }
+
+    case 44: // ShipEyesComponent
+        break;
+
+    case 45: // ShipSpawnerComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class ShipSpawner>(component);
+        if (in.has_field())
+            deserialized_component->paths = in.read<std::vector<std::weak_ptr<Path>>>();
+        if (in.has_field())
+            deserialized_component->floaters_manager = in.read<std::weak_ptr<FloatersManager>>();
+        if (in.has_field())
+            deserialized_component->light = in.read<std::weak_ptr<LighthouseLight>>();
+        if (in.has_field())
+            deserialized_component->last_chance_food_threshold = in.read<u32>();
+        if (in.has_field())
+            deserialized_component->last_chance_time_threshold = in.read<float>();
+        if (in.has_field())
+            deserialized_component->main_event_spawn = in.read<std::vector<SpawnEvent>>();
+        if (in.has_field())
+            deserialized_component->backup_spawn = in.read<std::vector<SpawnEvent>>();
+        break;
+    }
+
+    case 46: // ThanksComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class Thanks>(component);
+        if (in.has_field())
+            deserialized_component->back_to_menu_button = in.read<std::weak_ptr<Button>>();
+        break;
+    }
+
+    case 47: // PlayerInputComponent
+    {
+        auto const deserialized_component = std::static_pointer_cast<class PlayerInput>(component);
+        if (in.has_field())
+            deserialized_component->player_speed = in.read<float>();
+        if (in.has_field())
+            deserialized_component->camera_speed = in.read<float>();
+        break;
+    }
+
+    // # Auto binary deserialization end
+    default:
+        break;
     }
-    else if (component_name == "CreditsComponent")
+}
+
+void SceneSerializer::deserialize_components(YAML::Node const& entity_node, std::shared_ptr<Entity> const& deserialized_entity,
+                                             bool const first_pass)
+{
+    auto const components = entity_node["Components"];
+
+    for (auto it = components.begin(); it != components.end(); ++it)
     {
-        if (first_pass)
+        YAML::Node const& component = *it;
+        auto component_name = component["ComponentName"].as<std::string>();
+        if (false)
         {
-            auto const deserialized_component = Credits::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
+            // Custom deserialization here
         }
         else
         {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class Credits>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["back_to_menu_button"].IsDefined())
-            {
-                deserialized_component->back_to_menu_button = component["back_to_menu_button"].as<std::weak_ptr<Button>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            auto_deserialize_component(component, deserialized_entity, first_pass);
         }
     }
-    else if (component_name == "CustomerComponent")
+}
+
+std::shared_ptr<Entity> SceneSerializer::deserialize_entity_first_pass(YAML::Node const& entity)
+{
+    auto const entity_node = entity["guid"];
+    if (!entity_node)
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = Customer::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class Customer>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["collider"].IsDefined())
-            {
-                deserialized_component->collider = component["collider"].as<std::weak_ptr<Collider2D>>();
-            }
-            if (component["left_hand"].IsDefined())
-            {
-                deserialized_component->left_hand = component["left_hand"].as<std::weak_ptr<Entity>>();
-            }
-            if (component["right_hand"].IsDefined())
-            {
-                deserialized_component->right_hand = component["right_hand"].as<std::weak_ptr<Entity>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+        std::cout << "Deserialization of a scene failed. Broken entity. No guid present."
+                  << "\n";
+        return nullptr;
     }
-    else if (component_name == "CustomerManagerComponent")
+    auto const guid = entity_node.as<std::string>();
+
+    auto const name_node = entity["Name"];
+    if (!name_node)
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = CustomerManager::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class CustomerManager>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["destinations_after_feeding"].IsDefined())
-            {
-                deserialized_component->destinations_after_feeding =
-                    component["destinations_after_feeding"].as<std::vector<std::weak_ptr<Entity>>>();
-            }
-            if (component["destination_curve"].IsDefined())
-            {
-                deserialized_component->destination_curve = component["destination_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["customer_prefab"].IsDefined())
-            {
-                deserialized_component->customer_prefab = component["customer_prefab"].as<std::string>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+        std::cout << "Deserialization of a scene failed. Broken entity. No name present."
+                  << "\n";
+        return nullptr;
     }
-    else if (component_name == "FactoryComponent")
+    auto const name = name_node.as<std::string>();
+
+    std::shared_ptr<Entity> deserialized_entity = Entity::create(guid, name);
+    deserialized_entity->m_is_being_deserialized = true;
+
+    auto const transform = entity["TransformComponent"];
+    if (!transform)
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = Factory::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class Factory>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["type"].IsDefined())
-            {
-                deserialized_component->type = component["type"].as<FactoryType>();
-            }
-            if (component["lights"].IsDefined())
-            {
-                deserialized_component->lights = component["lights"].as<std::vector<std::weak_ptr<PointLight>>>();
-            }
-            if (component["factory_light"].IsDefined())
-            {
-                deserialized_component->factory_light = component["factory_light"].as<std::weak_ptr<PointLight>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+        std::cout << "Deserialization of a scene failed. Broken entity. No transform present."
+                  << "\n";
+        return nullptr;
     }
-    else if (component_name == "GameControllerComponent")
+
+    deserialized_entity->transform->set_local_position(transform["Translation"].as<glm::vec3>());
+    deserialized_entity->transform->set_euler_angles(transform["Rotation"].as<glm::vec3>());
+    deserialized_entity->transform->set_local_scale(transform["Scale"].as<glm::vec3>());
+    deserialized_entity->m_parent_guid = transform["Parent"]["guid"].as<std::string>();
+
+    deserialize_components(entity, deserialized_entity, true);
+
+    return deserialized_entity;
+}
+
+void SceneSerializer::deserialize_entity_second_pass(YAML::Node const& entity, std::shared_ptr<Entity> const& deserialized_entity)
+{
+    deserialize_components(entity, deserialized_entity, false);
+
+    deserialized_entity->m_is_being_deserialized = false;
+}
+
+// Serialize one entity (including its children) to a file.
+void SceneSerializer::serialize_this_entity(std::shared_ptr<Entity> const& entity, std::string const& file_path) const
+{
+    std::filesystem::path const path = file_path;
+
+    if (!path.has_parent_path())
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = GameController::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class GameController>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["current_scene"].IsDefined())
-            {
-                deserialized_component->current_scene = component["current_scene"].as<std::weak_ptr<Entity>>();
-            }
-            if (component["next_scene"].IsDefined())
-            {
-                deserialized_component->next_scene = component["next_scene"].as<std::weak_ptr<Entity>>();
-            }
-            if (component["dialog_manager"].IsDefined())
-            {
-                deserialized_component->dialog_manager = component["dialog_manager"].as<std::weak_ptr<DialoguePromptController>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+        Debug::log("Path to serialize an entity doesn't have a directory. Aborting.", DebugType::Error);
+        return;
     }
-    else if (component_name == "HovercraftWithoutKeeperComponent")
+
+    if (!std::filesystem::exists(path.parent_path()))
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = HovercraftWithoutKeeper::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class HovercraftWithoutKeeper>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+        create_directory(path.parent_path());
     }
-    else if (component_name == "IceBoundComponent")
+
+    std::ofstream scene_file(file_path);
+
+    if (!scene_file.is_open())
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = IceBound::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class IceBound>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+        std::cout << "Could not serialize an entity to a file: " << file_path << "\n";
+        return;
     }
-    else if (component_name == "LevelControllerComponent")
+
+    // Emitted straight into the file.
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = LevelController::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
-        {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class LevelController>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["map_time"].IsDefined())
-            {
-                deserialized_component->map_time = component["map_time"].as<float>();
-            }
-            if (component["map_food"].IsDefined())
-            {
-                deserialized_component->map_food = component["map_food"].as<u32>();
-            }
-            if (component["maximum_lighthouse_level"].IsDefined())
-            {
-                deserialized_component->maximum_lighthouse_level = component["maximum_lighthouse_level"].as<i32>();
-            }
-            if (component["factories"].IsDefined())
-            {
-                deserialized_component->factories = component["factories"].as<std::vector<std::weak_ptr<Factory>>>();
-            }
-            if (component["port"].IsDefined())
-            {
-                deserialized_component->port = component["port"].as<std::weak_ptr<Port>>();
-            }
-            if (component["lighthouse"].IsDefined())
-            {
-                deserialized_component->lighthouse = component["lighthouse"].as<std::weak_ptr<Lighthouse>>();
-            }
-            if (component["customer_manager"].IsDefined())
-            {
-                deserialized_component->customer_manager = component["customer_manager"].as<std::weak_ptr<CustomerManager>>();
-            }
-            if (component["playfield_width"].IsDefined())
-            {
-                deserialized_component->playfield_width = component["playfield_width"].as<float>();
-            }
-            if (component["playfield_additional_width"].IsDefined())
-            {
-                deserialized_component->playfield_additional_width = component["playfield_additional_width"].as<float>();
-            }
-            if (component["playfield_height"].IsDefined())
-            {
-                deserialized_component->playfield_height = component["playfield_height"].as<float>();
-            }
-            if (component["playfield_y_shift"].IsDefined())
-            {
-                deserialized_component->playfield_y_shift = component["playfield_y_shift"].as<float>();
-            }
-            if (component["ships_limit_curve"].IsDefined())
-            {
-                deserialized_component->ships_limit_curve = component["ships_limit_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["ships_limit"].IsDefined())
-            {
-                deserialized_component->ships_limit = component["ships_limit"].as<u32>();
-            }
-            if (component["ships_speed_curve"].IsDefined())
-            {
-                deserialized_component->ships_speed_curve = component["ships_speed_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["ships_speed"].IsDefined())
-            {
-                deserialized_component->ships_speed = component["ships_speed"].as<float>();
-            }
-            if (component["ships_range_curve"].IsDefined())
-            {
-                deserialized_component->ships_range_curve = component["ships_range_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["ships_turn_curve"].IsDefined())
-            {
-                deserialized_component->ships_turn_curve = component["ships_turn_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["ships_additional_speed_curve"].IsDefined())
-            {
-                deserialized_component->ships_additional_speed_curve = component["ships_additional_speed_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["pirates_in_control_curve"].IsDefined())
-            {
-                deserialized_component->pirates_in_control_curve = component["pirates_in_control_curve"].as<std::weak_ptr<Curve>>();
-            }
-            if (component["is_tutorial"].IsDefined())
-            {
-                deserialized_component->is_tutorial = component["is_tutorial"].as<bool>();
-            }
-            if (component["starting_packages"].IsDefined())
-            {
-                deserialized_component->starting_packages = component["starting_packages"].as<u32>();
-            }
-            if (component["tutorial_level"].IsDefined())
-            {
-                deserialized_component->tutorial_level = component["tutorial_level"].as<u32>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
+        YAML::Emitter out(scene_file);
+        out << YAML::BeginMap;
+        out << YAML::Key << "Scene" << YAML::Value << "Untitled";
+        out << YAML::Key << "Entities";
+        out << YAML::Value << YAML::BeginSeq;
+
+        serialize_entity_recursively(out, entity);
+
+        out << YAML::EndSeq;
+        out << YAML::EndMap;
+    }
+
+    scene_file.close();
+
+    Engine::asset_preloader->invalidate(file_path);
+    m_prefab_templates.erase(VirtualFileSystem::normalize_path(file_path));
+    m_pending_prefab_templates.erase(VirtualFileSystem::normalize_path(file_path));
+
+    // Runtime builds load the cooked copy. Read back from the file, since that's what it gets checked against.
+    if (VirtualFileSystem::normalize_path(file_path).starts_with("res/"))
+        cook_binary(file_path);
+}
+
+// Deserialize entity (might include its children) from a file.
+// Replaces all guids that are not present in the scene with newly generated ones.
+std::shared_ptr<Entity> SceneSerializer::deserialize_this_entity(std::string const& file_path)
+{
+    if (m_reads_binary)
+    {
+        DeserializationMode const previous_mode = m_deserialization_mode;
+        m_deserialization_mode = DeserializationMode::InjectFromFile;
+        ScopeGuard restore_mode = [&] { m_deserialization_mode = previous_mode; };
+
+        if (std::shared_ptr<Entity> first_entity = {}; deserialize_binary(file_path, first_entity))
+            return first_entity;
     }
-    else if (component_name == "LighthouseComponent")
+
+    YAML::Node data = {};
+
+    if (!load_yaml(file_path, data))
+        return {};
+
+    replace_included_guids(data);
+
+    if (!data["Scene"])
+        return {};
+
+    DeserializationMode const previous_mode = m_deserialization_mode;
+    m_deserialization_mode = DeserializationMode::InjectFromFile;
+
+    auto const scene_name = data["Scene"].as<std::string>();
+
+    std::shared_ptr<Entity> first_entity = {};
+
+    if (auto const entities = data["Entities"])
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = Lighthouse::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
+        std::vector<std::pair<std::shared_ptr<Entity>, YAML::Node>> deserialized_entities = {};
+        deserialized_entities.reserve(entities.size());
+
+        // First pass. Create all entities and components.
+        for (auto const entity : entities)
         {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class Lighthouse>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["light"].IsDefined())
-            {
-                deserialized_component->light = component["light"].as<std::weak_ptr<LighthouseLight>>();
-            }
-            if (component["water"].IsDefined())
+            auto const deserialized_entity = deserialize_entity_first_pass(entity);
+            if (deserialized_entity == nullptr)
             {
-                deserialized_component->water = component["water"].as<std::weak_ptr<Water>>();
+                m_deserialization_mode = previous_mode;
+                return {};
             }
-            if (component["spawn_position"].IsDefined())
+
+            if (first_entity == nullptr)
             {
-                deserialized_component->spawn_position = component["spawn_position"].as<std::weak_ptr<Entity>>();
+                first_entity = deserialized_entity;
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
-        }
-    }
-    else if (component_name == "LighthouseKeeperComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = LighthouseKeeper::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
+
+            deserialized_entities_pool.emplace_back(deserialized_entity);
+            deserialized_entities.emplace_back(deserialized_entity, entity);
         }
-        else
+
+        // Second pass. Assign components' values including references to other components.
+        // Assign appropriate parent for each entity.
+        for (auto const& [entity, node] : deserialized_entities)
         {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class LighthouseKeeper>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["maximum_speed"].IsDefined())
-            {
-                deserialized_component->maximum_speed = component["maximum_speed"].as<float>();
-            }
-            if (component["acceleration"].IsDefined())
-            {
-                deserialized_component->acceleration = component["acceleration"].as<float>();
-            }
-            if (component["deceleration"].IsDefined())
-            {
-                deserialized_component->deceleration = component["deceleration"].as<float>();
-            }
-            if (component["lighthouse"].IsDefined())
-            {
-                deserialized_component->lighthouse = component["lighthouse"].as<std::weak_ptr<Lighthouse>>();
-            }
-            if (component["port"].IsDefined())
-            {
-                deserialized_component->port = component["port"].as<std::weak_ptr<Port>>();
-            }
-            if (component["keeper_dust"].IsDefined())
-            {
-                deserialized_component->keeper_dust = component["keeper_dust"].as<std::weak_ptr<ParticleSystem>>();
-            }
-            if (component["keeper_splash"].IsDefined())
-            {
-                deserialized_component->keeper_splash = component["keeper_splash"].as<std::weak_ptr<ParticleSystem>>();
-            }
-            if (component["packages"].IsDefined())
+            deserialize_entity_second_pass(node, entity);
+
+            if (entity->m_parent_guid.empty())
+                continue;
+
+            for (auto const& [other_entity, other_node] : deserialized_entities)
             {
-                deserialized_component->packages = component["packages"].as<std::vector<std::weak_ptr<Entity>>>();
+                if (entity->m_parent_guid == other_entity->guid)
+                {
+                    entity->transform->set_parent(other_entity->transform);
+                    break;
+                }
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
         }
-    }
-    else if (component_name == "LighthouseLightComponent")
-    {
-        if (first_pass)
-        {
-            auto const deserialized_component = LighthouseLight::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
+
+        if (MainScene::get_instance()->is_running)
         {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class LighthouseLight>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["spotlight"].IsDefined())
-            {
-                deserialized_component->spotlight = component["spotlight"].as<std::weak_ptr<SpotLight>>();
-            }
-            if (component["spotlight_beam_width"].IsDefined())
+            for (auto const& component : deserialized_pool)
             {
-                deserialized_component->spotlight_beam_width = component["spotlight_beam_width"].as<float>();
+                component->awake();
+                component->has_been_awaken = true;
+
+                if (component->enabled())
+                {
+                    component->on_enabled();
+                }
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
         }
     }
-    else if (component_name == "PlayerComponent")
+
+    m_deserialization_mode = previous_mode;
+
+    return first_entity;
+}
+
+void SceneSerializer::serialize(std::string const& file_path) const
+{
+    save_snapshot(take_snapshot(file_path));
+    drop_saved_templates();
+}
+
+SceneSnapshot SceneSerializer::take_snapshot(std::string const& file_path) const
+{
+    std::string const key = VirtualFileSystem::normalize_path(file_path);
+
+    SceneSnapshot snapshot = {};
+    snapshot.file_path = file_path;
+
+    // Rebuilt every time, so blocks of removed entities don't stay around.
+    std::unordered_map<std::string, std::shared_ptr<std::string const>> entity_blocks = {};
+
+    for (auto const& entity : m_scene->entities)
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = Player::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
+        if (!entity->is_serialized)
         {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Player>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["packages_text"].IsDefined())
-            {
-                deserialized_component->packages_text = component["packages_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            if (component["flashes_text"].IsDefined())
-            {
-                deserialized_component->flashes_text = component["flashes_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            if (component["level_text"].IsDefined())
-            {
-                deserialized_component->level_text = component["level_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            if (component["clock_text"].IsDefined())
-            {
-                deserialized_component->clock_text = component["clock_text"].as<std::weak_ptr<ScreenText>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            continue;
         }
-    }
-    else if (component_name == "PopupComponent")
-    {
-        if (first_pass)
+
+        std::shared_ptr<std::string const> block = nullptr;
+
+        if (!m_dirty_entities.contains(entity->guid))
         {
-            auto const deserialized_component = Popup::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
+            if (auto const it = m_entity_blocks.find(entity->guid); it != m_entity_blocks.end())
+                block = it->second;
         }
-        else
+
+        if (block == nullptr)
         {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Popup>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            auto const text = std::make_shared<std::string>();
+            append_entity_block(*text, entity);
+            block = text;
+            ++snapshot.emitted_count;
         }
+
+        entity_blocks.emplace(entity->guid, block);
+        snapshot.entity_blocks.emplace_back(std::move(block));
     }
-    else if (component_name == "EndScreenComponent")
+
+    if (snapshot.emitted_count > 0 || entity_blocks.size() != m_entity_blocks.size())
+        ++m_blocks_version;
+
+    m_entity_blocks = std::move(entity_blocks);
+    m_dirty_entities.clear();
+    m_has_missing_entity_blocks = false;
+
+    auto const [it, inserted] = m_saved_versions.try_emplace(key, m_blocks_version);
+    snapshot.has_changes = inserted || it->second != m_blocks_version;
+    it->second = m_blocks_version;
+
+    return snapshot;
+}
+
+bool SceneSerializer::save_snapshot(SceneSnapshot const& snapshot)
+{
+    // A crash or a full disk in the middle of writing leaves the old file intact.
+    std::string const temporary_path = snapshot.file_path + ".tmp";
+
     {
-        if (first_pass)
+        std::ofstream scene_file(temporary_path, std::ios::trunc);
+
+        if (!scene_file.is_open())
         {
-            auto const deserialized_component = EndScreen::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
+            std::cout << "Could not create a scene file: " << temporary_path << "\n";
+            return false;
         }
-        else
+
+        scene_file << "Scene: Untitled\nEntities:" << (snapshot.entity_blocks.empty() ? " []\n" : "\n");
+
+        for (auto const& block : snapshot.entity_blocks)
         {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class EndScreen>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["is_failed"].IsDefined())
-            {
-                deserialized_component->is_failed = component["is_failed"].as<bool>();
-            }
-            if (component["number_of_stars"].IsDefined())
-            {
-                deserialized_component->number_of_stars = component["number_of_stars"].as<u32>();
-            }
-            if (component["stars"].IsDefined())
-            {
-                deserialized_component->stars = component["stars"].as<std::vector<std::weak_ptr<Entity>>>();
-            }
-            if (component["star_scale"].IsDefined())
-            {
-                deserialized_component->star_scale = component["star_scale"].as<glm::vec2>();
-            }
-            if (component["next_level_button"].IsDefined())
-            {
-                deserialized_component->next_level_button = component["next_level_button"].as<std::weak_ptr<Button>>();
-            }
-            if (component["restart_button"].IsDefined())
-            {
-                deserialized_component->restart_button = component["restart_button"].as<std::weak_ptr<Button>>();
-            }
-            if (component["menu_button"].IsDefined())
-            {
-                deserialized_component->menu_button = component["menu_button"].as<std::weak_ptr<Button>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            scene_file.write(block->data(), static_cast<std::streamsize>(block->size()));
+        }
+
+        if (!scene_file.good())
+        {
+            std::cout << "Error. Could not write a scene file: " << temporary_path << "\n";
+            return false;
         }
     }
-    else if (component_name == "PortComponent")
+
+    std::error_code error = {};
+    std::filesystem::rename(temporary_path, snapshot.file_path, error);
+
+    if (error)
+    {
+        std::cout << "Error. Could not replace a scene file: " << snapshot.file_path << "\n" << error.message() << "\n";
+        std::filesystem::remove(temporary_path, error);
+        return false;
+    }
+
+    Engine::asset_preloader->invalidate(snapshot.file_path);
+
+    // Runtime builds load the cooked copy. Read back from the file, since that's what it gets checked against.
+    if (VirtualFileSystem::normalize_path(snapshot.file_path).starts_with("res/"))
+        cook_binary(snapshot.file_path);
+
+    {
+        std::lock_guard lock(m_saved_files_mutex);
+        m_saved_files.emplace_back(VirtualFileSystem::normalize_path(snapshot.file_path));
+    }
+
+    return true;
+}
+
+void SceneSerializer::drop_saved_templates()
+{
+    std::vector<std::string> saved_files = {};
+
+    {
+        std::lock_guard lock(m_saved_files_mutex);
+        saved_files.swap(m_saved_files);
+    }
+
+    // Only once the file is replaced, a template built before that would hold the old contents.
+    for (auto const& key : saved_files)
+    {
+        m_prefab_templates.erase(key);
+        m_pending_prefab_templates.erase(key);
+    }
+}
+
+void SceneSerializer::mark_dirty(std::shared_ptr<Entity> const& entity)
+{
+    m_dirty_entities.emplace(entity->guid);
+}
+
+void SceneSerializer::mark_destroyed(std::shared_ptr<Entity> const& entity)
+{
+    std::vector<std::string> guids = {};
+    std::vector<std::shared_ptr<Entity>> entities = {entity};
+
+    // Children are destroyed with it.
+    while (!entities.empty())
+    {
+        auto const destroyed_entity = entities.back();
+        entities.pop_back();
+
+        guids.emplace_back(destroyed_entity->guid);
+
+        for (auto const& component : destroyed_entity->components)
+            guids.emplace_back(component->guid);
+
+        for (auto const& child : destroyed_entity->transform->children)
+            entities.emplace_back(child->entity.lock());
+    }
+
+    for (auto const& guid : guids)
+    {
+        m_entity_blocks.erase(guid);
+        m_dirty_entities.erase(guid);
+    }
+
+    // References are written as guids, so any block mentioning one of them has to change.
+    for (auto const& [guid, block] : m_entity_blocks)
+    {
+        if (std::ranges::any_of(guids, [&](std::string const& destroyed_guid) { return block->contains(destroyed_guid); }))
+            m_dirty_entities.emplace(guid);
+    }
+
+    ++m_blocks_version;
+}
+
+void SceneSerializer::mark_all_dirty()
+{
+    m_entity_blocks.clear();
+    m_dirty_entities.clear();
+    m_has_missing_entity_blocks = true;
+    ++m_blocks_version;
+}
+
+void SceneSerializer::refresh_entity_blocks(u32 const max_entities) const
+{
+    if (!m_has_missing_entity_blocks)
+        return;
+
+    u32 emitted_count = 0;
+
+    for (auto const& entity : m_scene->entities)
     {
-        if (first_pass)
+        if (!entity->is_serialized || m_entity_blocks.contains(entity->guid))
         {
-            auto const deserialized_component = Port::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
+            continue;
         }
-        else
+
+        if (emitted_count == max_entities)
         {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Port>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["lights"].IsDefined())
-            {
-                deserialized_component->lights = component["lights"].as<std::vector<std::weak_ptr<Entity>>>();
-            }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            ++m_blocks_version;
+            return;
         }
+
+        auto const text = std::make_shared<std::string>();
+        append_entity_block(*text, entity);
+        m_entity_blocks.emplace(entity->guid, text);
+        ++emitted_count;
     }
-    else if (component_name == "ShipComponent")
+
+    if (emitted_count > 0)
+        ++m_blocks_version;
+
+    m_has_missing_entity_blocks = false;
+}
+
+bool SceneSerializer::has_missing_entity_blocks()
+{
+    return m_has_missing_entity_blocks;
+}
+
+bool SceneSerializer::deserialize(std::string const& file_path)
+{
+    // Entities loaded from another file can share guids with the ones saved before.
+    mark_all_dirty();
+
+    if (std::shared_ptr<Entity> first_entity = {}; m_reads_binary && deserialize_binary(file_path, first_entity))
+        return true;
+
+    YAML::Node data = {};
+
+    if (!load_yaml(file_path, data))
+        return false;
+
+    if (!data["Scene"])
+        return false;
+
+    auto const scene_name = data["Scene"].as<std::string>();
+    std::cout << "Deserializing scene " << scene_name << "\n";
+
+    if (auto const entities = data["Entities"])
     {
-        if (first_pass)
+        std::vector<std::pair<std::shared_ptr<Entity>, YAML::Node>> deserialized_entities = {};
+        deserialized_entities.reserve(entities.size());
+
+        // First pass. Create all entities and components.
+        for (auto const entity : entities)
         {
-            auto const deserialized_component = Ship::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
+            auto const deserialized_entity = deserialize_entity_first_pass(entity);
+            if (deserialized_entity == nullptr)
+                return false;
+
+            deserialized_entities_pool.emplace_back(deserialized_entity);
+            deserialized_entities.emplace_back(deserialized_entity, entity);
         }
-        else
+
+        // Second pass. Assign components' values including references to other components.
+        // Assign appropriate parent for each entity.
+        for (auto const& [entity, node] : deserialized_entities)
         {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Ship>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["type"].IsDefined())
-            {
-                deserialized_component->type = component["type"].as<ShipType>();
-            }
-            if (component["light"].IsDefined())
-            {
-                deserialized_component->light = component["light"].as<std::weak_ptr<LighthouseLight>>();
-            }
-            if (component["spawner"].IsDefined())
-            {
-                deserialized_component->spawner = component["spawner"].as<std::weak_ptr<ShipSpawner>>();
-            }
-            if (component["eyes"].IsDefined())
+            deserialize_entity_second_pass(node, entity);
+
+            if (entity->m_parent_guid.empty())
+                continue;
+
+            for (auto const& [other_entity, other_node] : deserialized_entities)
             {
-                deserialized_component->eyes = component["eyes"].as<std::weak_ptr<ShipEyes>>();
+                if (entity->m_parent_guid == other_entity->guid)
+                {
+                    entity->transform->set_parent(other_entity->transform);
+                    break;
+                }
             }
-            if (component["my_light"].IsDefined())
+        }
+
+        if (MainScene::get_instance()->is_running)
+        {
+            for (auto const& component : deserialized_pool)
             {
-                deserialized_component->my_light = component["my_light"].as<std::weak_ptr<PointLight>>();
+                component->awake();
+                component->has_been_awaken = true;
+
+                if (component->enabled())
+                {
+                    component->on_enabled();
+                }
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
         }
     }
-    else if (component_name == "ShipEyesComponent")
+
+    return true;
+}
+
+bool SceneSerializer::load_yaml(std::string const& file_path, YAML::Node& data)
+{
+    // Deserialization can add nodes to the tree it reads, so the shared preloaded tree is copied.
+    if (auto const preloaded = Engine::asset_preloader->get_yaml_asset(file_path); preloaded.has_value())
+    {
+        data = YAML::Clone(preloaded.value());
+        return true;
+    }
+
+    std::optional<std::string> scene_data = Engine::asset_preloader->get_text_asset(file_path);
+
+    if (!scene_data.has_value())
     {
-        if (first_pass)
+        Debug::log("Preloading failed " + file_path);
+        FileView const scene_file = VirtualFileSystem::read(file_path);
+
+        if (!scene_file.is_valid())
         {
-            auto const deserialized_component = ShipEyes::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
+            Debug::log("Could not open a scene file: " + file_path + "\n", DebugType::Error);
+            return false;
         }
-        else
+
+        scene_data = std::string(scene_file.get_text());
+    }
+
+    data = YAML::Load(scene_data.value());
+    return true;
+}
+
+void SceneSerializer::replace_included_guids(YAML::Node const& data)
+{
+    std::unordered_set<std::string> included_guids = {};
+
+    for (auto const& entity : data["Entities"])
+    {
+        included_guids.emplace(entity["guid"].as<std::string>(""));
+
+        for (auto const& component : entity["Components"])
         {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class ShipEyes>(get_from_pool(component["guid"].as<std::string>()));
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+            included_guids.emplace(component["guid"].as<std::string>(""));
         }
     }
-    else if (component_name == "ShipSpawnerComponent")
-    {
-        if (first_pass)
+
+    // Every other node named guid is a reference, e.g. a transform's parent.
+    std::function<void(YAML::Node)> replace = [&](YAML::Node node) {
+        if (node.IsSequence())
         {
-            auto const deserialized_component = ShipSpawner::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
+            for (auto child : node)
+                replace(child);
+
+            return;
         }
-        else
+
+        if (!node.IsMap())
+            return;
+
+        for (auto pair : node)
         {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class ShipSpawner>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["paths"].IsDefined())
-            {
-                deserialized_component->paths = component["paths"].as<std::vector<std::weak_ptr<Path>>>();
-            }
-            if (component["floaters_manager"].IsDefined())
-            {
-                deserialized_component->floaters_manager = component["floaters_manager"].as<std::weak_ptr<FloatersManager>>();
-            }
-            if (component["light"].IsDefined())
-            {
-                deserialized_component->light = component["light"].as<std::weak_ptr<LighthouseLight>>();
-            }
-            if (component["last_chance_food_threshold"].IsDefined())
-            {
-                deserialized_component->last_chance_food_threshold = component["last_chance_food_threshold"].as<u32>();
-            }
-            if (component["last_chance_time_threshold"].IsDefined())
+            if (pair.first.Scalar() != "guid" || !pair.second.IsScalar())
             {
-                deserialized_component->last_chance_time_threshold = component["last_chance_time_threshold"].as<float>();
+                replace(pair.second);
+                continue;
             }
-            if (component["main_event_spawn"].IsDefined())
+
+            std::string const guid = pair.second.Scalar();
+
+            if (guid.empty())
+                continue;
+
+            if (auto const it = m_replaced_guids_map.find(guid); it != m_replaced_guids_map.end())
             {
-                deserialized_component->main_event_spawn = component["main_event_spawn"].as<std::vector<SpawnEvent>>();
+                pair.second = it->second;
             }
-            if (component["backup_spawn"].IsDefined())
+            else if (included_guids.contains(guid))
             {
-                deserialized_component->backup_spawn = component["backup_spawn"].as<std::vector<SpawnEvent>>();
+                std::string const new_guid = AK::generate_guid();
+                m_replaced_guids_map.emplace(guid, new_guid);
+                pair.second = new_guid;
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
         }
-    }
-    else if (component_name == "ThanksComponent")
+    };
+
+    replace(data);
+}
+
+bool SceneSerializer::deserialize_binary(std::string const& file_path, std::shared_ptr<Entity>& first_entity)
+{
+    auto const file = BinarySceneFile::load(BinaryScene::get_binary_path(file_path), file_path, binary_scene_layout_hash);
+
+    if (file == nullptr)
+        return false;
+
+    first_entity = instantiate_binary(file);
+    return true;
+}
+
+std::shared_ptr<Entity> SceneSerializer::instantiate_binary(std::shared_ptr<BinarySceneFile const> const& file)
+{
+    BinarySceneReader in(file);
+    u32 const entity_count = static_cast<u32>(file->get_entity_records().size());
+
+    // First pass. Create all entities and components.
+    create_binary_entities(in, 0, entity_count);
+
+    // Second pass. Assign components' values including references to other components.
+    // Assign appropriate parent for each entity.
+    prepare_binary_entities(in, 0, entity_count);
+
+    if (!in.is_valid())
+        Debug::log("Cooked scene is broken, some fields were not read: " + std::string(file->get_scene_name()), DebugType::Error);
+
+    if (MainScene::get_instance()->is_running)
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = Thanks::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
+        for (auto const& component : deserialized_pool)
         {
-            auto const deserialized_component = std::dynamic_pointer_cast<class Thanks>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["back_to_menu_button"].IsDefined())
+            component->awake();
+            component->has_been_awaken = true;
+
+            if (component->enabled())
             {
-                deserialized_component->back_to_menu_button = component["back_to_menu_button"].as<std::weak_ptr<Button>>();
+                component->on_enabled();
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
         }
     }
-    else if (component_name == "PlayerInputComponent")
+
+    return in.entities.empty() ? nullptr : in.entities.front();
+}
+
+void SceneSerializer::create_binary_entities(BinarySceneReader& in, u32 const first, u32 const last)
+{
+    auto const& file = in.get_file();
+
+    // References within the file are indices, so injected entities and components can get new guids right away.
+    bool const replaces_guids = m_deserialization_mode == DeserializationMode::InjectFromFile;
+
+    auto const& entity_records = file.get_entity_records();
+    auto const& component_records = file.get_component_records();
+
+    if (first == 0)
+    {
+        in.entities.reserve(entity_records.size());
+        in.components.reserve(component_records.size());
+    }
+
+    for (u32 i = first; i < last; ++i)
     {
-        if (first_pass)
-        {
-            auto const deserialized_component = PlayerInput::create();
-            deserialized_component->guid = component["guid"].as<std::string>();
-            deserialized_component->custom_name = component["custom_name"].as<std::string>();
-            deserialized_pool.emplace_back(deserialized_component);
-        }
-        else
+        auto const& entity_record = entity_records[i];
+        std::string const guid = replaces_guids ? AK::generate_guid() : std::string(file.get_string(entity_record.guid));
+        auto const deserialized_entity = Entity::create(guid, std::string(file.get_string(entity_record.name)));
+        deserialized_entity->m_is_being_deserialized = true;
+
+        deserialized_entity->transform->set_local_position(entity_record.translation);
+        deserialized_entity->transform->set_euler_angles(entity_record.rotation);
+        deserialized_entity->transform->set_local_scale(entity_record.scale);
+
+        in.entities.emplace_back(deserialized_entity);
+        deserialized_entities_pool.emplace_back(deserialized_entity);
+
+        for (u32 j = entity_record.first_component; j < entity_record.first_component + entity_record.component_count; ++j)
         {
-            auto const deserialized_component =
-                std::dynamic_pointer_cast<class PlayerInput>(get_from_pool(component["guid"].as<std::string>()));
-            if (component["player_speed"].IsDefined())
-            {
-                deserialized_component->player_speed = component["player_speed"].as<float>();
-            }
-            if (component["camera_speed"].IsDefined())
+            auto const& component_record = component_records[j];
+            auto const deserialized_component = ComponentRegistry::create(component_record.type);
+
+            // Kept as an empty slot, references are indices.
+            if (deserialized_component == nullptr)
             {
-                deserialized_component->camera_speed = component["camera_speed"].as<float>();
+                std::cout << "Error. Deserialization of component " << component_record.type << " failed."
+                          << "\n";
+                in.components.emplace_back(nullptr);
+                continue;
             }
-            deserialized_entity->add_component(deserialized_component);
-            deserialized_component->reprepare();
+
+            deserialized_component->guid = replaces_guids ? AK::generate_guid() : std::string(file.get_string(component_record.guid));
+            deserialized_component->custom_name = file.get_string(component_record.custom_name);
+
+            in.components.emplace_back(deserialized_component);
+            deserialized_pool.emplace_back(deserialized_component);
         }
     }
-    else
-    {
-        std::cout << "Error. Deserialization of component " << component_name << " failed."
-                  << "\n";
-    }
-    // # Put new deserialization here
 }
 
-void SceneSerializer::deserialize_components(YAML::Node const& entity_node, std::shared_ptr<Entity> const& deserialized_entity,
-                                             bool const first_pass)
+void SceneSerializer::prepare_binary_entities(BinarySceneReader& in, u32 const first, u32 const last)
 {
-    auto const components = entity_node["Components"];
+    auto const& file = in.get_file();
+    auto const& entity_records = file.get_entity_records();
+    auto const& component_records = file.get_component_records();
 
-    for (auto it = components.begin(); it != components.end(); ++it)
+    for (u32 i = first; i < last; ++i)
     {
-        YAML::Node const& component = *it;
-        auto component_name = component["ComponentName"].as<std::string>();
-        if (false)
+        auto const& entity_record = entity_records[i];
+        auto const& deserialized_entity = in.entities[i];
+
+        for (u32 j = entity_record.first_component; j < entity_record.first_component + entity_record.component_count; ++j)
         {
-            // Custom deserialization here
+            auto const& deserialized_component = in.components[j];
+
+            if (deserialized_component == nullptr)
+                continue;
+
+            in.begin_fields(j);
+            auto_deserialize_component_binary(in, component_records[j].type, deserialized_component);
+
+            deserialized_entity->add_component(deserialized_component);
+            deserialized_component->reprepare();
         }
-        else
+
+        deserialized_entity->m_is_being_deserialized = false;
+
+        if (entity_record.parent == BinaryScene::null_reference)
+            continue;
+
+        // Like with YAML, a parent outside of the file is remembered but not set.
+        if ((entity_record.parent & BinaryScene::external_reference) != 0)
         {
-            auto_deserialize_component(component, deserialized_entity, first_pass);
+            deserialized_entity->m_parent_guid = file.get_string(entity_record.parent & ~BinaryScene::external_reference);
+            continue;
         }
+
+        auto const& parent = in.entities[entity_record.parent];
+        deserialized_entity->m_parent_guid = parent->guid;
+        deserialized_entity->transform->set_parent(parent->transform);
     }
 }
 
-std::shared_ptr<Entity> SceneSerializer::deserialize_entity_first_pass(YAML::Node const& entity)
+PrefabLoad::PrefabLoad(AK::Badge<SceneSerializer>, std::shared_ptr<SceneSerializer> const& serializer,
+                       std::shared_ptr<BinarySceneFile const> const& file)
+    : m_serializer(serializer), m_reader(std::make_unique<BinarySceneReader>(file))
 {
-    auto const entity_node = entity["guid"];
-    if (!entity_node)
-    {
-        std::cout << "Deserialization of a scene failed. Broken entity. No guid present."
-                  << "\n";
-        return nullptr;
-    }
-    auto const guid = entity_node.as<std::string>();
+}
 
-    auto const name_node = entity["Name"];
-    if (!name_node)
-    {
-        std::cout << "Deserialization of a scene failed. Broken entity. No name present."
-                  << "\n";
-        return nullptr;
-    }
-    auto const name = name_node.as<std::string>();
+PrefabLoad::~PrefabLoad() = default;
 
-    std::shared_ptr<Entity> deserialized_entity = Entity::create(guid, name);
-    deserialized_entity->m_is_being_deserialized = true;
+bool PrefabLoad::step(u32 const max_entities, u32 const max_awakes)
+{
+    m_serializer->set_instance(m_serializer);
+    ScopeGuard unset_instance = [&] { m_serializer->set_instance(nullptr); };
 
-    auto const transform = entity["TransformComponent"];
-    if (!transform)
+    auto const& file = m_reader->get_file();
+    u32 const entity_count = static_cast<u32>(file.get_entity_records().size());
+    auto const scene = MainScene::get_instance();
+
+    switch (m_stage)
     {
-        std::cout << "Deserialization of a scene failed. Broken entity. No transform present."
-                  << "\n";
-        return nullptr;
+    case Stage::Creating:
+    {
+        u32 const last = std::min(m_next + std::max(max_entities, 1u), entity_count);
+        m_serializer->create_binary_entities(*m_reader, m_next, last);
+        m_next = last;
+
+        if (m_next == entity_count)
+        {
+            m_stage = Stage::Preparing;
+            m_next = 0;
+        }
+
+        break;
     }
+    case Stage::Preparing:
+    {
+        u32 const last = std::min(m_next + std::max(max_entities, 1u), entity_count);
+        m_serializer->prepare_binary_entities(*m_reader, m_next, last);
 
-    deserialized_entity->transform->set_local_position(transform["Translation"].as<glm::vec3>());
-    deserialized_entity->transform->set_euler_angles(transform["Rotation"].as<glm::vec3>());
-    deserialized_entity->transform->set_local_scale(transform["Scale"].as<glm::vec3>());
-    deserialized_entity->m_parent_guid = transform["Parent"]["guid"].as<std::string>();
+        // Scene::run_frame() would start them before they are awoken, they go back on the list once they are.
+        if (scene->is_running)
+        {
+            for (u32 i = m_next; i < last; ++i)
+            {
+                auto const& entity_record = file.get_entity_records()[i];
 
-    deserialize_components(entity, deserialized_entity, true);
+                for (u32 j = entity_record.first_component; j < entity_record.first_component + entity_record.component_count; ++j)
+                {
+                    if (m_reader->components[j] != nullptr)
+                        scene->remove_component_to_start(m_reader->components[j]);
+                }
+            }
+        }
 
-    return deserialized_entity;
-}
+        m_next = last;
 
-void SceneSerializer::deserialize_entity_second_pass(YAML::Node const& entity, std::shared_ptr<Entity> const& deserialized_entity)
-{
-    deserialize_components(entity, deserialized_entity, false);
+        if (m_next == entity_count)
+        {
+            if (!m_reader->is_valid())
+                Debug::log("Cooked scene is broken, some fields were not read: " + std::string(file.get_scene_name()), DebugType::Error);
 
-    deserialized_entity->m_is_being_deserialized = false;
-}
+            m_stage = scene->is_running ? Stage::Awaking : Stage::Done;
+            m_next = 0;
+        }
 
-// Serialize one entity (including its children) to a file.
-void SceneSerializer::serialize_this_entity(std::shared_ptr<Entity> const& entity, std::string const& file_path) const
-{
-    YAML::Emitter out;
-    out << YAML::BeginMap;
-    out << YAML::Key << "Scene" << YAML::Value << "Untitled";
-    out << YAML::Key << "Entities";
-    out << YAML::Value << YAML::BeginSeq;
+        break;
+    }
+    case Stage::Awaking:
+    {
+        auto const& components = m_serializer->deserialized_pool;
+        u32 const last = std::min(m_next + std::max(max_awakes, 1u), static_cast<u32>(components.size()));
 
-    serialize_entity_recursively(out, entity);
+        for (u32 i = m_next; i < last; ++i)
+        {
+            auto const& component = components[i];
+            component->awake();
+            component->has_been_awaken = true;
 
-    out << YAML::EndSeq;
-    out << YAML::EndMap;
+            if (component->enabled())
+            {
+                component->on_enabled();
+            }
+        }
 
-    std::filesystem::path const path = file_path;
+        m_next = last;
 
-    if (!path.has_parent_path())
-    {
-        Debug::log("Path to serialize an entity doesn't have a directory. Aborting.", DebugType::Error);
-        return;
+        if (m_next < components.size())
+            break;
+
+        // Like with a single frame load, nothing is started before every component is awoken.
+        for (auto const& component : components)
+            scene->add_component_to_start(component);
+
+        m_stage = Stage::Done;
+        break;
+    }
+    case Stage::Done:
+        break;
     }
 
-    if (!std::filesystem::exists(path.parent_path()))
+    return m_stage == Stage::Done;
+}
+
+void PrefabLoad::abandon()
+{
+    auto const scene = MainScene::get_instance();
+    std::vector<std::shared_ptr<Entity>> top_level_entities = {};
+
+    // Entities not parented yet have to be destroyed on their own. The scene might have destroyed some already when unloading.
+    for (auto const& entity : m_reader->entities)
     {
-        create_directory(path.parent_path());
+        if (entity->transform->parent.expired() && std::ranges::find(scene->entities, entity) != scene->entities.end())
+            top_level_entities.emplace_back(entity);
     }
 
-    std::ofstream scene_file(file_path);
-
-    if (!scene_file.is_open())
+    for (auto const& entity : top_level_entities)
     {
-        std::cout << "Could not serialize an entity to a file: " << file_path << "\n";
-        return;
+        entity->destroy_immediate();
     }
 
-    scene_file << out.c_str();
-    scene_file.close();
+    m_reader->entities.clear();
+    m_stage = Stage::Done;
 }
 
-// Deserialize entity (might include its children) from a file.
-// Replaces all guids that are not present in the scene with newly generated ones.
-std::shared_ptr<Entity> SceneSerializer::deserialize_this_entity(std::string const& file_path)
+PrefabLoad::Stage PrefabLoad::get_stage() const
 {
-    std::optional<std::string> scene_data = Engine::asset_preloader->get_text_asset(file_path);
+    return m_stage;
+}
+
+std::shared_ptr<Entity> PrefabLoad::get_root() const
+{
+    return m_reader->entities.empty() ? nullptr : m_reader->entities.front();
+}
 
-    std::stringstream stream;
+bool SceneSerializer::cook_binary(std::string const& file_path)
+{
+    FileView const file = VirtualFileSystem::read(file_path);
 
-    if (!scene_data.has_value())
+    if (!file.is_valid())
     {
-        Debug::log("Preloading failed " + file_path);
-        std::ifstream scene_file(file_path);
+        std::cout << "Error. Could not open a scene file to cook: " << file_path << "\n";
+        return false;
+    }
 
-        if (!scene_file.is_open())
-        {
-            Debug::log("Could not open a scene file: " + file_path + "\n", DebugType::Error);
-            return {};
-        }
+    std::vector<u8> binary = {};
+
+    if (!cook_binary(file_path, file.get_text(), binary))
+        return false;
 
-        stream << scene_file.rdbuf();
-        scene_file.close();
+    std::string const binary_path = BinaryScene::get_binary_path(file_path);
+    std::ofstream binary_file(binary_path, std::ios::binary | std::ios::trunc);
 
-        scene_data = stream.str();
-    }
-    else
+    if (!binary_file.is_open())
     {
-        Debug::log("Preloading succ " + file_path);
-        stream = std::stringstream(scene_data.value());
+        std::cout << "Error. Could not write a cooked scene file: " << binary_path << "\n";
+        return false;
     }
 
-    std::unordered_set<std::string> included_guids = {};
-    std::string line = {};
-    bool next_line_new_guid = false;
-    while (std::getline(stream, line))
+    binary_file.write(reinterpret_cast<char const*>(binary.data()), static_cast<std::streamsize>(binary.size()));
+
+    return binary_file.good();
+}
+
+bool SceneSerializer::cook_binary(std::string const& file_path, std::string_view const text, std::vector<u8>& binary)
+{
+    try
     {
-        size_t component_search = line.find("ComponentName:");
-        size_t entity_search = line.find("Entity:");
+        YAML::Node const data = YAML::Load(std::string(text));
 
-        if (component_search != std::string::npos || entity_search != std::string::npos)
+        if (!data["Scene"])
         {
-            next_line_new_guid = true;
-            continue;
+            std::cout << "Error. Not a scene file: " << file_path << "\n";
+            return false;
         }
 
-        if (next_line_new_guid)
+        BinarySceneWriter out(binary_scene_layout_hash);
+        std::vector<std::pair<u32, YAML::Node>> components = {};
+
+        for (auto const& entity : data["Entities"])
         {
-            size_t guid_search = line.find("guid:");
-            if (guid_search == std::string::npos)
+            auto const transform = entity["TransformComponent"];
+            u32 const entity_index = out.add_entity(entity["guid"].as<std::string>(), entity["Name"].as<std::string>(),
+                                                    transform["Translation"].as<glm::vec3>(), transform["Rotation"].as<glm::vec3>(),
+                                                    transform["Scale"].as<glm::vec3>());
+
+            for (auto const& component : entity["Components"])
             {
-                Debug::log("Copied entity might be corrupted, missing guid after component or entity?", DebugType::Error);
-                next_line_new_guid = false;
-                continue;
+                auto const component_name = component["ComponentName"].as<std::string>();
+                u32 const type = ComponentRegistry::get_id(component_name);
+
+                if (type == ComponentRegistry::invalid_id)
+                {
+                    std::cout << "Error. Cooking of component " << component_name << " failed."
+                              << "\n";
+                    return false;
+                }
+
+                out.add_component(entity_index, type, component["guid"].as<std::string>(), component["custom_name"].as<std::string>());
+                components.emplace_back(type, component);
             }
+        }
 
-            size_t first_guid_char_offset = guid_search + 6;
-            std::string guid = line.substr(first_guid_char_offset);
-            included_guids.emplace(guid);
+        // Fields can reference anything in the file, so they are transcoded once everything has an index.
+        u32 entity_index = 0;
+        for (auto const& entity : data["Entities"])
+        {
+            out.set_parent(entity_index, entity["TransformComponent"]["Parent"]["guid"].as<std::string>());
+            ++entity_index;
+        }
 
-            next_line_new_guid = false;
+        for (u32 i = 0; i < components.size(); ++i)
+        {
+            out.begin_fields(i);
+            auto_transcode_component(components[i].second, components[i].first, out);
         }
+
+        binary = out.finish(data["Scene"].as<std::string>(), text);
+    }
+    catch (YAML::Exception const& exception)
+    {
+        std::cout << "Error. Could not cook a scene file: " << file_path << "\n" << exception.what() << "\n";
+        return false;
     }
 
-    stream.clear();
-    stream.seekg(0);
+    return true;
+}
 
-    std::stringstream output = {};
-    while (std::getline(stream, line))
-    {
-        size_t guid_search = line.find("guid:");
+bool SceneSerializer::cook_directory(std::string const& directory)
+{
+    u32 cooked_count = 0;
+    u32 failed_count = 0;
 
-        if (guid_search == std::string::npos)
-        {
-            output << line << "\n";
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(directory))
+    {
+        if (!entry.is_regular_file() || entry.path().extension() != ".txt")
             continue;
-        }
 
-        // Replace guid
-        size_t first_guid_char_offset = guid_search + 6;
-        std::string guid = line.substr(first_guid_char_offset);
+        if (cook_binary(entry.path().generic_string()))
+            ++cooked_count;
+        else
+            ++failed_count;
+    }
 
-        if (guid == "\"\"")
-        {
-            output << line << "\n";
+    std::cout << std::format("Cooked {} scene files in {}, {} failed.\n", cooked_count, directory, failed_count);
+
+    return failed_count == 0;
+}
+
+void SceneSerializer::benchmark_formats(std::vector<std::string> const& prefab_names, u32 const iterations)
+{
+    // Loads a prefab from one of the formats and destroys it again, returns how long loading took in milliseconds.
+    auto const load = [](std::string const& file_path, bool const reads_binary) {
+        auto const scene_serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
+        scene_serializer->set_instance(scene_serializer);
+        ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
+        scene_serializer->m_reads_binary = reads_binary;
+
+        auto const start = std::chrono::steady_clock::now();
+        std::shared_ptr<Entity> const entity = scene_serializer->deserialize_this_entity(file_path);
+        double const elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (entity != nullptr)
+            entity->destroy_immediate();
+
+        return elapsed_ms;
+    };
+
+    auto const instantiate = [](std::string const& prefab_name) {
+        auto const start = std::chrono::steady_clock::now();
+        std::shared_ptr<Entity> const entity = load_prefab(prefab_name);
+        double const elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+        if (entity != nullptr)
+            entity->destroy_immediate();
+
+        return elapsed_ms;
+    };
+
+    u32 const iteration_count = std::max(iterations, 1u);
+    double total_yaml_ms = 0.0;
+    double total_binary_ms = 0.0;
+    double total_template_ms = 0.0;
+    std::vector<std::string> file_paths = {};
+
+    for (auto const& prefab_name : prefab_names)
+    {
+        std::string const file_path = m_prefab_path + prefab_name + ".txt";
+
+        // Otherwise an outdated copy would be ignored and the YAML measured twice.
+        if (!cook_binary(file_path))
             continue;
-        }
 
-        if (m_replaced_guids_map.contains(guid))
-        {
-            line.replace(first_guid_char_offset, guid.size(), m_replaced_guids_map.at(guid));
-        }
-        else if (included_guids.contains(guid))
+        file_paths.emplace_back(file_path);
+
+        // Only the text stays preloaded, a parsed tree would leave parsing the YAML out of the measurement.
+        Engine::asset_preloader->invalidate(file_path);
+        Engine::asset_preloader->preload_text_assets({file_path}, false);
+
+        // Models, textures and shaders are loaded by the first instance, after that only deserialization is measured.
+        load(file_path, false);
+        load(file_path, true);
+        instantiate(prefab_name);
+
+        double yaml_ms = 0.0;
+        double binary_ms = 0.0;
+        double template_ms = 0.0;
+
+        for (u32 i = 0; i < iteration_count; ++i)
         {
-            std::string new_guid = AK::generate_guid();
-            m_replaced_guids_map.emplace(guid, new_guid);
-            line.replace(first_guid_char_offset, guid.size(), new_guid);
+            yaml_ms += load(file_path, false);
+            binary_ms += load(file_path, true);
+            template_ms += instantiate(prefab_name);
         }
 
-        output << line << "\n";
+        yaml_ms /= iteration_count;
+        binary_ms /= iteration_count;
+        template_ms /= iteration_count;
+        total_yaml_ms += yaml_ms;
+        total_binary_ms += binary_ms;
+        total_template_ms += template_ms;
+
+        Debug::log(std::format("{}: YAML {} KB in {:.2f} ms, binary {} KB in {:.2f} ms, {:.1f}x faster, template {:.2f} ms", prefab_name,
+                               VirtualFileSystem::read(file_path).get_size() / 1024, yaml_ms,
+                               VirtualFileSystem::read(BinaryScene::get_binary_path(file_path)).get_size() / 1024, binary_ms,
+                               yaml_ms / binary_ms, template_ms));
     }
 
-    YAML::Node data = YAML::Load(output.str());
+    Debug::log(std::format("{} prefabs: YAML {:.2f} ms, binary {:.2f} ms, {:.1f}x faster, template {:.2f} ms", file_paths.size(),
+                           total_yaml_ms, total_binary_ms, total_yaml_ms / total_binary_ms, total_template_ms));
 
-    if (!data["Scene"])
-        return {};
+    // Parse them again for the game.
+    Engine::asset_preloader->preload_text_assets(file_paths, Engine::preparse_scene_files);
+}
 
-    DeserializationMode const previous_mode = m_deserialization_mode;
-    m_deserialization_mode = DeserializationMode::InjectFromFile;
+void SceneSerializer::save_prefab(std::shared_ptr<Entity> const& entity, std::string const& prefab_name)
+{
+    auto const scene_serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
+    scene_serializer->set_instance(scene_serializer);
+    ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
 
-    auto const scene_name = data["Scene"].as<std::string>();
+    scene_serializer->serialize_this_entity(entity, m_prefab_path + prefab_name + ".txt");
+}
 
-    std::shared_ptr<Entity> first_entity = {};
+std::shared_ptr<Entity> SceneSerializer::load_prefab(std::string const& prefab_name)
+{
+    std::string const file_path = m_prefab_path + prefab_name + ".txt";
 
-    if (auto const entities = data["Entities"])
-    {
-        std::vector<std::pair<std::shared_ptr<Entity>, YAML::Node>> deserialized_entities = {};
-        deserialized_entities.reserve(entities.size());
+    auto const scene_serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
+    scene_serializer->set_instance(scene_serializer);
+    ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
 
-        // First pass. Create all entities and components.
-        for (auto const entity : entities)
-        {
-            auto const deserialized_entity = deserialize_entity_first_pass(entity);
-            if (deserialized_entity == nullptr)
-            {
-                m_deserialization_mode = previous_mode;
-                return {};
-            }
+    auto const prefab_template = get_prefab_template(file_path);
 
-            if (first_entity == nullptr)
-            {
-                first_entity = deserialized_entity;
-            }
+    // Reports why the prefab couldn't be loaded.
+    if (prefab_template == nullptr)
+        return scene_serializer->deserialize_this_entity(file_path);
 
-            deserialized_entities_pool.emplace_back(deserialized_entity);
-            deserialized_entities.emplace_back(deserialized_entity, entity);
-        }
+    scene_serializer->m_deserialization_mode = DeserializationMode::InjectFromFile;
+    return scene_serializer->instantiate_binary(prefab_template);
+}
 
-        // Second pass. Assign components' values including references to other components.
-        // Assign appropriate parent for each entity.
-        for (auto const& [entity, node] : deserialized_entities)
-        {
-            deserialize_entity_second_pass(node, entity);
+void SceneSerializer::preload_prefab(std::string const& prefab_name)
+{
+    get_prefab_template(m_prefab_path + prefab_name + ".txt");
+}
 
-            if (entity->m_parent_guid.empty())
-                continue;
+struct SceneSerializer::PreloadedPrefab
+{
+    std::shared_ptr<BinarySceneFile const> prefab_template = nullptr;
+    std::vector<Model::TextureRequest> textures = {};
+};
 
-            for (auto const& [other_entity, other_node] : deserialized_entities)
-            {
-                if (entity->m_parent_guid == other_entity->guid)
-                {
-                    entity->transform->set_parent(other_entity->transform);
-                    break;
-                }
-            }
-        }
+void SceneSerializer::preload_prefab_async(std::string const& prefab_name)
+{
+    std::string const file_path = m_prefab_path + prefab_name + ".txt";
+    std::string const key = VirtualFileSystem::normalize_path(file_path);
 
-        if (MainScene::get_instance()->is_running)
+    if (m_prefab_templates.contains(key) || m_pending_prefab_templates.contains(key))
+        return;
+
+    if (m_thread_pool == nullptr)
+        m_thread_pool = std::make_unique<ThreadPool>(1);
+
+    auto const promise = std::make_shared<std::promise<std::shared_ptr<PreloadedPrefab const>>>();
+    m_pending_prefab_templates.emplace(key, promise->get_future().share());
+
+    m_thread_pool->submit([promise, file_path] {
+        auto const preloaded_prefab = std::make_shared<PreloadedPrefab>();
+        preloaded_prefab->prefab_template = build_prefab_template(file_path);
+
+        // Models are referenced by path, any string in the file naming one counts.
+        if (preloaded_prefab->prefab_template != nullptr)
         {
-            for (auto const& component : deserialized_pool)
+            for (auto const& string : preloaded_prefab->prefab_template->get_strings())
             {
-                component->awake();
-                component->has_been_awaken = true;
+                std::string const extension = std::filesystem::path(string).extension().string();
 
-                if (component->enabled())
-                {
-                    component->on_enabled();
-                }
+                if (extension == ".gltf" || extension == ".obj" || extension == ".fbx")
+                    std::ranges::move(Model::get_cooked_textures(std::string(string)), std::back_inserter(preloaded_prefab->textures));
             }
         }
-    }
-
-    m_deserialization_mode = previous_mode;
 
-    return first_entity;
+        promise->set_value(preloaded_prefab);
+    });
 }
 
-void SceneSerializer::serialize(std::string const& file_path) const
+void SceneSerializer::finish_preloaded_prefabs()
 {
-    YAML::Emitter out;
-    out << YAML::BeginMap;
-    out << YAML::Key << "Scene" << YAML::Value << "Untitled";
-    out << YAML::Key << "Entities";
-    out << YAML::Value << YAML::BeginSeq;
-
-    for (auto const& entity : m_scene->entities)
+    for (auto it = m_pending_prefab_templates.begin(); it != m_pending_prefab_templates.end();)
     {
-        if (!entity->is_serialized)
+        if (it->second.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
         {
+            ++it;
             continue;
         }
 
-        serialize_entity(out, entity);
+        add_preloaded_prefab(it->first, *it->second.get());
+        it = m_pending_prefab_templates.erase(it);
     }
+}
 
-    out << YAML::EndSeq;
-    out << YAML::EndMap;
+void SceneSerializer::add_preloaded_prefab(std::string const& key, PreloadedPrefab const& preloaded_prefab)
+{
+    Model::preload_textures(preloaded_prefab.textures);
 
-    std::ofstream scene_file(file_path);
+    if (preloaded_prefab.prefab_template != nullptr)
+        m_prefab_templates.emplace(key, preloaded_prefab.prefab_template);
+}
 
-    if (!scene_file.is_open())
+std::shared_ptr<PrefabLoad> SceneSerializer::begin_load_prefab(std::string const& prefab_name)
+{
+    auto const prefab_template = get_prefab_template(m_prefab_path + prefab_name + ".txt");
+
+    if (prefab_template == nullptr)
     {
-        std::cout << "Could not create a scene file: " << file_path << "\n";
-        return;
+        Debug::log("Could not load a prefab: " + prefab_name, DebugType::Error);
+        return nullptr;
     }
 
-    scene_file << out.c_str();
-    scene_file.close();
+    auto const scene_serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
+    scene_serializer->m_deserialization_mode = DeserializationMode::InjectFromFile;
+
+    return std::make_shared<PrefabLoad>(AK::Badge<SceneSerializer> {}, scene_serializer, prefab_template);
 }
 
-bool SceneSerializer::deserialize(std::string const& file_path)
+std::shared_ptr<BinarySceneFile const> SceneSerializer::get_prefab_template(std::string const& file_path)
 {
-    std::optional<std::string> scene_data = Engine::asset_preloader->get_text_asset(file_path);
+    std::string const key = VirtualFileSystem::normalize_path(file_path);
 
-    if (!scene_data.has_value())
-    {
-        std::ifstream scene_file(file_path);
-
-        if (!scene_file.is_open())
-        {
-            std::cout << "Could not open a scene file: " << file_path << "\n";
-            return false;
-        }
+    if (auto const it = m_prefab_templates.find(key); it != m_prefab_templates.end())
+        return it->second;
 
-        std::stringstream stream;
-        stream << scene_file.rdbuf();
-        scene_file.close();
+    // Waits if the worker thread isn't done with it yet.
+    if (auto const it = m_pending_prefab_templates.find(key); it != m_pending_prefab_templates.end())
+    {
+        auto const preloaded_prefab = it->second.get();
+        m_pending_prefab_templates.erase(it);
+        add_preloaded_prefab(key, *preloaded_prefab);
 
-        scene_data = stream.str();
+        if (preloaded_prefab->prefab_template != nullptr)
+            return preloaded_prefab->prefab_template;
     }
 
-    YAML::Node data = YAML::Load(scene_data.value());
-
-    if (!data["Scene"])
-        return false;
-
-    auto const scene_name = data["Scene"].as<std::string>();
-    std::cout << "Deserializing scene " << scene_name << "\n";
+    auto const prefab_template = build_prefab_template(file_path);
 
-    if (auto const entities = data["Entities"])
-    {
-        std::vector<std::pair<std::shared_ptr<Entity>, YAML::Node>> deserialized_entities = {};
-        deserialized_entities.reserve(entities.size());
+    if (prefab_template == nullptr)
+        return nullptr;
 
-        // First pass. Create all entities and components.
-        for (auto const entity : entities)
-        {
-            auto const deserialized_entity = deserialize_entity_first_pass(entity);
-            if (deserialized_entity == nullptr)
-                return false;
+    m_prefab_templates.emplace(key, prefab_template);
 
-            deserialized_entities_pool.emplace_back(deserialized_entity);
-            deserialized_entities.emplace_back(deserialized_entity, entity);
-        }
+    return prefab_template;
+}
 
-        // Second pass. Assign components' values including references to other components.
-        // Assign appropriate parent for each entity.
-        for (auto const& [entity, node] : deserialized_entities)
-        {
-            deserialize_entity_second_pass(node, entity);
+std::shared_ptr<BinarySceneFile const> SceneSerializer::build_prefab_template(std::string const& file_path)
+{
+    std::shared_ptr<BinarySceneFile const> prefab_template = nullptr;
 
-            if (entity->m_parent_guid.empty())
-                continue;
+#if !EDITOR
+    prefab_template = BinarySceneFile::load(BinaryScene::get_binary_path(file_path), file_path, binary_scene_layout_hash);
+#endif
 
-            for (auto const& [other_entity, other_node] : deserialized_entities)
-            {
-                if (entity->m_parent_guid == other_entity->guid)
-                {
-                    entity->transform->set_parent(other_entity->transform);
-                    break;
-                }
-            }
-        }
+    // No up to date cooked copy, or the editor, which only trusts the YAML. Cooked in memory then.
+    if (prefab_template == nullptr)
+    {
+        std::optional<std::string> text = Engine::asset_preloader->get_text_asset(file_path);
 
-        if (MainScene::get_instance()->is_running)
+        if (!text.has_value())
         {
-            for (auto const& component : deserialized_pool)
-            {
-                component->awake();
-                component->has_been_awaken = true;
-
-                if (component->enabled())
-                {
-                    component->on_enabled();
-                }
-            }
-        }
-    }
+            FileView const file = VirtualFileSystem::read(file_path);
 
-    return true;
-}
+            if (!file.is_valid())
+                return nullptr;
 
-void SceneSerializer::save_prefab(std::shared_ptr<Entity> const& entity, std::string const& prefab_name)
-{
-    auto const scene_serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
-    scene_serializer->set_instance(scene_serializer);
-    ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
+            text = std::string(file.get_text());
+        }
 
-    scene_serializer->serialize_this_entity(entity, m_prefab_path + prefab_name + ".txt");
-}
+        std::vector<u8> binary = {};
 
-// FIXME: We should probably cache entities that are prefabs and are referenced in the scene, just like Unity.
-//        So we won't need to read the .txt files here.
-std::shared_ptr<Entity> SceneSerializer::load_prefab(std::string const& prefab_name)
-{
-    auto const scene_serializer = std::make_shared<SceneSerializer>(MainScene::get_instance());
-    scene_serializer->set_instance(scene_serializer);
-    ScopeGuard unset_instance = [&] { scene_serializer->set_instance(nullptr); };
+        if (!cook_binary(file_path, text.value(), binary))
+            return nullptr;
 
-    std::shared_ptr<Entity> entity = scene_serializer->deserialize_this_entity(m_prefab_path + prefab_name + ".txt");
+        prefab_template = BinarySceneFile::create(std::move(binary), binary_scene_layout_hash);
+    }
 
-    return entity;
+    return prefab_template;
 }
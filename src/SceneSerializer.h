@@ -1,23 +1,78 @@
 #pragma once
 
+#include <future>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <yaml-cpp/node/node.h>
 
+#include "AK/Badge.h"
 #include "Material.h"
 #include "Scene.h"
+#include "ThreadPool.h"
 
 namespace YAML
 {
 class Emitter;
 }
 
+class BinarySceneFile;
+class BinarySceneReader;
+class BinarySceneWriter;
+class SceneSerializer;
+
 enum class DeserializationMode
 {
     Normal,
     InjectFromFile, // Tries to deserialize entities from a file into an existing scene. All guids are replaced with new ones.
 };
 
+// Serialized state of a scene at one point in time. It doesn't reference the scene, so it can be written from any thread.
+struct SceneSnapshot
+{
+    std::string file_path = {};
+    std::vector<std::shared_ptr<std::string const>> entity_blocks = {}; // Shared with later snapshots.
+    u32 emitted_count = 0;
+    bool has_changes = false; // Since the last snapshot of the same file.
+};
+
+// Instance of a prefab created over several calls to step(), see SceneSerializer::begin_load_prefab().
+class PrefabLoad
+{
+public:
+    enum class Stage
+    {
+        Creating,
+        Preparing,
+        Awaking, // Only if the scene is running. Components are started by the scene once they are awoken.
+        Done,
+    };
+
+    explicit PrefabLoad(AK::Badge<SceneSerializer>, std::shared_ptr<SceneSerializer> const& serializer,
+                        std::shared_ptr<BinarySceneFile const> const& file);
+    ~PrefabLoad();
+
+    // Works on the current stage only, at most max_entities entities or max_awakes components. Returns true once done.
+    bool step(u32 const max_entities, u32 const max_awakes);
+
+    // Destroys everything created so far. The load is Done afterwards.
+    void abandon();
+
+    [[nodiscard]] Stage get_stage() const;
+
+    // nullptr until the first step.
+    [[nodiscard]] std::shared_ptr<Entity> get_root() const;
+
+private:
+    std::shared_ptr<SceneSerializer> m_serializer;
+    std::unique_ptr<BinarySceneReader> m_reader;
+
+    Stage m_stage = Stage::Creating;
+    u32 m_next = 0;
+};
+
 class SceneSerializer
 {
 public:
@@ -35,17 +90,89 @@ public:
     void serialize(std::string const& file_path) const;
     bool deserialize(std::string const& file_path);
 
+    // Only entities marked dirty since they were last emitted are emitted again, the rest is reused from earlier snapshots.
+    [[nodiscard]] SceneSnapshot take_snapshot(std::string const& file_path) const;
+
+    // Writes the file next to the old one and renames it over, then cooks it. Safe to call from any thread.
+    static bool save_snapshot(SceneSnapshot const& snapshot);
+
+    // Drops the prefab templates of the files save_snapshot() has written since the last call. Main thread only.
+    static void drop_saved_templates();
+
+    static void mark_dirty(std::shared_ptr<Entity> const& entity);
+
+    // Call before destroying the entity. Entities referencing it or its children are emitted again.
+    static void mark_destroyed(std::shared_ptr<Entity> const& entity);
+
+    // For changes that can affect any entity, e.g. loading a scene. Every entity is emitted again,
+    // refresh_entity_blocks() spreads that over several frames.
+    static void mark_all_dirty();
+
+    // Emits at most max_entities entities that have no block since mark_all_dirty(). Main thread only.
+    void refresh_entity_blocks(u32 const max_entities) const;
+    [[nodiscard]] static bool has_missing_entity_blocks();
+
     static void save_prefab(std::shared_ptr<Entity> const& entity, std::string const& prefab_name);
+
+    // Instantiates the prefab's template, see m_prefab_templates.
     static std::shared_ptr<Entity> load_prefab(std::string const& prefab_name);
 
+    // Builds the template up front, so the first load_prefab() doesn't have to.
+    static void preload_prefab(std::string const& prefab_name);
+
+    // Builds the template on a worker thread, along with the list of textures its models use. Main thread only.
+    static void preload_prefab_async(std::string const& prefab_name);
+
+    // Picks up templates built by preload_prefab_async() and starts loading their textures. Main thread only, once per frame.
+    static void finish_preloaded_prefabs();
+
+    // Like load_prefab(), but the instance is created by stepping the returned load. nullptr if the prefab can't be loaded.
+    static std::shared_ptr<PrefabLoad> begin_load_prefab(std::string const& prefab_name);
+
+    // Writes the cooked binary copy of a YAML scene or prefab file, see BinaryScene.
+    static bool cook_binary(std::string const& file_path);
+
+    // Every scene or prefab file in the directory. Engine.exe --cook-scenes
+    static bool cook_directory(std::string const& directory);
+
+    // Loads every prefab from YAML, from its cooked copy and from its template, logs the average time of each and destroys them again.
+    static void benchmark_formats(std::vector<std::string> const& prefab_names, u32 const iterations);
+
 private:
     static void serialize_entity(YAML::Emitter& out, std::shared_ptr<Entity> const& entity);
     static void serialize_entity_recursively(YAML::Emitter& out, std::shared_ptr<Entity> const& entity);
+
+    // Appends the entity as an item of the scene's "Entities" sequence.
+    static void append_entity_block(std::string& text, std::shared_ptr<Entity> const& entity);
     static void auto_serialize_component(YAML::Emitter& out, std::shared_ptr<Component> const& component);
     void auto_deserialize_component(YAML::Node const& component, std::shared_ptr<Entity> const& deserialized_entity, bool const first_pass);
 
     void deserialize_components(YAML::Node const& entity_node, std::shared_ptr<Entity> const& deserialized_entity, bool const first_pass);
 
+    static bool cook_binary(std::string const& file_path, std::string_view const text, std::vector<u8>& binary);
+    static void auto_transcode_component(YAML::Node const& component, u32 const type, BinarySceneWriter& out);
+    static void auto_deserialize_component_binary(BinarySceneReader& in, u32 const type, std::shared_ptr<Component> const& component);
+
+    // Returns false, without creating anything, if the file has no up to date cooked copy.
+    bool deserialize_binary(std::string const& file_path, std::shared_ptr<Entity>& first_entity);
+    std::shared_ptr<Entity> instantiate_binary(std::shared_ptr<BinarySceneFile const> const& file);
+
+    // Both passes of instantiate_binary() over the entities in [first, last), in order.
+    void create_binary_entities(BinarySceneReader& in, u32 const first, u32 const last);
+    void prepare_binary_entities(BinarySceneReader& in, u32 const first, u32 const last);
+
+    // Returns nullptr if the prefab file is missing or can't be cooked.
+    static std::shared_ptr<BinarySceneFile const> get_prefab_template(std::string const& file_path);
+
+    // Cooks or loads the template without caching it. Safe to call from any thread.
+    static std::shared_ptr<BinarySceneFile const> build_prefab_template(std::string const& file_path);
+
+    // Parsed scene or prefab file, preloaded by AssetPreloader if possible.
+    static bool load_yaml(std::string const& file_path, YAML::Node& data);
+
+    // Gives every entity and component defined in data a new guid and updates the references to them.
+    void replace_included_guids(YAML::Node const& data);
+
     [[nodiscard]] std::shared_ptr<Entity> deserialize_entity_first_pass(YAML::Node const& entity);
     void deserialize_entity_second_pass(YAML::Node const& entity, std::shared_ptr<Entity> const& deserialized_entity);
 
@@ -57,8 +184,40 @@ private:
 
     DeserializationMode m_deserialization_mode = DeserializationMode::Normal;
 
+    // The editor works on the YAML files, they are the source of truth.
+    bool m_reads_binary = !EDITOR;
+
     // FIXME: Duplication of paths here and in Editor
     inline static std::string m_prefab_path = "./res/prefabs/";
 
+    // Every prefab loaded so far, cooked and validated once. Instances are created from these without touching the file again,
+    // references inside a prefab are indices, so they only need new guids. Saving a prefab drops its template.
+    inline static std::unordered_map<std::string, std::shared_ptr<BinarySceneFile const>> m_prefab_templates = {};
+
+    struct PreloadedPrefab;
+
+    // Stores the template and requests the textures, GPU placeholders are created for them.
+    static void add_preloaded_prefab(std::string const& key, PreloadedPrefab const& preloaded_prefab);
+
+    // Templates still being built by preload_prefab_async(), moved to m_prefab_templates once done or needed.
+    inline static std::unordered_map<std::string, std::shared_future<std::shared_ptr<PreloadedPrefab const>>>
+        m_pending_prefab_templates = {};
+    inline static std::unique_ptr<ThreadPool> m_thread_pool = nullptr;
+
+    // Last emitted text of every entity in the open scene, shared by the snapshots of all files. Main thread only.
+    inline static std::unordered_map<std::string, std::shared_ptr<std::string const>> m_entity_blocks = {};
+    inline static std::unordered_set<std::string> m_dirty_entities = {};
+    inline static bool m_has_missing_entity_blocks = false;
+
+    // Bumped by every change to the blocks. A file is up to date if its last snapshot saw the current version.
+    inline static u64 m_blocks_version = 0;
+    inline static std::unordered_map<std::string, u64> m_saved_versions = {};
+
+    // Written by save_snapshot() from any thread, see drop_saved_templates().
+    inline static std::vector<std::string> m_saved_files = {};
+    inline static std::mutex m_saved_files_mutex = {};
+
     inline static std::shared_ptr<SceneSerializer> m_instance;
+
+    friend class PrefabLoad;
 };
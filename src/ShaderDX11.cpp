@@ -3,20 +3,75 @@
 #include "AK/AK.h"
 #include "Renderer.h"
 #include "RendererDX11.h"
+#include "VirtualFileSystem.h"
 
 #include <d3dcommon.h>
 #include <d3dcompiler.h>
 #pragma comment(lib, "d3dcompiler")
 
 #include <array>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <unordered_map>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.inl>
 
+namespace
+{
+
+// Resolves #include through VirtualFileSystem, so packed shaders can include each other.
+// Paths are relative to the including file, like with D3D_COMPILE_STANDARD_FILE_INCLUDE.
+class ShaderInclude final : public ID3DInclude
+{
+public:
+    explicit ShaderInclude(std::string const& shader_path) : m_directory(std::filesystem::path(shader_path).parent_path())
+    {
+    }
+
+    HRESULT __stdcall Open(D3D_INCLUDE_TYPE, LPCSTR file_name, LPCVOID parent_data, LPCVOID* data, UINT* size) override
+    {
+        auto const parent = m_open_files.find(parent_data);
+        std::filesystem::path const path = (parent != m_open_files.end() ? parent->second.directory : m_directory) / file_name;
+
+        FileView file = VirtualFileSystem::read(path.string());
+
+        if (!file.is_valid())
+            return E_FAIL;
+
+        *data = file.get_bytes();
+        *size = static_cast<UINT>(file.get_size());
+
+        m_open_files.emplace(*data, OpenFile {std::move(file), path.parent_path()});
+
+        return S_OK;
+    }
+
+    HRESULT __stdcall Close(LPCVOID data) override
+    {
+        // Packed files are views into the pack, the same file included twice comes with the same pointer.
+        if (auto const it = m_open_files.find(data); it != m_open_files.end())
+            m_open_files.erase(it);
+
+        return S_OK;
+    }
+
+private:
+    struct OpenFile
+    {
+        FileView file = {};
+        std::filesystem::path directory = {};
+    };
+
+    std::filesystem::path m_directory = {};
+    std::unordered_multimap<void const*, OpenFile> m_open_files = {};
+};
+
+}
+
 ShaderDX11::ShaderDX11(AK::Badge<ShaderFactory>, std::string const& compute_path) : Shader(compute_path)
 {
 }
@@ -50,8 +105,8 @@ void ShaderDX11::load_shader()
         std::wstring const vertex_path_final = std::wstring(m_vertex_path.begin(), m_vertex_path.end());
         size_t size = 0;
         char const* shader_source = read_hlsl_shader_from_file(m_vertex_path, &size);
-        hr = D3DPreprocess(shader_source, size, m_vertex_path.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, &vs_blob,
-                           &shader_compile_errors_blob);
+        ShaderInclude include(m_vertex_path);
+        hr = D3DPreprocess(shader_source, size, m_vertex_path.c_str(), nullptr, &include, &vs_blob, &shader_compile_errors_blob);
 
         delete[] shader_source;
 
@@ -109,8 +164,8 @@ void ShaderDX11::load_shader()
         auto const pixel_path_final = std::wstring(m_fragment_path.begin(), m_fragment_path.end());
         size_t size = 0;
         auto const shader_source = read_hlsl_shader_from_file(m_fragment_path, &size);
-        hr = D3DPreprocess(shader_source, size, m_fragment_path.c_str(), nullptr, D3D_COMPILE_STANDARD_FILE_INCLUDE, &ps_blob,
-                           &shader_compile_errors_blob);
+        ShaderInclude include(m_fragment_path);
+        hr = D3DPreprocess(shader_source, size, m_fragment_path.c_str(), nullptr, &include, &ps_blob, &shader_compile_errors_blob);
 
         delete[] shader_source;
 
@@ -163,16 +218,32 @@ void ShaderDX11::load_shader()
     }
 
     {
-        std::array<D3D11_INPUT_ELEMENT_DESC, 5> constexpr input_element_desc = {
+        // Both layouts read the same two streams, they only differ in how the skin stream steps. Static meshes bind a single
+        // zero weight SkinVertex that is read per instance, so shaders that can skin work with either.
+        std::array<D3D11_INPUT_ELEMENT_DESC, 5> constexpr static_input_element_desc = {
             {{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
-             {"NORMAL", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-             {"TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-             {"TEXCOORD", 1, DXGI_FORMAT_R32G32B32A32_SINT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
-             {"TEXCOORD", 2, DXGI_FORMAT_R32G32B32A32_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0}}};
+             {"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+             {"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+             {"TEXCOORD", 1, DXGI_FORMAT_R8G8B8A8_UINT, 1, 0, D3D11_INPUT_PER_INSTANCE_DATA, 1},
+             {"TEXCOORD", 2, DXGI_FORMAT_R8G8B8A8_UNORM, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_INSTANCE_DATA, 1}}};
+
+        std::array<D3D11_INPUT_ELEMENT_DESC, 5> constexpr skinned_input_element_desc = {
+            {{"POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+             {"NORMAL", 0, DXGI_FORMAT_R16G16_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+             {"TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0},
+             {"TEXCOORD", 1, DXGI_FORMAT_R8G8B8A8_UINT, 1, 0, D3D11_INPUT_PER_VERTEX_DATA, 0},
+             {"TEXCOORD", 2, DXGI_FORMAT_R8G8B8A8_UNORM, 1, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0}}};
+
+        auto const device = RendererDX11::get_instance_dx11()->get_device();
 
-        HRESULT const hr = RendererDX11::get_instance_dx11()->get_device()->CreateInputLayout(
-            input_element_desc.data(), input_element_desc.size(), vs_blob->GetBufferPointer(), vs_blob->GetBufferSize(), &m_input_layout);
+        hr = device->CreateInputLayout(static_input_element_desc.data(), static_input_element_desc.size(), vs_blob->GetBufferPointer(),
+                                       vs_blob->GetBufferSize(), &m_input_layouts[static_cast<u8>(VertexLayout::Static)]);
         assert(SUCCEEDED(hr));
+
+        hr = device->CreateInputLayout(skinned_input_element_desc.data(), skinned_input_element_desc.size(), vs_blob->GetBufferPointer(),
+                                       vs_blob->GetBufferSize(), &m_input_layouts[static_cast<u8>(VertexLayout::Skinned)]);
+        assert(SUCCEEDED(hr));
+
         vs_blob->Release();
     }
 }
@@ -180,9 +251,22 @@ void ShaderDX11::load_shader()
 void ShaderDX11::use() const
 {
     auto const instance = RendererDX11::get_instance_dx11();
-    instance->get_device_context()->IASetInputLayout(m_input_layout);
+    instance->get_device_context()->IASetInputLayout(m_input_layouts[static_cast<u8>(VertexLayout::Static)]);
     instance->get_device_context()->VSSetShader(m_vertex_shader, nullptr, 0);
     instance->get_device_context()->PSSetShader(m_pixel_shader, nullptr, 0);
+
+    m_current_shader = this;
+    m_current_layout = VertexLayout::Static;
+}
+
+void ShaderDX11::set_vertex_layout(VertexLayout const vertex_layout)
+{
+    if (m_current_shader == nullptr || m_current_layout == vertex_layout)
+        return;
+
+    RendererDX11::get_instance_dx11()->get_device_context()->IASetInputLayout(
+        m_current_shader->m_input_layouts[static_cast<u8>(vertex_layout)]);
+    m_current_layout = vertex_layout;
 }
 
 void ShaderDX11::set_bool(std::string const& name, bool const value) const
@@ -216,29 +300,20 @@ i32 ShaderDX11::attach(char const* path, i32 type) const
 
 char* ShaderDX11::read_hlsl_shader_from_file(std::string const& path, size_t* p_size)
 {
-    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    FileView const file = VirtualFileSystem::read(path);
 
-    if (!file.is_open())
+    if (!file.is_valid())
     {
         *p_size = 0;
         return nullptr;
     }
 
-    std::streamsize const file_size = file.tellg();
-    file.seekg(0, std::ios::beg);
-
-    auto const buffer = new char[file_size + 1];
-
-    if (file.read(buffer, file_size))
-    {
-        buffer[file_size] = '\0'; // Null-terminate the string
-        *p_size = static_cast<size_t>(file_size);
-        return buffer;
-    }
+    auto const buffer = new char[file.get_size() + 1];
 
-    delete[] buffer;
-    *p_size = 0;
-    return nullptr;
+    std::memcpy(buffer, file.get_bytes(), file.get_size());
+    buffer[file.get_size()] = '\0'; // Null-terminate the string
+    *p_size = file.get_size();
+    return buffer;
 }
 
 bool ShaderDX11::save_compiled_shader(std::string const& path, ID3DBlob* p_blob)
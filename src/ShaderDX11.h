@@ -1,9 +1,11 @@
 #pragma once
 
+#include <array>
 #include <d3d11.h>
 
 #include "AK/Badge.h"
 #include "Shader.h"
+#include "Vertex.h"
 
 class ShaderFactory;
 
@@ -26,6 +28,9 @@ public:
     void virtual set_mat4(std::string const& name, glm::mat4 const value) const override;
     void virtual load_shader() override;
 
+    // Switches the input layout of the shader that was used last. use() always starts with VertexLayout::Static.
+    static void set_vertex_layout(VertexLayout const vertex_layout);
+
 private:
     i32 virtual attach(char const* path, i32 type) const override;
 
@@ -33,11 +38,14 @@ private:
     static bool save_compiled_shader(std::string const& path, ID3DBlob* blob);
     static bool read_file_to_blob(std::string const& path, ID3DBlob** pp_blob);
 
-    ID3D11InputLayout* m_input_layout = nullptr;
+    std::array<ID3D11InputLayout*, static_cast<u8>(VertexLayout::Count)> m_input_layouts = {};
     ID3D11VertexShader* m_vertex_shader = nullptr;
     ID3D11PixelShader* m_pixel_shader = nullptr;
 
     // NOTE: Do not use constexpr here! The string will not live until runtime because of that.
     //       https://developercommunity.visualstudio.com/t/c20-constexpr-stdstring-with-static-is-not-working/1441363
     inline static std::string m_compiled_path = "./res/shaders/compiled/";
+
+    inline static ShaderDX11 const* m_current_shader = nullptr;
+    inline static VertexLayout m_current_layout = VertexLayout::Static;
 };
@@ -1,8 +1,8 @@
 #include "ShaderGL.h"
 
-#include <fstream>
+#include "VirtualFileSystem.h"
+
 #include <iostream>
-#include <sstream>
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
@@ -171,27 +171,17 @@ ShaderGL::ShaderGL(AK::Badge<ShaderFactory>, std::string const& vertex_path, std
 i32 ShaderGL::attach(char const* path, i32 const type) const
 {
     std::string code;
-    std::ifstream shader_file;
-
-    shader_file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+    FileView const shader_file = VirtualFileSystem::read(path);
 
-    try
+    if (shader_file.is_valid())
     {
-        shader_file.open(path);
-
-        std::stringstream stream;
-
-        stream << shader_file.rdbuf();
-
-        shader_file.close();
-
-        code = stream.str();
+        code = shader_file.get_text();
     }
-    catch (std::ifstream::failure& e)
+    else
     {
         std::cout << "Error. ShaderGL file not successfully read."
                   << "\n"
-                  << e.what() << "\n";
+                  << path << "\n";
     }
 
     char const* shader_code = code.c_str();
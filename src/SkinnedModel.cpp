@@ -4,10 +4,13 @@
 #include "AK/Math.h"
 #include "AK/Types.h"
 #include "AnimationEngine.h"
+#include "AssimpFileSystem.h"
 #include "ConstantBufferTypes.h"
+#include "CookedModel.h"
 #include "Entity.h"
 #include "Globals.h"
 #include "Mesh.h"
+#include "MeshCooker.h"
 #include "MeshFactory.h"
 #include "Renderer.h"
 #include "RendererDX11.h"
@@ -15,6 +18,8 @@
 #include "Texture.h"
 #include "Vertex.h"
 
+#include <algorithm>
+#include <cfloat>
 #include <filesystem>
 #include <iostream>
 #include <map>
@@ -91,6 +96,9 @@ void SkinnedModel::draw_editor()
         reprepare();
     }
 
+    ImGui::DragFloat("Playback Speed", &playback.speed, 0.01f);
+    ImGui::Checkbox("Loop", &playback.loop);
+
     // Choose rasterizer draw mode for individual model
     std::array const draw_type_items = {"Default", "Wireframe", "Solid"};
 
@@ -107,29 +115,51 @@ void SkinnedModel::calculate_bounding_box()
     for (auto const& mesh : m_meshes)
         mesh->calculate_bounding_box();
 
-    // TODO: Merge bounding boxes together
-    if (!m_meshes.empty())
-        bounds = m_meshes[0]->bounds;
+    update_local_bounds();
+    bounds = m_local_bounds;
 }
 
 void SkinnedModel::adjust_bounding_box()
 {
-    // TODO: If we merge bounding boxes together, I think we can just adjust the whole model bounding box
-    for (auto const& mesh : m_meshes)
-        mesh->adjust_bounding_box(entity->transform->get_model_matrix());
-
-    if (!m_meshes.empty())
-        bounds = m_meshes[0]->bounds;
+    bounds = get_adjusted_bounding_box(entity->transform->get_model_matrix());
 }
 
 BoundingBox SkinnedModel::get_adjusted_bounding_box(glm::mat4 const& model_matrix) const
 {
     if (!m_meshes.empty())
-        return m_meshes[0]->get_adjusted_bounding_box(model_matrix);
+        return m_local_bounds.get_transformed(model_matrix);
 
     return {};
 }
 
+void SkinnedModel::update_local_bounds()
+{
+    if (m_meshes.empty())
+    {
+        m_local_bounds = {};
+        return;
+    }
+
+    // Bind pose of every mesh covers the unskinned vertices, the clip bounds cover everything the clips move.
+    m_local_bounds = m_meshes[0]->bounds;
+    for (u32 i = 1; i < m_meshes.size(); ++i)
+        m_local_bounds = BoundingBox::merge(m_local_bounds, m_meshes[i]->bounds);
+
+    auto const merge_clip = [this](std::shared_ptr<Animation const> const& clip) {
+        if (clip != nullptr && clip->has_bounds)
+            m_local_bounds = BoundingBox::merge(m_local_bounds, clip->bounds);
+    };
+
+    merge_clip(m_clip);
+    merge_clip(m_fade_out.animation);
+
+    for (auto const& layer : m_layers)
+        merge_clip(layer.animation);
+
+    if (entity != nullptr)
+        entity->transform->needs_bounding_box_adjusting = true;
+}
+
 bool SkinnedModel::is_skinned_model() const
 {
     return true;
@@ -188,14 +218,21 @@ void SkinnedModel::prepare()
         material->first_drawable = std::dynamic_pointer_cast<Drawable>(shared_from_this());
     }
 
-    load_model(model_path, SkinningLoadMode::Rig);
-    load_model(anim_path, SkinningLoadMode::Anim);
+    load_model(model_path);
+    initialize_animation();
 }
 
 void SkinnedModel::reset()
 {
     m_meshes.clear();
     m_loaded_textures.clear();
+    m_skin = {};
+    m_bone_counter = 0;
+    animation = nullptr;
+    m_clip = nullptr;
+    m_fade_out = {};
+    m_queued_clip = nullptr;
+    m_layers.clear();
 }
 
 void SkinnedModel::reprepare()
@@ -204,23 +241,66 @@ void SkinnedModel::reprepare()
     prepare();
 }
 
-void SkinnedModel::load_model(std::string const& path, SkinningLoadMode const& load_mode)
+void SkinnedModel::load_model(std::string const& path)
 {
+    std::filesystem::path const filesystem_path = path;
+    m_directory = filesystem_path.parent_path().string();
+
+    // Cook the model the first time it's loaded, so later launches map the cooked file and skip Assimp.
+    // Assimp is only used directly when the cooked model can't be written.
+    if (load_cooked_model(path) || (MeshCooker::cook(path, CookedModel::get_cooked_path(path)) && load_cooked_model(path)))
+        return;
+
     Assimp::Importer importer;
+    importer.SetIOHandler(new AssimpFileSystem);
     m_scene = importer.ReadFile(path, aiProcess_PopulateArmatureData | aiProcess_Triangulate | aiProcess_FlipUVs);
 
-    if ((m_scene == nullptr || m_scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || m_scene->mRootNode == nullptr)
-        && load_mode == SkinningLoadMode::Rig)
+    if (m_scene == nullptr || m_scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || m_scene->mRootNode == nullptr)
     {
         std::cout << "Error. Failed loading a model: " << importer.GetErrorString() << "\n";
         return;
     }
 
-    std::filesystem::path const filesystem_path = path;
-    m_directory = filesystem_path.parent_path().string();
-
     process_node(m_scene->mRootNode);
-    initialize_animation();
+}
+
+bool SkinnedModel::load_cooked_model(std::string const& path)
+{
+    auto const cooked_model = CookedModel::load(CookedModel::get_cooked_path(path), path);
+
+    if (cooked_model == nullptr)
+        return false;
+
+    // Cooked bones are stored by ID, in the order extract_bone_weight_for_vertices() would have assigned them.
+    for (u32 i = 0; i < cooked_model->bones.size(); ++i)
+    {
+        auto const& bone = cooked_model->bones[i];
+        m_skin.bone_info_map[bone.name] = {static_cast<i32>(i), bone.offset};
+        m_skin.joint_bounds.emplace_back(bone.bounds_min, bone.bounds_max);
+    }
+
+    m_bone_counter = static_cast<u32>(cooked_model->bones.size());
+
+    for (auto const& submesh : cooked_model->submeshes)
+    {
+        std::vector<std::shared_ptr<Texture>> textures;
+        textures.reserve(submesh.texture_count);
+
+        for (u32 i = submesh.first_texture; i < submesh.first_texture + submesh.texture_count; ++i)
+        {
+            auto const& texture = cooked_model->textures[i];
+            textures.push_back(load_material_texture(texture.path, texture.type));
+        }
+
+        // Skinned meshes are always drawn at full detail, the cooked LODs are only used by static models.
+        BoundingBox const local_bounds = {submesh.bounds_min, submesh.bounds_max};
+        m_meshes.emplace_back(ResourceManager::get_instance().load_mesh(m_meshes.size(), model_path, cooked_model->get_vertices(submesh),
+                                                                        cooked_model->get_skin_vertices(submesh),
+                                                                        cooked_model->get_indices(submesh), {}, local_bounds, textures,
+                                                                        m_draw_type, material));
+    }
+
+    return true;
 }
 
 void SkinnedModel::process_node(aiNode const* node)
@@ -308,35 +388,31 @@ std::vector<std::shared_ptr<Texture>> SkinnedModel::load_material_textures(aiMat
         aiString str;
         material->GetTexture(type, i, &str);
 
-        bool is_already_loaded = false;
-        for (auto const& loaded_texture : m_loaded_textures)
-        {
-            if (std::strcmp(loaded_texture->path.data(), str.C_Str()) == 0)
-            {
-                textures.push_back(loaded_texture);
-                is_already_loaded = true;
-                break;
-            }
-        }
+        textures.push_back(load_material_texture(str.C_Str(), type_name));
+    }
 
-        if (is_already_loaded)
-            continue;
+    return textures;
+}
 
-        auto file_path = std::string(str.C_Str());
-        file_path = m_directory + '/' + file_path;
+std::shared_ptr<Texture> SkinnedModel::load_material_texture(std::string const& relative_path, TextureType const type)
+{
+    for (auto const& loaded_texture : m_loaded_textures)
+    {
+        if (loaded_texture->path == relative_path)
+            return loaded_texture;
+    }
 
-        TextureSettings settings = {};
-        settings.flip_vertically = false;
-        settings.filtering_min = TextureFiltering::Nearest;
-        settings.filtering_max = TextureFiltering::Nearest;
-        settings.filtering_mipmap = TextureFiltering::Nearest;
+    TextureSettings settings = {};
+    settings.flip_vertically = false;
+    settings.filtering_min = TextureFiltering::Nearest;
+    settings.filtering_max = TextureFiltering::Nearest;
+    settings.filtering_mipmap = TextureFiltering::Nearest;
 
-        std::shared_ptr<Texture> texture = ResourceManager::get_instance().load_texture(file_path, type_name, settings);
-        textures.push_back(texture);
-        m_loaded_textures.push_back(texture);
-    }
+    std::shared_ptr<Texture> texture =
+        ResourceManager::get_instance().load_texture_async(m_directory + '/' + relative_path, type, settings);
+    m_loaded_textures.push_back(texture);
 
-    return textures;
+    return texture;
 }
 
 void SkinnedModel::extract_bone_weight_for_vertices(std::vector<Vertex>& vertices, aiMesh const* mesh)
@@ -345,29 +421,37 @@ void SkinnedModel::extract_bone_weight_for_vertices(std::vector<Vertex>& vertice
     {
         int bone_id = -1;
         std::string bone_name = mesh->mBones[bone_index]->mName.C_Str();
-        if (!m_bone_info_map.contains(bone_name))
+        if (!m_skin.bone_info_map.contains(bone_name))
         {
             BoneInfo new_bone_info;
             new_bone_info.id = m_bone_counter;
             new_bone_info.offset = AK::Math::ai_matrix_to_glm(mesh->mBones[bone_index]->mOffsetMatrix);
-            m_bone_info_map[bone_name] = new_bone_info;
+            m_skin.bone_info_map[bone_name] = new_bone_info;
             bone_id = m_bone_counter;
             m_bone_counter++;
         }
         else
         {
-            bone_id = m_bone_info_map[bone_name].id;
+            bone_id = m_skin.bone_info_map[bone_name].id;
         }
         assert(bone_id != -1);
         auto const weights = mesh->mBones[bone_index]->mWeights;
         i32 const num_weights = mesh->mBones[bone_index]->mNumWeights;
 
+        if (bone_id >= m_skin.joint_bounds.size())
+            m_skin.joint_bounds.resize(bone_id + 1, {glm::vec3(FLT_MAX), glm::vec3(-FLT_MAX)});
+
+        BoundingBox& joint_bounds = m_skin.joint_bounds[bone_id];
+
         for (int weight_index = 0; weight_index < num_weights; ++weight_index)
         {
             i32 const vertex_id = weights[weight_index].mVertexId;
             float const weight = weights[weight_index].mWeight;
             assert(vertex_id <= vertices.size());
             set_vertex_bone_data(vertices[vertex_id], bone_id, weight);
+
+            if (weight > 0.0f)
+                joint_bounds = BoundingBox::merge(joint_bounds, {vertices[vertex_id].position, vertices[vertex_id].position});
         }
     }
 }
@@ -394,93 +478,244 @@ void SkinnedModel::set_vertex_bone_data_to_default(Vertex& vertex)
     }
 }
 
-void SkinnedModel::calculate_bone_transform(AssimpNodeData const* node, glm::mat4 const& parent_transform)
+void SkinnedModel::advance_playback(double const delta)
 {
-    std::string const node_name = node->name;
-    glm::mat4 node_transform = node->transformation;
+    if (m_clip == nullptr)
+        return;
 
-    if (skinning_matrices.empty())
-        skinning_matrices.resize(512);
+    playback.advance(*m_clip, delta);
 
-    if (Bone* bone = find_bone(node_name))
+    if (m_fade_out.animation != nullptr)
     {
-        bone->update(AnimationEngine::get_instance()->get_current_time());
-        node_transform = bone->local_transform;
+        m_fade_out.playback.advance(*m_fade_out.animation, delta);
+        m_fade_time += static_cast<float>(delta);
+
+        if (m_fade_time >= m_fade_duration)
+        {
+            m_fade_out = {};
+
+            if (m_queued_clip != nullptr)
+            {
+                auto const clip = std::move(m_queued_clip);
+                m_queued_clip = nullptr;
+                start_crossfade(clip, m_queued_fade_duration);
+            }
+        }
     }
 
-    glm::mat4 const global_transformation = parent_transform * node_transform;
+    for (auto& layer : m_layers)
+        layer.playback.advance(*layer.animation, delta);
+}
+
+void SkinnedModel::crossfade_to(std::string const& clip_path, float const duration)
+{
+    if (animation == nullptr)
+        return;
+
+    auto const clip = ResourceManager::get_instance().load_animation(model_path, clip_path, m_skin);
 
-    auto bone_info_map = animation.bone_info_map;
-    if (bone_info_map.contains(node_name))
+    // Only two clips are blended, replacing the one fading out would make the pose jump.
+    if (m_fade_out.animation != nullptr && duration > 0.0f)
     {
-        i32 const index = bone_info_map[node_name].id;
-        glm::mat4 const offset = bone_info_map[node_name].offset;
-        skinning_matrices[index] = global_transformation * offset;
+        m_queued_clip = clip;
+        m_queued_fade_duration = duration;
+        return;
     }
 
-    for (int i = 0; i < node->children_count; i++)
-        calculate_bone_transform(&node->children[i], global_transformation);
+    m_queued_clip = nullptr;
+    start_crossfade(clip, duration);
 }
 
-void SkinnedModel::initialize_animation()
+void SkinnedModel::start_crossfade(std::shared_ptr<Animation const> const& clip, float const duration)
 {
-    Assimp::Importer importer;
-    aiScene const* scene = importer.ReadFile(anim_path, aiProcess_Triangulate);
-    assert(scene && scene->mRootNode);
-    auto const assimp_animation = scene->mAnimations[0];
-    animation.duration = assimp_animation->mDuration;
-    animation.ticks_per_second = assimp_animation->mTicksPerSecond;
-    read_hierarchy_data(animation.root_node, scene->mRootNode);
-    read_missing_bones(assimp_animation);
+    if (duration > 0.0f)
+    {
+        m_fade_out.animation = m_clip;
+        m_fade_out.playback = playback;
+        m_fade_out.channels = m_clip_channels;
+        m_fade_time = 0.0f;
+        m_fade_duration = duration;
+    }
+    else
+    {
+        m_fade_out = {};
+    }
+
+    m_clip = clip;
+    m_clip_channels = clip == animation ? animation->rig.channels : PoseBlending::map_channels(animation->rig, *clip);
+    playback.time = 0.0;
+    playback.cursors.assign(clip->bones.size(), {});
+
+    update_local_bounds();
 }
 
-void SkinnedModel::read_hierarchy_data(AssimpNodeData& dest, aiNode const* src)
+u32 SkinnedModel::add_layer(std::string const& clip_path, AnimationLayerMode const mode, std::string const& mask_root,
+                            float const weight)
 {
-    assert(src);
+    assert(animation != nullptr);
+
+    Rig const& rig = animation->rig;
 
-    dest.name = src->mName.data;
-    dest.transformation = AK::Math::ai_matrix_to_glm(src->mTransformation);
-    dest.children_count = src->mNumChildren;
+    AnimationLayer layer = {};
+    layer.animation = ResourceManager::get_instance().load_animation(model_path, clip_path, m_skin);
+    layer.mode = mode;
+    layer.weight = weight;
+    layer.channels = PoseBlending::map_channels(rig, *layer.animation);
+    layer.joint_weights = PoseBlending::build_joint_mask(rig, mask_root);
+    layer.playback.cursors.assign(layer.animation->bones.size(), {});
 
-    for (int i = 0; i < src->mNumChildren; i++)
+    if (mode == AnimationLayerMode::Additive)
     {
-        AssimpNodeData newData;
-        read_hierarchy_data(newData, src->mChildren[i]);
-        dest.children.push_back(newData);
+        AnimationPlayback first_frame = {};
+        first_frame.cursors.assign(layer.animation->bones.size(), {});
+        PoseBlending::sample(rig, *layer.animation, layer.channels, first_frame, UINT32_MAX, layer.reference_pose);
     }
+
+    m_layers.emplace_back(layer);
+    update_local_bounds();
+    return static_cast<u32>(m_layers.size() - 1);
+}
+
+void SkinnedModel::set_layer_weight(u32 const index, float const weight)
+{
+    assert(index < m_layers.size());
+    m_layers[index].weight = weight;
+}
+
+void SkinnedModel::clear_layers()
+{
+    m_layers.clear();
+    update_local_bounds();
+}
+
+float SkinnedModel::get_crossfade_weight() const
+{
+    if (m_fade_duration <= 0.0f)
+        return 1.0f;
+
+    return glm::clamp(m_fade_time / m_fade_duration, 0.0f, 1.0f);
 }
 
-void SkinnedModel::read_missing_bones(aiAnimation const* assimp_animation)
+void SkinnedModel::update_animation(double const delta, AnimationLODSettings const& lod_settings)
 {
-    u32 const size = assimp_animation->mNumChannels;
+    if (animation == nullptr)
+        return;
 
-    std::map<std::string, BoneInfo> new_bone_info_map = m_bone_info_map;
-    u32 bone_count = m_bone_counter;
+    advance_playback(delta);
 
-    for (int i = 0; i < size; i++)
+    switch (playback.lod)
     {
-        auto const channel = assimp_animation->mChannels[i];
-        std::string boneName = channel->mNodeName.data;
+    case AnimationLOD::Full:
+        evaluate_pose(skinning_matrices, UINT32_MAX);
+        playback.time_since_evaluation = 0.0;
+        m_has_reduced_palettes = false;
+        break;
 
-        if (!new_bone_info_map.contains(boneName))
+    case AnimationLOD::Reduced:
+    {
+        double const interval = glm::max(static_cast<double>(lod_settings.reduced_update_interval), 0.0001);
+        playback.time_since_evaluation += delta;
+
+        // Blending lags one interval behind the clip, which isn't noticeable at the distance Reduced is used.
+        if (!m_has_reduced_palettes || playback.time_since_evaluation >= interval)
         {
-            new_bone_info_map[boneName].id = bone_count;
-            bone_count++;
+            // Coming from another level, the pose on screen is where blending starts.
+            if (!m_has_reduced_palettes)
+            {
+                std::ranges::copy(skinning_matrices, m_next_palette.begin());
+                m_has_reduced_palettes = true;
+            }
+
+            // The last evaluation is the start of the next blend, both buffers are sized in initialize_animation().
+            std::swap(m_previous_palette, m_next_palette);
+            evaluate_pose(m_next_palette, lod_settings.reduced_max_joint_depth);
+            playback.time_since_evaluation = fmod(playback.time_since_evaluation, interval);
         }
 
-        Bone bone;
-        bone.init(channel->mNodeName.data, new_bone_info_map[channel->mNodeName.data].id, channel);
-        animation.bones.push_back(bone);
+        blend_palettes(static_cast<float>(playback.time_since_evaluation / interval));
+        break;
+    }
+
+    case AnimationLOD::Frozen:
+    case AnimationLOD::Count:
+        // Off-screen, keep the last pose. Cursors catch up through the binary search once the model is visible again.
+        m_has_reduced_palettes = false;
+        break;
+    }
+}
+
+void SkinnedModel::evaluate_pose(std::vector<glm::mat4>& palette, u32 const max_joint_depth)
+{
+    Rig const& rig = animation->rig;
+
+    PoseBlending::sample(rig, *m_clip, m_clip_channels, playback, max_joint_depth, m_pose);
+
+    if (m_fade_out.animation != nullptr)
+    {
+        PoseBlending::sample(rig, *m_fade_out.animation, m_fade_out.channels, m_fade_out.playback, max_joint_depth, m_layer_pose);
+        PoseBlending::blend(m_layer_pose, m_pose, get_crossfade_weight(), m_pose);
+    }
+
+    for (auto& layer : m_layers)
+    {
+        if (layer.weight <= 0.0f)
+            continue;
+
+        PoseBlending::sample(rig, *layer.animation, layer.channels, layer.playback, max_joint_depth, m_layer_pose);
+
+        if (layer.mode == AnimationLayerMode::Additive)
+            PoseBlending::add(m_pose, m_layer_pose, layer.reference_pose, layer.weight, layer.joint_weights, m_pose);
+        else
+            PoseBlending::blend_masked(m_pose, m_layer_pose, layer.weight, layer.joint_weights, m_pose);
+    }
+
+    // Matrices only show up here, once per joint, no matter how many clips went into the pose.
+    PoseBlending::local_to_model(rig, m_pose, m_model_space_transforms);
+
+    for (u32 i = 0; i < rig.num_bones; ++i)
+    {
+        if (i32 const palette_id = rig.palette_ids[i]; palette_id != -1)
+            palette[palette_id] = m_model_space_transforms[i] * rig.offsets[i];
     }
+}
+
+void SkinnedModel::blend_palettes(float const alpha)
+{
+    Rig const& rig = animation->rig;
 
-    animation.bone_info_map = new_bone_info_map;
+    // Linear blend of skinning matrices is only valid for poses this close together, which the short interval guarantees.
+    for (u32 i = 0; i < rig.num_bones; ++i)
+    {
+        if (i32 const palette_id = rig.palette_ids[i]; palette_id != -1)
+        {
+            glm::mat4 const& previous = m_previous_palette[palette_id];
+            skinning_matrices[palette_id] = previous + (m_next_palette[palette_id] - previous) * alpha;
+        }
+    }
 }
 
-Bone* SkinnedModel::find_bone(std::string const& name)
+void SkinnedModel::initialize_animation()
 {
-    auto const iter = std::ranges::find_if(animation.bones, [&](Bone const& bone) { return bone.name == name; });
-    if (iter == animation.bones.end())
-        return nullptr;
+    animation = ResourceManager::get_instance().load_animation(model_path, anim_path, m_skin);
+
+    playback.time = 0.0;
+    playback.time_since_evaluation = 0.0;
+    playback.cursors.assign(animation->bones.size(), {});
+
+    m_clip = animation;
+    m_clip_channels = animation->rig.channels;
+    m_fade_out = {};
+    m_queued_clip = nullptr;
+    m_fade_duration = 0.0f;
+    m_layers.clear();
+
+    m_pose.resize(animation->rig.num_bones);
+    m_layer_pose.resize(animation->rig.num_bones);
+    m_model_space_transforms.resize(animation->rig.num_bones);
+    skinning_matrices.resize(animation->rig.palette_size);
+    m_previous_palette.resize(animation->rig.palette_size);
+    m_next_palette.resize(animation->rig.palette_size);
+    m_has_reduced_palettes = false;
 
-    return &(*iter);
+    update_local_bounds();
 }
@@ -5,6 +5,7 @@
 #include <assimp/material.h>
 
 #include "AK/Badge.h"
+#include "AnimationPose.h"
 #include "Mesh.h"
 #include "Rig.h"
 #include "Texture.h"
@@ -18,12 +19,6 @@ struct aiMesh;
 struct aiScene;
 struct aiNode;
 
-enum class SkinningLoadMode
-{
-    Rig,
-    Anim
-};
-
 class SkinnedModel : public Drawable
 {
 public:
@@ -58,7 +53,17 @@ public:
     virtual BoundingBox get_adjusted_bounding_box(glm::mat4 const& model_matrix) const override;
 
     virtual bool is_skinned_model() const override;
-    void calculate_bone_transform(AssimpNodeData const* node, glm::mat4 const& parent_transform);
+    void advance_playback(double const delta);
+    void update_animation(double const delta, AnimationLODSettings const& lod_settings);
+
+    // Blends from the clip currently playing to the one at clip_path over duration seconds.
+    // While another crossfade is running it starts once that one ends, only the last such request is kept.
+    void crossfade_to(std::string const& clip_path, float const duration);
+
+    // Plays clip_path on top of the base clip, limited to the joints under mask_root (all joints if empty). Returns the layer index.
+    u32 add_layer(std::string const& clip_path, AnimationLayerMode const mode, std::string const& mask_root, float const weight);
+    void set_layer_weight(u32 const index, float const weight);
+    void clear_layers();
 
     std::string model_path = "./res/models/enemy/enemy.gltf";
     std::string anim_path = "./res/models/enemy/AS_Walking.gltf";
@@ -67,7 +72,10 @@ public:
     std::vector<glm::mat4> skinning_matrices = {};
 
     NON_SERIALIZED
-    Animation animation = {};
+    std::shared_ptr<Animation const> animation = nullptr;
+
+    NON_SERIALIZED
+    AnimationPlayback playback = {};
 
 protected:
     explicit SkinnedModel(std::shared_ptr<Material> const& material);
@@ -76,11 +84,13 @@ protected:
     std::vector<std::shared_ptr<Mesh>> m_meshes = {};
 
 private:
-    void load_model(std::string const& path, SkinningLoadMode const& load_mode);
+    void load_model(std::string const& path);
+    bool load_cooked_model(std::string const& path);
     void process_node(aiNode const* node);
     std::shared_ptr<Mesh> proccess_mesh(aiMesh const* mesh);
     std::vector<std::shared_ptr<Texture>> load_material_textures(aiMaterial const* material, aiTextureType type,
                                                                  TextureType const type_name);
+    std::shared_ptr<Texture> load_material_texture(std::string const& relative_path, TextureType const type);
     // void extract_bone_data(aiNode const* node, SkinningLoadMode mode);
     // void extract_bone_data_from_mesh(aiMesh const* mesh, SkinningLoadMode mode);
 
@@ -89,14 +99,46 @@ private:
     void set_vertex_bone_data_to_default(Vertex& vertex);
 
     void initialize_animation();
-    void read_hierarchy_data(AssimpNodeData& dest, aiNode const* src);
-    void read_missing_bones(aiAnimation const* assimp_animation);
-    Bone* find_bone(std::string const& name);
+
+    // Switches the base layer to an already loaded clip. Doesn't load anything, so it's safe on the animation workers.
+    void start_crossfade(std::shared_ptr<Animation const> const& clip, float const duration);
+    void update_local_bounds();
+    void evaluate_pose(std::vector<glm::mat4>& palette, u32 const max_joint_depth);
+    float get_crossfade_weight() const;
+    void blend_palettes(float const alpha);
 
     aiScene const* m_scene = nullptr;
-    std::map<std::string, BoneInfo> m_bone_info_map = {};
+    ModelSkin m_skin = {};
     u32 m_bone_counter = 0;
 
+    // Clip the base layer is playing, starts as animation and changes with crossfade_to(). animation keeps owning the rig.
+    std::shared_ptr<Animation const> m_clip = nullptr;
+    std::vector<i32> m_clip_channels = {};
+
+    // Clip being faded out, animation is nullptr when no crossfade is running.
+    AnimationLayer m_fade_out = {};
+    float m_fade_time = 0.0f;
+    float m_fade_duration = 0.0f;
+
+    // Crossfade requested while one was running, nullptr if none. Loaded by crossfade_to() on the caller's thread.
+    std::shared_ptr<Animation const> m_queued_clip = nullptr;
+    float m_queued_fade_duration = 0.0f;
+
+    std::vector<AnimationLayer> m_layers = {};
+
+    // Model space bounds of the meshes in every pose the playing clips can reach.
+    BoundingBox m_local_bounds = {};
+
+    // Scratch buffers, sized once in initialize_animation() so evaluation doesn't allocate.
+    Pose m_pose = {};
+    Pose m_layer_pose = {};
+    std::vector<glm::mat4> m_model_space_transforms = {};
+
+    // Last two pose evaluations of a Reduced model, skinning_matrices is blended between them every frame.
+    std::vector<glm::mat4> m_previous_palette = {};
+    std::vector<glm::mat4> m_next_palette = {};
+    bool m_has_reduced_palettes = false;
+
     std::string m_directory = "";
     std::vector<std::shared_ptr<Texture>> m_loaded_textures = {};
 };
@@ -7,6 +7,7 @@
 #include "SkyboxFactory.h"
 #include "TextureLoaderDX11.h"
 #include "VertexBufferDX11.h"
+#include "VertexPacking.h"
 
 SkyboxDX11::SkyboxDX11(AK::Badge<SkyboxFactory>, std::shared_ptr<Material> const& material, std::string const& path)
     : Skybox(material, path)
@@ -39,11 +40,11 @@ void SkyboxDX11::draw() const
 
     bind_texture();
 
-    auto const device_context = RendererDX11::get_instance_dx11()->get_device_context();
+    auto const renderer = RendererDX11::get_instance_dx11();
+    auto const device_context = renderer->get_device_context();
 
-    u32 constexpr offset = 0;
     device_context->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-    device_context->IASetVertexBuffers(0, 1, m_vertex_buffer->get_address_of(), m_vertex_buffer->stride_ptr(), &offset);
+    renderer->set_vertex_buffers(*m_vertex_buffer, nullptr);
     device_context->IASetIndexBuffer(m_index_buffer->get(), DXGI_FORMAT_R32_UINT, 0);
     device_context->DrawIndexed(m_index_buffer->buffer_size(), 0, 0);
 
@@ -94,7 +95,7 @@ void SkyboxDX11::create_cube()
         4, 5, 1, 1, 0, 4 // Bottom face
     };
 
-    std::vector<Vertex> vertices = {};
+    std::vector<StaticVertex> vertices = {};
     vertices.reserve(8);
 
     float constexpr size = 1.0f;
@@ -109,9 +110,9 @@ void SkyboxDX11::create_cube()
         vertex.position = corner;
         vertex.normal = glm::vec3(0.0f);
         vertex.texture_coordinates = glm::vec2(0.0f);
-        vertices.push_back(vertex);
+        vertices.push_back(VertexPacking::pack_static(vertex));
     }
 
-    m_vertex_buffer = std::make_shared<VertexBufferDX11>(device, vertices.data(), vertices.size());
+    m_vertex_buffer = std::make_shared<VertexBufferDX11>(device, vertices.data(), vertices.size(), sizeof(StaticVertex));
     m_index_buffer = std::make_shared<IndexBufferDX11>(device, indices.data(), indices.size());
 }
@@ -0,0 +1,95 @@
+#include "SoundFileSystem.h"
+
+#include "VirtualFileSystem.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+// A view of the whole file plus the read position, miniaudio's resource manager streams or decodes from it.
+struct OpenFile
+{
+    FileView file = {};
+    size_t cursor = 0;
+};
+
+ma_result on_open(ma_vfs*, char const* path, ma_uint32 const open_mode, ma_vfs_file* file)
+{
+    if ((open_mode & MA_OPEN_MODE_WRITE) != 0)
+        return MA_INVALID_OPERATION;
+
+    FileView view = VirtualFileSystem::read(path);
+
+    if (!view.is_valid())
+        return MA_DOES_NOT_EXIST;
+
+    *file = new OpenFile {std::move(view), 0};
+
+    return MA_SUCCESS;
+}
+
+ma_result on_close(ma_vfs*, ma_vfs_file const file)
+{
+    delete static_cast<OpenFile*>(file);
+
+    return MA_SUCCESS;
+}
+
+ma_result on_read(ma_vfs*, ma_vfs_file const file, void* destination, size_t const size, size_t* bytes_read)
+{
+    auto* open_file = static_cast<OpenFile*>(file);
+    size_t const read_size = std::min(size, open_file->file.get_size() - open_file->cursor);
+
+    std::memcpy(destination, open_file->file.get_bytes() + open_file->cursor, read_size);
+    open_file->cursor += read_size;
+
+    if (bytes_read != nullptr)
+        *bytes_read = read_size;
+
+    return read_size == 0 && size > 0 ? MA_AT_END : MA_SUCCESS;
+}
+
+ma_result on_seek(ma_vfs*, ma_vfs_file const file, ma_int64 const offset, ma_seek_origin const origin)
+{
+    auto* open_file = static_cast<OpenFile*>(file);
+
+    ma_int64 base = 0;
+    if (origin == ma_seek_origin_current)
+        base = static_cast<ma_int64>(open_file->cursor);
+    else if (origin == ma_seek_origin_end)
+        base = static_cast<ma_int64>(open_file->file.get_size());
+
+    ma_int64 const cursor = base + offset;
+
+    if (cursor < 0 || cursor > static_cast<ma_int64>(open_file->file.get_size()))
+        return MA_BAD_SEEK;
+
+    open_file->cursor = static_cast<size_t>(cursor);
+
+    return MA_SUCCESS;
+}
+
+ma_result on_tell(ma_vfs*, ma_vfs_file const file, ma_int64* cursor)
+{
+    *cursor = static_cast<ma_int64>(static_cast<OpenFile*>(file)->cursor);
+
+    return MA_SUCCESS;
+}
+
+ma_result on_info(ma_vfs*, ma_vfs_file const file, ma_file_info* info)
+{
+    info->sizeInBytes = static_cast<OpenFile*>(file)->file.get_size();
+
+    return MA_SUCCESS;
+}
+
+ma_vfs_callbacks vfs_callbacks = {on_open, nullptr, on_close, on_read, nullptr, on_seek, on_tell, on_info};
+
+}
+
+ma_vfs* SoundFileSystem::get_vfs()
+{
+    return &vfs_callbacks;
+}
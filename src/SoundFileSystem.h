@@ -0,0 +1,13 @@
+#pragma once
+
+#include <miniaudio.h>
+
+// miniaudio VFS that reads sound files through VirtualFileSystem, so ma_sound_init_from_file() works with packed sounds.
+// Passed to the audio engine in Engine::initialize_miniaudio().
+class SoundFileSystem
+{
+public:
+    SoundFileSystem() = delete;
+
+    static ma_vfs* get_vfs();
+};
@@ -34,7 +34,7 @@ void Sphere::initialize()
 
 Sphere::Sphere(AK::Badge<Sphere>, std::shared_ptr<Material> const& material) : Model(material)
 {
-    m_draw_type = DrawType::TriangleStrip;
+    m_draw_type = use_geometry_shader ? DrawType::TriangleStrip : DrawType::Triangles;
     Sphere::prepare();
 }
 
@@ -42,7 +42,7 @@ Sphere::Sphere(AK::Badge<Sphere>, float const radius, u32 const sectors, u32 con
                std::shared_ptr<Material> const& material)
     : Model(material), sector_count(sectors), stack_count(stacks), texture_path(std::move(texture_path)), radius(radius)
 {
-    m_draw_type = DrawType::TriangleStrip;
+    m_draw_type = use_geometry_shader ? DrawType::TriangleStrip : DrawType::Triangles;
     Sphere::prepare();
 }
 
@@ -85,7 +85,7 @@ std::shared_ptr<Mesh> Sphere::create_sphere() const
 
         if (!texture_path.empty())
         {
-            std::vector diffuse_maps = {ResourceManager::get_instance().load_texture(texture_path, TextureType::Diffuse)};
+            std::vector diffuse_maps = {ResourceManager::get_instance().load_texture_async(texture_path, TextureType::Diffuse)};
             textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
         }
 
@@ -118,36 +118,33 @@ std::shared_ptr<Mesh> Sphere::create_sphere() const
         }
     }
 
-    bool odd_row = false;
-    for (u32 y = 0; y < sector_count; ++y)
+    // A triangle list instead of a strip, so the sphere can be simplified into levels of detail.
+    for (u32 x = 0; x < stack_count; ++x)
     {
-        if (!odd_row)
+        for (u32 y = 0; y < sector_count; ++y)
         {
-            for (u32 x = 0; x <= stack_count; ++x)
-            {
-                indices.push_back(y * (stack_count + 1) + x);
-                indices.push_back((y + 1) * (stack_count + 1) + x);
-            }
-        }
-        else
-        {
-            for (i32 x = stack_count; x >= 0; --x)
-            {
-                indices.push_back((y + 1) * (stack_count + 1) + x);
-                indices.push_back(y * (stack_count + 1) + x);
-            }
-        }
+            u32 const a0 = x * (sector_count + 1) + y;
+            u32 const a1 = a0 + 1;
+            u32 const b0 = (x + 1) * (sector_count + 1) + y;
+            u32 const b1 = b0 + 1;
 
-        odd_row = !odd_row;
+            // The first and the last row meet in a single point at the poles.
+            if (y != 0)
+                indices.insert(indices.end(), {a0, b0, a1});
+
+            if (y != sector_count - 1)
+                indices.insert(indices.end(), {a1, b0, b1});
+        }
     }
 
     if (!texture_path.empty())
     {
-        std::vector diffuse_maps = {ResourceManager::get_instance().load_texture(texture_path, TextureType::Diffuse)};
+        std::vector diffuse_maps = {ResourceManager::get_instance().load_texture_async(texture_path, TextureType::Diffuse)};
         textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
     }
 
     std::stringstream stream;
     stream << std::to_string(stack_count) << "|" << std::to_string(sector_count) << "SPHERE";
-    return ResourceManager::get_instance().load_mesh(m_meshes.size(), stream.str(), vertices, indices, textures, m_draw_type, material);
+    return ResourceManager::get_instance().load_mesh(m_meshes.size(), stream.str(), vertices, indices, textures, m_draw_type, material,
+                                                     DrawFunctionType::Indexed, true);
 }
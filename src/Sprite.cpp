@@ -74,7 +74,7 @@ std::shared_ptr<Mesh> Sprite::create_sprite() const
 
     if (!diffuse_texture_path.empty())
         diffuse_maps.emplace_back(
-            ResourceManager::get_instance().load_texture(diffuse_texture_path, TextureType::Diffuse, texture_settings));
+            ResourceManager::get_instance().load_texture_async(diffuse_texture_path, TextureType::Diffuse, texture_settings));
 
     textures.insert(textures.end(), diffuse_maps.begin(), diffuse_maps.end());
 
@@ -1,10 +1,10 @@
 #include "Terrain.h"
 
 #include <iostream>
-#include <stb_image.h>
 
 #include "MeshFactory.h"
 #include "ResourceManager.h"
+#include "TextureLoader.h"
 
 std::shared_ptr<Terrain> Terrain::create(std::shared_ptr<Material> const& material, bool const use_gpu, std::string const& height_map_path)
 {
@@ -140,18 +140,19 @@ std::shared_ptr<Mesh> Terrain::create_terrain_from_height_map_gpu() const
 
 std::shared_ptr<Mesh> Terrain::create_terrain_from_height_map()
 {
-    stbi_set_flip_vertically_on_load(true);
+    ImageData const image = TextureLoader::decode_image(m_height_map_path, true, 0);
 
-    i32 width, height, number_of_components;
-    unsigned char* data = stbi_load(m_height_map_path.c_str(), &width, &height, &number_of_components, 0);
-
-    if (data == nullptr)
+    if (image.pixels == nullptr)
     {
         std::cout << "Height map failed to load at path: " << m_height_map_path << '\n';
-        stbi_image_free(data);
         return ResourceManager::get_instance().load_mesh(m_meshes.size(), m_height_map_path, {}, {}, {}, m_draw_type, material);
     }
 
+    i32 const width = image.width;
+    i32 const height = image.height;
+    i32 const number_of_components = image.number_of_components;
+    u8 const* data = image.pixels.get();
+
     std::vector<Vertex> vertices = {};
     vertices.reserve(height * width);
 
@@ -171,8 +172,6 @@ std::shared_ptr<Mesh> Terrain::create_terrain_from_height_map()
         }
     }
 
-    stbi_image_free(data);
-
     std::vector<u32> indices = {};
     indices.reserve((height - 1) * width * 2);
     for (u32 i = 0; i < height - 1; ++i)
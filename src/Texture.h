@@ -59,4 +59,10 @@ struct Texture
     ID3D11SamplerState* image_sampler_state = nullptr;
 
     std::string path = {};
+
+    // False while the image is still being decoded by ResourceManager::load_texture_async(), a 1x1 white placeholder is bound until then.
+    bool is_loaded = true;
+
+    // 6 for cubemaps.
+    u32 layer_count = 1;
 };
@@ -0,0 +1,139 @@
+#include "TextureDecodeQueue.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <iostream>
+
+TextureDecodeQueue::TextureDecodeQueue(u32 const thread_count)
+{
+    m_workers.reserve(thread_count);
+
+    for (u32 i = 0; i < thread_count; ++i)
+        m_workers.emplace_back(&TextureDecodeQueue::worker_loop, this);
+}
+
+TextureDecodeQueue::~TextureDecodeQueue()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_is_stopping = true;
+    }
+
+    m_request_condition.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+void TextureDecodeQueue::push(Request const& request)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_requests.emplace_back(request);
+        m_in_flight += 1;
+    }
+
+    m_request_condition.notify_one();
+}
+
+bool TextureDecodeQueue::pop_finished(Result& result)
+{
+    std::lock_guard lock(m_mutex);
+
+    if (m_results.empty())
+        return false;
+
+    result = std::move(m_results.front());
+    m_results.pop_front();
+    m_in_flight -= 1;
+    return true;
+}
+
+void TextureDecodeQueue::wait_for_finished()
+{
+    std::unique_lock lock(m_mutex);
+    m_finished_condition.wait(lock, [this] { return !m_results.empty() || m_in_flight == 0; });
+}
+
+u32 TextureDecodeQueue::get_in_flight_count()
+{
+    std::lock_guard lock(m_mutex);
+    return m_in_flight;
+}
+
+void TextureDecodeQueue::worker_loop()
+{
+    while (true)
+    {
+        Request request = {};
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_request_condition.wait(lock, [this] { return m_is_stopping || !m_requests.empty(); });
+
+            if (m_is_stopping)
+                return;
+
+            request = std::move(m_requests.front());
+            m_requests.pop_front();
+        }
+
+        Result result = {};
+        result.image = TextureLoader::decode_image(request.texture->path, request.settings.flip_vertically, request.desired_channels);
+        result.texture = std::move(request.texture);
+        result.settings = request.settings;
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_results.emplace_back(std::move(result));
+        }
+
+        m_finished_condition.notify_all();
+    }
+}
+
+void TextureDecodeQueue::run_benchmark(std::string const& directory, u32 const thread_count)
+{
+    std::vector<std::string> paths;
+    for (auto const& entry : std::filesystem::recursive_directory_iterator(directory))
+    {
+        auto const extension = entry.path().extension().string();
+        if (entry.is_regular_file() && (extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga"))
+            paths.emplace_back(entry.path().string());
+    }
+
+    std::atomic<u32> next_path = 0;
+    std::atomic<u64> decoded_bytes = 0;
+    std::atomic<u32> decoded_images = 0;
+
+    // No glfwGetTime() here, the benchmark runs before GLFW is initialized.
+    auto const start = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> workers;
+    for (u32 i = 0; i < std::max(thread_count, 1u); ++i)
+    {
+        workers.emplace_back([&] {
+            for (u32 index = next_path++; index < paths.size(); index = next_path++)
+            {
+                ImageData const image = TextureLoader::decode_image(paths[index], true, 4);
+                if (image.pixels == nullptr)
+                    continue;
+
+                decoded_bytes += static_cast<u64>(image.width) * image.height * image.number_of_components;
+                decoded_images += 1;
+            }
+        });
+    }
+
+    for (auto& worker : workers)
+        worker.join();
+
+    double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::format("Decoded {} of {} images ({:.1f} MB) with {} threads in {:.1f} ms: {:.1f} images/s, {:.1f} MB/s\n",
+                             decoded_images.load(), paths.size(), decoded_bytes.load() / (1024.0 * 1024.0), thread_count,
+                             seconds * 1000.0, decoded_images.load() / seconds, decoded_bytes.load() / (1024.0 * 1024.0) / seconds);
+}
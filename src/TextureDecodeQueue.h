@@ -0,0 +1,61 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "TextureLoader.h"
+
+// Decodes texture files on a pool of worker threads. GPU resources are never touched here,
+// finished images are handed back to the main thread through pop_finished().
+class TextureDecodeQueue
+{
+public:
+    struct Request
+    {
+        std::shared_ptr<Texture> texture = nullptr;
+        TextureSettings settings = {};
+        i32 desired_channels = 0;
+    };
+
+    struct Result
+    {
+        std::shared_ptr<Texture> texture = nullptr;
+        TextureSettings settings = {};
+        ImageData image = {};
+    };
+
+    explicit TextureDecodeQueue(u32 const thread_count);
+    ~TextureDecodeQueue();
+
+    TextureDecodeQueue(TextureDecodeQueue const&) = delete;
+    void operator=(TextureDecodeQueue const&) = delete;
+
+    void push(Request const& request);
+    bool pop_finished(Result& result);
+
+    // Blocks until at least one decode finishes or nothing is left in flight.
+    void wait_for_finished();
+
+    [[nodiscard]] u32 get_in_flight_count();
+
+    // Decodes every image under directory with thread_count threads and prints the throughput. Doesn't need a window or a renderer.
+    static void run_benchmark(std::string const& directory, u32 const thread_count);
+
+private:
+    void worker_loop();
+
+    std::vector<std::thread> m_workers = {};
+
+    std::mutex m_mutex = {};
+    std::condition_variable m_request_condition = {};
+    std::condition_variable m_finished_condition = {};
+    std::deque<Request> m_requests = {};
+    std::deque<Result> m_results = {};
+    u32 m_in_flight = 0;
+    bool m_is_stopping = false;
+};
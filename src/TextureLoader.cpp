@@ -1,6 +1,11 @@
 #include "TextureLoader.h"
 
+#include "VirtualFileSystem.h"
+
 #include <cassert>
+#include <cstring>
+#include <iostream>
+#include <stb_image.h>
 
 std::shared_ptr<Texture> TextureLoader::load_texture(std::string const& path, TextureType const type, TextureSettings const& settings)
 {
@@ -17,14 +22,99 @@ std::shared_ptr<Texture> TextureLoader::load_cubemap(std::vector<std::string> co
 
     auto const [id, width, height, number_of_components, texture_2d, shader_resource_view, image_sampler_state] =
         cubemap_from_files(paths, settings);
-    return std::make_shared<Texture>(id, width, height, number_of_components, type, texture_2d, shader_resource_view, image_sampler_state,
-                                     paths[0]);
+    auto texture = std::make_shared<Texture>(id, width, height, number_of_components, type, texture_2d, shader_resource_view,
+                                             image_sampler_state, paths[0]);
+    texture->layer_count = 6;
+    return texture;
 }
 
 std::shared_ptr<Texture> TextureLoader::load_cubemap(std::string const& path, TextureType const type, TextureSettings const& settings)
 {
     auto const [id, width, height, number_of_components, texture_2d, shader_resource_view, image_sampler_state] =
         cubemap_from_file(path, settings);
-    return std::make_shared<Texture>(id, width, height, number_of_components, type, texture_2d, shader_resource_view, image_sampler_state,
-                                     path);
+    auto texture = std::make_shared<Texture>(id, width, height, number_of_components, type, texture_2d, shader_resource_view,
+                                             image_sampler_state, path);
+    texture->layer_count = 6;
+    return texture;
+}
+
+ImageData TextureLoader::decode_image(std::string const& path, bool const flip_vertically, i32 const desired_channels)
+{
+    // stbi_set_flip_vertically_on_load() is global state in our stb_image version, so it's never called, every load flips here.
+    ImageData image = {};
+    FileView const file = VirtualFileSystem::read(path);
+    u8* data = nullptr;
+
+    if (file.is_valid())
+    {
+        data = stbi_load_from_memory(file.get_bytes(), static_cast<i32>(file.get_size()), &image.width, &image.height,
+                                     &image.number_of_components, desired_channels);
+    }
+
+    if (data == nullptr)
+    {
+        std::cout << "Texture failed to load at path: " << path << '\n';
+        return {};
+    }
+
+    if (desired_channels != 0)
+        image.number_of_components = desired_channels;
+
+    image.pixels = std::shared_ptr<u8>(data, stbi_image_free);
+
+    if (flip_vertically)
+    {
+        size_t const row_size = static_cast<size_t>(image.width) * image.number_of_components;
+        std::vector<u8> row(row_size);
+
+        for (i32 top = 0, bottom = image.height - 1; top < bottom; ++top, --bottom)
+        {
+            u8* top_row = data + top * row_size;
+            u8* bottom_row = data + bottom * row_size;
+            std::memcpy(row.data(), top_row, row_size);
+            std::memcpy(top_row, bottom_row, row_size);
+            std::memcpy(bottom_row, row.data(), row_size);
+        }
+    }
+
+    return image;
+}
+
+std::shared_ptr<Texture> TextureLoader::load_placeholder(std::string const& path, TextureType const type)
+{
+    i32 const channels = get_decode_channels() == 0 ? 4 : get_decode_channels();
+
+    ImageData white_pixel = {};
+    white_pixel.width = 1;
+    white_pixel.height = 1;
+    white_pixel.number_of_components = channels;
+    white_pixel.pixels = std::shared_ptr<u8>(new u8[channels], std::default_delete<u8[]>());
+    std::memset(white_pixel.pixels.get(), 255, channels);
+
+    auto const [id, width, height, number_of_components, texture_2d, shader_resource_view, image_sampler_state] =
+        texture_from_image(white_pixel, {});
+    auto texture = std::make_shared<Texture>(id, width, height, number_of_components, type, texture_2d, shader_resource_view,
+                                             image_sampler_state, path);
+    texture->is_loaded = false;
+    return texture;
+}
+
+void TextureLoader::finalize_texture(Texture& texture, ImageData const& image, TextureSettings const& settings)
+{
+    // Failed decodes keep the placeholder, the error has already been reported by decode_image().
+    if (image.pixels != nullptr)
+    {
+        TextureData const texture_data = texture_from_image(image, settings);
+        release_texture(texture);
+
+        texture.id = texture_data.id;
+        texture.width = texture_data.width;
+        texture.height = texture_data.height;
+        texture.number_of_components = texture_data.number_of_components;
+        texture.texture_2d = texture_data.texture_2d;
+        texture.shader_resource_view = texture_data.shader_resource_view;
+        texture.image_sampler_state = texture_data.image_sampler_state;
+    }
+
+    texture.is_loaded = true;
 }
@@ -8,6 +8,15 @@
 
 class ResourceManager;
 
+// Decoded pixels, not yet uploaded to the GPU.
+struct ImageData
+{
+    std::shared_ptr<u8> pixels = nullptr;
+    i32 width = 0;
+    i32 height = 0;
+    i32 number_of_components = 0;
+};
+
 struct TextureData
 {
     u32 id = 0;
@@ -29,6 +38,12 @@ public:
         return m_instance;
     }
 
+    // CPU only, so it's safe to call from worker threads. desired_channels of 0 keeps the file's channel count.
+    [[nodiscard]] static ImageData decode_image(std::string const& path, bool const flip_vertically, i32 const desired_channels);
+
+    // Channel count the renderer's texture_from_image() expects decode_image() to produce.
+    [[nodiscard]] virtual i32 get_decode_channels() const = 0;
+
 protected:
     static void set_instance(std::shared_ptr<TextureLoader> const& texture_loader)
     {
@@ -45,9 +60,14 @@ private:
     [[nodiscard]] std::shared_ptr<Texture> load_cubemap(std::string const& path, TextureType const type,
                                                         TextureSettings const& settings = {});
 
+    [[nodiscard]] std::shared_ptr<Texture> load_placeholder(std::string const& path, TextureType const type);
+    void finalize_texture(Texture& texture, ImageData const& image, TextureSettings const& settings);
+
     TextureData virtual texture_from_file(std::string const& path, TextureSettings const settings) = 0;
     TextureData virtual cubemap_from_files(std::vector<std::string> const& paths, TextureSettings const settings) = 0;
     TextureData virtual cubemap_from_file(std::string const& path, TextureSettings const settings) = 0;
+    TextureData virtual texture_from_image(ImageData const& image, TextureSettings const settings) = 0;
+    void virtual release_texture(Texture const& texture) = 0;
 
     friend class ResourceManager;
 };
@@ -3,7 +3,6 @@
 #include <DDSTextureLoader11.h>
 #include <codecvt>
 #include <d3d11.h>
-#include <stb_image.h>
 
 #include "RendererDX11.h"
 
@@ -16,16 +15,20 @@ std::shared_ptr<TextureLoaderDX11> TextureLoaderDX11::create()
 
 TextureData TextureLoaderDX11::texture_from_file(std::string const& path, TextureSettings const settings)
 {
-    auto const device = RendererDX11::get_instance_dx11()->get_device();
-    stbi_set_flip_vertically_on_load(settings.flip_vertically);
+    ImageData const image = decode_image(path, settings.flip_vertically, get_decode_channels());
 
-    i32 image_width;
-    i32 image_height;
-    i32 image_channels;
-    i32 constexpr image_desired_channels = 4;
-    u8* image_data = stbi_load(path.c_str(), &image_width, &image_height, &image_channels, image_desired_channels);
+    assert(image.pixels != nullptr);
 
-    assert(image_data);
+    return texture_from_image(image, settings);
+}
+
+TextureData TextureLoaderDX11::texture_from_image(ImageData const& image, TextureSettings const settings)
+{
+    auto const device = RendererDX11::get_instance_dx11()->get_device();
+
+    i32 const image_width = image.width;
+    i32 const image_height = image.height;
+    i32 const image_desired_channels = image.number_of_components;
 
     // Originally it was ImageWidth * 4, but if I understand it correctly, it's image width * number of channels
     // "SysMemPitch: The distance (in bytes) from the beginning of one line of a texture to the next line" - via microsoft
@@ -43,7 +46,7 @@ TextureData TextureLoaderDX11::texture_from_file(std::string const& path, Textur
     image_texture_desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
 
     D3D11_SUBRESOURCE_DATA image_subresource_data = {};
-    image_subresource_data.pSysMem = image_data;
+    image_subresource_data.pSysMem = image.pixels.get();
     image_subresource_data.SysMemPitch = image_pitch;
 
     ID3D11Texture2D* image_texture = nullptr;
@@ -51,7 +54,6 @@ TextureData TextureLoaderDX11::texture_from_file(std::string const& path, Textur
 
     assert(SUCCEEDED(hr));
 
-    free(image_data);
     ID3D11ShaderResourceView* texture_resource = nullptr;
     hr = device->CreateShaderResourceView(image_texture, nullptr, &texture_resource);
 
@@ -138,6 +140,24 @@ TextureData TextureLoaderDX11::cubemap_from_file(std::string const& path, Textur
     return texture_data;
 }
 
+void TextureLoaderDX11::release_texture(Texture const& texture)
+{
+    if (texture.image_sampler_state != nullptr)
+        texture.image_sampler_state->Release();
+
+    if (texture.shader_resource_view != nullptr)
+        texture.shader_resource_view->Release();
+
+    if (texture.texture_2d != nullptr)
+        texture.texture_2d->Release();
+}
+
+i32 TextureLoaderDX11::get_decode_channels() const
+{
+    // Everything is uploaded as R8G8B8A8.
+    return 4;
+}
+
 D3D11_TEXTURE_ADDRESS_MODE TextureLoaderDX11::convert_wrap_mode(TextureWrapMode const wrap_mode)
 {
     switch (wrap_mode)
@@ -9,10 +9,14 @@ class TextureLoaderDX11 final : public TextureLoader
 public:
     static std::shared_ptr<TextureLoaderDX11> create();
 
+    [[nodiscard]] virtual i32 get_decode_channels() const override;
+
 private:
     virtual TextureData texture_from_file(std::string const& path, TextureSettings const settings) override;
     virtual TextureData cubemap_from_files(std::vector<std::string> const& paths, TextureSettings const settings) override;
     virtual TextureData cubemap_from_file(std::string const& path, TextureSettings const settings) override;
+    virtual TextureData texture_from_image(ImageData const& image, TextureSettings const settings) override;
+    virtual void release_texture(Texture const& texture) override;
 
     static D3D11_TEXTURE_ADDRESS_MODE convert_wrap_mode(TextureWrapMode const wrap_mode);
     static D3D11_FILTER convert_filtering_mode(TextureFiltering const texture_filtering_min, TextureFiltering const texture_filtering_mag,
@@ -1,7 +1,6 @@
 #include "TextureLoaderGL.h"
 
 #include <iostream>
-#include <stb_image.h>
 
 std::shared_ptr<TextureLoaderGL> TextureLoaderGL::create()
 {
@@ -12,20 +11,23 @@ std::shared_ptr<TextureLoaderGL> TextureLoaderGL::create()
 
 TextureData TextureLoaderGL::texture_from_file(std::string const& path, TextureSettings const settings)
 {
-    u32 texture_id;
-    glGenTextures(1, &texture_id);
+    ImageData const image = decode_image(path, settings.flip_vertically, get_decode_channels());
 
-    stbi_set_flip_vertically_on_load(settings.flip_vertically);
+    if (image.pixels == nullptr)
+        return {};
 
-    i32 width, height, number_of_components;
-    unsigned char* data = stbi_load(path.c_str(), &width, &height, &number_of_components, 0);
+    return texture_from_image(image, settings);
+}
 
-    if (data == nullptr)
-    {
-        std::cout << "Texture failed to load at path: " << path << '\n';
-        stbi_image_free(data);
-        return {};
-    }
+TextureData TextureLoaderGL::texture_from_image(ImageData const& image, TextureSettings const settings)
+{
+    u32 texture_id;
+    glGenTextures(1, &texture_id);
+
+    i32 const width = image.width;
+    i32 const height = image.height;
+    i32 const number_of_components = image.number_of_components;
+    u8 const* data = image.pixels.get();
 
     GLint format;
     if (number_of_components == 1)
@@ -70,7 +72,6 @@ TextureData TextureLoaderGL::texture_from_file(std::string const& path, TextureS
 
     glBindTexture(GL_TEXTURE_2D, 0);
 
-    stbi_image_free(data);
     return {texture_id, static_cast<u32>(width), static_cast<u32>(height), static_cast<u32>(number_of_components)};
 }
 
@@ -79,8 +80,6 @@ TextureData TextureLoaderGL::cubemap_from_files(std::vector<std::string> const&
     u32 texture_id;
     glGenTextures(1, &texture_id);
 
-    stbi_set_flip_vertically_on_load(settings.flip_vertically);
-
     glBindTexture(GL_TEXTURE_CUBE_MAP, texture_id);
 
     i32 width = 0;
@@ -89,18 +88,19 @@ TextureData TextureLoaderGL::cubemap_from_files(std::vector<std::string> const&
 
     for (u32 i = 0; i < paths.size(); ++i)
     {
-        u8* data = stbi_load(paths[i].c_str(), &width, &height, &channel_count, 0);
+        ImageData const image = decode_image(paths[i], settings.flip_vertically, 0);
 
-        if (data != nullptr)
+        if (image.pixels != nullptr)
         {
-            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, data);
+            width = image.width;
+            height = image.height;
+            channel_count = image.number_of_components;
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE, image.pixels.get());
         }
         else
         {
             std::cout << "Cubemap texture failed to load at path: " << paths[i] << "\n";
         }
-
-        stbi_image_free(data);
     }
 
     glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, convert_filtering_mode(settings.filtering_min, settings.filtering_mipmap));
@@ -119,6 +119,17 @@ TextureData TextureLoaderGL::cubemap_from_file(std::string const& path, TextureS
     return {};
 }
 
+void TextureLoaderGL::release_texture(Texture const& texture)
+{
+    if (texture.id != 0)
+        glDeleteTextures(1, &texture.id);
+}
+
+i32 TextureLoaderGL::get_decode_channels() const
+{
+    return 0;
+}
+
 GLint TextureLoaderGL::convert_wrap_mode(TextureWrapMode const wrap_mode)
 {
     switch (wrap_mode)
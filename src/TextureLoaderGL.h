@@ -9,10 +9,14 @@ class TextureLoaderGL final : public TextureLoader
 public:
     static std::shared_ptr<TextureLoaderGL> create();
 
+    [[nodiscard]] virtual i32 get_decode_channels() const override;
+
 private:
     virtual TextureData texture_from_file(std::string const& path, TextureSettings const settings) override;
     virtual TextureData cubemap_from_files(std::vector<std::string> const& paths, TextureSettings const settings) override;
     virtual TextureData cubemap_from_file(std::string const& path, TextureSettings const settings) override;
+    virtual TextureData texture_from_image(ImageData const& image, TextureSettings const settings) override;
+    virtual void release_texture(Texture const& texture) override;
 
     static GLint convert_wrap_mode(TextureWrapMode const wrap_mode);
     static GLint convert_filtering_mode(TextureFiltering const texture_filtering, TextureFiltering const mipmap_filtering);
@@ -0,0 +1,81 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <utility>
+
+ThreadPool::ThreadPool(u32 const thread_count)
+{
+    m_workers.reserve(thread_count);
+
+    for (u32 i = 0; i < thread_count; ++i)
+        m_workers.emplace_back(&ThreadPool::worker_loop, this);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_is_stopping = true;
+    }
+
+    m_job_condition.notify_all();
+
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+void ThreadPool::submit(std::function<void()> job)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_jobs.emplace_back(std::move(job));
+        m_in_flight += 1;
+    }
+
+    m_job_condition.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock lock(m_mutex);
+    m_idle_condition.wait(lock, [this] { return m_in_flight == 0; });
+}
+
+u32 ThreadPool::get_thread_count() const
+{
+    return static_cast<u32>(m_workers.size());
+}
+
+u32 ThreadPool::get_default_thread_count()
+{
+    return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+}
+
+void ThreadPool::worker_loop()
+{
+    while (true)
+    {
+        std::function<void()> job = {};
+
+        {
+            std::unique_lock lock(m_mutex);
+            m_job_condition.wait(lock, [this] { return m_is_stopping || !m_jobs.empty(); });
+
+            // Jobs still queued on shutdown are dropped.
+            if (m_is_stopping)
+                return;
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop_front();
+        }
+
+        job();
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_in_flight -= 1;
+        }
+
+        m_idle_condition.notify_all();
+    }
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "AK/Types.h"
+
+// Runs jobs on a fixed set of worker threads, in the order they were submitted.
+// Jobs must not touch the renderer or the scene, hand results back to the main thread instead.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(u32 const thread_count);
+    ~ThreadPool();
+
+    ThreadPool(ThreadPool const&) = delete;
+    void operator=(ThreadPool const&) = delete;
+
+    void submit(std::function<void()> job);
+
+    // Blocks until every submitted job has finished.
+    void wait();
+
+    [[nodiscard]] u32 get_thread_count() const;
+
+    // Leaves one core to the main thread.
+    static u32 get_default_thread_count();
+
+private:
+    void worker_loop();
+
+    std::vector<std::thread> m_workers = {};
+
+    std::mutex m_mutex = {};
+    std::condition_variable m_job_condition = {};
+    std::condition_variable m_idle_condition = {};
+    std::deque<std::function<void()>> m_jobs = {};
+    u32 m_in_flight = 0;
+    bool m_is_stopping = false;
+};
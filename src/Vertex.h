@@ -4,6 +4,9 @@
 #include "glm/vec3.hpp"
 #include "glm/vec4.hpp"
 
+#include "AK/Types.h"
+
+// Full precision vertex that meshes are built from. It is packed into the formats below before it reaches the GPU.
 struct Vertex
 {
     glm::vec3 position;
@@ -12,3 +15,25 @@ struct Vertex
     glm::ivec4 skin_indices = {-1, -1, -1, -1};
     glm::vec4 skin_weights = {0.0f, 0.0f, 0.0f, 0.0f};
 };
+
+enum class VertexLayout : u8
+{
+    Static,
+    Skinned,
+    Count,
+};
+
+// First vertex stream, used by every mesh. 20 bytes.
+struct StaticVertex
+{
+    glm::vec3 position;
+    u32 normal;              // Octahedral encoded, 2x snorm16
+    u32 texture_coordinates; // 2x half
+};
+
+// Second vertex stream, only skinned meshes have one. Unused influences have zero weight.
+struct SkinVertex
+{
+    u32 skin_indices; // 4x u8
+    u32 skin_weights; // 4x unorm8, sum up to 255
+};
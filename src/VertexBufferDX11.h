@@ -3,12 +3,11 @@
 #include <d3d11.h>
 
 #include "AK/Types.h"
-#include "Vertex.h"
 
 class VertexBufferDX11
 {
 public:
-    VertexBufferDX11(ID3D11Device* device, Vertex const* data, u32 const vertices_count);
+    VertexBufferDX11(ID3D11Device* device, void const* data, u32 const vertices_count, u32 const stride);
     VertexBufferDX11(VertexBufferDX11 const& rhs) = delete;
     VertexBufferDX11& operator=(VertexBufferDX11 const& rhs) = delete;
 
@@ -0,0 +1,95 @@
+#include "VertexPacking.h"
+
+#include <iostream>
+
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/gtc/packing.hpp>
+
+VertexLayout VertexPacking::pack(std::span<Vertex const> const vertices, std::vector<StaticVertex>& static_vertices,
+                                 std::vector<SkinVertex>& skin_vertices)
+{
+    static_vertices.resize(vertices.size());
+    skin_vertices.clear();
+
+    bool is_skinned = false;
+    for (u32 i = 0; i < vertices.size(); ++i)
+    {
+        static_vertices[i] = pack_static(vertices[i]);
+        is_skinned = is_skinned || vertices[i].skin_indices.x >= 0;
+    }
+
+    if (!is_skinned)
+        return VertexLayout::Static;
+
+    skin_vertices.resize(vertices.size());
+    for (u32 i = 0; i < vertices.size(); ++i)
+        skin_vertices[i] = pack_skin(vertices[i]);
+
+    return VertexLayout::Skinned;
+}
+
+StaticVertex VertexPacking::pack_static(Vertex const& vertex)
+{
+    return {vertex.position, encode_normal(vertex.normal), glm::packHalf2x16(vertex.texture_coordinates)};
+}
+
+SkinVertex VertexPacking::pack_skin(Vertex const& vertex)
+{
+    glm::vec4 weights = {};
+    glm::u8vec4 indices = {};
+
+    for (u32 i = 0; i < 4; ++i)
+    {
+        if (vertex.skin_indices[i] < 0)
+            continue;
+
+        if (vertex.skin_indices[i] > static_cast<i32>(max_skin_index))
+        {
+            std::cout << "Error. Bone index " << vertex.skin_indices[i] << " doesn't fit into a vertex, influence dropped.\n";
+            continue;
+        }
+
+        indices[i] = static_cast<u8>(vertex.skin_indices[i]);
+        weights[i] = glm::max(vertex.skin_weights[i], 0.0f);
+    }
+
+    float const weight_sum = weights.x + weights.y + weights.z + weights.w;
+    if (weight_sum <= 0.0f)
+        return {};
+
+    // Quantize the normalized weights and hand the rounding error to the largest one, so they always sum up to exactly one.
+    glm::u8vec4 quantized_weights = glm::u8vec4(glm::round(weights / weight_sum * 255.0f));
+    i32 const error = 255 - (quantized_weights.x + quantized_weights.y + quantized_weights.z + quantized_weights.w);
+
+    u32 largest = 0;
+    for (u32 i = 1; i < 4; ++i)
+    {
+        if (weights[i] > weights[largest])
+            largest = i;
+    }
+
+    quantized_weights[largest] = static_cast<u8>(quantized_weights[largest] + error);
+
+    return {glm::packUint4x8(indices), glm::packUint4x8(quantized_weights)};
+}
+
+u32 VertexPacking::encode_normal(glm::vec3 const& normal)
+{
+    // https://knarkowicz.wordpress.com/2014/04/16/octahedron-normal-vector-encoding/
+    float const length = glm::abs(normal.x) + glm::abs(normal.y) + glm::abs(normal.z);
+
+    if (length <= 0.0f)
+        return 0;
+
+    glm::vec3 const n = normal / length;
+    glm::vec2 encoded = glm::vec2(n.x, n.y);
+
+    if (n.z < 0.0f)
+    {
+        glm::vec2 const signs = glm::vec2(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+        encoded = (1.0f - glm::abs(glm::vec2(n.y, n.x))) * signs;
+    }
+
+    return glm::packSnorm2x16(encoded);
+}
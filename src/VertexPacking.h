@@ -0,0 +1,27 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "AK/Types.h"
+#include "Vertex.h"
+
+// Converts full precision vertices into the GPU vertex streams.
+class VertexPacking
+{
+public:
+    VertexPacking() = delete;
+
+    // Fills skin_vertices only if at least one vertex has a bone influence, the returned layout says which happened.
+    static VertexLayout pack(std::span<Vertex const> const vertices, std::vector<StaticVertex>& static_vertices,
+                             std::vector<SkinVertex>& skin_vertices);
+
+    [[nodiscard]] static StaticVertex pack_static(Vertex const& vertex);
+    [[nodiscard]] static SkinVertex pack_skin(Vertex const& vertex);
+
+    // Shaders decode it with decode_octahedral_normal().
+    [[nodiscard]] static u32 encode_normal(glm::vec3 const& normal);
+
+    // Bone indices are stored as u8.
+    static u32 constexpr max_skin_index = 255;
+};
@@ -0,0 +1,126 @@
+#include "VirtualFileSystem.h"
+
+#include "AssetPack.h"
+#include "EngineDefines.h"
+#include "MemoryMappedFile.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iostream>
+#include <utility>
+
+FileView::FileView(std::span<std::byte const> const data, std::shared_ptr<void const> owner) : m_data(data), m_owner(std::move(owner))
+{
+}
+
+bool FileView::is_valid() const
+{
+    return m_owner != nullptr;
+}
+
+std::span<std::byte const> FileView::get_data() const
+{
+    return m_data;
+}
+
+u8 const* FileView::get_bytes() const
+{
+    return reinterpret_cast<u8 const*>(m_data.data());
+}
+
+size_t FileView::get_size() const
+{
+    return m_data.size();
+}
+
+std::string_view FileView::get_text() const
+{
+    return {reinterpret_cast<char const*>(m_data.data()), m_data.size()};
+}
+
+bool VirtualFileSystem::mount(std::string const& pack_path)
+{
+    std::error_code error;
+    if (!std::filesystem::exists(pack_path, error))
+        return false;
+
+    auto const pack = AssetPack::open(pack_path);
+
+    if (pack == nullptr)
+    {
+        std::cout << "Error. Asset pack could not be mounted, reading loose files instead: " << pack_path << "\n";
+        return false;
+    }
+
+    m_pack = pack;
+
+    std::cout << "Mounted asset pack " << pack_path << " with " << pack->get_entry_count() << " files.\n";
+
+    return true;
+}
+
+void VirtualFileSystem::unmount()
+{
+    m_pack = nullptr;
+}
+
+FileView VirtualFileSystem::read(std::string const& path)
+{
+#if EDITOR
+    if (FileView file = read_loose_file(path); file.is_valid())
+        return file;
+
+    return read_packed_file(path);
+#else
+    if (FileView file = read_packed_file(path); file.is_valid())
+        return file;
+
+    return read_loose_file(path);
+#endif
+}
+
+bool VirtualFileSystem::exists(std::string const& path)
+{
+    if (m_pack != nullptr && m_pack->find(normalize_path(path)).has_value())
+        return true;
+
+    std::error_code error;
+    return std::filesystem::is_regular_file(path, error);
+}
+
+std::string VirtualFileSystem::normalize_path(std::string_view const path)
+{
+    std::string result(path);
+    std::ranges::replace(result, '\\', '/');
+
+    result = std::filesystem::path(result).lexically_normal().generic_string();
+
+    std::ranges::transform(result, result.begin(), [](char const c) { return static_cast<char>(std::tolower(static_cast<u8>(c))); });
+
+    return result;
+}
+
+FileView VirtualFileSystem::read_loose_file(std::string const& path)
+{
+    auto const mapped_file = MemoryMappedFile::open(path);
+
+    if (mapped_file == nullptr)
+        return {};
+
+    auto const* data = reinterpret_cast<std::byte const*>(mapped_file->get_data());
+    return {std::span(data, mapped_file->get_size()), mapped_file};
+}
+
+FileView VirtualFileSystem::read_packed_file(std::string const& path)
+{
+    if (m_pack == nullptr)
+        return {};
+
+    auto const data = m_pack->find(normalize_path(path));
+
+    if (!data.has_value())
+        return {};
+
+    return {data.value(), m_pack};
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include "AK/Types.h"
+
+class AssetPack;
+
+// Contents of a file, mapped in place. Keeps the pack or loose file it points into mapped for as long as it is alive.
+class FileView
+{
+public:
+    FileView() = default;
+    FileView(std::span<std::byte const> const data, std::shared_ptr<void const> owner);
+
+    [[nodiscard]] bool is_valid() const;
+
+    [[nodiscard]] std::span<std::byte const> get_data() const;
+    [[nodiscard]] u8 const* get_bytes() const;
+    [[nodiscard]] size_t get_size() const;
+
+    // Text assets aren't null-terminated, don't pass this on as a C string.
+    [[nodiscard]] std::string_view get_text() const;
+
+private:
+    std::span<std::byte const> m_data = {};
+    std::shared_ptr<void const> m_owner = nullptr;
+};
+
+// Single place every loader reads assets through. Files are served from the mounted AssetPack, except in editor builds,
+// where loose files under res/ take precedence so edits show up without rebuilding the pack.
+// Files missing from the pack are always read loose, which covers anything written at runtime.
+// Reading is thread-safe, mounting is not and happens before anything gets loaded.
+class VirtualFileSystem
+{
+public:
+    VirtualFileSystem() = delete;
+
+    // Returns false if there is no valid pack at pack_path, assets are then read from loose files only.
+    static bool mount(std::string const& pack_path);
+    static void unmount();
+
+    [[nodiscard]] static FileView read(std::string const& path);
+    [[nodiscard]] static bool exists(std::string const& path);
+
+    // Lowercase, forward slashes and no leading "./", the form paths are stored in the pack with.
+    // Windows file names are case-insensitive and the engine doesn't always spell them like the files on disk.
+    static std::string normalize_path(std::string_view const path);
+
+    inline static std::string const default_pack_path = "./res.pack";
+
+private:
+    static FileView read_loose_file(std::string const& path);
+    static FileView read_packed_file(std::string const& path);
+
+    inline static std::shared_ptr<AssetPack> m_pack = nullptr;
+};
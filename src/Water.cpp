@@ -134,8 +134,9 @@ void Water::prepare()
 
     std::vector<std::shared_ptr<Texture>> diffuse_maps = {};
 
-    m_meshes.push_back(
-        ResourceManager::get_instance().load_mesh(m_meshes.size(), "WATER", vertices, indices, diffuse_maps, m_draw_type, material));
+    // Meshes of other tesselation levels are unloaded by ResourceManager once no water uses them.
+    m_meshes.push_back(ResourceManager::get_instance().load_mesh(m_meshes.size(), std::to_string(tesselation_level) + "WATER", vertices,
+                                                                 indices, diffuse_maps, m_draw_type, material));
 }
 
 void Water::reprepare()
@@ -1,4 +1,14 @@
+#include "AssetPackBuilder.h"
 #include "Engine.h"
+#include "MeshCooker.h"
+#include "SceneSerializer.h"
+#include "TextureDecodeQueue.h"
+#include "VirtualFileSystem.h"
+
+#include <charconv>
+#include <iostream>
+#include <string>
+#include <string_view>
 
 #define FORCE_DEDICATED_GPU 1
 
@@ -17,8 +27,51 @@ extern "C"
 }
 #endif
 
-i32 main(i32, char**)
+i32 main(i32 argc, char** argv)
 {
+    // Headless decode throughput test: Engine.exe --benchmark-texture-decode [thread count]
+    if (argc >= 2 && std::string(argv[1]) == "--benchmark-texture-decode")
+    {
+        u32 thread_count = std::thread::hardware_concurrency();
+
+        if (argc >= 3)
+        {
+            std::string_view const argument = argv[2];
+            auto const [end, error] = std::from_chars(argument.data(), argument.data() + argument.size(), thread_count);
+
+            if (error != std::errc {} || end != argument.data() + argument.size() || thread_count == 0)
+            {
+                std::cout << "Error. Thread count must be a positive number: " << argument << "\n";
+                return 1;
+            }
+        }
+
+        TextureDecodeQueue::run_benchmark("./res/textures", thread_count);
+        return 0;
+    }
+
+    // Same as tools/MeshCooker, for machines that only have the engine built: Engine.exe --cook-meshes [--verify]
+    if (argc >= 2 && std::string(argv[1]) == "--cook-meshes")
+    {
+        bool const verify = argc >= 3 && std::string(argv[2]) == "--verify";
+        return MeshCooker::cook_directory("./res/models", verify) ? 0 : 1;
+    }
+
+    // Same as tools/AssetPacker: Engine.exe --pack-assets [pack]
+    if (argc >= 2 && std::string(argv[1]) == "--pack-assets")
+    {
+        std::string const pack_path = argc >= 3 ? argv[2] : VirtualFileSystem::default_pack_path;
+        return AssetPackBuilder::build("./res", pack_path) ? 0 : 1;
+    }
+
+    // Writes the binary copy runtime builds load next to every scene and prefab: Engine.exe --cook-scenes
+    if (argc >= 2 && std::string(argv[1]) == "--cook-scenes")
+    {
+        bool const scenes_cooked = SceneSerializer::cook_directory("./res/scenes");
+        bool const prefabs_cooked = SceneSerializer::cook_directory("./res/prefabs");
+        return scenes_cooked && prefabs_cooked ? 0 : 1;
+    }
+
     if (auto const result = Engine::initialize(); result != 0)
         return result;
 
@@ -0,0 +1,21 @@
+#include "AK/Types.h"
+#include "AssetPackBuilder.h"
+#include "VirtualFileSystem.h"
+
+#include <iostream>
+#include <string>
+
+// Usage, from the directory the game runs from:
+//   AssetPacker <directory> [pack]  packs every file under directory, e.g. ./res, into pack (./res.pack by default)
+i32 main(i32 argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cout << "Usage: AssetPacker <directory> [pack]\n";
+        return 1;
+    }
+
+    std::string const pack_path = argc >= 3 ? argv[2] : VirtualFileSystem::default_pack_path;
+
+    return AssetPackBuilder::build(argv[1], pack_path) ? 0 : 1;
+}
@@ -0,0 +1,21 @@
+#include "AK/Types.h"
+#include "MeshCooker.h"
+
+#include <iostream>
+#include <string>
+
+// Usage:
+//   MeshCooker <directory>           cooks every model under directory, e.g. res/models
+//   MeshCooker --verify <directory>  also loads every cooked model back and compares it against a fresh import
+i32 main(i32 argc, char** argv)
+{
+    bool const verify = argc >= 2 && std::string(argv[1]) == "--verify";
+
+    if (argc < (verify ? 3 : 2))
+    {
+        std::cout << "Usage: MeshCooker [--verify] <directory>\n";
+        return 1;
+    }
+
+    return MeshCooker::cook_directory(argv[verify ? 2 : 1], verify) ? 0 : 1;
+}